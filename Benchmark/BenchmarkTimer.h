@@ -0,0 +1,70 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 벤치마크용 나노초 타이머와 지연시간 표본
+ *
+ * StopWatch<HighResolution>은 TimeSpan(마이크로초)으로 반환하므로 연산 1회를 재기에는 해상도가 부족하다.
+ * 그래서 StopWatch의 고해상도 카운터(Start의 반환값)와 Frequency를 직접 써서 나노초로 환산한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Time.h>
+#include <JCore/Container/Vector.h>
+
+NS_JC_BEGIN
+
+class NanoStopWatch
+{
+public:
+	NanoStopWatch() : m_uiStartCounter(0) {}
+
+	void Start() { m_uiStartCounter = m_Watch.Start(); }
+
+	// Start 이후 지난 시간
+	double ElapsedNanoSeconds() {
+		const Int64U uiNow = m_Watch.Start();
+		return double(uiNow - m_uiStartCounter) * 1'000'000'000.0 / double(m_Watch.Frequency);
+	}
+private:
+	StopWatch<StopWatchMode::HighResolution> m_Watch;
+	Int64U m_uiStartCounter;
+};
+
+// 연산 1회 지연시간 표본을 모아서 백분위수를 구한다.
+class LatencySamples
+{
+public:
+	LatencySamples(int capacity = 1024) : m_Samples(capacity), m_bSorted(true) {}
+
+	void Add(double nanoSeconds) {
+		m_Samples.PushBack(nanoSeconds);
+		m_bSorted = false;
+	}
+
+	void Clear() {
+		m_Samples.Clear();
+		m_bSorted = true;
+	}
+
+	int Count() const { return m_Samples.Size(); }
+
+	// percentile: 0 ~ 100
+	double Percentile(double percentile) {
+		if (m_Samples.Size() == 0) return 0.0;
+
+		if (!m_bSorted) {
+			m_Samples.Sort();
+			m_bSorted = true;
+		}
+
+		int iIndex = int(percentile / 100.0 * (m_Samples.Size() - 1) + 0.5);
+		return m_Samples[Math::Min(iIndex, m_Samples.Size() - 1)];
+	}
+private:
+	Vector<double> m_Samples;
+	bool m_bSorted;
+};
+
+NS_JC_END
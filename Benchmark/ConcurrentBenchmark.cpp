@@ -0,0 +1,192 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 동시성 컨테이너 처리량 비교
+ * 읽기/쓰기 락 하나로 감싼 TreeSet/HashMap을 기준으로 ConcurrentSkipListSet, ConcurrentHashMap의 처리량을 쓰레드 수별로 잰다.
+ *
+ *  concurrent_benchmark
+ *
+ *  - 셋: 탐색 80%, 삽입 10%, 삭제 10%
+ *  - 해시맵: 쓰기 10%(읽기 위주), 쓰기 50%(쓰기 위주)
+ *
+ * 쓰레드 수가 하드웨어 쓰레드 수보다 많은 줄은 병렬 실행이 아니라 시분할 결과이므로 표시를 붙인다.
+ * 확장성을 말하려면 측정할 쓰레드 수만큼 코어가 있는 머신에서 돌린 결과를 써야 한다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Time.h>
+#include <JCore/Sync/NormalRwLock.h>
+#include <JCore/Threading/Thread.h>
+#include <JCore/Container/HashMap.h>
+#include <JCore/Container/ConcurrentHashMap.h>
+
+#include <thread>
+
+#include "Tree/TreeSet.h"
+#include "Tree/ConcurrentSkipListSet.h"
+
+USING_NS_JC;
+
+// 하드웨어 쓰레드보다 많은 쓰레드로 잰 결과에 붙일 표시
+const char* OversubscribedMark(int threadCount) {
+	return threadCount > int(std::thread::hardware_concurrency()) ? " (시분할)" : "";
+}
+
+// 읽기/쓰기 락으로 감싼 TreeSet (동시성 비교 기준)
+class RwLockTreeSet
+{
+public:
+	bool Insert(int data) { NormalWriteLockGuard guard(m_Lock); return m_Set.Insert(data); }
+	bool Remove(int data) { NormalWriteLockGuard guard(m_Lock); return m_Set.Remove(data); }
+	bool Search(int data) { NormalReadLockGuard guard(m_Lock); return m_Set.Search(data); }
+private:
+	NormalRwLock m_Lock;
+	TreeSet<int> m_Set;
+};
+
+// 쓰레드마다 탐색 80%, 삽입 10%, 삭제 10%를 섞어서 수행하고 초당 처리량을 잰다.
+template <typename TSet>
+double MeasureConcurrentThroughput(TSet& set, int threadCount, int opsPerThread, int range) {
+	constexpr int MaxThreadCount = 64;
+	Thread threads[MaxThreadCount];
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Start([&set, opsPerThread, range, i](void*) {
+			Int32U uiSeed = 2463534242u + i * 7919u;
+			for (int j = 0; j < opsPerThread; ++j) {
+				uiSeed ^= uiSeed << 13;
+				uiSeed ^= uiSeed >> 17;
+				uiSeed ^= uiSeed << 5;
+				const int iKey = int(uiSeed % Int32U(range));
+				const int iOp = int((uiSeed >> 24) % 10);
+
+				if (iOp == 0) set.Insert(iKey);
+				else if (iOp == 1) set.Remove(iKey);
+				else set.Search(iKey);
+			}
+		});
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Join();
+	}
+
+	return double(threadCount) * opsPerThread / watch.StopReset().GetTotalSeconds();
+}
+
+void CompareConcurrentSet(int threadCount) {
+	constexpr int Range = 200'000;
+	constexpr int OpsPerThread = 100'000;
+
+	RwLockTreeSet tree;
+	ConcurrentSkipListSet<int> skipList;
+	for (int i = 0; i < Range; i += 2) {
+		tree.Insert(i);
+		skipList.Insert(i);
+	}
+
+	const double fTreeOps = MeasureConcurrentThroughput(tree, threadCount, OpsPerThread, Range);
+	const double fSkipListOps = MeasureConcurrentThroughput(skipList, threadCount, OpsPerThread, Range);
+	Console::WriteLine("[쓰레드 %2d개] RwLock TreeSet: %8.0f ops/s, ConcurrentSkipListSet: %8.0f ops/s (x%.2f)%s",
+		threadCount, fTreeOps, fSkipListOps, fSkipListOps / fTreeOps, OversubscribedMark(threadCount)
+	);
+}
+
+// 읽기/쓰기 락 하나로 감싼 HashMap (동시성 해시맵 비교 기준)
+class RwLockHashMap
+{
+public:
+	bool Insert(int key, int value) { NormalWriteLockGuard guard(m_Lock); return m_Map.Insert(key, value); }
+	bool Remove(int key) { NormalWriteLockGuard guard(m_Lock); return m_Map.Remove(key); }
+	bool TryGet(int key, int& value) {
+		NormalReadLockGuard guard(m_Lock);
+		int* pValue = m_Map.Find(key);
+		if (pValue == nullptr) return false;
+		value = *pValue;
+		return true;
+	}
+private:
+	NormalRwLock m_Lock;
+	HashMap<int, int> m_Map;
+};
+
+// 쓰레드마다 쓰기 writePercent%(삽입/삭제 반반), 나머지는 탐색을 섞어서 수행하고 초당 처리량을 잰다.
+template <typename TMap>
+double MeasureConcurrentMapThroughput(TMap& map, int threadCount, int opsPerThread, int range, int writePercent) {
+	constexpr int MaxThreadCount = 64;
+	Thread threads[MaxThreadCount];
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Start([&map, opsPerThread, range, writePercent, i](void*) {
+			Int32U uiSeed = 2463534242u + i * 7919u;
+			for (int j = 0; j < opsPerThread; ++j) {
+				uiSeed ^= uiSeed << 13;
+				uiSeed ^= uiSeed >> 17;
+				uiSeed ^= uiSeed << 5;
+				const int iKey = int(uiSeed % Int32U(range));
+				const int iOp = int((uiSeed >> 20) % 100);
+
+				if (iOp < writePercent / 2) map.Insert(iKey, iKey);
+				else if (iOp < writePercent) map.Remove(iKey);
+				else {
+					int iValue;
+					map.TryGet(iKey, iValue);
+				}
+			}
+		});
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Join();
+	}
+
+	return double(threadCount) * opsPerThread / watch.StopReset().GetTotalSeconds();
+}
+
+void CompareConcurrentHashMap(int threadCount, int writePercent) {
+	constexpr int Range = 200'000;
+	constexpr int OpsPerThread = 100'000;
+
+	RwLockHashMap locked;
+	ConcurrentHashMap<int, int> spinStriped;
+	ConcurrentHashMap<int, int, NormalRwLock> rwStriped;
+	for (int i = 0; i < Range; i += 2) {
+		locked.Insert(i, i);
+		spinStriped.Insert(i, i);
+		rwStriped.Insert(i, i);
+	}
+
+	const double fLockedOps = MeasureConcurrentMapThroughput(locked, threadCount, OpsPerThread, Range, writePercent);
+	const double fSpinOps = MeasureConcurrentMapThroughput(spinStriped, threadCount, OpsPerThread, Range, writePercent);
+	const double fRwOps = MeasureConcurrentMapThroughput(rwStriped, threadCount, OpsPerThread, Range, writePercent);
+	Console::WriteLine("[쓰기 %2d%% | 쓰레드 %2d개] RwLock HashMap: %9.0f ops/s, 세그먼트 SpinLock: %9.0f ops/s (x%.2f), 세그먼트 RwLock: %9.0f ops/s (x%.2f)%s",
+		writePercent, threadCount, fLockedOps, fSpinOps, fSpinOps / fLockedOps, fRwOps, fRwOps / fLockedOps, OversubscribedMark(threadCount)
+	);
+}
+
+int main() {
+	Console::WriteLine("하드웨어 쓰레드 %d개", int(std::thread::hardware_concurrency()));
+
+	{
+		Console::WriteLine("동시성 셋 처리량 비교 (탐색 80%%, 삽입 10%%, 삭제 10%%)");
+		for (int iThreadCount = 1; iThreadCount <= 64; iThreadCount *= 2) {
+			CompareConcurrentSet(iThreadCount);
+		}
+	}
+
+	{
+		Console::WriteLine("동시성 해시맵 처리량 비교 (읽기 위주: 쓰기 10%%, 쓰기 위주: 쓰기 50%%)");
+		for (int iThreadCount = 1; iThreadCount <= 64; iThreadCount *= 2) {
+			CompareConcurrentHashMap(iThreadCount, 10);
+		}
+		for (int iThreadCount = 1; iThreadCount <= 64; iThreadCount *= 2) {
+			CompareConcurrentHashMap(iThreadCount, 50);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,220 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 컨테이너 비교 벤치마크
+ * 같은 작업을 TreeSet과 다른 정렬 컨테이너, std::set/std::map, JCore HashMap/FlatHashMap에 똑같이 돌려서 비교한다.
+ *
+ *  container_benchmark [csv|json (기본 csv)] [최대 데이터 수 (기본 1,000,000)]
+ *
+ * 데이터 수는 1,000부터 10배씩 최대 데이터 수까지 늘린다.
+ * 키는 [0, 2 * 데이터 수) 범위의 짝수만 넣으므로 무작위 탐색은 약 절반이 실패한다.
+ *
+ *  - BulkLoad:		빈 컨테이너에 무작위 순서로 데이터 수만큼 삽입
+ *  - PointLookup:	무작위 키 탐색
+ *  - OrderedScan:	무작위 위치부터 ScanLength개씩 오름차순 순회 (연산 수 = 읽은 키 수, 순서가 없는 컨테이너는 제외)
+ *  - Mixed90_10:	탐색 90%, 삽입 5%, 삭제 5%
+ *
+ * checksum은 작업 결과(성공한 연산 수 또는 읽은 키의 합)이므로 같은 작업/데이터 수에서는 모든 컨테이너가 같아야 한다.
+ */
+
+#include <JCore/Core.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Benchmark/ContainerEngine.h"
+#include "Benchmark/KeyDistribution.h"
+#include "Benchmark/BenchmarkTimer.h"
+
+USING_NS_JC;
+
+constexpr int DefaultMaxDataCount = 1'000'000;
+constexpr int ScanLength = 100;
+
+enum class OutputFormat
+{
+	Csv,
+	Json
+};
+
+struct BenchmarkResult
+{
+	const char* Engine;
+	const char* Workload;
+	int DataCount;
+	Int64 OperationCount;
+	double TotalNanoSeconds;
+	Int64 Checksum;
+};
+
+// 결과를 한줄씩 바로 출력한다. (오래 걸리는 큰 데이터 수에서도 중간 결과를 볼 수 있도록)
+class ResultWriter
+{
+public:
+	ResultWriter(OutputFormat format) : m_eFormat(format), m_bFirst(true) {}
+
+	void Begin() {
+		if (m_eFormat == OutputFormat::Csv) {
+			Console::WriteLine("engine,workload,data_count,operations,total_ns,ns_per_op,ops_per_sec,checksum");
+			return;
+		}
+
+		Console::Write("[");
+	}
+
+	void Write(const BenchmarkResult& result) {
+		const double fNanoPerOp = result.TotalNanoSeconds / double(Math::Max(result.OperationCount, Int64(1)));
+		const double fOpsPerSec = fNanoPerOp > 0.0 ? 1'000'000'000.0 / fNanoPerOp : 0.0;
+
+		if (m_eFormat == OutputFormat::Csv) {
+			Console::WriteLine("%s,%s,%d,%lld,%.0f,%.2f,%.0f,%lld",
+				result.Engine, result.Workload, result.DataCount, result.OperationCount,
+				result.TotalNanoSeconds, fNanoPerOp, fOpsPerSec, result.Checksum);
+			return;
+		}
+
+		Console::Write("%s\n  {\"engine\": \"%s\", \"workload\": \"%s\", \"data_count\": %d, \"operations\": %lld, "
+			"\"total_ns\": %.0f, \"ns_per_op\": %.2f, \"ops_per_sec\": %.0f, \"checksum\": %lld}",
+			m_bFirst ? "" : ",",
+			result.Engine, result.Workload, result.DataCount, result.OperationCount,
+			result.TotalNanoSeconds, fNanoPerOp, fOpsPerSec, result.Checksum);
+		m_bFirst = false;
+	}
+
+	void End() {
+		if (m_eFormat == OutputFormat::Json) {
+			Console::WriteLine("\n]");
+		}
+	}
+private:
+	OutputFormat m_eFormat;
+	bool m_bFirst;
+};
+
+// 모든 컨테이너가 같은 입력을 쓰도록 데이터 수마다 한번만 만든다.
+struct Workload
+{
+	Workload(int dataCount)
+		: DataCount(dataCount)
+		, LoadKeys(dataCount)
+		, LookupKeys(dataCount)
+		, ScanStarts(Math::Max(dataCount / ScanLength, 1))
+		, MixedKeys(dataCount)
+		, MixedOperations(dataCount)
+	{
+		const int iRange = dataCount * 2;
+
+		GenerateKeys(KeyDistribution::Uniform, dataCount, LoadKeys);
+		for (int i = 0; i < dataCount; ++i) {
+			LoadKeys[i] *= 2;
+			LookupKeys.PushBack(Random::GenerateInt(0, iRange));
+			MixedKeys.PushBack(Random::GenerateInt(0, iRange));
+
+			// 0: 탐색, 1: 삽입, 2: 삭제
+			const int iDice = Random::GenerateInt(0, 20);
+			MixedOperations.PushBack(iDice == 0 ? 1 : iDice == 1 ? 2 : 0);
+		}
+
+		const int iScanRange = Math::Max(iRange - ScanLength * 2, 1);
+		for (int i = 0; i < Math::Max(dataCount / ScanLength, 1); ++i) {
+			ScanStarts.PushBack(Random::GenerateInt(0, iScanRange));
+		}
+	}
+
+	int DataCount;
+	Vector<int> LoadKeys;
+	Vector<int> LookupKeys;
+	Vector<int> ScanStarts;
+	Vector<int> MixedKeys;
+	Vector<int> MixedOperations;
+};
+
+template <typename TEngine>
+void RunEngine(const Workload& workload, ResultWriter& writer) {
+	TEngine engine;
+	NanoStopWatch watch;
+	BenchmarkResult result{ TEngine::Name, nullptr, workload.DataCount, 0, 0.0, 0 };
+
+	{
+		Int64 iInserted = 0;
+		watch.Start();
+		for (int i = 0; i < workload.LoadKeys.Size(); ++i) {
+			iInserted += engine.Insert(workload.LoadKeys[i]);
+		}
+		result.TotalNanoSeconds = watch.ElapsedNanoSeconds();
+		result.Workload = "BulkLoad";
+		result.OperationCount = workload.LoadKeys.Size();
+		result.Checksum = iInserted;
+		writer.Write(result);
+	}
+
+	{
+		Int64 iFound = 0;
+		watch.Start();
+		for (int i = 0; i < workload.LookupKeys.Size(); ++i) {
+			iFound += engine.Search(workload.LookupKeys[i]);
+		}
+		result.TotalNanoSeconds = watch.ElapsedNanoSeconds();
+		result.Workload = "PointLookup";
+		result.OperationCount = workload.LookupKeys.Size();
+		result.Checksum = iFound;
+		writer.Write(result);
+	}
+
+	if constexpr (TEngine::Ordered) {
+		Int64 iSum = 0;
+		watch.Start();
+		for (int i = 0; i < workload.ScanStarts.Size(); ++i) {
+			iSum += engine.Scan(workload.ScanStarts[i], ScanLength);
+		}
+		result.TotalNanoSeconds = watch.ElapsedNanoSeconds();
+		result.Workload = "OrderedScan";
+		result.OperationCount = Int64(workload.ScanStarts.Size()) * ScanLength;
+		result.Checksum = iSum;
+		writer.Write(result);
+	}
+
+	{
+		Int64 iSucceeded = 0;
+		watch.Start();
+		for (int i = 0; i < workload.MixedKeys.Size(); ++i) {
+			const int iKey = workload.MixedKeys[i];
+			switch (workload.MixedOperations[i]) {
+			case 1:  iSucceeded += engine.Insert(iKey); break;
+			case 2:  iSucceeded += engine.Remove(iKey); break;
+			default: iSucceeded += engine.Search(iKey); break;
+			}
+		}
+		result.TotalNanoSeconds = watch.ElapsedNanoSeconds();
+		result.Workload = "Mixed90_10";
+		result.OperationCount = workload.MixedKeys.Size();
+		result.Checksum = iSucceeded;
+		writer.Write(result);
+	}
+}
+
+int main(int argc, char** argv) {
+	const OutputFormat eFormat = argc > 1 && std::strcmp(argv[1], "json") == 0 ? OutputFormat::Json : OutputFormat::Csv;
+	const int iMaxDataCount = argc > 2 ? atoi(argv[2]) : DefaultMaxDataCount;
+	ResultWriter writer(eFormat);
+
+	writer.Begin();
+	for (Int64 iDataCount = 1'000; iDataCount <= iMaxDataCount; iDataCount *= 10) {
+		const Workload workload{ int(iDataCount) };
+
+		RunEngine<RedBlackTreeSetEngine>(workload, writer);
+		RunEngine<RedBlackTreeSetCursorEngine>(workload, writer);
+		RunEngine<AvlTreeSetEngine>(workload, writer);
+		RunEngine<TreapSetEngine>(workload, writer);
+		RunEngine<RadixTreeMapEngine>(workload, writer);
+		RunEngine<BitmapSetEngine>(workload, writer);
+		RunEngine<ConcurrentSkipListSetEngine>(workload, writer);
+		RunEngine<StdSetEngine>(workload, writer);
+		RunEngine<StdMapEngine>(workload, writer);
+		RunEngine<HashMapEngine>(workload, writer);
+		RunEngine<FlatHashMapEngine>(workload, writer);
+	}
+	writer.End();
+
+	return 0;
+}
@@ -0,0 +1,224 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 컨테이너 비교 벤치마크용 어댑터
+ * 컨테이너마다 인터페이스가 조금씩 다르므로 같은 작업을 같은 코드로 돌릴 수 있게 감싼다.
+ *
+ * 모든 어댑터는 다음을 제공한다.
+ *  - Name:			출력에 쓸 이름
+ *  - Ordered:		순서 순회(Scan) 지원 여부 (false면 Scan 작업을 건너뛴다)
+ *  - Insert/Search/Remove/Clear/Size
+ *  - Scan(from, count): from 이상인 키를 오름차순으로 최대 count개 읽고 읽은 키의 합을 반환
+ *
+ * 새 정렬 컨테이너를 비교하려면 어댑터를 하나 추가하고 ContainerBenchmark.cpp의 main에서 RunEngine을 호출하면 된다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Container/HashMap.h>
+#include <JCore/Container/FlatHashMap.h>
+
+#include <map>
+#include <set>
+
+#include "Tree/TreeSet.h"
+#include "Tree/AvlBalancer.h"
+#include "Tree/TreapSet.h"
+#include "Tree/RadixTreeMap.h"
+#include "Tree/BitmapSet.h"
+#include "Tree/ConcurrentSkipListSet.h"
+
+NS_JC_BEGIN
+
+namespace Detail {
+	// 반복자 인터페이스(HasNext/Next)가 같은 컨테이너들의 Scan
+	template <typename TIterator, typename Selector>
+	Int64 ScanIterator(TIterator it, int count, Selector&& selector) {
+		Int64 iSum = 0;
+		for (int i = 0; i < count && it.HasNext(); ++i) {
+			iSum += selector(it.Next());
+		}
+		return iSum;
+	}
+
+	template <typename TStdIterator, typename Selector>
+	Int64 ScanStdIterator(TStdIterator it, TStdIterator end, int count, Selector&& selector) {
+		Int64 iSum = 0;
+		for (int i = 0; i < count && it != end; ++i, ++it) {
+			iSum += selector(*it);
+		}
+		return iSum;
+	}
+
+	inline int SelectKey(int key) { return key; }
+
+	// 범위 커서로 ScanBatchSize개씩 버퍼에 받아서 읽는다.
+	template <typename TCursor>
+	Int64 ScanCursor(TCursor cursor, int count) {
+		constexpr int ScanBatchSize = 64;
+		int buffer[ScanBatchSize];
+		Int64 iSum = 0;
+
+		for (int iRead; count > 0 && (iRead = cursor.Read(buffer, Math::Min(count, ScanBatchSize))) > 0; count -= iRead) {
+			for (int i = 0; i < iRead; ++i) {
+				iSum += buffer[i];
+			}
+		}
+
+		return iSum;
+	}
+}
+
+template <typename TBalancer>
+struct TreeSetEngine
+{
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Set.Insert(key); }
+	bool Search(int key) const { return Set.Search(key); }
+	bool Remove(int key) { return Set.Remove(key); }
+	void Clear() { Set.Clear(); }
+	int Size() const { return Set.Size(); }
+	Int64 Scan(int from, int count) const { return Detail::ScanIterator(Set.LowerBound(from), count, Detail::SelectKey); }
+
+	TreeSet<int, TBalancer> Set;
+};
+
+struct RedBlackTreeSetEngine : TreeSetEngine<RedBlackBalancer> { static constexpr const char* Name = "TreeSet(RedBlack)"; };
+struct AvlTreeSetEngine : TreeSetEngine<AvlBalancer> { static constexpr const char* Name = "TreeSet(AVL)"; };
+
+// 같은 트리를 반복자 대신 범위 커서로 묶음 단위로 읽는다. (Scan만 다르다)
+struct RedBlackTreeSetCursorEngine : TreeSetEngine<RedBlackBalancer>
+{
+	static constexpr const char* Name = "TreeSet(RedBlack,Cursor)";
+
+	Int64 Scan(int from, int count) const { return Detail::ScanCursor(Set.ScanCursor(from), count); }
+};
+
+struct TreapSetEngine
+{
+	static constexpr const char* Name = "TreapSet";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Set.Insert(key); }
+	bool Search(int key) const { return Set.Search(key); }
+	bool Remove(int key) { return Set.Remove(key); }
+	void Clear() { Set.Clear(); }
+	int Size() const { return Set.Size(); }
+	Int64 Scan(int from, int count) const { return Detail::ScanIterator(Set.LowerBound(from), count, Detail::SelectKey); }
+
+	TreapSet<int> Set;
+};
+
+struct RadixTreeMapEngine
+{
+	static constexpr const char* Name = "RadixTreeMap";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Map.Insert(key, key); }
+	bool Search(int key) const { return Map.Search(key); }
+	bool Remove(int key) { return Map.Remove(key); }
+	void Clear() { Map.Clear(); }
+	int Size() const { return Map.Size(); }
+	Int64 Scan(int from, int count) const {
+		return Detail::ScanIterator(Map.LowerBound(from), count, [](const Pair<int, int>& pair) { return pair.Key; });
+	}
+
+	RadixTreeMap<int, int> Map;
+};
+
+struct BitmapSetEngine
+{
+	static constexpr const char* Name = "BitmapSet";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Set.Insert(key); }
+	bool Search(int key) const { return Set.Search(key); }
+	bool Remove(int key) { return Set.Remove(key); }
+	void Clear() { Set.Clear(); }
+	int Size() const { return Set.Size(); }
+	Int64 Scan(int from, int count) const { return Detail::ScanIterator(Set.LowerBound(from), count, Detail::SelectKey); }
+
+	BitmapSet Set;
+};
+
+struct ConcurrentSkipListSetEngine
+{
+	static constexpr const char* Name = "ConcurrentSkipListSet";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Set.Insert(key); }
+	bool Search(int key) const { return Set.Search(key); }
+	bool Remove(int key) { return Set.Remove(key); }
+	void Clear() { Set.Clear(); }
+	int Size() const { return Set.Size(); }
+	Int64 Scan(int from, int count) const { return Detail::ScanIterator(Set.LowerBound(from), count, Detail::SelectKey); }
+
+	ConcurrentSkipListSet<int> Set;
+};
+
+struct StdSetEngine
+{
+	static constexpr const char* Name = "std::set";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Set.insert(key).second; }
+	bool Search(int key) const { return Set.find(key) != Set.end(); }
+	bool Remove(int key) { return Set.erase(key) != 0; }
+	void Clear() { Set.clear(); }
+	int Size() const { return int(Set.size()); }
+	Int64 Scan(int from, int count) const { return Detail::ScanStdIterator(Set.lower_bound(from), Set.end(), count, Detail::SelectKey); }
+
+	std::set<int> Set;
+};
+
+struct StdMapEngine
+{
+	static constexpr const char* Name = "std::map";
+	static constexpr bool Ordered = true;
+
+	bool Insert(int key) { return Map.emplace(key, key).second; }
+	bool Search(int key) const { return Map.find(key) != Map.end(); }
+	bool Remove(int key) { return Map.erase(key) != 0; }
+	void Clear() { Map.clear(); }
+	int Size() const { return int(Map.size()); }
+	Int64 Scan(int from, int count) const {
+		return Detail::ScanStdIterator(Map.lower_bound(from), Map.end(), count, [](const std::pair<const int, int>& pair) { return pair.first; });
+	}
+
+	std::map<int, int> Map;
+};
+
+// 해시맵은 순서가 없으므로 Scan 작업은 하지 않는다.
+struct HashMapEngine
+{
+	static constexpr const char* Name = "HashMap";
+	static constexpr bool Ordered = false;
+
+	bool Insert(int key) { return Map.Insert(key, key); }
+	bool Search(int key) const { return Map.Exist(key); }
+	bool Remove(int key) { return Map.Remove(key); }
+	void Clear() { Map.Clear(); }
+	int Size() const { return Map.Size(); }
+	Int64 Scan(int, int) const { return 0; }
+
+	HashMap<int, int> Map;
+};
+
+struct FlatHashMapEngine
+{
+	static constexpr const char* Name = "FlatHashMap";
+	static constexpr bool Ordered = false;
+
+	bool Insert(int key) { return Map.Insert(key, key); }
+	bool Search(int key) const { return Map.Exist(key); }
+	bool Remove(int key) { return Map.Remove(key); }
+	void Clear() { Map.Clear(); }
+	int Size() const { return Map.Size(); }
+	Int64 Scan(int, int) const { return 0; }
+
+	FlatHashMap<int, int> Map;
+};
+
+NS_JC_END
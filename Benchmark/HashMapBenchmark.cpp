@@ -0,0 +1,261 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 해시맵 비교
+ * 버킷 배열 HashMap과 개방 주소 FlatHashMap, 그리고 HashMap의 확장 방식과 String 키 탐색 방식을 비교한다.
+ *
+ *  hashmap_benchmark
+ *
+ *  - 메모리 사용량: 같은 데이터를 담은 컨테이너들을 MemoryUsageRegistry에 등록하고 사용량을 출력
+ *  - 탐색: 삽입/탐색 시간, 할당 횟수, 메모리 사용량
+ *  - 확장 지연시간: 한번에 확장, 점진적 재해쉬, Reserve의 삽입 1회 지연시간 분포
+ *  - String 키: 임시 String으로 두번 해쉬할 때와 const char*로 한번 해쉬할 때
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/Time.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Container/HashMap.h>
+#include <JCore/Container/FlatHashMap.h>
+#include <JCore/Container/MemoryUsageRegistry.h>
+
+#include "Tree/TreeSet.h"
+
+#include "Benchmark/BenchmarkTimer.h"
+
+USING_NS_JC;
+
+void PrintMemoryUsage(const char* name, const MemoryUsage& usage) {
+	Console::WriteLine("%-14s 개수: %8lld, 원소: %9lld, 노드: %9lld, 테이블: %8lld, 여유: %9lld, 합계: %9lld바이트 (원소당 추가 %.1f바이트)",
+		name,
+		usage.ElementCount,
+		usage.ElementBytes,
+		usage.NodeBytes,
+		usage.TableBytes,
+		usage.SlackBytes,
+		usage.TotalBytes(),
+		usage.OverheadPerElement()
+	);
+}
+
+// 같은 데이터를 담은 컨테이너들을 등록소에 등록하고 사용량을 출력한다.
+void CompareMemoryUsage(int dataCount) {
+	TreeSet<int> set;
+	HashMap<int, int> map;
+	FlatHashMap<int, int> flatMap;
+	Vector<int> vec;
+
+	MemoryUsageRegistration setRegistration("TreeSet", &set);
+	MemoryUsageRegistration mapRegistration("HashMap", &map);
+	MemoryUsageRegistration flatMapRegistration("FlatHashMap", &flatMap);
+	MemoryUsageRegistration vecRegistration("Vector", &vec);
+
+	for (int i = 0; i < dataCount; ++i) {
+		set.Insert(i);
+		map.Insert(i, i);
+		flatMap.Insert(i, i);
+		vec.PushBack(i);
+	}
+
+	MemoryUsageRegistry::ForEach(PrintMemoryUsage);
+	PrintMemoryUsage("합계", MemoryUsageRegistry::Total());
+
+	// 해시맵은 비워진 버킷도 노드 배열을 들고있으므로 여유분으로 남는다.
+	for (int i = 0; i < dataCount; i += 2) {
+		map.Remove(i);
+	}
+	PrintMemoryUsage("HashMap(절반)", map.GetMemoryUsage());
+}
+
+// 동적 할당(크기를 지정하는 할당) 횟수를 센다.
+struct CountingAllocator : DefaultAllocator
+{
+	using DefaultAllocator::Allocate;
+
+	template <typename T = void*>
+	static auto Allocate(int size, int& allocatedSize) {
+		++AllocationCount;
+		return DefaultAllocator::Allocate<T>(size, allocatedSize);
+	}
+
+	inline static Int64 AllocationCount = 0;
+};
+
+// 같은 키를 넣고 삽입/탐색 시간, 할당 횟수, 메모리 사용량을 비교한다. (탐색 키는 절반이 없는 키)
+template <typename TMap>
+void CompareHashMapLookup(const char* name, const Vector<int>& keys, const Vector<int>& lookupKeys) {
+	StopWatch<StopWatchMode::HighResolution> watch;
+	CountingAllocator::AllocationCount = 0;
+	TMap map;
+
+	watch.Start();
+	for (int i = 0; i < keys.Size(); ++i) {
+		map.Insert(keys[i], i);
+	}
+	const double fInsertMs = watch.StopReset().GetTotalMiliSeconds();
+	const Int64 iAllocationCount = CountingAllocator::AllocationCount;
+
+	int iFound = 0;
+	watch.Start();
+	for (int i = 0; i < lookupKeys.Size(); ++i) {
+		iFound += map.Exist(lookupKeys[i]);
+	}
+	const double fLookupMs = watch.StopReset().GetTotalMiliSeconds();
+
+	const MemoryUsage usage = map.GetMemoryUsage();
+	Console::WriteLine("%-12s | 삽입: %8.1fms, 탐색: %8.1fms (%.1fns/회, 찾은 수: %d) | 할당: %9lld회, 메모리: %6.1fMB",
+		name,
+		fInsertMs,
+		fLookupMs,
+		fLookupMs * 1'000'000.0 / lookupKeys.Size(),
+		iFound,
+		iAllocationCount,
+		double(usage.TotalBytes()) / (1024 * 1024)
+	);
+}
+
+void CompareHashMaps(int dataCount) {
+	Vector<int> keys(dataCount);
+	Vector<int> lookupKeys(dataCount);
+
+	// 짝수 키만 넣고 [0, 2 * dataCount) 범위에서 무작위로 찾는다.
+	for (int i = 0; i < dataCount; ++i) {
+		keys.PushBack(Random::GenerateInt(0, dataCount) * 2);
+		lookupKeys.PushBack(Random::GenerateInt(0, dataCount * 2));
+	}
+
+	CompareHashMapLookup<HashMap<int, int, CountingAllocator>>("HashMap", keys, lookupKeys);
+	CompareHashMapLookup<FlatHashMap<int, int, CountingAllocator>>("FlatHashMap", keys, lookupKeys);
+}
+
+enum class HashMapGrowth
+{
+	StopTheWorld,	// 꽉 차면 한번에 확장 (기본)
+	Incremental,	// 점진적 재해쉬
+	Reserve			// 미리 Reserve해서 확장하지 않음
+};
+
+// 하나씩 넣으면서 삽입 1회의 지연시간을 잰다. 확장이 일어나는 삽입이 최대 지연시간이 된다.
+void MeasureHashMapGrowth(const char* name, const Vector<int>& keys, HashMapGrowth growth) {
+	HashMap<int, int> map;
+	NanoStopWatch watch;
+	LatencySamples samples(keys.Size());
+	double fTotalNs = 0.0;
+
+	if (growth == HashMapGrowth::Incremental) map.SetIncrementalRehash(true);
+	if (growth == HashMapGrowth::Reserve) map.Reserve(keys.Size());
+
+	for (int i = 0; i < keys.Size(); ++i) {
+		watch.Start();
+		map.Insert(keys[i], i);
+		const double fElapsed = watch.ElapsedNanoSeconds();
+		samples.Add(fElapsed);
+		fTotalNs += fElapsed;
+	}
+
+	int iFound = 0;
+	for (int i = 0; i < keys.Size(); ++i) {
+		iFound += map.Exist(keys[i]);
+	}
+
+	Console::WriteLine("%-14s | 합계: %8.1fms | p50: %6.0fns, p99: %6.0fns, p99.99: %9.0fns, 최대: %11.0fns | 재해쉬 중: %s, 찾은 수: %d",
+		name,
+		fTotalNs / 1'000'000.0,
+		samples.Percentile(50),
+		samples.Percentile(99),
+		samples.Percentile(99.99),
+		samples.Percentile(100),
+		map.IsRehashing() ? "O" : "X",
+		iFound
+	);
+}
+
+void CompareHashMapGrowth(int dataCount) {
+	Vector<int> keys(dataCount);
+	for (int i = 0; i < dataCount; ++i) {
+		keys.PushBack(Random::GenerateInt(0, 2'000'000'000));
+	}
+
+	MeasureHashMapGrowth("한번에 확장", keys, HashMapGrowth::StopTheWorld);
+	MeasureHashMapGrowth("점진적 재해쉬", keys, HashMapGrowth::Incremental);
+	MeasureHashMapGrowth("Reserve", keys, HashMapGrowth::Reserve);
+}
+
+// String 키 해시맵에 const char* 키로 세기/탐색할 때
+// 1. 임시 String을 만들어서 Exist + Insert (해쉬 두번)
+// 2. const char* 그대로 FindOrInsert, Find (해쉬 한번, 새 키일 때만 String 생성)
+void CompareStringKeyInsert(int dataCount, int keyCount) {
+	Vector<String> source(keyCount);
+	Vector<const char*> words(dataCount);
+
+	for (int i = 0; i < keyCount; ++i) {
+		source.PushBack(StringUtil::Format("session/%d/user/%d", i * 7919, i));
+	}
+
+	for (int i = 0; i < dataCount; ++i) {
+		words.PushBack(source[Random::GenerateInt(0, keyCount)].Source());
+	}
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	HashMap<String, int> temporaryMap;
+	HashMap<String, int> heterogeneousMap;
+	Int64 iTemporarySum = 0, iHeterogeneousSum = 0;
+
+	watch.Start();
+	for (int i = 0; i < words.Size(); ++i) {
+		const String key(words[i]);
+		if (temporaryMap.Exist(key)) {
+			++temporaryMap.Get(key);
+		} else {
+			temporaryMap.Insert(key, 1);
+		}
+	}
+	for (int i = 0; i < words.Size(); ++i) {
+		iTemporarySum += *temporaryMap.Find(String(words[i]));
+	}
+	const double fTemporaryMs = watch.StopReset().GetTotalMiliSeconds();
+
+	watch.Start();
+	for (int i = 0; i < words.Size(); ++i) {
+		++heterogeneousMap.FindOrInsert(words[i]);
+	}
+	for (int i = 0; i < words.Size(); ++i) {
+		iHeterogeneousSum += *heterogeneousMap.Find(words[i]);
+	}
+	const double fHeterogeneousMs = watch.StopReset().GetTotalMiliSeconds();
+
+	Console::WriteLine("키 %d개, 연산 %d회 | 임시 String + Exist/Insert: %8.1fms | const char* + FindOrInsert/Find: %8.1fms (%.2f배) | 합계 일치: %s",
+		keyCount,
+		dataCount,
+		fTemporaryMs,
+		fHeterogeneousMs,
+		fTemporaryMs / fHeterogeneousMs,
+		iTemporarySum == iHeterogeneousSum ? "O" : "X"
+	);
+}
+
+int main() {
+	{
+		Console::WriteLine("메모리 사용량 (단위: 바이트)");
+		CompareMemoryUsage(100'000);
+	}
+
+	{
+		Console::WriteLine("해시맵 비교 (버킷 배열 vs 개방 주소)");
+		CompareHashMaps(1'000'000);
+	}
+
+	{
+		Console::WriteLine("해시맵 확장 지연시간 (데이터 500만개, 4,194,304개째에 테이블 확장)");
+		CompareHashMapGrowth(5'000'000);
+	}
+
+	{
+		Console::WriteLine("String 키 해시맵 단일 해쉬 삽입/이종 탐색");
+		CompareStringKeyInsert(1'000'000, 10'000);
+		CompareStringKeyInsert(1'000'000, 500'000);
+	}
+
+	return 0;
+}
@@ -0,0 +1,297 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 해쉬 품질/속도 벤치마크
+ * 지금의 Hasher와 이전 Hasher(LegacyHasher, 비교용으로 그대로 옮겨둔 것)를 같은 입력으로 비교한다.
+ *
+ *  hasher_benchmark [키 수 (기본 1,048,576)]
+ *
+ * [버킷 분포] distribution
+ * 키 집합마다 키 수만큼 해쉬해서 BucketCount개의 버킷에 나눠 담는다.
+ * HashMap은 하위 비트(해쉬 % 용량, 용량이 2의 거듭제곱)를, FlatHashMap은 섞은 후 상위 비트를 쓰므로 둘 다 본다.
+ *  - chi2_low/chi2_high: 하위/상위 비트로 나눴을 때의 카이제곱 / 자유도. 고르게 퍼지면 1 근처이고 클수록 몰린다.
+ *  - max_load_low: 하위 비트로 나눴을 때 가장 많이 담긴 버킷의 키 수 (평균은 키 수 / BucketCount)
+ *
+ * [눈사태] avalanche
+ * 무작위 입력의 비트 하나를 뒤집었을 때 출력 비트가 뒤집히는 비율을 (입력 비트, 출력 비트) 쌍마다 구한다.
+ *  - worst_bias: 0.5에서 가장 먼 비율과 0.5의 차이 (0에 가까울수록 좋다)
+ *  - noise: 완벽한 해쉬라도 표본 수 때문에 나올 수 있는 worst_bias의 대략적인 크기 (worst_bias가 이 근처면 치우침이 없는 것)
+ *  - mean_flip: 평균 비율 (0.5가 이상적)
+ *
+ * [속도] throughput
+ * 정수는 순차 키, 바이트열은 큰 버퍼의 여러 위치(정렬되지 않은 주소 포함)를 길이별로 해쉬한다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Hasher.h>
+#include <JCore/Container/Vector.h>
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#include "Benchmark/BenchmarkTimer.h"
+
+USING_NS_JC;
+
+constexpr int DefaultKeyCount = 1 << 20;
+constexpr int BucketBits = 16;
+constexpr int BucketCount = 1 << BucketBits;
+
+// 이전 구현 (나머지 연산 믹서, 8바이트 단위 루프가 바이트 수가 아닌 워드 수까지만 돌던 문자열 해쉬)
+struct LegacyHasher
+{
+	static constexpr Int32U Prime = 0x087b840FU;
+	static constexpr Int64U XorKey = 0x3e4dc77d;
+
+	static Int32U Integer(Int64U val) {
+		return Int32U(((val ^ XorKey) % Prime) * Prime);
+	}
+
+	static Int32U Bytes(const char* source, int length) {
+		Int32U uiConv = Prime;
+		const int iStepCount = length / 8;
+
+		int i = 0;
+		for (; i < iStepCount; i += 8) {
+			Int64U uiWord;
+			std::memcpy(&uiWord, source + i, 8);
+			uiConv ^= Integer(uiWord);
+			uiConv *= Prime;
+		}
+
+		for (; i < length; ++i) {
+			uiConv ^= source[i] ^ XorKey;
+			uiConv *= Prime;
+		}
+
+		return uiConv;
+	}
+};
+
+struct CurrentHasher
+{
+	static Int32U Integer(Int64U val) { return Hasher<Int64U>()(val); }
+	static Int32U Bytes(const char* source, int length) { return Hasher<String>::HashBytes(source, length); }
+};
+
+// 입력 생성용 (재현 가능하도록 고정된 수열)
+class SplitMixRandom
+{
+public:
+	SplitMixRandom(Int64U seed) : m_uiState(seed) {}
+
+	Int64U Next() {
+		m_uiState += 0x9E3779B97F4A7C15ULL;
+		return Detail::Mix64(m_uiState);
+	}
+private:
+	Int64U m_uiState;
+};
+
+// 키 집합 (문자열은 한 버퍼에 이어 붙이고 위치/길이만 들고 있는다)
+struct KeySet
+{
+	enum Kind { Integer, Bytes };
+
+	KeySet(const char* name, Kind kind) : Name(name), KeyKind(kind) {}
+
+	void AddInteger(Int64U key) { Integers.PushBack(key); }
+
+	void AddBytes(const char* source, int length) {
+		Offsets.PushBack(Buffer.Size());
+		Lengths.PushBack(length);
+		for (int i = 0; i < length; ++i) {
+			Buffer.PushBack(source[i]);
+		}
+	}
+
+	int Count() const { return KeyKind == Integer ? Integers.Size() : Offsets.Size(); }
+
+	template <typename THasher>
+	Int32U Hash(int index) const {
+		if (KeyKind == Integer) {
+			return THasher::Integer(Integers[index]);
+		}
+
+		return THasher::Bytes(&Buffer[Offsets[index]], Lengths[index]);
+	}
+
+	const char* Name;
+	Kind KeyKind;
+	Vector<Int64U> Integers;
+	Vector<char> Buffer;
+	Vector<int> Offsets;
+	Vector<int> Lengths;
+};
+
+double ChiSquareRatio(const Vector<int>& counts, int keyCount) {
+	const double fExpected = double(keyCount) / BucketCount;
+	double fChiSquare = 0.0;
+
+	for (int i = 0; i < counts.Size(); ++i) {
+		const double fDiff = counts[i] - fExpected;
+		fChiSquare += fDiff * fDiff / fExpected;
+	}
+
+	return fChiSquare / (BucketCount - 1);
+}
+
+template <typename THasher>
+void MeasureDistribution(const char* hasherName, const KeySet& keys) {
+	Vector<int> lowCounts(BucketCount, 0);
+	Vector<int> highCounts(BucketCount, 0);
+
+	for (int i = 0; i < keys.Count(); ++i) {
+		const Int32U uiHash = keys.Hash<THasher>(i);
+		++lowCounts[uiHash & (BucketCount - 1)];
+		++highCounts[uiHash >> (32 - BucketBits)];
+	}
+
+	int iMaxLoad = 0;
+	for (int i = 0; i < BucketCount; ++i) {
+		iMaxLoad = Math::Max(iMaxLoad, lowCounts[i]);
+	}
+
+	Console::WriteLine("distribution,%s,%s,%d,%d,%.3f,%.3f,%d",
+		hasherName, keys.Name, keys.Count(), BucketCount,
+		ChiSquareRatio(lowCounts, keys.Count()), ChiSquareRatio(highCounts, keys.Count()), iMaxLoad);
+}
+
+// hash(입력, 길이)의 출력 중 하위 outputBits 비트만 본다.
+template <typename THash>
+void MeasureAvalanche(const char* hasherName, const char* inputName, int inputBytes, int outputBits, int sampleCount, THash&& hash) {
+	const int iInputBits = inputBytes * 8;
+	Vector<int> flips(iInputBits * outputBits, 0);
+	Vector<char> input(inputBytes, 0);
+	SplitMixRandom random(inputBytes);
+
+	for (int iSample = 0; iSample < sampleCount; ++iSample) {
+		for (int i = 0; i < inputBytes; ++i) {
+			input[i] = char(random.Next());
+		}
+
+		const Int64U uiBase = hash(&input[0], inputBytes);
+
+		for (int iBit = 0; iBit < iInputBits; ++iBit) {
+			input[iBit / 8] ^= char(1 << (iBit % 8));
+			const Int64U uiDiff = hash(&input[0], inputBytes) ^ uiBase;
+			input[iBit / 8] ^= char(1 << (iBit % 8));
+
+			for (int iOut = 0; iOut < outputBits; ++iOut) {
+				flips[iBit * outputBits + iOut] += int((uiDiff >> iOut) & 1);
+			}
+		}
+	}
+
+	double fWorstBias = 0.0;
+	double fSum = 0.0;
+	for (int i = 0; i < flips.Size(); ++i) {
+		const double fRatio = double(flips[i]) / sampleCount;
+		fWorstBias = Math::Max(fWorstBias, std::fabs(fRatio - 0.5));
+		fSum += fRatio;
+	}
+
+	Console::WriteLine("avalanche,%s,%s,%d,%d,%.4f,%.4f,%.4f",
+		hasherName, inputName, iInputBits, outputBits, fWorstBias, fSum / flips.Size(),
+		0.5 / std::sqrt(double(sampleCount)) * std::sqrt(2.0 * std::log(double(flips.Size()))));
+}
+
+template <typename THasher>
+void MeasureIntegerThroughput(const char* hasherName, int keyCount) {
+	NanoStopWatch watch;
+	Int64U uiSink = 0;
+	constexpr int Repeat = 16;
+
+	watch.Start();
+	for (int r = 0; r < Repeat; ++r) {
+		for (int i = 0; i < keyCount; ++i) {
+			uiSink += THasher::Integer(Int64U(i) + r);
+		}
+	}
+	const double fNanoPerHash = watch.ElapsedNanoSeconds() / (double(keyCount) * Repeat);
+
+	Console::WriteLine("throughput,%s,integer,8,%.3f,%.3f,%llu", hasherName, fNanoPerHash, 8.0 / fNanoPerHash, uiSink);
+}
+
+template <typename THasher>
+void MeasureBytesThroughput(const char* hasherName, const Vector<char>& buffer, int length) {
+	NanoStopWatch watch;
+	Int64U uiSink = 0;
+	const Int64 iTotalBytes = 256LL * 1024 * 1024;	// 길이와 관계없이 같은 양을 해쉬한다.
+	const Int64 iHashCount = Math::Max(iTotalBytes / length, Int64(1));
+	const int iSpan = buffer.Size() - length;
+
+	watch.Start();
+	for (Int64 i = 0; i < iHashCount; ++i) {
+		// 같은 입력을 반복해서 컴파일러가 계산을 루프 밖으로 빼지 못하도록 위치를 바꾼다. (홀수 간격이라 정렬되지 않은 주소도 섞인다)
+		const int iOffset = int((i * 67) % iSpan);
+		uiSink += THasher::Bytes(&buffer[iOffset], length);
+	}
+	const double fNanoPerHash = watch.ElapsedNanoSeconds() / double(iHashCount);
+
+	Console::WriteLine("throughput,%s,bytes,%d,%.3f,%.3f,%llu", hasherName, length, fNanoPerHash, length / fNanoPerHash, uiSink);
+}
+
+int main(int argc, char** argv) {
+	const int iKeyCount = argc > 1 ? atoi(argv[1]) : DefaultKeyCount;
+	SplitMixRandom random(1);
+	char key[64];
+
+	KeySet sequentialIntegers("SequentialInteger", KeySet::Integer);
+	KeySet strideIntegers("Stride4096Integer", KeySet::Integer);	// 4096 간격 (페이지 정렬 주소, 큰 단위로 띄엄띄엄 발급된 ID)
+	KeySet randomIntegers("RandomInteger", KeySet::Integer);
+	KeySet sequentialStrings("SequentialString", KeySet::Bytes);	// "user:0", "user:1", ...
+	KeySet randomStrings("RandomString", KeySet::Bytes);			// 8 ~ 24자 영문 소문자
+	KeySet pathStrings("LongPrefixString", KeySet::Bytes);			// 앞 40자가 같은 경로
+
+	for (int i = 0; i < iKeyCount; ++i) {
+		sequentialIntegers.AddInteger(Int64U(i));
+		strideIntegers.AddInteger(Int64U(i) * 4096);
+		randomIntegers.AddInteger(random.Next());
+
+		sequentialStrings.AddBytes(key, snprintf(key, sizeof(key), "user:%d", i));
+		pathStrings.AddBytes(key, snprintf(key, sizeof(key), "/var/lib/service/storage/objects/bucket/%d.bin", i));
+
+		const int iLength = 8 + int(random.Next() % 17);
+		for (int j = 0; j < iLength; ++j) {
+			key[j] = char('a' + random.Next() % 26);
+		}
+		randomStrings.AddBytes(key, iLength);
+	}
+
+	Console::WriteLine("section,hasher,keys,key_count,buckets,chi2_low,chi2_high,max_load_low");
+	for (const KeySet* pKeys : { &sequentialIntegers, &strideIntegers, &randomIntegers, &sequentialStrings, &randomStrings, &pathStrings }) {
+		MeasureDistribution<LegacyHasher>("Legacy", *pKeys);
+		MeasureDistribution<CurrentHasher>("Current", *pKeys);
+	}
+
+	Console::WriteLine("");
+	Console::WriteLine("section,hasher,input,input_bits,output_bits,worst_bias,mean_flip,noise");
+	MeasureAvalanche("Legacy", "Integer", 8, 32, 20'000, [](const char* p, int) { Int64U v; std::memcpy(&v, p, 8); return Int64U(LegacyHasher::Integer(v)); });
+	MeasureAvalanche("Current", "Integer", 8, 32, 20'000, [](const char* p, int) { Int64U v; std::memcpy(&v, p, 8); return Int64U(CurrentHasher::Integer(v)); });
+	for (int iBytes : { 4, 16, 64, 256 }) {
+		const int iSampleCount = iBytes <= 16 ? 20'000 : 2'000;
+		char szName[32];
+		snprintf(szName, sizeof(szName), "Bytes%d", iBytes);
+
+		MeasureAvalanche("Legacy", szName, iBytes, 32, iSampleCount, [](const char* p, int n) { return Int64U(LegacyHasher::Bytes(p, n)); });
+		MeasureAvalanche("Current", szName, iBytes, 64, iSampleCount, [](const char* p, int n) { return HashBytes64(p, n); });
+	}
+
+	Vector<char> buffer(1 << 20, 0);
+	for (int i = 0; i < buffer.Size(); ++i) {
+		buffer[i] = char(random.Next());
+	}
+
+	Console::WriteLine("");
+	Console::WriteLine("section,hasher,input,length,ns_per_hash,bytes_per_ns,checksum");
+	MeasureIntegerThroughput<LegacyHasher>("Legacy", iKeyCount);
+	MeasureIntegerThroughput<CurrentHasher>("Current", iKeyCount);
+	for (int iLength : { 4, 8, 16, 32, 64, 128, 256, 1024, 4096, 65536 }) {
+		MeasureBytesThroughput<LegacyHasher>("Legacy", buffer, iLength);
+		MeasureBytesThroughput<CurrentHasher>("Current", buffer, iLength);
+	}
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 벤치마크용 키 분포
+ * [0, count) 범위의 키를 분포에 맞는 순서로 count개 만든다.
+ *
+ *  - Sequential: 0, 1, 2, ...
+ *  - Reverse:    count - 1, count - 2, ...
+ *  - Uniform:    무작위 순열 (중복 없음)
+ *  - Zipfian:    소수의 키에 접근이 몰린다. (중복 있음, YCSB와 같은 theta = 0.99)
+ *  - Clustered:  연속된 키 묶음(ClusterSize개) 단위로 무작위 순서, 묶음 안에서는 오름차순
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/Container/Vector.h>
+
+#include <cmath>
+
+NS_JC_BEGIN
+
+enum class KeyDistribution
+{
+	Sequential,
+	Reverse,
+	Uniform,
+	Zipfian,
+	Clustered,
+	Max
+};
+
+inline const char* KeyDistributionName(KeyDistribution distribution) {
+	switch (distribution) {
+	case KeyDistribution::Sequential:	return "Sequential";
+	case KeyDistribution::Reverse:		return "Reverse";
+	case KeyDistribution::Uniform:		return "Uniform";
+	case KeyDistribution::Zipfian:		return "Zipfian";
+	case KeyDistribution::Clustered:	return "Clustered";
+	default:							return "Unknown";
+	}
+}
+
+// Gray et al. "Quickly Generating Billion-Record Synthetic Databases"의 방식
+// 생성자에서 zeta(n)을 한번 계산하고 이후 샘플 하나당 O(1)
+class ZipfianGenerator
+{
+public:
+	ZipfianGenerator(int itemCount, double theta = 0.99)
+		: m_iItemCount(itemCount)
+		, m_fTheta(theta)
+		, m_fAlpha(1.0 / (1.0 - theta))
+		, m_fZetaN(Zeta(itemCount, theta))
+	{
+		const double fZeta2 = Zeta(2, theta);
+		m_fEta = (1.0 - std::pow(2.0 / itemCount, 1.0 - theta)) / (1.0 - fZeta2 / m_fZetaN);
+	}
+
+	// 0이 가장 자주 나오는 순위
+	int NextRank() const {
+		const double fU = Random::GenerateDouble(0.0, 1.0);
+		const double fUz = fU * m_fZetaN;
+
+		if (fUz < 1.0) return 0;
+		if (fUz < 1.0 + std::pow(0.5, m_fTheta)) return 1;
+
+		const int iRank = int(m_iItemCount * std::pow(m_fEta * fU - m_fEta + 1.0, m_fAlpha));
+		return iRank < m_iItemCount ? iRank : m_iItemCount - 1;
+	}
+private:
+	static double Zeta(int n, double theta) {
+		double fSum = 0.0;
+		for (int i = 1; i <= n; ++i) {
+			fSum += 1.0 / std::pow(double(i), theta);
+		}
+		return fSum;
+	}
+
+	int m_iItemCount;
+	double m_fTheta;
+	double m_fAlpha;
+	double m_fZetaN;
+	double m_fEta;
+};
+
+namespace Detail {
+	inline void ShuffleKeys(Vector<int>& keys) {
+		for (int i = keys.Size() - 1; i > 0; --i) {
+			const int j = Random::GenerateInt(0, i + 1);
+			const int iTemp = keys[i];
+			keys[i] = keys[j];
+			keys[j] = iTemp;
+		}
+	}
+}
+
+inline void GenerateKeys(KeyDistribution distribution, int count, Vector<int>& keys) {
+	constexpr int ClusterSize = 256;
+
+	keys.Clear();
+
+	switch (distribution) {
+	case KeyDistribution::Sequential:
+		for (int i = 0; i < count; ++i) keys.PushBack(i);
+		break;
+	case KeyDistribution::Reverse:
+		for (int i = count - 1; i >= 0; --i) keys.PushBack(i);
+		break;
+	case KeyDistribution::Uniform:
+		for (int i = 0; i < count; ++i) keys.PushBack(i);
+		Detail::ShuffleKeys(keys);
+		break;
+	case KeyDistribution::Zipfian: {
+		// 인기 순위를 그대로 키로 쓰면 자주 쓰는 키가 작은 쪽에 몰리므로 곱셈 해시로 흩뿌린다.
+		// 2654435761은 소수이고 count보다 크므로 count와 서로소라서 [0, count)의 순열이 된다.
+		const ZipfianGenerator zipfian(count);
+		for (int i = 0; i < count; ++i) {
+			keys.PushBack(int(Int64U(zipfian.NextRank()) * 2654435761ULL % Int64U(count)));
+		}
+		break;
+	}
+	case KeyDistribution::Clustered: {
+		Vector<int> clusters((count + ClusterSize - 1) / ClusterSize);
+		for (int i = 0; i < count; i += ClusterSize) clusters.PushBack(i);
+		Detail::ShuffleKeys(clusters);
+
+		for (int i = 0; i < clusters.Size(); ++i) {
+			const int iEnd = Math::Min(clusters[i] + ClusterSize, count);
+			for (int iKey = clusters[i]; iKey < iEnd; ++iKey) {
+				keys.PushBack(iKey);
+			}
+		}
+		break;
+	}
+	default:
+		DebugAssertMsg(false, "올바르지 않은 키 분포입니다.");
+	}
+}
+
+NS_JC_END
@@ -0,0 +1,311 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 멀티쓰레드 메모리 할당 벤치마크
+ * 여러 쓰레드가 같은 할당자에서 동시에 할당/해제할 때의 처리량을 비교한다.
+ *
+ *  memory_pool_benchmark [쓰레드당 연산 수 (기본 1,000,000)]
+ *
+ * 쓰레드마다 LiveBlockCount개의 칸을 두고 연산마다 무작위 칸 하나의 블록을 해제한 후 8 ~ 512바이트 블록을 새로 할당한다.
+ * (살아있는 블록 수가 일정하게 유지되는 요청 처리 서버의 작업 패턴)
+ *
+ *  - malloc: 시스템 할당자
+ *  - BinarySearch, Indexed: 쓰레드 캐시 없는 메모리풀 (Push/Pop마다 MemoryChunckQueue에 CAS)
+ *  - ...+ThreadCache: 쓰레드 캐시(MemoryPoolThreadCache)를 켠 메모리풀
+ *
+ * 출력은 CSV이다. mops는 초당 백만 연산(할당 + 해제 1쌍)이다.
+ *
+ * 이어서 빈 줄 다음에 콜드 스타트 표를 출력한다.
+ * 새로 만든 MemoryChunckQueue에서 ColdChunkCount개의 64바이트 청크를 연달아 꺼내고(alloc_ns) 꺼낸 순서대로 전부 써본다(touch_ns).
+ *  - Legacy: 청크를 하나씩 Memory::Allocate로 할당 (슬랩 없음)
+ *  - Slab: 기본 정책 (64KB부터 2배씩 2MB까지)
+ *  - Slab2M: 처음부터 2MB 슬랩 (큰 페이지를 쓸 수 있으면 쓴다)
+ * system_allocs는 시스템 할당 횟수, released_bytes는 전부 반납한 후 ReleaseEmptySlabs가 돌려준 바이트 수이다. (Legacy는 해제한 청크 바이트 수)
+ *
+ * 마지막으로 1 ~ max_size 사이의 무작위 요청을 예전 2의 거듭제곱 블록과 지금 사이즈 클래스로 나눴을 때를 비교한다.
+ *  - waste: 내부 단편화 (받은 블록 바이트 중 요청하지 않은 바이트의 비율)
+ *  - lookup_ns: 크기 -> 블록 인덱스 변환 1회 시간 (예전: 블록 크기 표 이진 탐색, 지금: AllocationLengthMapConverter::ToIndex)
+ *
+ * 끝으로 요청 하나를 처리하며 임시 컨테이너(Vector + HashMap + TreeSet)를 만들고 버리는 작업을
+ * DefaultAllocator와 ArenaAllocator(요청마다 Reset)로 비교한다.
+ *  - arena_kb: 아레나가 받아둔 블록 크기
+ *  - checksum: 두 할당자로 만든 컨테이너의 크기 합이 같으면 O
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Threading/Thread.h>
+#include <JCore/Pool/BinarySearchMemoryPool.h>
+#include <JCore/Pool/IndexedMemoryPool.h>
+#include <JCore/Allocator/ArenaAllocator.h>
+#include <JCore/Container/HashMap.h>
+
+#include <cstdlib>
+
+#include "Tree/TreeSet.h"
+#include "Benchmark/BenchmarkTimer.h"
+
+USING_NS_JC;
+
+constexpr int DefaultOpsPerThread = 1'000'000;
+constexpr int MaxThreadCount = 64;
+constexpr int LiveBlockCount = 256;
+constexpr int MinBlockSize = 8;
+constexpr int MaxBlockSize = 512;
+constexpr int ColdChunkSize = 64;
+constexpr int ColdChunkCount = 1'000'000;
+constexpr int SizeClassSampleCount = 1'000'000;
+
+// 사이즈 클래스를 바꾸기 전의 블록 크기 표
+constexpr int PowerOfTwoBlockSizes[] {
+	1 << 0,  1 << 1,  1 << 2,  1 << 3,  1 << 4,
+	1 << 5,  1 << 6,  1 << 7,  1 << 8,  1 << 9,
+	1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14,
+	1 << 15, 1 << 16, 1 << 17, 1 << 18, 1 << 19,
+	1 << 20, 1 << 21, 1 << 22, 1 << 23, 1 << 24
+};
+
+struct MallocAllocator
+{
+	void* Allocate(int size) { return malloc(size); }
+	void Deallocate(void* memory, int) { free(memory); }
+};
+
+struct PoolAllocator
+{
+	void* Allocate(int size) {
+		int iRealAllocatedSize;
+		return Pool->DynamicPop(size, iRealAllocatedSize);
+	}
+
+	// 요청한 크기로 반납한다. (받은 크기로 반납해도 같은 블록으로 간다)
+	void Deallocate(void* memory, int size) { Pool->DynamicPush(memory, size); }
+
+	MemoryPoolAbstract* Pool;
+};
+
+template <typename TAllocator>
+double MeasureThroughput(TAllocator& allocator, int threadCount, int opsPerThread) {
+	Thread threads[MaxThreadCount];
+	NanoStopWatch watch;
+
+	watch.Start();
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Start([&allocator, opsPerThread, i](void*) {
+			void* pBlocks[LiveBlockCount]{};
+			int iSizes[LiveBlockCount]{};
+			Int32U uiSeed = 2463534242u + i * 7919u;
+
+			for (int j = 0; j < opsPerThread; ++j) {
+				uiSeed ^= uiSeed << 13;
+				uiSeed ^= uiSeed >> 17;
+				uiSeed ^= uiSeed << 5;
+				const int iSlot = int(uiSeed % LiveBlockCount);
+				const int iSize = MinBlockSize + int((uiSeed >> 8) % (MaxBlockSize - MinBlockSize + 1));
+
+				if (pBlocks[iSlot] != nullptr) {
+					allocator.Deallocate(pBlocks[iSlot], iSizes[iSlot]);
+				}
+
+				pBlocks[iSlot] = allocator.Allocate(iSize);
+				iSizes[iSlot] = iSize;
+				*static_cast<char*>(pBlocks[iSlot]) = char(j);
+			}
+
+			for (int j = 0; j < LiveBlockCount; ++j) {
+				if (pBlocks[j] != nullptr) {
+					allocator.Deallocate(pBlocks[j], iSizes[j]);
+				}
+			}
+		});
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].Join();
+	}
+
+	return double(threadCount) * opsPerThread / watch.ElapsedNanoSeconds() * 1000.0;
+}
+
+template <typename TPool>
+double MeasurePool(int threadCount, int opsPerThread, bool threadCache) {
+	TPool pool(false);
+	pool.SetThreadCache(threadCache);
+	PoolAllocator allocator{ &pool };
+	return MeasureThroughput(allocator, threadCount, opsPerThread);
+}
+
+void MeasureColdStart(const char* name, const MemorySlabPolicy& policy) {
+	MemoryChunckQueue queue(ColdChunkSize, 0, policy);
+	void** pChunks = dbg_new void*[ColdChunkCount];
+	int iSystemAllocCount = 0;
+	NanoStopWatch watch;
+
+	watch.Start();
+	for (int i = 0; i < ColdChunkCount; ++i) {
+		bool bNewAlloc;
+		pChunks[i] = queue.Pop(bNewAlloc);
+		iSystemAllocCount += bNewAlloc;
+	}
+	const double fAllocNs = watch.ElapsedNanoSeconds() / ColdChunkCount;
+
+	watch.Start();
+	for (int i = 0; i < ColdChunkCount; ++i) {
+		Int64* pWords = static_cast<Int64*>(pChunks[i]);
+		for (int j = 0; j < ColdChunkSize / int(sizeof(Int64)); ++j) {
+			pWords[j] += i + j;
+		}
+	}
+	const double fTouchNs = watch.ElapsedNanoSeconds() / ColdChunkCount;
+	const int iSlabCount = queue.SlabCount();
+
+	for (int i = 0; i < ColdChunkCount; ++i) {
+		queue.Push(pChunks[i]);
+	}
+
+	const Int64U uiReleasedBytes = queue.ReleaseEmptySlabs();
+	Console::WriteLine("%s,%d,%.2f,%.2f,%d,%d,%llu", name, ColdChunkCount, fAllocNs, fTouchNs, iSystemAllocCount, iSlabCount, uiReleasedBytes);
+	delete[] pChunks;
+}
+
+void MeasureSizeClass(int maxSize) {
+	int* pSizes = dbg_new int[SizeClassSampleCount];
+	Int32U uiSeed = 2463534242u;
+	Int64U uiRequested = 0;
+	Int64U uiPowerOfTwoBytes = 0;
+	Int64U uiClassBytes = 0;
+
+	for (int i = 0; i < SizeClassSampleCount; ++i) {
+		uiSeed ^= uiSeed << 13;
+		uiSeed ^= uiSeed >> 17;
+		uiSeed ^= uiSeed << 5;
+		pSizes[i] = 1 + int(uiSeed % Int32U(maxSize));
+		uiRequested += pSizes[i];
+	}
+
+	NanoStopWatch watch;
+	watch.Start();
+	for (int i = 0; i < SizeClassSampleCount; ++i) {
+		uiPowerOfTwoBytes += PowerOfTwoBlockSizes[Arrays::LowerBound(PowerOfTwoBlockSizes, pSizes[i])];
+	}
+	const double fPowerOfTwoNs = watch.ElapsedNanoSeconds() / SizeClassSampleCount;
+
+	watch.Start();
+	for (int i = 0; i < SizeClassSampleCount; ++i) {
+		uiClassBytes += Detail::MemoryBlockSizeMap_v[Detail::AllocationLengthMapConverter::ToIndex(pSizes[i])];
+	}
+	const double fClassNs = watch.ElapsedNanoSeconds() / SizeClassSampleCount;
+
+	Console::WriteLine("%d,%.4f,%.4f,%.2f,%.2f",
+		maxSize,
+		double(uiPowerOfTwoBytes - uiRequested) / double(uiPowerOfTwoBytes),
+		double(uiClassBytes - uiRequested) / double(uiClassBytes),
+		fPowerOfTwoNs,
+		fClassNs
+	);
+	delete[] pSizes;
+}
+
+// 요청 하나를 처리하며 임시 컨테이너를 만들고 버리는 상황을 흉내낸다.
+template <typename TAllocator>
+int RunScratchRequest(const Vector<int>& keys) {
+	Vector<int, TAllocator> vec;
+	HashMap<int, int, TAllocator> map;
+	TreeSet<int, RedBlackBalancer, NullTreeStatistics, TAllocator> set;
+
+	for (int i = 0; i < keys.Size(); ++i) {
+		vec.PushBack(keys[i]);
+		map.Insert(keys[i], i);
+		set.Insert(keys[i]);
+	}
+
+	return vec.Size() + map.Size() + set.Size();
+}
+
+void MeasureArenaScratch(int requestCount, int elementCount) {
+	Vector<int> keys(elementCount);
+	Int32U uiSeed = 2463534242u;
+	for (int i = 0; i < elementCount; ++i) {
+		uiSeed ^= uiSeed << 13;
+		uiSeed ^= uiSeed >> 17;
+		uiSeed ^= uiSeed << 5;
+		keys.PushBack(int(uiSeed % Int32U(elementCount * 4)));
+	}
+
+	NanoStopWatch watch;
+	Int64 iDefaultChecksum = 0;
+	watch.Start();
+	for (int i = 0; i < requestCount; ++i) {
+		iDefaultChecksum += RunScratchRequest<DefaultAllocator>(keys);
+	}
+	const double fDefaultMs = watch.ElapsedNanoSeconds() / 1'000'000.0;
+
+	Arena arena;
+	Int64 iArenaChecksum = 0;
+	watch.Start();
+	for (int i = 0; i < requestCount; ++i) {
+		{
+			ArenaScope scope(arena);
+			iArenaChecksum += RunScratchRequest<ArenaAllocator>(keys);
+		}
+		arena.Reset();
+	}
+	const double fArenaMs = watch.ElapsedNanoSeconds() / 1'000'000.0;
+
+	Console::WriteLine("%d,%d,%.2f,%.2f,%.2f,%llu,%s",
+		requestCount,
+		elementCount,
+		fDefaultMs,
+		fArenaMs,
+		fDefaultMs / fArenaMs,
+		arena.ReservedBytes() / 1024,
+		iDefaultChecksum == iArenaChecksum ? "O" : "X"
+	);
+}
+
+int main(int argc, char** argv) {
+	const int iOpsPerThread = argc > 1 ? atoi(argv[1]) : DefaultOpsPerThread;
+
+	Console::WriteLine("allocator,threads,ops_per_thread,mops");
+	for (int iThreadCount = 1; iThreadCount <= MaxThreadCount; iThreadCount *= 2) {
+		MallocAllocator mallocAllocator;
+		const double fResults[] = {
+			MeasureThroughput(mallocAllocator, iThreadCount, iOpsPerThread),
+			MeasurePool<BinarySearchMemoryPool>(iThreadCount, iOpsPerThread, false),
+			MeasurePool<BinarySearchMemoryPool>(iThreadCount, iOpsPerThread, true),
+			MeasurePool<IndexedMemoryPool>(iThreadCount, iOpsPerThread, false),
+			MeasurePool<IndexedMemoryPool>(iThreadCount, iOpsPerThread, true)
+		};
+		const char* szNames[] = { "malloc", "BinarySearch", "BinarySearch+ThreadCache", "Indexed", "Indexed+ThreadCache" };
+
+		for (int i = 0; i < int(sizeof(szNames) / sizeof(szNames[0])); ++i) {
+			Console::WriteLine("%s,%d,%d,%.2f", szNames[i], iThreadCount, iOpsPerThread, fResults[i]);
+		}
+	}
+
+	MemorySlabPolicy legacyPolicy;
+	legacyPolicy.InitialSlabBytes = 0;
+
+	MemorySlabPolicy hugePolicy;
+	hugePolicy.InitialSlabBytes = MemorySlabPolicy::DefaultMaxSlabBytes;
+
+	Console::WriteLine("");
+	Console::WriteLine("policy,chunks,alloc_ns,touch_ns,system_allocs,slabs,released_bytes");
+	MeasureColdStart("Legacy", legacyPolicy);
+	MeasureColdStart("Slab", MemorySlabPolicy{});
+	MeasureColdStart("Slab2M", hugePolicy);
+
+	Console::WriteLine("");
+	Console::WriteLine("max_size,pow2_waste,class_waste,pow2_lookup_ns,class_lookup_ns");
+	MeasureSizeClass(512);
+	MeasureSizeClass(4096);
+	MeasureSizeClass(65536);
+	MeasureSizeClass(1 << 20);
+
+	Console::WriteLine("");
+	Console::WriteLine("requests,elements_per_request,default_ms,arena_ms,speedup,arena_kb,checksum");
+	MeasureArenaScratch(20'000, 64);
+	MeasureArenaScratch(2'000, 1'024);
+	MeasureArenaScratch(100, 32'768);
+
+	return 0;
+}
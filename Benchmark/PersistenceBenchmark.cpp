@@ -0,0 +1,254 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리 저장/복구 비교
+ * 직렬화, 메모리 맵 인덱스, 선행 기록 로그(DurableTreeSet)의 기록/읽기 비용을 잰다.
+ * 작업 디렉터리에 임시 파일을 만들고 끝나면 지운다.
+ *
+ *  persistence_benchmark
+ *
+ *  - 직렬화: 파일에서 다시 읽을 때 하나씩 삽입하는 것과 Deserialize로 바로 트리를 만드는 것
+ *  - 메모리 맵 인덱스: 같은 데이터를 TreeSet과 MappedTreeIndex에서 탐색
+ *  - 선행 기록 로그: 그룹 커밋 크기별 연산당 기록 비용, 체크포인트 + 로그 꼬리 복구
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/Time.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/FileSystem/File.h>
+#include <JCore/FileSystem/FileStream.h>
+
+#include <cstdio>
+
+#include "Tree/TreeSet.h"
+#include "Tree/RadixTreeMap.h"
+#include "Tree/MappedTreeIndex.h"
+#include "Tree/DurableTreeSet.h"
+
+USING_NS_JC;
+
+// 파일에서 다시 읽을 때 하나씩 삽입하는 것과 정렬된 데이터로 바로 트리를 만드는 것(Deserialize)을 비교한다.
+template <typename TBalancer>
+void CompareDeserialize(const char* name, const char* path, int dataCount) {
+	TreeSet<int, TBalancer> source;
+	for (int i = 0; i < dataCount; ++i) {
+		source.Insert(Random::GenerateInt(0, dataCount * 4));
+	}
+
+	int iFileSize;
+	{
+		FileStream stream(path, eWrite, eCreate);
+		source.Serialize(stream);
+		iFileSize = stream.GetLength();
+	}
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	TreeSet<int, TBalancer> inserted;
+	bool bInserted;
+	watch.Start();
+	{
+		FileStream stream(path, eRead, eOpen);
+		TreeStreamReader reader(stream);
+		TreeSerializeCodec<int, true> codec;
+		Int64 iCount = 0;
+		bInserted = TreeSerializeHeader::Read(reader, codec.Encoding, TreeSerializeEncoding::None, iCount);
+		for (Int64 i = 0; bInserted && i < iCount; ++i) {
+			int iData;
+			bInserted = codec.Read(reader, iData);
+			if (bInserted) inserted.Insert(iData);
+		}
+	}
+	const TimeSpan insertElapsed = watch.StopReset();
+
+	TreeSet<int, TBalancer> loaded;
+	bool bLoaded;
+	{
+		FileStream stream(path, eRead, eOpen);
+		bLoaded = loaded.Deserialize(stream);
+	}
+	const TimeSpan loadElapsed = watch.StopReset();
+
+	Console::WriteLine("%-10s | 데이터 수: %d, 파일 크기: %d바이트 | 하나씩 삽입: %8.2fms, Deserialize: %8.2fms | 결과: %s, 최대 높이: %d (삽입 %d)",
+		name,
+		source.Size(),
+		iFileSize,
+		insertElapsed.GetTotalMiliSeconds(),
+		loadElapsed.GetTotalMiliSeconds(),
+		bInserted && bLoaded && inserted.Size() == source.Size() && loaded.Size() == source.Size() ? TreeValidateErrorName(loaded.Validate()) : "실패",
+		loaded.GetMaxHeight(),
+		inserted.GetMaxHeight()
+	);
+}
+
+void CompareSerialize(int dataCount) {
+	const char* szPath = "treeset_serialize.bin";
+
+	CompareDeserialize<RedBlackBalancer>("RedBlack", szPath, dataCount);
+	CompareDeserialize<AvlBalancer>("AVL", szPath, dataCount);
+	CompareDeserialize<WavlBalancer>("WAVL", szPath, dataCount);
+
+	RadixTreeMap<String, int> source;
+	for (int i = 0; i < 10'000; ++i) {
+		source.Insert(StringUtil::Format("user/%d/session", i), i);
+	}
+
+	{
+		FileStream stream(szPath, eWrite, eCreate);
+		source.Serialize(stream);
+	}
+
+	RadixTreeMap<String, int> loaded;
+	{
+		FileStream stream(szPath, eRead, eOpen);
+		loaded.Deserialize(stream);
+	}
+
+	int* pValue = loaded.Find("user/1234/session");
+	Console::WriteLine("RadixTreeMap<String, int> | 데이터 수: %d -> %d, \"user/1234/session\": %d", source.Size(), loaded.Size(), pValue ? *pValue : -1);
+	std::remove(szPath);
+}
+
+// 같은 데이터를 TreeSet과 메모리 맵 인덱스(Eytzinger 배치)에서 탐색해서 비교한다.
+void CompareMappedIndex(int dataCount) {
+	const char* szPath = "treeset_index.bin";
+	TreeSet<int> set;
+	Vector<int> lookupKeys(dataCount);
+
+	for (int i = 0; i < dataCount; ++i) {
+		set.Insert(Random::GenerateInt(0, dataCount * 4));
+		lookupKeys.PushBack(Random::GenerateInt(0, dataCount * 4));
+	}
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	MappedTreeIndex<int>::Write(set, szPath);
+	const TimeSpan writeElapsed = watch.StopReset();
+
+	{
+		MappedTreeIndex<int> index(szPath);
+		const TimeSpan openElapsed = watch.StopReset();
+
+		int iTreeFound = 0;
+		for (int i = 0; i < lookupKeys.Size(); ++i) {
+			iTreeFound += set.Search(lookupKeys[i]);
+		}
+		const TimeSpan treeElapsed = watch.StopReset();
+
+		int iIndexFound = 0;
+		for (int i = 0; i < lookupKeys.Size(); ++i) {
+			iIndexFound += index.Search(lookupKeys[i]);
+		}
+		const TimeSpan indexElapsed = watch.StopReset();
+
+		Console::WriteLine("데이터 수: %lld, 파일 크기: %lld바이트 | 기록: %.2fms, 열기: %.3fms, 체크섬: %s",
+			index.Size(),
+			index.FileBytes(),
+			writeElapsed.GetTotalMiliSeconds(),
+			openElapsed.GetTotalMiliSeconds(),
+			index.VerifyChecksum() ? "일치" : "불일치"
+		);
+		Console::WriteLine("탐색 %d회 (성공 %d) | TreeSet: %.2fms, 메모리 맵 인덱스: %.2fms | 결과 일치: %s",
+			lookupKeys.Size(),
+			iIndexFound,
+			treeElapsed.GetTotalMiliSeconds(),
+			indexElapsed.GetTotalMiliSeconds(),
+			iTreeFound == iIndexFound ? "O" : "X"
+		);
+	}
+
+	std::remove(szPath);
+}
+
+void DeleteDurableFiles(const char* path) {
+	File::Delete(StringUtil::Format("%s.checkpoint", path));
+	File::Delete(StringUtil::Format("%s.wal", path));
+}
+
+// 그룹 커밋 크기에 따른 연산당 기록 비용을 비교한다. (매 프레임마다 fsync)
+void CompareDurableCommit(const char* path, int groupCommitCount, int operationCount) {
+	DeleteDurableFiles(path);
+
+	DurableTreeSetOptions options;
+	options.GroupCommitCount = groupCommitCount;
+	DurableTreeSet<int> set(path, options);
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	for (int i = 0; i < operationCount; ++i) {
+		set.Insert(Random::GenerateInt(0, MaxInt32_v));
+	}
+	set.Commit();
+	const TimeSpan elapsed = watch.StopReset();
+
+	Console::WriteLine("그룹 커밋 %4d개 | 연산 %d회, 커밋 %lld회, 연산당 %.2fus",
+		groupCommitCount,
+		operationCount,
+		set.GetCommitCount(),
+		elapsed.GetTotalMiliSeconds() * 1000.0 / operationCount
+	);
+}
+
+// 체크포인트 + 로그 꼬리로 복구되는지, 쓰다 만 프레임은 버리는지 확인한다.
+void CompareDurableRecovery(const char* path, int dataCount) {
+	DeleteDurableFiles(path);
+
+	DurableTreeSetOptions options;
+	options.CheckpointLogBytes = 1024 * 1024;
+	int iExpectedSize;
+	Int64 iCheckpointCount;
+
+	{
+		DurableTreeSet<int> set(path, options);
+		for (int i = 0; i < dataCount; ++i) {
+			set.Insert(Random::GenerateInt(0, dataCount * 4));
+			if (i % 4 == 0) set.Remove(Random::GenerateInt(0, dataCount * 4));
+		}
+		iExpectedSize = set.Size();
+		iCheckpointCount = set.GetCheckpointCount();
+	}
+
+	// 마지막 프레임을 쓰다가 죽은 상황을 흉내낸다.
+	{
+		FileStream log(StringUtil::Format("%s.wal", path), eWrite, eAppend);
+		const Byte garbage[] = { 0x40, 0x00, 0x00, 0x00, 0x01 };
+		log.Write(garbage, 0, sizeof(garbage));
+	}
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	DurableTreeSet<int> recovered(path, options);
+	const TimeSpan elapsed = watch.StopReset();
+
+	Console::WriteLine("체크포인트 %lld회 | 복구: %.2fms, 크기: %d (기대 %d), 검증: %s",
+		iCheckpointCount,
+		elapsed.GetTotalMiliSeconds(),
+		recovered.Size(),
+		iExpectedSize,
+		TreeValidateErrorName(recovered.GetSet().Validate())
+	);
+}
+
+int main() {
+	{
+		Console::WriteLine("직렬화 후 다시 읽기 비교");
+		CompareSerialize(1'000'000);
+	}
+
+	{
+		Console::WriteLine("메모리 맵 인덱스 탐색 비교");
+		CompareMappedIndex(1'000'000);
+	}
+
+	{
+		Console::WriteLine("선행 기록 로그 트리셋");
+		const char* szPath = "durable_set";
+		CompareDurableCommit(szPath, 1, 2'000);
+		CompareDurableCommit(szPath, 16, 20'000);
+		CompareDurableCommit(szPath, 256, 200'000);
+		CompareDurableRecovery(szPath, 500'000);
+		DeleteDurableFiles(szPath);
+	}
+
+	return 0;
+}
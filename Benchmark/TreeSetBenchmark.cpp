@@ -0,0 +1,142 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * TreeSet 성능 측정
+ * 키 분포(KeyDistribution.h)와 데이터 수별로 Insert/Search/Remove/Clear의 처리량과 지연시간을 잰다.
+ *
+ *  treeset_benchmark [최대 데이터 수 (기본 10,000,000)]
+ *
+ * 데이터 수는 1,000부터 10배씩 최대 데이터 수까지 늘린다. (100,000,000개는 노드만 약 4GB)
+ * 연산 1회 지연시간은 단계마다 최대 LatencySampleCount개만 골라서 따로 잰다.
+ * (모든 연산을 재면 타이머 호출 비용이 연산 비용과 비슷해져서 처리량이 왜곡된다)
+ * 회전/op는 CountingTreeStatistics로 센다. (이중 회전은 2회, 카운터 갱신 비용이 측정값에 포함된다)
+ */
+
+#include <JCore/Core.h>
+
+#include <cstdlib>
+
+#include "Tree/TreeSet.h"
+#include "Benchmark/KeyDistribution.h"
+#include "Benchmark/BenchmarkTimer.h"
+
+USING_NS_JC;
+
+constexpr int LatencySampleCount = 10'000;
+constexpr int DefaultMaxDataCount = 10'000'000;
+
+using TBenchmarkSet = TreeSet<int, RedBlackBalancer, CountingTreeStatistics>;
+
+struct PhaseResult
+{
+	const char* Name;
+	Int64 OperationCount;
+	double TotalNanoSeconds;
+	Int64 RotationCount;
+	LatencySamples Latency;
+};
+
+void PrintHeader() {
+	Console::WriteLine("%-10s %11s %-6s %12s %9s %9s %9s %9s %9s %9s %10s",
+		"분포", "데이터 수", "연산", "ops/s", "ns/op", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)", "회전/op", "최대 메모리(MB)");
+}
+
+void PrintPhase(KeyDistribution distribution, int dataCount, PhaseResult& result, Int64 peakBytes) {
+	const double fNanoPerOp = result.TotalNanoSeconds / double(result.OperationCount);
+	Console::WriteLine("%-10s %11d %-6s %12.0f %9.1f %9.0f %9.0f %9.0f %9.0f %9.3f %10.1f",
+		KeyDistributionName(distribution),
+		dataCount,
+		result.Name,
+		1'000'000'000.0 / fNanoPerOp,
+		fNanoPerOp,
+		result.Latency.Percentile(50),
+		result.Latency.Percentile(99),
+		result.Latency.Percentile(99.9),
+		result.Latency.Percentile(100),
+		double(result.RotationCount) / double(result.OperationCount),
+		double(peakBytes) / (1024.0 * 1024.0)
+	);
+}
+
+// keys 순서대로 operation을 수행한다.
+template <typename Operation>
+void RunPhase(TBenchmarkSet& set, const Vector<int>& keys, PhaseResult& result, Operation&& operation) {
+	const int iSampleInterval = Math::Max(1, keys.Size() / LatencySampleCount);
+	NanoStopWatch totalWatch;
+	NanoStopWatch opWatch;
+
+	set.ResetStatistics();
+	result.Latency.Clear();
+	totalWatch.Start();
+
+	for (int i = 0; i < keys.Size(); ++i) {
+		if (i % iSampleInterval != 0) {
+			operation(keys[i]);
+			continue;
+		}
+
+		opWatch.Start();
+		operation(keys[i]);
+		result.Latency.Add(opWatch.ElapsedNanoSeconds());
+	}
+
+	result.TotalNanoSeconds = totalWatch.ElapsedNanoSeconds();
+	result.OperationCount = keys.Size();
+	result.RotationCount = set.GetStatistics().GetSingleRotationCount();
+}
+
+void RunBenchmark(KeyDistribution distribution, int dataCount) {
+	// 삽입, 탐색, 삭제 순서를 각각 따로 만들어서 같은 순서를 반복하는 효과를 없앤다.
+	Vector<int> insertKeys(dataCount);
+	Vector<int> searchKeys(dataCount);
+	Vector<int> removeKeys(dataCount);
+	GenerateKeys(distribution, dataCount, insertKeys);
+	GenerateKeys(distribution, dataCount, searchKeys);
+	GenerateKeys(distribution, dataCount, removeKeys);
+
+	TBenchmarkSet set;
+	PhaseResult result{};
+	Int64 iPeakBytes = 0;
+
+	result.Name = "Insert";
+	RunPhase(set, insertKeys, result, [&set](int key) { set.Insert(key); });
+	iPeakBytes = set.GetMemoryUsage().TotalBytes();
+	PrintPhase(distribution, dataCount, result, iPeakBytes);
+
+	result.Name = "Search";
+	RunPhase(set, searchKeys, result, [&set](int key) { set.Search(key); });
+	PrintPhase(distribution, dataCount, result, iPeakBytes);
+
+	result.Name = "Remove";
+	RunPhase(set, removeKeys, result, [&set](int key) { set.Remove(key); });
+	PrintPhase(distribution, dataCount, result, iPeakBytes);
+
+	// Clear는 한번에 전체를 지우므로 노드 1개당 비용으로 환산한다.
+	for (int i = 0; i < insertKeys.Size(); ++i) {
+		set.Insert(insertKeys[i]);
+	}
+
+	NanoStopWatch clearWatch;
+	const int iClearCount = set.Size();
+	result.Name = "Clear";
+	result.Latency.Clear();
+	clearWatch.Start();
+	set.Clear();
+	result.TotalNanoSeconds = clearWatch.ElapsedNanoSeconds();
+	result.OperationCount = Math::Max(iClearCount, 1);
+	result.RotationCount = 0;
+	PrintPhase(distribution, dataCount, result, iPeakBytes);
+}
+
+int main(int argc, char** argv) {
+	const int iMaxDataCount = argc > 1 ? atoi(argv[1]) : DefaultMaxDataCount;
+
+	PrintHeader();
+	for (Int64 iDataCount = 1'000; iDataCount <= iMaxDataCount; iDataCount *= 10) {
+		for (int i = 0; i < int(KeyDistribution::Max); ++i) {
+			RunBenchmark(KeyDistribution(i), int(iDataCount));
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,310 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리 변형 비교
+ * TreeSet의 균형 정책, 그리고 TreeSet과 다른 정렬 구조(트립, 기수 트리, 비트맵 셋)를 같은 작업으로 비교한다.
+ *
+ *  tree_variant_benchmark
+ *
+ *  - 균형 정책: RedBlack/AVL/WAVL의 평균 깊이, 최대 높이, 연산당 회전 수
+ *  - 레드블랙트리 통계: CountingTreeStatistics로 모은 회전/색상 변경/케이스별 횟수
+ *  - 트립 일괄 병합: 큰 셋에 변경분을 하나씩 삽입할 때와 TreapSet::Union으로 합칠 때
+ *  - 기수 트리: Int32/String 키 탐색
+ *  - 비트맵 셋: 삽입/후속자/삭제
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/Time.h>
+#include <JCore/Primitives/StringUtil.h>
+
+#include "Tree/TreeSet.h"
+#include "Tree/TreapSet.h"
+#include "Tree/RadixTreeMap.h"
+#include "Tree/BitmapSet.h"
+
+USING_NS_JC;
+
+template <typename TBalancer>
+void CompareBalancer(const char* name, const Vector<int>& keys) {
+	TreeSet<int, TBalancer, CountingTreeStatistics> set;
+
+	for (int i = 0; i < keys.Size(); ++i) {
+		set.Insert(keys[i]);
+	}
+
+	const Int64 iInsertRotationCount = set.GetStatistics().GetSingleRotationCount();
+	const double fInsertAverageDepth = set.GetAverageDepth();
+	const int iInsertMaxHeight = set.GetMaxHeight();
+
+	// 절반을 삭제한 후의 모양도 확인 (WAVL은 삭제가 섞여야 AVL과 차이가 난다.)
+	set.ResetStatistics();
+	for (int i = 0; i < keys.Size(); i += 2) {
+		set.Remove(keys[i]);
+	}
+
+	const Int64 iRemoveRotationCount = set.GetStatistics().GetSingleRotationCount();
+	const int iRemoveCount = (keys.Size() + 1) / 2;
+
+	Console::WriteLine("%-10s | 삽입 후 평균 깊이: %6.2f, 최대 높이: %3d, 삽입당 회전: %.3f | 삭제 후 평균 깊이: %6.2f, 삭제당 회전: %.3f",
+		name,
+		fInsertAverageDepth,
+		iInsertMaxHeight,
+		double(iInsertRotationCount) / keys.Size(),
+		set.GetAverageDepth(),
+		double(iRemoveRotationCount) / iRemoveCount
+	);
+}
+
+void CompareBalancers(const char* title, const Vector<int>& keys) {
+	Console::WriteLine("[%s] 데이터 %d개", title, keys.Size());
+	CompareBalancer<RedBlackBalancer>("RedBlack", keys);
+	CompareBalancer<AvlBalancer>("AVL", keys);
+	CompareBalancer<WavlBalancer>("WAVL", keys);
+}
+
+// 삽입 후 절반을 탐색/삭제하고 레드블랙트리 통계를 출력한다.
+void PrintTreeStatistics(const char* title, const Vector<int>& keys) {
+	TreeSet<int, RedBlackBalancer, CountingTreeStatistics> set;
+
+	for (int i = 0; i < keys.Size(); ++i) set.Insert(keys[i]);
+	for (int i = 0; i < keys.Size(); i += 2) set.Search(keys[i]);
+	for (int i = 0; i < keys.Size(); i += 2) set.Remove(keys[i]);
+
+	const TreeStatistics stats = set.GetStatistics();
+	Console::WriteLine("[%s] 회전 LL: %lld, RR: %lld, LR: %lld, RL: %lld | 색상 변경: %lld | 할당: %lld, 해제: %lld",
+		title,
+		stats.GetRotationCount(TreeNodeRotateMode::LL),
+		stats.GetRotationCount(TreeNodeRotateMode::RR),
+		stats.GetRotationCount(TreeNodeRotateMode::LR),
+		stats.GetRotationCount(TreeNodeRotateMode::RL),
+		stats.RecolorCount,
+		stats.AllocationCount,
+		stats.DeallocationCount
+	);
+	Console::WriteLine("  삽입 케이스 1-1: %lld, 1-2: %lld, 1-3: %lld, 1-4: %lld, 2: %lld",
+		stats.GetInsertCaseCount(RedBlackInsertCase::Case1_1),
+		stats.GetInsertCaseCount(RedBlackInsertCase::Case1_2),
+		stats.GetInsertCaseCount(RedBlackInsertCase::Case1_3),
+		stats.GetInsertCaseCount(RedBlackInsertCase::Case1_4),
+		stats.GetInsertCaseCount(RedBlackInsertCase::Case2)
+	);
+	Console::WriteLine("  삭제 케이스 자식1개: %lld, 부모Red 1/2/3: %lld/%lld/%lld, 부모Black 1/2/3/5: %lld/%lld/%lld/%lld",
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::SingleChild),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group1Case1),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group1Case2),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group1Case3),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group2Case1),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group2Case2),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group2Case3),
+		stats.GetRemoveCaseCount(RedBlackRemoveCase::Group2Case5)
+	);
+	Console::WriteLine("  탐색 깊이 평균: %.2f, 최대: %d (%lld회)",
+		stats.GetAverageSearchDepth(),
+		stats.SearchDepthMax,
+		stats.SearchCount
+	);
+}
+
+// 큰 셋에 작은 변경분을 합치는 작업을 개별 삽입과 트립 합집합으로 비교
+void CompareBulkMerge(int baseCount, int deltaCount, int parallelDepth) {
+	TreeSet<int> tree;
+	TreapSet<int> base;
+	TreapSet<int> delta;
+	Vector<int> deltaKeys(deltaCount);
+
+	for (int i = 0; i < baseCount; ++i) {
+		tree.Insert(i * 2);
+		base.Insert(i * 2);
+	}
+
+	for (int i = 0; i < deltaCount; ++i) {
+		const int iKey = Random::GenerateInt(0, baseCount * 2);
+		deltaKeys.PushBack(iKey);
+		delta.Insert(iKey);
+	}
+
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	for (int i = 0; i < deltaKeys.Size(); ++i) {
+		tree.Insert(deltaKeys[i]);
+	}
+	const TimeSpan insertElapsed = watch.StopReset();
+	base.Union(delta, parallelDepth);
+	const TimeSpan unionElapsed = watch.StopReset();
+
+	bool bMatched = tree.Size() == base.Size();
+
+	// 차집합, 필터 결과도 TreeSet과 일치하는지 확인
+	TreapSet<int> removed;
+	for (int i = 0; i < deltaKeys.Size(); ++i) {
+		removed.Insert(deltaKeys[i]);
+		tree.Remove(deltaKeys[i]);
+	}
+	base.Difference(removed, parallelDepth);
+	bMatched &= tree.Size() == base.Size();
+
+	base.Filter([](int data) { return data % 4 == 0; }, parallelDepth);
+	tree.ForEach([&base, &bMatched](int data) {
+		bMatched &= base.Search(data) == (data % 4 == 0);
+	});
+
+	Console::WriteLine("[기존 %d개 + 변경 %d개] TreeSet 개별 삽입: %.2fms, TreapSet 합집합(병렬 깊이 %d): %.2fms | 결과 일치: %s",
+		baseCount, deltaCount,
+		insertElapsed.GetTotalMiliSeconds(),
+		parallelDepth,
+		unionElapsed.GetTotalMiliSeconds(),
+		bMatched ? "O" : "X"
+	);
+}
+
+// 같은 키로 TreeSet과 기수 트리의 탐색 속도를 비교
+template <typename TKey>
+void CompareRadixLookup(const char* title, const Vector<TKey>& keys) {
+	TreeSet<TKey> tree;
+	RadixTreeMap<TKey, int> radix;
+
+	for (int i = 0; i < keys.Size(); ++i) {
+		tree.Insert(keys[i]);
+		radix.Insert(keys[i], i);
+	}
+
+	int iTreeFound = 0;
+	int iRadixFound = 0;
+	StopWatch<StopWatchMode::HighResolution> watch;
+	watch.Start();
+	for (int i = 0; i < keys.Size(); ++i) {
+		iTreeFound += tree.Search(keys[i]);
+	}
+	const TimeSpan treeElapsed = watch.StopReset();
+	for (int i = 0; i < keys.Size(); ++i) {
+		iRadixFound += radix.Search(keys[i]);
+	}
+	const TimeSpan radixElapsed = watch.StopReset();
+
+	Console::WriteLine("[%s] 데이터 %d개 탐색 TreeSet: %.2fms, RadixTreeMap: %.2fms | 결과 일치: %s",
+		title, tree.Size(),
+		treeElapsed.GetTotalMiliSeconds(),
+		radixElapsed.GetTotalMiliSeconds(),
+		iTreeFound == iRadixFound && tree.Size() == radix.Size() ? "O" : "X"
+	);
+}
+
+// 타이머 아이디처럼 삽입/삭제와 후속자 질의가 섞이는 경우 TreeSet과 비트맵 셋 비교
+void CompareSuccessor(int dataCount, int range) {
+	Vector<int> keys(dataCount);
+	for (int i = 0; i < dataCount; ++i) {
+		keys.PushBack(Random::GenerateInt(0, range));
+	}
+
+	TreeSet<int> tree;
+	BitmapSet bitmap;
+	StopWatch<StopWatchMode::HighResolution> watch;
+
+	watch.Start();
+	for (int i = 0; i < keys.Size(); ++i) tree.Insert(keys[i]);
+	const TimeSpan treeInsert = watch.StopReset();
+	for (int i = 0; i < keys.Size(); ++i) bitmap.Insert(keys[i]);
+	const TimeSpan bitmapInsert = watch.StopReset();
+
+	Int64 iTreeSum = 0;
+	Int64 iBitmapSum = 0;
+	for (int i = 0; i < keys.Size(); ++i) {
+		auto it = tree.UpperBound(keys[i]);
+		if (it.HasNext()) iTreeSum += it.Current();
+	}
+	const TimeSpan treeSuccessor = watch.StopReset();
+	for (int i = 0; i < keys.Size(); ++i) {
+		int iSuccessor;
+		if (bitmap.Successor(keys[i], iSuccessor)) iBitmapSum += iSuccessor;
+	}
+	const TimeSpan bitmapSuccessor = watch.StopReset();
+
+	for (int i = 0; i < keys.Size(); ++i) tree.Remove(keys[i]);
+	const TimeSpan treeRemove = watch.StopReset();
+	for (int i = 0; i < keys.Size(); ++i) bitmap.Remove(keys[i]);
+	const TimeSpan bitmapRemove = watch.StopReset();
+
+	Console::WriteLine("[데이터 %d개, 범위 %d] 삽입 %.2fms / %.2fms, 후속자 %.2fms / %.2fms, 삭제 %.2fms / %.2fms (TreeSet / BitmapSet) | 결과 일치: %s",
+		dataCount, range,
+		treeInsert.GetTotalMiliSeconds(), bitmapInsert.GetTotalMiliSeconds(),
+		treeSuccessor.GetTotalMiliSeconds(), bitmapSuccessor.GetTotalMiliSeconds(),
+		treeRemove.GetTotalMiliSeconds(), bitmapRemove.GetTotalMiliSeconds(),
+		iTreeSum == iBitmapSum && tree.IsEmpty() && bitmap.IsEmpty() ? "O" : "X"
+	);
+}
+
+int main() {
+	{
+		Console::WriteLine("균형 정책 비교");
+		constexpr int DataCount = 100'000;
+		Vector<int> keys(DataCount);
+		for (int i = 0; i < DataCount; ++i) {
+			keys.PushBack(i);
+		}
+		CompareBalancers("순차 삽입", keys);
+
+		for (int i = DataCount - 1; i > 0; --i) {
+			const int j = Random::GenerateInt(0, i + 1);
+			const int iTemp = keys[i];
+			keys[i] = keys[j];
+			keys[j] = iTemp;
+		}
+		CompareBalancers("무작위 삽입", keys);
+	}
+
+	{
+		Console::WriteLine("레드블랙트리 통계");
+		constexpr int DataCount = 100'000;
+		Vector<int> keys(DataCount);
+		for (int i = 0; i < DataCount; ++i) {
+			keys.PushBack(i);
+		}
+		PrintTreeStatistics("순차 삽입", keys);
+
+		for (int i = DataCount - 1; i > 0; --i) {
+			const int j = Random::GenerateInt(0, i + 1);
+			const int iTemp = keys[i];
+			keys[i] = keys[j];
+			keys[j] = iTemp;
+		}
+		PrintTreeStatistics("무작위 삽입", keys);
+	}
+
+	{
+		Console::WriteLine("트립 일괄 병합");
+		CompareBulkMerge(1'000'000, 10'000, 0);
+		CompareBulkMerge(1'000'000, 100'000, 0);
+		CompareBulkMerge(1'000'000, 100'000, 2);
+	}
+
+	{
+		Console::WriteLine("기수 트리 탐색 비교");
+		constexpr int DataCount = 1'000'000;
+		Vector<int> intKeys(DataCount);
+		Vector<String> stringKeys(DataCount);
+		for (int i = 0; i < DataCount; ++i) {
+			const int iKey = Random::GenerateInt(0, DataCount * 4);
+			intKeys.PushBack(iKey);
+			stringKeys.PushBack(StringUtil::Format("user/%d/session", iKey));
+		}
+		CompareRadixLookup("Int32", intKeys);
+		CompareRadixLookup("String", stringKeys);
+
+		RadixTreeMap<String, int> radix;
+		for (int i = 0; i < 1000; ++i) {
+			radix.Insert(stringKeys[i], i);
+		}
+		int iPrefixCount = 0;
+		radix.ForEachPrefix("user/1", [&iPrefixCount](Pair<String, int>&) { ++iPrefixCount; });
+		Console::WriteLine("\"user/1\" 접두사 데이터 수: %d", iPrefixCount);
+	}
+
+	{
+		Console::WriteLine("비트맵 셋 후속자 비교");
+		CompareSuccessor(1'000'000, 4'000'000);
+		CompareSuccessor(1'000'000, MaxInt32_v);
+	}
+
+	return 0;
+}
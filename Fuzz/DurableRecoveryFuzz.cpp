@@ -0,0 +1,299 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 내구성 트리셋 복구 검증
+ * 커밋할 때마다 로그 길이와 그 시점의 셋(std::set)을 기록해두고, 로그 파일을 망가뜨린 후 다시 열어서
+ * 복구된 셋이 망가진 위치 직전까지 커밋된 상태와 같은지 확인한다. PersistenceBenchmark는 정상 종료만 다루므로
+ * 쓰다가 죽은 경우의 복구 경로는 여기서 확인한다.
+ *
+ *  durable_recovery_fuzz [라운드당 연산 수 (기본 2,000)]
+ *
+ *  - 잘린 로그: 마지막 프레임의 모든 위치와 앞쪽 프레임 경계에서 로그를 자른다.
+ *  - 손상된 로그: 마지막 프레임과 중간 프레임의 바이트를 바꾸고, 로그 끝에 쓰레기 바이트를 붙인다.
+ *  - 이전 세대 로그: 체크포인트를 교체한 직후 로그를 새로 시작하기 전에 죽은 것처럼 이전 로그를 되돌려놓는다.
+ *
+ * 복구한 후 한번 더 열어서 복구 과정에서 새로 만든 체크포인트와 로그도 같은 상태로 열리는지 확인한다.
+ * 실패하면 1을 반환한다. 작업 파일은 현재 디렉토리에 만들고 끝나면 지운다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/FileSystem/File.h>
+#include <JCore/FileSystem/FileStream.h>
+
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include "Tree/DurableTreeSet.h"
+
+USING_NS_JC;
+
+constexpr int DefaultOperationCount = 2'000;
+constexpr int GroupCommitCount = 16;
+constexpr int KeyRanges[] = { 32, 1'024 };
+constexpr int EarlyCutCount = 64;			// 마지막 프레임 말고 앞쪽에서 잘라볼 위치 수
+constexpr Byte CorruptMask = 0x5A;
+
+const char* const TestPath = "durable_recovery_fuzz";
+
+// 커밋된 시점의 로그 길이와 셋
+struct CommitSnapshot
+{
+	int LogBytes;
+	std::set<int> Reference;
+};
+
+struct DurableFiles
+{
+	TreeBufferWriter Checkpoint;
+	TreeBufferWriter Log;
+};
+
+String CheckpointPath() { return StringUtil::Format("%s.checkpoint", TestPath); }
+String LogPath() { return StringUtil::Format("%s.wal", TestPath); }
+
+void DeleteFiles() {
+	File::Delete(CheckpointPath());
+	File::Delete(StringUtil::Format("%s.checkpoint.tmp", TestPath));
+	File::Delete(LogPath());
+}
+
+void ReadFileBytes(const String& path, TreeBufferWriter& bytes) {
+	FileStream stream(path, eRead, eOpen);
+	const int iLength = stream.GetLength();
+	bytes.Clear();
+	stream.Read(bytes.Grow(iLength), 0, iLength);
+}
+
+void WriteFileBytes(const String& path, const Byte* bytes, int length) {
+	FileStream stream(path, eWrite, eCreate);
+	stream.Write(bytes, 0, length);
+}
+
+bool EqualsReference(const DurableTreeSet<int>& set, const std::set<int>& reference) {
+	if (set.Size() != int(reference.size())) {
+		return false;
+	}
+
+	auto referenceIt = reference.begin();
+	bool bEqual = true;
+	set.ForEach([&](int data) {
+		if (bEqual && (referenceIt == reference.end() || *referenceIt != data)) {
+			bEqual = false;
+		}
+		++referenceIt;
+	});
+	return bEqual;
+}
+
+// 체크포인트와 log를 파일로 되돌려놓고 두번 열어서 두번 모두 reference와 같은지 확인한다.
+bool RecoversTo(const DurableFiles& files, const Byte* log, int logLength, const std::set<int>& reference) {
+	DeleteFiles();
+	WriteFileBytes(CheckpointPath(), files.Checkpoint.Source(), files.Checkpoint.Length());
+	WriteFileBytes(LogPath(), log, logLength);
+
+	for (int i = 0; i < 2; ++i) {
+		DurableTreeSet<int> set(TestPath);
+		if (!EqualsReference(set, reference)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// logLength 바이트까지 남았을 때 복구되어야 하는 상태 (그 안에 끝까지 들어있는 마지막 커밋)
+const CommitSnapshot& ExpectedSnapshot(const std::vector<CommitSnapshot>& snapshots, int logLength) {
+	int iIndex = 0;
+	while (iIndex + 1 < int(snapshots.size()) && snapshots[iIndex + 1].LogBytes <= logLength) {
+		++iIndex;
+	}
+	return snapshots[iIndex];
+}
+
+void PrintFailure(const char* reason, int keyRange, int position, int logLength) {
+	Console::WriteLine("[복구] 실패: %s (키 범위: %d, 위치: %d, 로그 크기: %d)", reason, keyRange, position, logLength);
+}
+
+// 무작위 연산 후 체크포인트를 한번 만들고(커밋되지 않은 연산 포함), 다시 무작위 연산을 하며 커밋마다 상태를 기록한다.
+void BuildFiles(int keyRange, int operationCount, DurableFiles& files, std::vector<CommitSnapshot>& snapshots) {
+	DurableTreeSetOptions options;
+	options.GroupCommitCount = GroupCommitCount;
+	options.SyncOnCommit = false;
+
+	DeleteFiles();
+	DurableTreeSet<int> set(TestPath, options);
+	std::set<int> reference;
+
+	auto apply = [&](int count) {
+		for (int i = 0; i < count; ++i) {
+			const int iKey = Random::GenerateInt(0, keyRange);
+			const Int64 iCommitCount = set.GetCommitCount();
+
+			if (Random::GenerateInt(0, 2) == 0) {
+				set.Insert(iKey);
+				reference.insert(iKey);
+			} else {
+				set.Remove(iKey);
+				reference.erase(iKey);
+			}
+
+			if (set.GetCommitCount() != iCommitCount) {
+				snapshots.push_back({ set.GetLogBytes(), reference });
+			}
+		}
+	};
+
+	apply(operationCount / 2);
+	Random::GenerateInt(0, 2) == 0 ? set.Insert(keyRange) : set.Remove(keyRange);	// 커밋되지 않은 연산을 남긴다.
+	set.Checkpoint();
+	reference.erase(keyRange);
+	if (set.Search(keyRange)) reference.insert(keyRange);
+
+	snapshots.clear();
+	snapshots.push_back({ set.GetLogBytes(), reference });
+	apply(operationCount - operationCount / 2);
+	set.Commit();
+	if (snapshots.back().LogBytes != set.GetLogBytes()) {
+		snapshots.push_back({ set.GetLogBytes(), reference });
+	}
+
+	ReadFileBytes(CheckpointPath(), files.Checkpoint);
+	ReadFileBytes(LogPath(), files.Log);
+}
+
+bool FuzzTruncatedLog(int keyRange, int operationCount) {
+	DurableFiles files;
+	std::vector<CommitSnapshot> snapshots;
+	BuildFiles(keyRange, operationCount, files, snapshots);
+
+	const int iLogLength = files.Log.Length();
+	const int iLastFrame = snapshots.size() > 1 ? snapshots[snapshots.size() - 2].LogBytes : 0;
+	int iCutCount = 0;
+
+	auto check = [&](int cut) {
+		++iCutCount;
+		if (!RecoversTo(files, files.Log.Source(), cut, ExpectedSnapshot(snapshots, cut).Reference)) {
+			PrintFailure("잘린 로그의 복구 결과가 마지막 커밋과 다릅니다.", keyRange, cut, iLogLength);
+			return false;
+		}
+		return true;
+	};
+
+	for (int iCut = iLastFrame; iCut <= iLogLength; ++iCut) {
+		if (!check(iCut)) return false;
+	}
+
+	for (int i = 0; i < EarlyCutCount; ++i) {
+		if (!check(Random::GenerateInt(0, iLastFrame + 1))) return false;
+	}
+
+	Console::WriteLine("[잘린 로그, 키 범위 %d] 통과 (커밋: %d, 로그 크기: %d, 자른 위치: %d)",
+		keyRange, int(snapshots.size()) - 1, iLogLength, iCutCount
+	);
+	return true;
+}
+
+bool FuzzCorruptedLog(int keyRange, int operationCount) {
+	DurableFiles files;
+	std::vector<CommitSnapshot> snapshots;
+	BuildFiles(keyRange, operationCount, files, snapshots);
+
+	const int iLogLength = files.Log.Length();
+	TreeBufferWriter log;
+	int iCorruptCount = 0;
+
+	// 프레임 하나(헤더 + 페이로드)의 모든 바이트를 하나씩 바꿔본다. 그 프레임 직전 커밋까지만 복구되어야 한다.
+	auto corruptFrame = [&](int frame) {
+		const int iBegin = snapshots[frame].LogBytes;
+		const int iEnd = snapshots[frame + 1].LogBytes;
+
+		for (int iPosition = iBegin; iPosition < iEnd; ++iPosition) {
+			log.Clear();
+			log.WriteBytes(files.Log.Source(), iLogLength);
+			log.Source()[iPosition] ^= CorruptMask;
+			++iCorruptCount;
+
+			if (!RecoversTo(files, log.Source(), iLogLength, snapshots[frame].Reference)) {
+				PrintFailure("손상된 로그의 복구 결과가 손상 직전 커밋과 다릅니다.", keyRange, iPosition, iLogLength);
+				return false;
+			}
+		}
+		return true;
+	};
+
+	const int iFrameCount = int(snapshots.size()) - 1;
+	if (iFrameCount > 0 && (!corruptFrame(iFrameCount - 1) || !corruptFrame(iFrameCount / 2))) {
+		return false;
+	}
+
+	// 끝에 쓰레기가 붙으면 커밋된 프레임은 모두 복구되어야 한다.
+	for (int iGarbage = 1; iGarbage <= 64; ++iGarbage) {
+		log.Clear();
+		log.WriteBytes(files.Log.Source(), iLogLength);
+		for (int i = 0; i < iGarbage; ++i) {
+			log.WriteByte(Byte(Random::GenerateInt(0, 256)));
+		}
+		++iCorruptCount;
+
+		if (!RecoversTo(files, log.Source(), log.Length(), snapshots.back().Reference)) {
+			PrintFailure("끝에 쓰레기가 붙은 로그의 복구 결과가 마지막 커밋과 다릅니다.", keyRange, iLogLength, log.Length());
+			return false;
+		}
+	}
+
+	Console::WriteLine("[손상된 로그, 키 범위 %d] 통과 (커밋: %d, 로그 크기: %d, 손상시킨 경우: %d)",
+		keyRange, iFrameCount, iLogLength, iCorruptCount
+	);
+	return true;
+}
+
+// 커밋된 Insert K 뒤에 커밋되지 않은 Remove K가 체크포인트에 들어간 상태에서
+// 로그를 새로 시작하기 전에 죽으면 이전 로그의 Insert K가 다시 적용되지 않아야 한다.
+bool FuzzStaleLog(int keyRange) {
+	DurableFiles files;
+	std::set<int> reference;
+
+	DeleteFiles();
+	{
+		DurableTreeSetOptions options;
+		options.GroupCommitCount = keyRange * 2;
+		DurableTreeSet<int> set(TestPath, options);
+
+		for (int iKey = 0; iKey < keyRange; ++iKey) {
+			set.Insert(iKey);
+		}
+		set.Commit();
+		ReadFileBytes(LogPath(), files.Log);
+
+		for (int iKey = 0; iKey < keyRange; ++iKey) {
+			if (Random::GenerateInt(0, 2) == 0) set.Remove(iKey);
+			else reference.insert(iKey);
+		}
+		set.Checkpoint();
+		ReadFileBytes(CheckpointPath(), files.Checkpoint);
+	}
+
+	if (!RecoversTo(files, files.Log.Source(), files.Log.Length(), reference)) {
+		PrintFailure("이전 세대의 로그가 체크포인트 위에 다시 적용되었습니다.", keyRange, 0, files.Log.Length());
+		return false;
+	}
+
+	Console::WriteLine("[이전 세대 로그, 키 범위 %d] 통과 (체크포인트 크기: %d)", keyRange, int(reference.size()));
+	return true;
+}
+
+int main(int argc, char** argv) {
+	const int iOperationCount = argc > 1 ? atoi(argv[1]) : DefaultOperationCount;
+	bool bPassed = true;
+
+	for (int iKeyRange : KeyRanges) {
+		bPassed &= FuzzTruncatedLog(iKeyRange, iOperationCount);
+		bPassed &= FuzzCorruptedLog(iKeyRange, iOperationCount);
+		bPassed &= FuzzStaleLog(iKeyRange);
+	}
+
+	DeleteFiles();
+	return bPassed ? 0 : 1;
+}
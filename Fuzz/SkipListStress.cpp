@@ -0,0 +1,173 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 동시성 스킵리스트 셋 스트레스 검증
+ * 여러 쓰레드가 같은 ConcurrentSkipListSet에 삽입/삭제/탐색을 섞어서 수행한 후 최종 상태를 확인한다.
+ * 락프리 코드(삭제 표시, 상위 레벨 연결, 에폭 회수)를 고친 후 돌려서 깨진 곳이 없는지 확인하는 용도이다.
+ *
+ *  skiplist_stress [쓰레드 수 (기본 8)] [쓰레드당 연산 수 (기본 200,000)]
+ *
+ * 쓰레드마다 성공한 삽입은 +1, 성공한 삭제는 -1로 키별로 기록해두고 끝난 후 모든 쓰레드의 기록을 합친다.
+ * 어떤 순서로 실행됐든 키마다 합은 0(없음) 또는 1(있음)이어야 하고 최종 셋에 그 키가 있는지와 같아야 한다.
+ * 그 밖에 최종 셋이 오름차순이고 중복이 없는지, Size가 실제 원소 수와 같은지 확인한다.
+ * 수정하는 동안 순회 쓰레드 하나가 계속 순회하며 오름차순이 깨지지 않는지도 본다. (순회는 약한 일관성이지만 순서는 지켜야 한다)
+ * 실패하면 1을 반환한다. AddressSanitizer로 빌드해서 돌리면 회수 시점 오류도 같이 잡힌다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Threading/Thread.h>
+
+#include <cstdlib>
+
+#include "Tree/ConcurrentSkipListSet.h"
+
+USING_NS_JC;
+
+constexpr int DefaultThreadCount = 8;
+constexpr int DefaultOperationCount = 200'000;
+constexpr int MaxThreadCount = 64;
+constexpr int KeyRanges[] = { 16, 1'024, 65'536 };		// 좁은 범위일수록 같은 키를 두고 경합이 잦다.
+
+// 쓰레드 하나의 작업과 결과
+struct StressWorker
+{
+	Thread Runner;
+	Vector<int> Delta;		// 키별로 성공한 삽입 수 - 성공한 삭제 수
+	Int64 InsertCount = 0;
+	Int64 RemoveCount = 0;
+};
+
+// 삽입 40%, 삭제 40%, 탐색 10%, LowerBound 10%
+void RunWorker(ConcurrentSkipListSet<int>& set, StressWorker& worker, int seed, int operationCount, int keyRange) {
+	Int32U uiSeed = 2463534242u + Int32U(seed) * 7919u;
+
+	for (int i = 0; i < operationCount; ++i) {
+		uiSeed ^= uiSeed << 13;
+		uiSeed ^= uiSeed >> 17;
+		uiSeed ^= uiSeed << 5;
+		const int iKey = int(uiSeed % Int32U(keyRange));
+		const int iOp = int((uiSeed >> 24) % 10);
+
+		if (iOp < 4) {
+			if (set.Insert(iKey)) {
+				++worker.Delta[iKey];
+				++worker.InsertCount;
+			}
+		} else if (iOp < 8) {
+			if (set.Remove(iKey)) {
+				--worker.Delta[iKey];
+				++worker.RemoveCount;
+			}
+		} else if (iOp < 9) {
+			set.Search(iKey);
+		} else {
+			set.LowerBound(iKey);
+		}
+	}
+}
+
+bool StressSkipList(int threadCount, int operationCount, int keyRange) {
+	ConcurrentSkipListSet<int> set;
+	StressWorker workers[MaxThreadCount];
+	Thread iterator;
+	Atomic<bool> bRunning = true;
+	Atomic<bool> bIteratedInOrder = true;
+
+	iterator.Start([&](void*) {
+		while (bRunning.Load()) {
+			int iPrev = -1;
+			set.ForEach([&](int data) {
+				if (data <= iPrev) bIteratedInOrder.Store(false);
+				iPrev = data;
+			});
+		}
+	});
+
+	for (int i = 0; i < threadCount; ++i) {
+		workers[i].Delta = Vector<int>(keyRange, 0);
+		workers[i].Runner.Start([&set, &worker = workers[i], i, operationCount, keyRange](void*) {
+			RunWorker(set, worker, i, operationCount, keyRange);
+		});
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		workers[i].Runner.Join();
+	}
+
+	bRunning.Store(false);
+	iterator.Join();
+
+	// 쓰레드별 기록을 합쳐서 키마다 있어야 하는지 구한다.
+	Vector<int> expected(keyRange, 0);
+	Int64 iInsertCount = 0;
+	Int64 iRemoveCount = 0;
+	for (int i = 0; i < threadCount; ++i) {
+		for (int iKey = 0; iKey < keyRange; ++iKey) {
+			expected[iKey] += workers[i].Delta[iKey];
+		}
+		iInsertCount += workers[i].InsertCount;
+		iRemoveCount += workers[i].RemoveCount;
+	}
+
+	const char* szReason = nullptr;
+	int iFailedKey = -1;
+	int iExpectedCount = 0;
+
+	for (int iKey = 0; iKey < keyRange && szReason == nullptr; ++iKey) {
+		if (expected[iKey] != 0 && expected[iKey] != 1) {
+			szReason = "같은 키의 삽입/삭제 성공 횟수가 맞지 않습니다.";
+			iFailedKey = iKey;
+		} else if (set.Search(iKey) != (expected[iKey] == 1)) {
+			szReason = "성공한 연산 기록과 Search 결과가 다릅니다.";
+			iFailedKey = iKey;
+		}
+		iExpectedCount += expected[iKey];
+	}
+
+	int iCount = 0;
+	int iPrev = -1;
+	set.ForEach([&](int data) {
+		if (szReason == nullptr && data <= iPrev) {
+			szReason = "순회 결과가 오름차순이 아니거나 중복이 있습니다.";
+			iFailedKey = data;
+		}
+		if (szReason == nullptr && (data >= keyRange || expected[data] != 1)) {
+			szReason = "성공한 연산 기록에 없는 키가 남아있습니다.";
+			iFailedKey = data;
+		}
+		iPrev = data;
+		++iCount;
+	});
+
+	if (szReason == nullptr && !bIteratedInOrder.Load()) {
+		szReason = "수정 중 순회 결과가 오름차순이 아닙니다.";
+	}
+
+	if (szReason == nullptr && (iCount != iExpectedCount || set.Size() != iCount)) {
+		szReason = "Size, 순회한 원소 수, 기록으로 구한 원소 수가 다릅니다.";
+	}
+
+	if (szReason != nullptr) {
+		Console::WriteLine("[쓰레드 %d개, 키 범위 %d] 실패: %s (키: %d, Size: %d, 순회: %d, 기대: %d)",
+			threadCount, keyRange, szReason, iFailedKey, set.Size(), iCount, iExpectedCount
+		);
+		return false;
+	}
+
+	Console::WriteLine("[쓰레드 %d개, 키 범위 %d] 통과 (삽입 성공: %lld, 삭제 성공: %lld, 최종 크기: %d)",
+		threadCount, keyRange, iInsertCount, iRemoveCount, iCount
+	);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	const int iThreadCount = Math::Min(argc > 1 ? atoi(argv[1]) : DefaultThreadCount, MaxThreadCount);
+	const int iOperationCount = argc > 2 ? atoi(argv[2]) : DefaultOperationCount;
+	bool bPassed = true;
+
+	for (int iKeyRange : KeyRanges) {
+		bPassed &= StressSkipList(iThreadCount, iOperationCount, iKeyRange);
+	}
+
+	return bPassed ? 0 : 1;
+}
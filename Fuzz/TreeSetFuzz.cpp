@@ -0,0 +1,1025 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리 무작위 차분 검증
+ * 같은 무작위 연산을 트리와 std::set(기준)에 똑같이 수행하면서 결과가 같은지, 트리 속성(Validate)이 유지되는지 확인한다.
+ * 삽입/삭제/회전 코드를 최적화한 후 돌려서 깨진 곳이 없는지 확인하는 용도이다.
+ *
+ *  treeset_fuzz [트리당 연산 수 (기본 1,000,000)]
+ *
+ * 키 범위를 라운드마다 바꿔가며 (좁은 범위는 중복 삽입/없는 키 삭제가 잦고, 넓은 범위는 트리가 커진다)
+ * 라운드 앞 절반은 삽입 위주, 뒤 절반은 삭제 위주로 섞어서 트리가 커졌다가 줄어들게 한다.
+ * Validate는 O(n)이므로 마지막 검증 후 연산 수가 (크기 / ValidateCostRatio) 이상일 때만 한다. (작은 트리는 매 연산마다)
+ * 실패하면 실패한 연산과 직전 연산 기록을 출력하고 1을 반환한다.
+ *
+ * 마지막으로 String 키 트립의 일괄 연산(Union/Difference)을 기준 셋과 비교한다.
+ * 겹치는 키의 노드를 해제하는 경로는 소멸자를 호출하므로 소멸자가 있는 타입으로 확인해야 한다.
+ *
+ * 해시맵은 같은 방식으로 std::unordered_map(기준)과 비교한다.
+ * HashMap은 점진적 재해쉬를 켜고 라운드마다 새로 만들어서 (가끔 Reserve로 미리 키워서) 확장과 버킷 이동이 계속 일어나게 한다.
+ * 이동 중에도 삭제/탐색/ForEach가 아직 안 옮긴 이전 버킷을 빠짐없이 보는지 확인하기 위해 ForEach 비교는 트리의 Validate와 같은 주기로 한다.
+ *
+ * FlatHashMap은 용량 기준으로 (데이터 + 삭제 표시)를 높게(13/16) 유지하다가 크기를 낮게(6/16) 유지하기를 번갈아 하면서 삽입/삭제를 계속 섞는다.
+ * 빈 슬롯이 없어진 그룹은 재해쉬 전까지 계속 삭제 표시를 남기므로 삭제 표시가 쌓이고, 확장 기준(14/16) 바로 아래에 머물다가
+ * 크기가 작을 때 넘으면 같은 크기로 정리(재해쉬)하는 경로로 간다. (크기가 아니라 삭제 표시까지 세어서 유지해야 매번 확장으로 빠지지 않는다)
+ * 삭제가 바로 빈 슬롯으로 돌아가는 경우, 삭제 표시를 남기는 경우, 같은 크기로 정리하는 경우를 모두 지나가지 못하면 실패로 본다.
+ * ClusteredKeySize개씩 해쉬가 같은 키(ClusteredKey)로도 돌려서 태그까지 같은 키가 한 그룹을 넘쳐 다음 그룹으로 가는 경로도 확인한다.
+ *
+ * RadixTreeMap은 트리와 같은 연산 섞기로 std::map(기준)과 비교하고 Validate로 노드 종류별 자식 수와 접두사를 확인한다.
+ * 정수 키는 범위가 넓어질수록 한 바이트 아래 자식이 많아져서 Node4 -> 16 -> 48 -> 256으로 커진다.
+ * 라운드가 끝나면 Clear 대신 남은 키를 모두 삭제하면서 검증해서, 위쪽 노드까지 줄어들고
+ * 자식이 하나 남은 Node4가 자식에 접두사를 넘기고 없어지는 경로를 지나가게 한다.
+ * 무작위 순서로만 지우면 위쪽 서브트리들이 거의 동시에 비어서 내부 노드 자식으로 합쳐지는 일이 드물므로 라운드마다 오름차순/내림차순으로도 지운다. 정수 키로 돌릴 때 네 종류의 노드가 모두 나오지 않으면 실패로 본다.
+ * String 키는 공통 접두사를 MaxPrefixLength보다 길게 붙여서 생략된 접두사를 리프 키로 비교하고 합치는 경로를 확인한다.
+ *
+ * BitmapSet은 std::set(기준)과 비교하고 Successor/Predecessor, 반복자의 Next/Previous도 같이 확인한다.
+ * 0을 가운데 두고 키를 만들어서 부호 비트가 바뀌는 레벨 0 경계를 지나가게 하고, 마지막 라운드는 레벨마다
+ * 노드 하나가 덮는 키 수(64, 4096, ...)의 배수 근처 키만 써서 셋을 듬성듬성하게 만든다.
+ * 그러면 후속자/선행자가 같은 리프에 없어서 위 레벨로 올라가 옆 서브트리의 최솟값/최댓값을 찾는 경로를 지나간다.
+ * 결과가 키와 몇번째 레벨부터 다른지를 세어서 레벨 0 ~ 4 경계를 모두 넘어가 보지 못하면 실패로 본다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+#include <JCore/Primitives/StringUtil.h>
+
+#include <JCore/Container/HashMap.h>
+#include <JCore/Container/FlatHashMap.h>
+
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Tree/TreeSet.h"
+#include "Tree/TreapSet.h"
+#include "Tree/RadixTreeMap.h"
+#include "Tree/BitmapSet.h"
+
+USING_NS_JC;
+
+constexpr int DefaultOperationCount = 1'000'000;
+constexpr int ValidateCostRatio = 64;
+constexpr int HistoryCount = 16;
+constexpr int ScanRange = 64;
+constexpr int ScanBatchSize = 7;
+constexpr int KeyRanges[] = { 8, 64, 1'024, 65'536, 1 << 20 };
+constexpr int MergeOperationCost = 1'000;		// 일괄 연산 1회를 연산 몇개로 칠지
+constexpr int MergeMaxSetSize = 512;
+constexpr int ChurnPhaseCount = 16;				// 라운드마다 높게/낮게 유지하기를 몇번 바꿀지
+constexpr int ChurnHighLoad = 13;				// 높게 유지할 데이터 + 삭제 표시 수 (용량의 16분의 몇, 확장 기준 14/16 바로 아래)
+constexpr int ChurnLowLoad = 6;					// 낮게 유지할 크기 (같은 크기 정리 기준 7/16 아래)
+constexpr int ClusteredKeySize = 24;			// ClusteredKey의 해쉬가 같은 키 수 (그룹 크기 16보다 크게)
+constexpr int BitmapLevelStrides[] = { 64, 4'096, 262'144, 1 << 24, 1 << 30 };	// BitmapSet 레벨 5 ~ 1 노드 하나가 덮는 키 수
+constexpr int BoundaryKeySpread = 3;			// 경계 키를 경계에서 몇칸까지 떨어뜨릴지
+constexpr int BoundaryMultipleCount = 4;		// 경계 키를 0에서 stride 몇배까지 만들지
+
+// 연속된 ClusteredKeySize개의 키가 같은 해쉬를 갖는다. 같은 그룹에 몰리고 태그(H2)도 같다.
+struct ClusteredKey
+{
+	int Value;
+
+	bool operator==(const ClusteredKey& other) const { return Value == other.Value; }
+};
+
+NS_JC_BEGIN
+
+template <>
+struct Hasher<ClusteredKey>
+{
+	Int32U operator()(const ClusteredKey& key) const {
+		return Hasher<int>()(key.Value / ClusteredKeySize);
+	}
+};
+
+NS_JC_END
+
+inline int MapKeyValue(int key) { return key; }
+inline int MapKeyValue(const ClusteredKey& key) { return key.Value; }
+
+enum class FuzzOperation
+{
+	Insert,
+	Remove,
+	Search,
+	LowerBound,
+	Scan,
+	Find,
+	ForEach,
+	Reserve,
+	Successor,
+	Predecessor
+};
+
+inline const char* FuzzOperationName(FuzzOperation operation) {
+	switch (operation) {
+	case FuzzOperation::Insert:		return "Insert";
+	case FuzzOperation::Remove:		return "Remove";
+	case FuzzOperation::Search:		return "Search";
+	case FuzzOperation::LowerBound:	return "LowerBound";
+	case FuzzOperation::Scan:		return "Scan";
+	case FuzzOperation::Find:		return "Find";
+	case FuzzOperation::ForEach:	return "ForEach";
+	case FuzzOperation::Reserve:	return "Reserve";
+	case FuzzOperation::Successor:	return "Successor";
+	case FuzzOperation::Predecessor:return "Predecessor";
+	}
+	return "Unknown";
+}
+
+struct FuzzRecord
+{
+	FuzzOperation Operation;
+	int Key;
+};
+
+// 실패 원인을 찾을 수 있도록 최근 연산 HistoryCount개를 기억한다.
+class FuzzHistory
+{
+public:
+	FuzzHistory() : m_iCount(0) {}
+
+	void Add(FuzzOperation operation, int key) {
+		m_Records[m_iCount % HistoryCount] = { operation, key };
+		++m_iCount;
+	}
+
+	void Print() const {
+		const Int64 iBegin = Math::Max(m_iCount - HistoryCount, Int64(0));
+		for (Int64 i = iBegin; i < m_iCount; ++i) {
+			const FuzzRecord& record = m_Records[i % HistoryCount];
+			Console::WriteLine("  #%lld %s(%d)", i, FuzzOperationName(record.Operation), record.Key);
+		}
+	}
+
+	Int64 Count() const { return m_iCount; }
+private:
+	FuzzRecord m_Records[HistoryCount];
+	Int64 m_iCount;
+};
+
+FuzzOperation GenerateOperation(bool growing) {
+	// 앞 절반: 삽입 60%, 삭제 30% / 뒤 절반: 삽입 30%, 삭제 60% / 나머지는 탐색 5%, LowerBound 3%, Scan 2%
+	const int iDice = Random::GenerateInt(0, 100);
+
+	if (iDice < 30) return growing ? FuzzOperation::Remove : FuzzOperation::Insert;
+	if (iDice < 90) return growing ? FuzzOperation::Insert : FuzzOperation::Remove;
+	if (iDice < 95) return FuzzOperation::Search;
+	if (iDice < 98) return FuzzOperation::LowerBound;
+	return FuzzOperation::Scan;
+}
+
+// 연산 하나를 트리와 기준 셋에 모두 수행하고 결과가 같은지 확인한다.
+template <typename TSet>
+bool ApplyOperation(TSet& set, std::set<int>& reference, FuzzOperation operation, int key) {
+	switch (operation) {
+	case FuzzOperation::Insert:
+		return set.Insert(key) == reference.insert(key).second;
+	case FuzzOperation::Remove:
+		return set.Remove(key) == (reference.erase(key) != 0);
+	case FuzzOperation::Search:
+		return set.Search(key) == (reference.find(key) != reference.end());
+	case FuzzOperation::LowerBound: {
+		auto it = set.LowerBound(key);
+		const auto referenceIt = reference.lower_bound(key);
+
+		if (referenceIt == reference.end()) {
+			return !it.HasNext();
+		}
+
+		return it.HasNext() && it.Next() == *referenceIt;
+	}
+	case FuzzOperation::Scan: {
+		// [key, key + ScanRange)를 작은 버퍼로 여러번 나눠 읽는다.
+		auto cursor = set.ScanCursor(key, key + ScanRange);
+		auto referenceIt = reference.lower_bound(key);
+		const auto referenceEnd = reference.lower_bound(key + ScanRange);
+		int buffer[ScanBatchSize];
+
+		for (int iRead; (iRead = cursor.Read(buffer, ScanBatchSize)) > 0;) {
+			for (int i = 0; i < iRead; ++i, ++referenceIt) {
+				if (referenceIt == referenceEnd || *referenceIt != buffer[i]) {
+					return false;
+				}
+			}
+		}
+
+		return referenceIt == referenceEnd;
+	}
+	}
+	return false;
+}
+
+// 오름차순 순회 결과가 기준 셋과 같은지 확인한다.
+template <typename TSet>
+bool EqualsReference(const TSet& set, const std::set<int>& reference) {
+	if (set.Size() != int(reference.size())) {
+		return false;
+	}
+
+	auto referenceIt = reference.begin();
+	bool bEqual = true;
+	set.ForEach([&](int data) {
+		if (bEqual && (referenceIt == reference.end() || *referenceIt != data)) {
+			bEqual = false;
+		}
+		++referenceIt;
+	});
+	return bEqual;
+}
+
+template <typename TSet>
+void PrintFailure(const char* name, const char* reason, int keyRange, const TSet& set, const FuzzHistory& history) {
+	Console::WriteLine("[%s] 실패: %s (키 범위: %d, 크기: %d, 연산 수: %lld)", name, reason, keyRange, set.Size(), history.Count());
+	Console::WriteLine("최근 연산 (마지막이 실패한 연산)");
+	history.Print();
+}
+
+template <typename TSet>
+bool FuzzSet(const char* name, int operationCount) {
+	TSet set;
+	std::set<int> reference;
+	FuzzHistory history;
+	Int64 iValidateCount = 0;
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]);
+	const int iRoundOperationCount = Math::Max(operationCount / iRoundCount, 2);
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = KeyRanges[iRound];
+		int iSinceValidate = 0;
+
+		for (int i = 0; i < iRoundOperationCount; ++i) {
+			const FuzzOperation eOperation = GenerateOperation(i < iRoundOperationCount / 2);
+			const int iKey = Random::GenerateInt(0, iKeyRange);
+			history.Add(eOperation, iKey);
+
+			if (!ApplyOperation(set, reference, eOperation, iKey)) {
+				PrintFailure(name, "기준 셋과 결과가 다릅니다.", iKeyRange, set, history);
+				return false;
+			}
+
+			if (++iSinceValidate < set.Size() / ValidateCostRatio) {
+				continue;
+			}
+
+			iSinceValidate = 0;
+			++iValidateCount;
+
+			const TreeValidateError eError = set.Validate();
+			if (eError != TreeValidateError::None) {
+				PrintFailure(name, TreeValidateErrorName(eError), iKeyRange, set, history);
+				return false;
+			}
+		}
+
+		if (!EqualsReference(set, reference)) {
+			PrintFailure(name, "순회 결과가 기준 셋과 다릅니다.", iKeyRange, set, history);
+			return false;
+		}
+
+		set.Clear();
+		reference.clear();
+	}
+
+	Console::WriteLine("[%s] 통과 (연산 수: %lld, 검증 횟수: %lld)", name, history.Count(), iValidateCount);
+	return true;
+}
+
+// 숫자 순서와 문자열 순서가 같도록 0을 채운다.
+inline String MergeKey(int key) {
+	return StringUtil::Format("%07d", key);
+}
+
+template <typename TSet>
+void FillMergeSet(TSet& set, std::set<int>& reference, int keyRange) {
+	const int iCount = Random::GenerateInt(0, Math::Min(keyRange, MergeMaxSetSize) + 1);
+
+	for (int i = 0; i < iCount; ++i) {
+		const int iKey = Random::GenerateInt(0, keyRange);
+		set.Insert(MergeKey(iKey));
+		reference.insert(iKey);
+	}
+}
+
+template <typename TSet>
+bool EqualsMergeReference(const TSet& set, const std::set<int>& reference) {
+	if (set.Size() != int(reference.size()) || set.Validate() != TreeValidateError::None) {
+		return false;
+	}
+
+	auto referenceIt = reference.begin();
+	bool bEqual = true;
+	set.ForEach([&](const String& data) {
+		if (bEqual && (referenceIt == reference.end() || data != MergeKey(*referenceIt))) {
+			bEqual = false;
+		}
+		++referenceIt;
+	});
+	return bEqual;
+}
+
+bool FuzzTreapMerge(const char* name, int operationCount) {
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]);
+	const int iRoundMergeCount = Math::Max(operationCount / MergeOperationCost / iRoundCount, 1);
+	int iMergeCount = 0;
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = KeyRanges[iRound];
+
+		for (int i = 0; i < iRoundMergeCount; ++i) {
+			TreapSet<String> lhs;
+			TreapSet<String> rhs;
+			TreapSet<String> removed;
+			std::set<int> lhsReference;
+			std::set<int> rhsReference;
+			std::set<int> removedReference;
+			const int iParallelDepth = Random::GenerateInt(0, 2);
+
+			FillMergeSet(lhs, lhsReference, iKeyRange);
+			FillMergeSet(rhs, rhsReference, iKeyRange);
+			FillMergeSet(removed, removedReference, iKeyRange);
+
+			lhs.Union(rhs, iParallelDepth);
+			lhsReference.insert(rhsReference.begin(), rhsReference.end());
+			++iMergeCount;
+
+			if (!rhs.IsEmpty() || !EqualsMergeReference(lhs, lhsReference)) {
+				Console::WriteLine("[%s] 실패: 합집합 결과가 기준 셋과 다릅니다. (키 범위: %d, 병렬 깊이: %d)", name, iKeyRange, iParallelDepth);
+				return false;
+			}
+
+			lhs.Difference(removed, iParallelDepth);
+			for (int iKey : removedReference) lhsReference.erase(iKey);
+			++iMergeCount;
+
+			if (!EqualsMergeReference(lhs, lhsReference) || !EqualsMergeReference(removed, removedReference)) {
+				Console::WriteLine("[%s] 실패: 차집합 결과가 기준 셋과 다릅니다. (키 범위: %d, 병렬 깊이: %d)", name, iKeyRange, iParallelDepth);
+				return false;
+			}
+		}
+	}
+
+	Console::WriteLine("[%s] 통과 (일괄 연산 수: %d)", name, iMergeCount);
+	return true;
+}
+
+FuzzOperation GenerateMapOperation(bool growing) {
+	// 앞 절반: 삽입 60%, 삭제 30% / 뒤 절반: 삽입 30%, 삭제 60% / 나머지는 Find 10%
+	// Reserve는 남은 재해쉬를 바로 끝내고 미리 키워서 확장을 막으므로 라운드마다 한번만 따로 한다.
+	const int iDice = Random::GenerateInt(0, 100);
+
+	if (iDice < 30) return growing ? FuzzOperation::Remove : FuzzOperation::Insert;
+	if (iDice < 90) return growing ? FuzzOperation::Insert : FuzzOperation::Remove;
+	return FuzzOperation::Find;
+}
+
+// 연산 하나를 해시맵과 기준 맵에 모두 수행하고 결과가 같은지 확인한다. 값은 넣을 때마다 달라지도록 value를 쓴다.
+// 맵의 키 타입은 TMapKey{ key }로 만든다.
+template <typename TMapKey = int, typename TMap>
+bool ApplyMapOperation(TMap& map, std::unordered_map<int, int>& reference, FuzzOperation operation, int key, int value) {
+	const TMapKey mapKey{ key };
+
+	switch (operation) {
+	case FuzzOperation::Insert:
+		return map.Insert(mapKey, value) == reference.emplace(key, value).second;
+	case FuzzOperation::Remove:
+		return map.Remove(mapKey) == (reference.erase(key) != 0);
+	case FuzzOperation::Find: {
+		const int* pValue = map.Find(mapKey);
+		const auto referenceIt = reference.find(key);
+
+		if (referenceIt == reference.end()) {
+			return pValue == nullptr;
+		}
+
+		return pValue != nullptr && *pValue == referenceIt->second;
+	}
+	default:
+		return false;
+	}
+}
+
+// ForEach로 모든 키/값을 한번씩 지나가는지 확인한다.
+template <typename TMap>
+bool EqualsMapReference(TMap& map, const std::unordered_map<int, int>& reference) {
+	if (map.Size() != int(reference.size())) {
+		return false;
+	}
+
+	std::unordered_set<int> visited;
+	bool bEqual = true;
+	map.ForEach([&](const auto& pair) {
+		const int iKey = MapKeyValue(pair.Key);
+		const auto referenceIt = reference.find(iKey);
+		if (referenceIt == reference.end() || referenceIt->second != pair.Value || !visited.insert(iKey).second) {
+			bEqual = false;
+		}
+	});
+	return bEqual && visited.size() == reference.size();
+}
+
+template <typename TMap>
+void PrintMapFailure(const char* name, const char* reason, int keyRange, const TMap& map, const FuzzHistory& history) {
+	Console::WriteLine("[%s] 실패: %s (키 범위: %d, 크기: %d, 용량: %d, 연산 수: %lld)", name, reason, keyRange, map.Size(), map.Capacity(), history.Count());
+	Console::WriteLine("최근 연산 (마지막이 실패한 연산)");
+	history.Print();
+}
+
+bool FuzzHashMap(const char* name, int operationCount) {
+	FuzzHistory history;
+	Int64 iCheckCount = 0;
+	Int64 iRehashingOperationCount = 0;
+	Int64 iRehashingCheckCount = 0;
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]);
+	const int iRoundOperationCount = Math::Max(operationCount / iRoundCount, 2);
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = KeyRanges[iRound];
+		HashMap<int, int> map;
+		std::unordered_map<int, int> reference;
+		int iSinceCheck = 0;
+		int iReserveAt = Random::GenerateInt(0, iRoundOperationCount / 2);
+
+		map.SetIncrementalRehash(true);
+		if (Random::GenerateInt(0, 2) == 0) {
+			map.Reserve(Random::GenerateInt(0, iKeyRange / 4 + 1));
+		}
+
+		for (int i = 0; i < iRoundOperationCount; ++i) {
+			// Reserve는 정한 시점 이후 처음 재해쉬 중일 때 한다. (옮기던 버킷을 다 옮기고 확장하는 경로)
+			const bool bRehashing = map.IsRehashing();
+			const bool bReserve = i >= iReserveAt && bRehashing;
+			const FuzzOperation eOperation = bReserve ? FuzzOperation::Reserve : GenerateMapOperation(i < iRoundOperationCount / 2);
+			const int iKey = Random::GenerateInt(0, iKeyRange);
+			if (bReserve) iReserveAt = iRoundOperationCount;
+			history.Add(eOperation, iKey);
+
+			if (bReserve) {
+				// 지금 크기의 최대 2배까지만 미리 늘린다. (남은 이동을 끝낸 후 확장한다)
+				map.Reserve(map.Size() + Random::GenerateInt(0, map.Size() + 1));
+			} else if (!ApplyMapOperation(map, reference, eOperation, iKey, i) || map.Size() != int(reference.size())) {
+				PrintMapFailure(name, "기준 맵과 결과가 다릅니다.", iKeyRange, map, history);
+				return false;
+			}
+
+			iRehashingOperationCount += bRehashing;
+
+			if (++iSinceCheck < map.Size() / ValidateCostRatio) {
+				continue;
+			}
+
+			iSinceCheck = 0;
+			++iCheckCount;
+			iRehashingCheckCount += map.IsRehashing();
+			history.Add(FuzzOperation::ForEach, 0);
+
+			if (!EqualsMapReference(map, reference)) {
+				PrintMapFailure(name, "ForEach 결과가 기준 맵과 다릅니다.", iKeyRange, map, history);
+				return false;
+			}
+		}
+
+		if (!EqualsMapReference(map, reference)) {
+			PrintMapFailure(name, "ForEach 결과가 기준 맵과 다릅니다.", iKeyRange, map, history);
+			return false;
+		}
+	}
+
+	Console::WriteLine("[%s] 통과 (연산 수: %lld, 재해쉬 중 연산 수: %lld, ForEach 비교: %lld (재해쉬 중 %lld))",
+		name, history.Count(), iRehashingOperationCount, iCheckCount, iRehashingCheckCount
+	);
+	return true;
+}
+
+// 삭제 표시 정리 경로를 몇번 지나갔는지
+struct FlatHashMapChurnCount
+{
+	Int64 ClearedRemoveCount = 0;	// 그룹에 빈 슬롯이 있어서 바로 비운 삭제
+	Int64 DeletedRemoveCount = 0;	// 삭제 표시를 남긴 삭제
+	Int64 CleanupRehashCount = 0;	// 삭제 표시가 쌓여서 같은 크기로 정리한 삽입
+	Int64 GrowRehashCount = 0;		// 용량을 늘린 삽입
+};
+
+// 용량 기준 목표보다 작으면 삽입, 크면 있는 키 중 하나를 삭제한다. 일부는 반대 연산이나 탐색을 섞는다.
+FuzzOperation GenerateChurnOperation(int load, int targetLoad) {
+	const int iDice = Random::GenerateInt(0, 100);
+	const bool bGrow = load < targetLoad;
+
+	if (iDice < 10) return FuzzOperation::Find;
+	if (iDice < 25) return bGrow ? FuzzOperation::Remove : FuzzOperation::Insert;
+	return bGrow ? FuzzOperation::Insert : FuzzOperation::Remove;
+}
+
+template <typename TKey>
+bool FuzzFlatHashMap(const char* name, int operationCount) {
+	FuzzHistory history;
+	FlatHashMapChurnCount count;
+	Int64 iCheckCount = 0;
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]);
+	const int iRoundOperationCount = Math::Max(operationCount / iRoundCount, 2);
+	const int iPhaseOperationCount = Math::Max(iRoundOperationCount / ChurnPhaseCount, 1);
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = KeyRanges[iRound];
+		FlatHashMap<TKey, int> map;
+		std::unordered_map<int, int> reference;
+		std::vector<int> keys;		// 삭제할 키를 고르기 위한 들어있는 키 목록
+		int iSinceCheck = 0;
+
+		for (int i = 0; i < iRoundOperationCount; ++i) {
+			const bool bHighLoad = (i / iPhaseOperationCount) % 2 == 0;
+			const int iLoad = bHighLoad ? map.Size() + map.DeletedCount() : map.Size();
+			const int iTargetLoad = map.Capacity() * (bHighLoad ? ChurnHighLoad : ChurnLowLoad) / 16;
+			const FuzzOperation eOperation = GenerateChurnOperation(iLoad, iTargetLoad);
+			int iKey = Random::GenerateInt(0, iKeyRange);
+			int iKeyIndex = -1;
+
+			if (eOperation == FuzzOperation::Remove && !keys.empty()) {
+				iKeyIndex = Random::GenerateInt(0, int(keys.size()));
+				iKey = keys[iKeyIndex];
+			}
+
+			const int iPrevCapacity = map.Capacity();
+			const int iPrevDeletedCount = map.DeletedCount();
+			history.Add(eOperation, iKey);
+
+			if (!ApplyMapOperation<TKey>(map, reference, eOperation, iKey, i) || map.Size() != int(reference.size())) {
+				PrintMapFailure(name, "기준 맵과 결과가 다릅니다.", iKeyRange, map, history);
+				return false;
+			}
+
+			if (eOperation == FuzzOperation::Insert && map.Size() > int(keys.size())) {
+				keys.push_back(iKey);
+
+				if (map.Capacity() != iPrevCapacity) ++count.GrowRehashCount;
+				else if (map.DeletedCount() < iPrevDeletedCount - 1) ++count.CleanupRehashCount;
+			} else if (eOperation == FuzzOperation::Remove && iKeyIndex != -1) {
+				keys[iKeyIndex] = keys.back();
+				keys.pop_back();
+
+				if (map.DeletedCount() > iPrevDeletedCount) ++count.DeletedRemoveCount;
+				else ++count.ClearedRemoveCount;
+			}
+
+			if (++iSinceCheck < map.Size() / ValidateCostRatio) {
+				continue;
+			}
+
+			iSinceCheck = 0;
+			++iCheckCount;
+			history.Add(FuzzOperation::ForEach, 0);
+
+			if (!EqualsMapReference(map, reference)) {
+				PrintMapFailure(name, "ForEach 결과가 기준 맵과 다릅니다.", iKeyRange, map, history);
+				return false;
+			}
+		}
+
+		if (!EqualsMapReference(map, reference)) {
+			PrintMapFailure(name, "ForEach 결과가 기준 맵과 다릅니다.", iKeyRange, map, history);
+			return false;
+		}
+	}
+
+	const bool bCovered = count.ClearedRemoveCount > 0 && count.DeletedRemoveCount > 0 && count.CleanupRehashCount > 0;
+	Console::WriteLine("[%s] %s (연산 수: %lld, ForEach 비교: %lld, 빈 슬롯 삭제: %lld, 삭제 표시: %lld, 같은 크기 정리: %lld, 확장: %lld)",
+		name, bCovered ? "통과" : "실패: 삭제 표시를 남기고 정리하는 경로를 모두 지나가지 못했습니다.",
+		history.Count(), iCheckCount, count.ClearedRemoveCount, count.DeletedRemoveCount, count.CleanupRehashCount, count.GrowRehashCount
+	);
+	return bCovered;
+}
+
+// RadixTreeMap 키: String은 경로 압축 접두사가 MaxPrefixLength보다 길어지도록 긴 공통 접두사를 붙인다. (숫자 순서와 문자열 순서가 같다)
+template <typename TKey>
+TKey MakeRadixKey(int key);
+
+template <>
+inline int MakeRadixKey<int>(int key) { return key; }
+
+template <>
+inline String MakeRadixKey<String>(int key) { return StringUtil::Format("radix-tree-fuzz/%07d", key); }
+
+// 반복자의 현재 위치가 기준 맵의 위치와 같은지 (둘 다 끝이어도 같다)
+template <typename TKey, typename TIterator>
+bool EqualsRadixPosition(const TIterator& it, std::map<int, int>::const_iterator referenceIt, const std::map<int, int>& reference) {
+	if (referenceIt == reference.end()) {
+		return !it.HasNext();
+	}
+
+	return it.HasNext() && it.Current().Key == MakeRadixKey<TKey>(referenceIt->first) && it.Current().Value == referenceIt->second;
+}
+
+// 연산 하나를 기수 트리와 기준 맵에 모두 수행하고 결과가 같은지 확인한다. Search는 Find로 값까지 비교한다.
+template <typename TKey>
+bool ApplyRadixOperation(RadixTreeMap<TKey, int>& map, std::map<int, int>& reference, FuzzOperation operation, int key, int value) {
+	const TKey radixKey = MakeRadixKey<TKey>(key);
+
+	switch (operation) {
+	case FuzzOperation::Insert:
+		return map.Insert(radixKey, value) == reference.emplace(key, value).second;
+	case FuzzOperation::Remove:
+		return map.Remove(radixKey) == (reference.erase(key) != 0);
+	case FuzzOperation::Search: {
+		const int* pValue = map.Find(radixKey);
+		const auto referenceIt = reference.find(key);
+
+		if (referenceIt == reference.end()) {
+			return pValue == nullptr;
+		}
+
+		return pValue != nullptr && *pValue == referenceIt->second;
+	}
+	case FuzzOperation::LowerBound:
+		return EqualsRadixPosition<TKey>(map.LowerBound(radixKey), reference.lower_bound(key), reference);
+	case FuzzOperation::Scan: {
+		// LowerBound 위치부터 ScanRange개를 반복자로 읽는다.
+		auto it = map.LowerBound(radixKey);
+		auto referenceIt = reference.lower_bound(key);
+
+		for (int i = 0; i < ScanRange; ++i) {
+			if (!EqualsRadixPosition<TKey>(it, referenceIt, reference)) {
+				return false;
+			}
+
+			if (referenceIt == reference.end()) {
+				break;
+			}
+
+			it.Next();
+			++referenceIt;
+		}
+
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// ForEach와 Begin부터의 반복자 순회가 모두 기준 맵과 같은지 확인한다.
+template <typename TKey>
+bool EqualsRadixReference(const RadixTreeMap<TKey, int>& map, const std::map<int, int>& reference) {
+	if (map.Size() != int(reference.size())) {
+		return false;
+	}
+
+	auto referenceIt = reference.cbegin();
+	bool bEqual = true;
+	map.ForEach([&](const Pair<TKey, int>& pair) {
+		if (bEqual && (referenceIt == reference.end() || pair.Key != MakeRadixKey<TKey>(referenceIt->first) || pair.Value != referenceIt->second)) {
+			bEqual = false;
+		}
+		++referenceIt;
+	});
+
+	auto it = map.Begin();
+	for (referenceIt = reference.cbegin(); bEqual && referenceIt != reference.end(); ++referenceIt) {
+		bEqual = EqualsRadixPosition<TKey>(it, referenceIt, reference);
+		if (bEqual) it.Next();
+	}
+
+	return bEqual && !it.HasNext();
+}
+
+enum class DrainOrder
+{
+	Random,
+	Ascending,
+	Descending
+};
+
+// 남은 키를 order 순서로 모두 삭제하면서 검증 주기마다 Validate한다.
+template <typename TKey>
+TreeValidateError DrainRadixTreeMap(RadixTreeMap<TKey, int>& map, std::map<int, int>& reference, DrainOrder order, FuzzHistory& history) {
+	std::vector<int> keys;
+	if (order == DrainOrder::Descending) {
+		for (auto it = reference.rbegin(); it != reference.rend(); ++it) keys.push_back(it->first);
+	} else {
+		for (const auto& [iKey, iValue] : reference) keys.push_back(iKey);
+	}
+
+	for (int i = int(keys.size()) - 1; i > 0 && order == DrainOrder::Random; --i) {
+		const int j = Random::GenerateInt(0, i + 1);
+		const int iTemp = keys[i];
+		keys[i] = keys[j];
+		keys[j] = iTemp;
+	}
+
+	int iSinceValidate = 0;
+	for (int iKey : keys) {
+		history.Add(FuzzOperation::Remove, iKey);
+
+		if (!ApplyRadixOperation(map, reference, FuzzOperation::Remove, iKey, 0)) {
+			return TreeValidateError::Size;
+		}
+
+		if (++iSinceValidate < map.Size() / ValidateCostRatio) {
+			continue;
+		}
+
+		iSinceValidate = 0;
+		const TreeValidateError eError = map.Validate();
+		if (eError != TreeValidateError::None) {
+			return eError;
+		}
+	}
+
+	return map.IsEmpty() ? TreeValidateError::None : TreeValidateError::Size;
+}
+
+template <typename TKey>
+bool FuzzRadixTreeMap(const char* name, int operationCount, bool requireAllNodeTypes) {
+	constexpr RadixNodeType InnerNodeTypes[] = { RadixNodeType::Node4, RadixNodeType::Node16, RadixNodeType::Node48, RadixNodeType::Node256 };
+
+	RadixTreeMap<TKey, int> map;
+	std::map<int, int> reference;
+	FuzzHistory history;
+	Int64 iValidateCount = 0;
+	int iPeakNodeCount[4]{};		// InnerNodeTypes 순서로 검증할 때 본 최대 노드 수
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]);
+	const int iRoundOperationCount = Math::Max(operationCount / iRoundCount, 2);
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = KeyRanges[iRound];
+		int iSinceValidate = 0;
+
+		for (int i = 0; i < iRoundOperationCount; ++i) {
+			const FuzzOperation eOperation = GenerateOperation(i < iRoundOperationCount / 2);
+			const int iKey = Random::GenerateInt(0, iKeyRange);
+			history.Add(eOperation, iKey);
+
+			if (!ApplyRadixOperation(map, reference, eOperation, iKey, i)) {
+				PrintFailure(name, "기준 맵과 결과가 다릅니다.", iKeyRange, map, history);
+				return false;
+			}
+
+			if (++iSinceValidate < map.Size() / ValidateCostRatio) {
+				continue;
+			}
+
+			iSinceValidate = 0;
+			++iValidateCount;
+
+			const TreeValidateError eError = map.Validate();
+			if (eError != TreeValidateError::None) {
+				PrintFailure(name, TreeValidateErrorName(eError), iKeyRange, map, history);
+				return false;
+			}
+
+			for (int j = 0; j < 4; ++j) {
+				iPeakNodeCount[j] = Math::Max(iPeakNodeCount[j], map.NodeCount(InnerNodeTypes[j]));
+			}
+		}
+
+		if (!EqualsRadixReference(map, reference)) {
+			PrintFailure(name, "순회 결과가 기준 맵과 다릅니다.", iKeyRange, map, history);
+			return false;
+		}
+
+		const TreeValidateError eError = DrainRadixTreeMap(map, reference, DrainOrder(iRound % 3), history);
+		if (eError != TreeValidateError::None) {
+			PrintFailure(name, TreeValidateErrorName(eError), iKeyRange, map, history);
+			return false;
+		}
+	}
+
+	const bool bCovered = !requireAllNodeTypes || (iPeakNodeCount[0] > 0 && iPeakNodeCount[1] > 0 && iPeakNodeCount[2] > 0 && iPeakNodeCount[3] > 0);
+	Console::WriteLine("[%s] %s (연산 수: %lld, 검증 횟수: %lld, 최대 노드 수 Node4/16/48/256: %d/%d/%d/%d)",
+		name, bCovered ? "통과" : "실패: 네 종류의 노드가 모두 나오지 않았습니다.",
+		history.Count(), iValidateCount, iPeakNodeCount[0], iPeakNodeCount[1], iPeakNodeCount[2], iPeakNodeCount[3]
+	);
+	return bCovered;
+}
+
+FuzzOperation GenerateBitmapOperation(bool growing) {
+	// 삽입/삭제는 GenerateOperation과 같고 나머지는 탐색 2%, LowerBound 2%, Successor 2%, Predecessor 2%, Scan 2%
+	const int iDice = Random::GenerateInt(0, 100);
+
+	if (iDice < 30) return growing ? FuzzOperation::Remove : FuzzOperation::Insert;
+	if (iDice < 90) return growing ? FuzzOperation::Insert : FuzzOperation::Remove;
+	if (iDice < 92) return FuzzOperation::Search;
+	if (iDice < 94) return FuzzOperation::LowerBound;
+	if (iDice < 96) return FuzzOperation::Successor;
+	if (iDice < 98) return FuzzOperation::Predecessor;
+	return FuzzOperation::Scan;
+}
+
+// keyRange가 0이면 레벨 경계 (stride의 배수) 근처 키, 아니면 0을 가운데 둔 [-keyRange / 2, keyRange / 2) 키
+int GenerateBitmapKey(int keyRange) {
+	if (keyRange > 0) {
+		return Random::GenerateInt(0, keyRange) - keyRange / 2;
+	}
+
+	const int iStride = BitmapLevelStrides[Random::GenerateInt(0, sizeof(BitmapLevelStrides) / sizeof(BitmapLevelStrides[0]))];
+	const Int64 iKey = Int64(iStride) * Random::GenerateInt(-BoundaryMultipleCount, BoundaryMultipleCount + 1) +
+		Random::GenerateInt(-BoundaryKeySpread, BoundaryKeySpread + 1);
+	return int(Math::Min(Math::Max(iKey, Int64(MinInt32_v)), Int64(MaxInt32_v)));
+}
+
+// 키와 결과가 처음 달라지는 레벨 (같은 리프면 LeafLevel)
+inline int CrossedLevel(int key, int found) {
+	const Int32U uiKey = BitmapNode::ToKey(key);
+	const Int32U uiFound = BitmapNode::ToKey(found);
+	int iLevel = 0;
+
+	while (iLevel < BitmapNode::LeafLevel && BitmapNode::Index(uiKey, iLevel) == BitmapNode::Index(uiFound, iLevel)) {
+		++iLevel;
+	}
+
+	return iLevel;
+}
+
+// 연산 하나를 비트맵 셋과 기준 셋에 모두 수행하고 결과가 같은지 확인한다.
+// 후속자/선행자를 찾았으면 키와 처음 달라지는 레벨을 crossed에 센다.
+bool ApplyBitmapOperation(BitmapSet& set, std::set<int>& reference, FuzzOperation operation, int key, Int64* crossed) {
+	switch (operation) {
+	case FuzzOperation::Insert:
+		return set.Insert(key) == reference.insert(key).second;
+	case FuzzOperation::Remove:
+		return set.Remove(key) == (reference.erase(key) != 0);
+	case FuzzOperation::Search:
+		return set.Search(key) == (reference.find(key) != reference.end());
+	case FuzzOperation::LowerBound: {
+		auto it = set.LowerBound(key);
+		const auto referenceIt = reference.lower_bound(key);
+
+		if (referenceIt == reference.end()) {
+			return !it.HasNext();
+		}
+
+		return it.HasNext() && it.Current() == *referenceIt;
+	}
+	case FuzzOperation::Successor: {
+		// UpperBound 반복자도 같은 위치여야 한다.
+		Int32 iFound;
+		const bool bFound = set.Successor(key, iFound);
+		const auto referenceIt = reference.upper_bound(key);
+		auto it = set.UpperBound(key);
+
+		if (referenceIt == reference.end()) {
+			return !bFound && !it.HasNext();
+		}
+
+		if (!bFound || iFound != *referenceIt || !it.HasNext() || it.Current() != iFound) {
+			return false;
+		}
+
+		++crossed[CrossedLevel(key, iFound)];
+		return true;
+	}
+	case FuzzOperation::Predecessor: {
+		Int32 iFound;
+		const bool bFound = set.Predecessor(key, iFound);
+		auto referenceIt = reference.lower_bound(key);
+
+		if (referenceIt == reference.begin()) {
+			return !bFound;
+		}
+
+		if (!bFound || iFound != *--referenceIt) {
+			return false;
+		}
+
+		++crossed[CrossedLevel(key, iFound)];
+		return true;
+	}
+	case FuzzOperation::Scan: {
+		// LowerBound 위치부터 Next로 ScanRange개를 읽고, 다시 같은 위치부터 Previous로 ScanRange개를 읽는다.
+		auto it = set.LowerBound(key);
+		const auto referenceBegin = reference.lower_bound(key);
+		auto referenceIt = referenceBegin;
+
+		for (int i = 0; i < ScanRange && referenceIt != reference.end(); ++i, ++referenceIt) {
+			if (!it.HasNext() || it.Next() != *referenceIt) {
+				return false;
+			}
+		}
+
+		if (referenceIt == reference.end() && it.HasNext()) {
+			return false;
+		}
+
+		it = set.LowerBound(key);
+		if (referenceBegin == reference.end()) {
+			return !it.HasNext();
+		}
+
+		referenceIt = referenceBegin;
+		for (int i = 0; i < ScanRange; ++i, --referenceIt) {
+			if (!it.HasNext() || it.Previous() != *referenceIt) {
+				return false;
+			}
+
+			if (referenceIt == reference.begin()) {
+				return !it.HasNext();
+			}
+		}
+
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+// ForEach, Begin부터 Next, Last부터 Previous 순회가 모두 기준 셋과 같은지 확인한다.
+bool EqualsBitmapReference(const BitmapSet& set, const std::set<int>& reference) {
+	if (!EqualsReference(set, reference)) {
+		return false;
+	}
+
+	auto it = set.Begin();
+	for (auto referenceIt = reference.begin(); referenceIt != reference.end(); ++referenceIt) {
+		if (!it.HasNext() || it.Next() != *referenceIt) {
+			return false;
+		}
+	}
+
+	auto reverseIt = set.Last();
+	for (auto referenceIt = reference.rbegin(); referenceIt != reference.rend(); ++referenceIt) {
+		if (!reverseIt.HasNext() || reverseIt.Previous() != *referenceIt) {
+			return false;
+		}
+	}
+
+	return !it.HasNext() && !reverseIt.HasNext();
+}
+
+bool FuzzBitmapSet(const char* name, int operationCount) {
+	BitmapSet set;
+	std::set<int> reference;
+	FuzzHistory history;
+	Int64 iValidateCount = 0;
+	Int64 iCrossed[BitmapNode::LevelCount]{};		// 후속자/선행자가 키와 처음 달라진 레벨별 횟수
+	const int iRoundCount = sizeof(KeyRanges) / sizeof(KeyRanges[0]) + 1;		// 마지막 라운드는 경계 키
+	const int iRoundOperationCount = Math::Max(operationCount / iRoundCount, 2);
+
+	for (int iRound = 0; iRound < iRoundCount; ++iRound) {
+		const int iKeyRange = iRound < iRoundCount - 1 ? KeyRanges[iRound] : 0;
+		int iSinceValidate = 0;
+
+		for (int i = 0; i < iRoundOperationCount; ++i) {
+			const FuzzOperation eOperation = GenerateBitmapOperation(i < iRoundOperationCount / 2);
+			const int iKey = GenerateBitmapKey(iKeyRange);
+			history.Add(eOperation, iKey);
+
+			if (!ApplyBitmapOperation(set, reference, eOperation, iKey, iCrossed)) {
+				PrintFailure(name, "기준 셋과 결과가 다릅니다.", iKeyRange, set, history);
+				return false;
+			}
+
+			if (++iSinceValidate < set.Size() / ValidateCostRatio) {
+				continue;
+			}
+
+			iSinceValidate = 0;
+			++iValidateCount;
+
+			const TreeValidateError eError = set.Validate();
+			if (eError != TreeValidateError::None) {
+				PrintFailure(name, TreeValidateErrorName(eError), iKeyRange, set, history);
+				return false;
+			}
+		}
+
+		if (!EqualsBitmapReference(set, reference)) {
+			PrintFailure(name, "순회 결과가 기준 셋과 다릅니다.", iKeyRange, set, history);
+			return false;
+		}
+
+		set.Clear();
+		reference.clear();
+	}
+
+	bool bCovered = true;
+	for (int iLevel = 0; iLevel < BitmapNode::LeafLevel; ++iLevel) {
+		bCovered &= iCrossed[iLevel] > 0;
+	}
+
+	Console::WriteLine("[%s] %s (연산 수: %lld, 검증 횟수: %lld, 후속자/선행자가 넘어간 레벨 0/1/2/3/4/같은 리프: %lld/%lld/%lld/%lld/%lld/%lld)",
+		name, bCovered ? "통과" : "실패: 넘어가 보지 못한 레벨 경계가 있습니다.", history.Count(), iValidateCount,
+		iCrossed[0], iCrossed[1], iCrossed[2], iCrossed[3], iCrossed[4], iCrossed[5]
+	);
+	return bCovered;
+}
+
+int main(int argc, char** argv) {
+	const int iOperationCount = argc > 1 ? atoi(argv[1]) : DefaultOperationCount;
+	bool bPassed = true;
+
+	bPassed &= FuzzSet<TreeSet<int, RedBlackBalancer>>("TreeSet(RedBlack)", iOperationCount);
+	bPassed &= FuzzSet<TreeSet<int, AvlBalancer>>("TreeSet(AVL)", iOperationCount);
+	bPassed &= FuzzSet<TreeSet<int, WavlBalancer>>("TreeSet(WAVL)", iOperationCount);
+	bPassed &= FuzzSet<TreapSet<int>>("TreapSet", iOperationCount);
+	bPassed &= FuzzTreapMerge("TreapSet<String> Union/Difference", iOperationCount);
+	bPassed &= FuzzRadixTreeMap<int>("RadixTreeMap<int>", iOperationCount, true);
+	bPassed &= FuzzRadixTreeMap<String>("RadixTreeMap<String>", iOperationCount, false);
+	bPassed &= FuzzBitmapSet("BitmapSet", iOperationCount);
+	bPassed &= FuzzHashMap("HashMap(점진적 재해쉬)", iOperationCount);
+	bPassed &= FuzzFlatHashMap<int>("FlatHashMap(삽입/삭제 반복)", iOperationCount);
+	bPassed &= FuzzFlatHashMap<ClusteredKey>("FlatHashMap<ClusteredKey>(삽입/삭제 반복)", iOperationCount);
+
+	return bPassed ? 0 : 1;
+}
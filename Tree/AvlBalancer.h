@@ -0,0 +1,118 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * AVL 트리 균형 정책
+ * 모든 노드에서 좌/우 서브트리 높이 차이가 1 이하가 되도록 유지한다.
+ * 레드블랙트리보다 트리가 낮게 유지되므로 탐색 위주 작업에 유리하지만 회전이 더 잦다.
+ *
+ * 노드가 트리에서 떨어진 후 삭제된 노드의 부모부터 루트 방향으로 높이를 갱신하며(Retrace)
+ * 균형이 깨진 노드를 회전시킨다. 서브트리 높이가 변하지 않으면 더 올라갈 필요가 없다.
+ */
+
+#pragma once
+
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Primitives/String.h>
+#include <JCore/Math.h>
+
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+struct AvlNodeTag
+{
+	int Height = 1;		// 리프노드의 높이가 1, 없는 노드의 높이는 0
+};
+
+struct AvlBalancer
+{
+	using TNodeTag = AvlNodeTag;
+
+	template <typename TTree, typename TNode>
+	static void InsertFixup(TTree& tree, TNode* child) {
+		Retrace(tree, child->Parent);
+	}
+
+	// AVL은 노드가 떨어진 후에 높이를 다시 계산한다.
+	template <typename TTree, typename TNode>
+	static void RemoveFixup(TTree&, TNode*) {}
+
+	template <typename TTree, typename TNode>
+	static void RemoveRetrace(TTree& tree, TNode* parent) {
+		Retrace(tree, parent);
+	}
+
+	template <typename TNode>
+	static void BuildNode(TNode* node, int height, bool) {
+		node->Height = height;
+	}
+
+	// 저장된 높이가 정확하고 좌/우 높이 차이가 1 이하인지 확인한다.
+	template <typename TNode>
+	static bool ValidateNode(const TNode* node, int leftHeight, int rightHeight, JCORE_OUT int& height) {
+		if (node->Height != Math::Max(leftHeight, rightHeight) + 1 || Math::Abs(leftHeight - rightHeight) > 1) {
+			return false;
+		}
+
+		height = node->Height;
+		return true;
+	}
+
+	template <typename TNode>
+	static String DbgNodeTagString(const TNode* node) {
+		return StringUtil::Format("H%d", node->Height);
+	}
+private:
+	template <typename TNode>
+	static int Height(const TNode* node) { return node ? node->Height : 0; }
+
+	template <typename TNode>
+	static int BalanceFactor(const TNode* node) { return Height(node->Left) - Height(node->Right); }
+
+	template <typename TNode>
+	static void UpdateHeight(TNode* node) {
+		if (node) node->Height = Math::Max(Height(node->Left), Height(node->Right)) + 1;
+	}
+
+	// node를 루트로하는 서브트리의 균형을 맞추고 새로운 서브트리 루트를 반환한다.
+	template <typename TTree, typename TNode>
+	static TNode* Rebalance(TTree& tree, TNode* node) {
+		const int iBalance = BalanceFactor(node);
+		TreeNodeRotateMode eMode;
+
+		if (iBalance > 1) {
+			eMode = BalanceFactor(node->Left) < 0 ? TreeNodeRotateMode::LR : TreeNodeRotateMode::LL;
+		} else if (iBalance < -1) {
+			eMode = BalanceFactor(node->Right) > 0 ? TreeNodeRotateMode::RL : TreeNodeRotateMode::RR;
+		} else {
+			UpdateHeight(node);
+			return node;
+		}
+
+		// 회전 후 새로운 서브트리 루트의 두 자식은 원래 서브트리들을 그대로 물고있으므로
+		// 두 자식 -> 루트 순으로만 높이를 갱신해주면 된다.
+		tree.RotateNode(node, eMode);
+		TNode* pNewRoot = node->Parent;
+		UpdateHeight(pNewRoot->Left);
+		UpdateHeight(pNewRoot->Right);
+		UpdateHeight(pNewRoot);
+		return pNewRoot;
+	}
+
+	template <typename TTree, typename TNode>
+	static void Retrace(TTree& tree, TNode* node) {
+		while (node) {
+			const int iPrevHeight = node->Height;
+			node = Rebalance(tree, node);
+
+			// 서브트리 높이가 그대로면 조상들의 균형도 그대로다.
+			if (node->Height == iPrevHeight) {
+				return;
+			}
+
+			node = node->Parent;
+		}
+	}
+};
+
+NS_JC_END
@@ -0,0 +1,188 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 비트맵 계층 노드
+ * 32비트 키를 상위 비트부터 6비트씩 잘라서 64갈래 트리의 인덱스로 사용한다.
+ *
+ *  레벨   0     1     2     3     4     5
+ *  비트 31~30 29~24 23~18 17~12 11~6  5~0
+ *
+ * 내부 노드의 Bitmap은 비어있지 않은 자식의 위치를, 리프(레벨 5) 노드의 Bitmap은 키 자체를 나타낸다.
+ * 자식 배열은 64칸을 다 잡지 않고 비어있지 않은 자식만 인덱스 순서대로 압축해서 저장한다.
+ * 인덱스 i 자식의 배열 위치는 i 미만 비트의 PopCount이다.
+ *
+ * 한 레벨에서 다음/이전 자식을 찾는 것이 비트 연산 한번이므로 후속자/선행자 탐색이 최대 6레벨 안에 끝난다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Bit.h>
+#include <JCore/Memory.h>
+
+NS_JC_BEGIN
+
+struct BitmapNode
+{
+	static constexpr int LevelCount = 6;
+	static constexpr int LeafLevel = LevelCount - 1;
+	static constexpr int BitsPerLevel = 6;
+
+	BitmapNode() : Bitmap(0), Children(nullptr), Capacity(0) {}
+	BitmapNode(const BitmapNode&) = delete;
+	~BitmapNode() { delete[] Children; }
+
+	BitmapNode& operator=(const BitmapNode&) = delete;
+
+	static constexpr int Shift(int level) { return (LeafLevel - level) * BitsPerLevel; }
+	static constexpr int Index(Int32U key, int level) { return int(key >> Shift(level)) & 63; }
+
+	// level 노드에서 인덱스를 제외한 상위 비트만 남긴다. (루트는 상위 비트가 없다)
+	static constexpr Int32U HighBits(Int32U key, int level) {
+		return level == 0 ? 0 : key & ~((Int32U(1) << (Shift(level) + BitsPerLevel)) - 1);
+	}
+
+	// 부호 비트를 뒤집어서 Int32의 대소관계가 Int32U에서도 유지되도록 한다.
+	static constexpr Int32U ToKey(Int32 data) { return Int32U(data) ^ 0x80000000u; }
+	static constexpr Int32 ToData(Int32U key) { return Int32(key ^ 0x80000000u); }
+
+	bool Has(int idx) const { return (Bitmap & Bit64(idx)) != 0; }
+	int Rank(int idx) const { return PopCount64(Bitmap & BitMaskBelow64(idx)); }
+	BitmapNode* Child(int idx) const { return Children[Rank(idx)]; }
+
+	BitmapNode* AddChild(int idx) {
+		const int iCount = PopCount64(Bitmap);
+		const int iRank = Rank(idx);
+
+		if (iCount == Capacity) {
+			const int iNewCapacity = Capacity == 0 ? 2 : Capacity * 2;
+			BitmapNode** pNewChildren = dbg_new BitmapNode*[iNewCapacity];
+			if (Children != nullptr) {
+				Memory::CopyUnsafe(pNewChildren, Children, sizeof(BitmapNode*) * iCount);
+				delete[] Children;
+			}
+			Children = pNewChildren;
+			Capacity = iNewCapacity;
+		}
+
+		for (int i = iCount; i > iRank; --i) {
+			Children[i] = Children[i - 1];
+		}
+
+		BitmapNode* pChild = dbg_new BitmapNode;
+		Children[iRank] = pChild;
+		Bitmap |= Bit64(idx);
+		return pChild;
+	}
+
+	void RemoveChild(int idx) {
+		const int iCount = PopCount64(Bitmap);
+		const int iRank = Rank(idx);
+		delete Children[iRank];
+
+		for (int i = iRank; i < iCount - 1; ++i) {
+			Children[i] = Children[i + 1];
+		}
+
+		Bitmap &= ~Bit64(idx);
+
+		if (Bitmap == 0) {
+			delete[] Children;
+			Children = nullptr;
+			Capacity = 0;
+		}
+	}
+
+	// 자식 노드를 재귀적으로 모두 삭제한다. (자신은 삭제하지 않음)
+	void DeleteChildren(int level) {
+		if (level < LeafLevel) {
+			const int iCount = PopCount64(Bitmap);
+			for (int i = 0; i < iCount; ++i) {
+				Children[i]->DeleteChildren(level + 1);
+				delete Children[i];
+			}
+		}
+
+		delete[] Children;
+		Children = nullptr;
+		Capacity = 0;
+		Bitmap = 0;
+	}
+
+	// 서브트리의 가장 작은 키 (base: 상위 레벨에서 결정된 비트)
+	Int32U Minimum(int level, Int32U base) const {
+		const BitmapNode* pCur = this;
+
+		for (; level < LeafLevel; ++level) {
+			base |= Int32U(CountTrailingZero64(pCur->Bitmap)) << Shift(level);
+			pCur = pCur->Children[0];
+		}
+
+		return base | Int32U(CountTrailingZero64(pCur->Bitmap));
+	}
+
+	// 서브트리의 가장 큰 키
+	Int32U Maximum(int level, Int32U base) const {
+		const BitmapNode* pCur = this;
+
+		for (; level < LeafLevel; ++level) {
+			base |= Int32U(63 - CountLeadingZero64(pCur->Bitmap)) << Shift(level);
+			pCur = pCur->Children[PopCount64(pCur->Bitmap) - 1];
+		}
+
+		return base | Int32U(63 - CountLeadingZero64(pCur->Bitmap));
+	}
+
+	// key 이상인 가장 작은 키를 found에 담는다.
+	// 같은 인덱스의 자식에서 못찾으면 이 레벨에서 다음 비트를 찾아 그 서브트리의 최솟값을 취한다.
+	bool FindAtLeast(int level, Int32U key, Int32U& found) const {
+		const int iIndex = Index(key, level);
+
+		if (level == LeafLevel) {
+			const Int64U uiMask = Bitmap & BitMaskFrom64(iIndex);
+			if (uiMask == 0) return false;
+			found = HighBits(key, level) | Int32U(CountTrailingZero64(uiMask));
+			return true;
+		}
+
+		if (Has(iIndex) && Child(iIndex)->FindAtLeast(level + 1, key, found)) {
+			return true;
+		}
+
+		const Int64U uiMask = Bitmap & BitMaskFrom64(iIndex + 1);
+		if (uiMask == 0) return false;
+
+		const int iNext = CountTrailingZero64(uiMask);
+		found = Child(iNext)->Minimum(level + 1, HighBits(key, level) | (Int32U(iNext) << Shift(level)));
+		return true;
+	}
+
+	// key 이하인 가장 큰 키를 found에 담는다.
+	bool FindAtMost(int level, Int32U key, Int32U& found) const {
+		const int iIndex = Index(key, level);
+
+		if (level == LeafLevel) {
+			const Int64U uiMask = Bitmap & BitMaskBelow64(iIndex + 1);
+			if (uiMask == 0) return false;
+			found = HighBits(key, level) | Int32U(63 - CountLeadingZero64(uiMask));
+			return true;
+		}
+
+		if (Has(iIndex) && Child(iIndex)->FindAtMost(level + 1, key, found)) {
+			return true;
+		}
+
+		const Int64U uiMask = Bitmap & BitMaskBelow64(iIndex);
+		if (uiMask == 0) return false;
+
+		const int iPrev = 63 - CountLeadingZero64(uiMask);
+		found = Child(iPrev)->Maximum(level + 1, HighBits(key, level) | (Int32U(iPrev) << Shift(level)));
+		return true;
+	}
+
+	Int64U Bitmap;
+	BitmapNode** Children;
+	int Capacity;
+};
+
+NS_JC_END
@@ -0,0 +1,237 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 비트맵 계층 기반 Int32 정렬 셋
+ * 트리셋은 탐색 한번에 O(log n)개의 노드를 비교하면서 내려가지만
+ * 비트맵 셋은 키 비트를 그대로 인덱스로 쓰므로 데이터 수와 무관하게 최대 6레벨만 내려간다.
+ * 후속자/선행자도 각 레벨에서 다음 1 비트를 찾는 비트 연산으로 끝나서 O(log64 U)이다.
+ *
+ * 트리셋과 같은 질의 함수를 제공한다. (Insert, Remove, Search, Begin, Last, LowerBound, UpperBound, ForEach, Size)
+ * 추가로 반복자 없이 바로 쓸 수 있는 Successor/Predecessor를 제공한다.
+ */
+
+#pragma once
+
+#include "BitmapNode.h"
+#include "BitmapSetIterator.h"
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+class BitmapSet
+{
+public:
+	using TIterator = BitmapSetIterator;
+
+	BitmapSet() : m_iSize(0) {}
+	BitmapSet(const BitmapSet&) = delete;
+	~BitmapSet() { Clear(); }
+
+	BitmapSet& operator=(const BitmapSet&) = delete;
+
+	// 이미 있는 데이터면 false를 반환한다.
+	bool Insert(Int32 data) {
+		const Int32U uiKey = BitmapNode::ToKey(data);
+		BitmapNode* pCur = &m_Root;
+
+		for (int iLevel = 0; iLevel < BitmapNode::LeafLevel; ++iLevel) {
+			const int iIndex = BitmapNode::Index(uiKey, iLevel);
+			pCur = pCur->Has(iIndex) ? pCur->Child(iIndex) : pCur->AddChild(iIndex);
+		}
+
+		const Int64U uiBit = Bit64(BitmapNode::Index(uiKey, BitmapNode::LeafLevel));
+
+		if (pCur->Bitmap & uiBit) {
+			return false;
+		}
+
+		pCur->Bitmap |= uiBit;
+		++m_iSize;
+		return true;
+	}
+
+	bool Remove(Int32 data) {
+		const Int32U uiKey = BitmapNode::ToKey(data);
+		BitmapNode* pPath[BitmapNode::LevelCount];
+		BitmapNode* pCur = &m_Root;
+
+		for (int iLevel = 0; iLevel < BitmapNode::LeafLevel; ++iLevel) {
+			const int iIndex = BitmapNode::Index(uiKey, iLevel);
+
+			if (!pCur->Has(iIndex)) {
+				return false;
+			}
+
+			pPath[iLevel] = pCur;
+			pCur = pCur->Child(iIndex);
+		}
+
+		const Int64U uiBit = Bit64(BitmapNode::Index(uiKey, BitmapNode::LeafLevel));
+
+		if ((pCur->Bitmap & uiBit) == 0) {
+			return false;
+		}
+
+		pCur->Bitmap &= ~uiBit;
+		--m_iSize;
+
+		// 비어버린 노드를 부모에서 떼어낸다. 루트는 항상 유지한다.
+		for (int iLevel = BitmapNode::LeafLevel - 1; iLevel >= 0 && pCur->Bitmap == 0; --iLevel) {
+			pCur = pPath[iLevel];
+			pCur->RemoveChild(BitmapNode::Index(uiKey, iLevel));
+		}
+
+		return true;
+	}
+
+	bool Search(Int32 data) const {
+		const Int32U uiKey = BitmapNode::ToKey(data);
+		const BitmapNode* pCur = &m_Root;
+
+		for (int iLevel = 0; iLevel < BitmapNode::LeafLevel; ++iLevel) {
+			const int iIndex = BitmapNode::Index(uiKey, iLevel);
+
+			if (!pCur->Has(iIndex)) {
+				return false;
+			}
+
+			pCur = pCur->Child(iIndex);
+		}
+
+		return pCur->Has(BitmapNode::Index(uiKey, BitmapNode::LeafLevel));
+	}
+
+	// data 초과인 가장 작은 데이터
+	bool Successor(Int32 data, Int32& successor) const {
+		const Int32U uiKey = BitmapNode::ToKey(data);
+		Int32U uiFound;
+
+		if (uiKey == MaxInt32U_v || !m_Root.FindAtLeast(0, uiKey + 1, uiFound)) {
+			return false;
+		}
+
+		successor = BitmapNode::ToData(uiFound);
+		return true;
+	}
+
+	// data 미만인 가장 큰 데이터
+	bool Predecessor(Int32 data, Int32& predecessor) const {
+		const Int32U uiKey = BitmapNode::ToKey(data);
+		Int32U uiFound;
+
+		if (uiKey == 0 || !m_Root.FindAtMost(0, uiKey - 1, uiFound)) {
+			return false;
+		}
+
+		predecessor = BitmapNode::ToData(uiFound);
+		return true;
+	}
+
+	void Clear() {
+		m_Root.DeleteChildren(0);
+		m_iSize = 0;
+	}
+
+	int Size() const { return m_iSize; }
+	bool IsEmpty() const { return m_iSize == 0; }
+
+	TIterator Begin() const {
+		if (m_iSize == 0) return TIterator();
+		return TIterator(&m_Root, m_Root.Minimum(0, 0));
+	}
+
+	TIterator Last() const {
+		if (m_iSize == 0) return TIterator();
+		return TIterator(&m_Root, m_Root.Maximum(0, 0));
+	}
+
+	// data 이상인 첫번째 데이터 위치
+	TIterator LowerBound(Int32 data) const {
+		Int32U uiFound;
+
+		if (!m_Root.FindAtLeast(0, BitmapNode::ToKey(data), uiFound)) {
+			return TIterator();
+		}
+
+		return TIterator(&m_Root, uiFound);
+	}
+
+	// data 초과인 첫번째 데이터 위치
+	TIterator UpperBound(Int32 data) const {
+		Int32 iFound;
+
+		if (!Successor(data, iFound)) {
+			return TIterator();
+		}
+
+		return TIterator(&m_Root, BitmapNode::ToKey(iFound));
+	}
+
+	// 오름차순 순회
+	// 반복자로 순회하면 매번 루트부터 내려가므로 여기서는 리프 비트맵을 한번에 훑는다.
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		ForEachRecursive(&m_Root, 0, 0, consumer);
+	}
+
+	// 루트가 아닌 빈 노드가 남아있지 않은지, 자식 배열이 비트맵과 맞는지, 리프 비트 수가 크기와 같은지 확인한다. O(노드 수)
+	TreeValidateError Validate() const {
+		int iCount = 0;
+
+		if (!ValidateRecursive(&m_Root, 0, iCount)) {
+			return TreeValidateError::Structure;
+		}
+
+		return iCount == m_iSize ? TreeValidateError::None : TreeValidateError::Size;
+	}
+private:
+	static bool ValidateRecursive(const BitmapNode* node, int level, int& count) {
+		const int iCount = PopCount64(node->Bitmap);
+
+		if (level == BitmapNode::LeafLevel) {
+			count += iCount;
+			return iCount > 0 && node->Children == nullptr;
+		}
+
+		// 루트만 비어있을 수 있고, 비어있으면 자식 배열도 없어야 한다.
+		if (iCount == 0) {
+			return level == 0 && node->Children == nullptr && node->Capacity == 0;
+		}
+
+		if (node->Children == nullptr || node->Capacity < iCount) {
+			return false;
+		}
+
+		for (int i = 0; i < iCount; ++i) {
+			if (!ValidateRecursive(node->Children[i], level + 1, count)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename Consumer>
+	static void ForEachRecursive(const BitmapNode* node, int level, Int32U base, Consumer& consumer) {
+		Int64U uiBitmap = node->Bitmap;
+
+		if (level == BitmapNode::LeafLevel) {
+			while (uiBitmap != 0) {
+				consumer(BitmapNode::ToData(base | Int32U(CountTrailingZero64(uiBitmap))));
+				uiBitmap &= uiBitmap - 1;
+			}
+			return;
+		}
+
+		for (int i = 0; uiBitmap != 0; ++i) {
+			const int iIndex = CountTrailingZero64(uiBitmap);
+			ForEachRecursive(node->Children[i], level + 1, base | (Int32U(iIndex) << BitmapNode::Shift(level)), consumer);
+			uiBitmap &= uiBitmap - 1;
+		}
+	}
+
+	BitmapNode m_Root;
+	int m_iSize;
+};
+
+NS_JC_END
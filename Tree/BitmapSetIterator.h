@@ -0,0 +1,62 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 비트맵 셋 순회 반복자
+ * 노드 대신 현재 키를 들고 다니고 이동할 때마다 루트에서 후속자/선행자를 다시 찾는다.
+ * 탐색이 최대 6레벨이라 트리셋 반복자와 사용법은 같지만 부모 링크가 필요없다.
+ */
+
+#pragma once
+
+#include "BitmapNode.h"
+
+NS_JC_BEGIN
+
+class BitmapSetIterator
+{
+public:
+	BitmapSetIterator() : m_pRoot(nullptr), m_uiCurrent(0) {}
+	BitmapSetIterator(const BitmapNode* root, Int32U current) : m_pRoot(root), m_uiCurrent(current) {}
+
+	bool HasNext() const { return m_pRoot != nullptr; }
+	bool IsEnd() const { return m_pRoot == nullptr; }
+
+	Int32 Current() const {
+		DebugAssertMsg(m_pRoot, "반복자가 끝에 도달했습니다.");
+		return BitmapNode::ToData(m_uiCurrent);
+	}
+
+	// 현재 데이터를 반환하고 다음 데이터로 이동
+	Int32 Next() {
+		DebugAssertMsg(m_pRoot, "반복자가 끝에 도달했습니다.");
+		const Int32U uiCur = m_uiCurrent;
+
+		if (uiCur == MaxInt32U_v || !m_pRoot->FindAtLeast(0, uiCur + 1, m_uiCurrent)) {
+			m_pRoot = nullptr;
+		}
+
+		return BitmapNode::ToData(uiCur);
+	}
+
+	// 현재 데이터를 반환하고 이전 데이터로 이동
+	Int32 Previous() {
+		DebugAssertMsg(m_pRoot, "반복자가 끝에 도달했습니다.");
+		const Int32U uiCur = m_uiCurrent;
+
+		if (uiCur == 0 || !m_pRoot->FindAtMost(0, uiCur - 1, m_uiCurrent)) {
+			m_pRoot = nullptr;
+		}
+
+		return BitmapNode::ToData(uiCur);
+	}
+
+	bool operator==(const BitmapSetIterator& other) const {
+		return m_pRoot == other.m_pRoot && (m_pRoot == nullptr || m_uiCurrent == other.m_uiCurrent);
+	}
+	bool operator!=(const BitmapSetIterator& other) const { return !(*this == other); }
+private:
+	const BitmapNode* m_pRoot;		// 끝에 도달하면 nullptr
+	Int32U m_uiCurrent;
+};
+
+NS_JC_END
@@ -0,0 +1,353 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 락프리 동시성 스킵리스트 셋
+ * 전역 락 없이 여러 쓰레드가 동시에 삽입/삭제/탐색할 수 있는 정렬 셋이다.
+ * Herlihy & Shavit의 LockFreeSkipList를 바탕으로 하고 노드 회수는 EpochReclaimer에 맡긴다.
+ *
+ *  - 삽입: 최하위 레벨에 CAS로 연결되는 순간 셋에 들어간 것으로 본다. 상위 레벨은 그 뒤에 하나씩 연결한다.
+ *  - 삭제: 상위 레벨부터 다음 포인터에 삭제 표시를 하고 최하위 레벨에 표시하는 순간 셋에서 빠진 것으로 본다.
+ *          표시된 노드의 물리적인 연결 해제는 이후 탐색하는 쓰레드들이 지나가면서 돕는다.
+ *  - 회수: 삭제 쓰레드가 표시를 끝냈을 때 삽입 쓰레드가 아직 상위 레벨을 연결하는 중일 수 있다.
+ *          둘 다 손을 뗀 뒤 마지막 쓰레드가 모든 레벨에서 연결을 끊고 Retire 한다.
+ *  - 탐색: 헤드의 모든 레벨이 아니라 지금까지 쓰인 가장 높은 레벨부터 내려간다. 삽입 쓰레드는 노드를 연결하기 전에 이 값을 올려둔다.
+ *
+ * 트리셋과 같은 이름의 함수를 제공한다. (Insert, Remove, Search, Begin, LowerBound, UpperBound, ForEach, Size)
+ * 순회는 약한 일관성을 가진다. (ConcurrentSkipListSetIterator.h 참고)
+ * Clear와 소멸자는 다른 쓰레드가 접근하지 않을 때만 호출해야 한다.
+ */
+
+#pragma once
+
+#include <JCore/Bit.h>
+#include <JCore/Math.h>
+
+#include "SkipListNode.h"
+#include "EpochReclaimer.h"
+#include "ConcurrentSkipListSetIterator.h"
+
+NS_JC_BEGIN
+
+template <typename T>
+class ConcurrentSkipListSet
+{
+	using TNode						= SkipListNode<T>;
+	using TConcurrentSkipListSet	= ConcurrentSkipListSet<T>;
+public:
+	using TIterator					= ConcurrentSkipListSetIterator<T>;
+
+	static constexpr int MaxHeight = 32;		// 레벨이 올라갈 확률 1/2 기준으로 약 40억개까지 O(log n) 유지
+
+	ConcurrentSkipListSet() : m_iLevelCount(1), m_iSize(0) {}
+	ConcurrentSkipListSet(const TConcurrentSkipListSet&) = delete;
+	~ConcurrentSkipListSet() { Clear(); }
+
+	TConcurrentSkipListSet& operator=(const TConcurrentSkipListSet&) = delete;
+
+	// 이미 있는 데이터면 false를 반환한다.
+	bool Insert(const T& data) {
+		EpochGuard guard;
+		TNode* pPreds[MaxHeight];
+		TNode* pSuccs[MaxHeight];
+		const int iHeight = RandomHeight();
+		TNode* pNewNode = nullptr;
+
+		RaiseLevelCount(iHeight);
+
+		for (;;) {
+			if (Find(data, pPreds, pSuccs)) {
+				if (pNewNode != nullptr) {
+					TNode::Destroy(pNewNode);
+				}
+				return false;
+			}
+
+			if (pNewNode == nullptr) {
+				pNewNode = TNode::Create(data, iHeight);
+			}
+
+			for (int i = 0; i < iHeight; ++i) {
+				pNewNode->Next[i].Store(pSuccs[i]);
+			}
+
+			TNode* pExpected = pSuccs[0];
+			if (NextOf(pPreds[0], 0).CompareExchange(pExpected, pNewNode)) {
+				break;
+			}
+		}
+
+		++m_iSize;
+		LinkUpperLevels(pNewNode, pPreds, pSuccs);
+		Release(pNewNode);
+		return true;
+	}
+
+	bool Remove(const T& data) {
+		EpochGuard guard;
+		TNode* pPreds[MaxHeight];
+		TNode* pSuccs[MaxHeight];
+
+		if (!Find(data, pPreds, pSuccs)) {
+			return false;
+		}
+
+		TNode* pVictim = pSuccs[0];
+
+		// 상위 레벨부터 표시해서 더이상 상위 레벨로 이 노드에 새로 도달하지 못하게 한다.
+		for (int i = pVictim->Height - 1; i >= 1; --i) {
+			TNode* pSucc = pVictim->Next[i].LoadAcquire();
+
+			while (!TNode::IsMarked(pSucc)) {
+				pVictim->Next[i].CompareExchange(pSucc, TNode::Mark(pSucc));
+			}
+		}
+
+		TNode* pSucc = pVictim->Next[0].LoadAcquire();
+
+		for (;;) {
+			if (TNode::IsMarked(pSucc)) {
+				// 다른 쓰레드가 먼저 삭제했다.
+				return false;
+			}
+
+			if (pVictim->Next[0].CompareExchange(pSucc, TNode::Mark(pSucc))) {
+				break;
+			}
+		}
+
+		--m_iSize;
+		Find(data, pPreds, pSuccs);
+		Release(pVictim);
+		return true;
+	}
+
+	bool Search(const T& data) const {
+		EpochGuard guard;
+		TNode* pCur = FindLowerBound(data);
+		return pCur != nullptr && pCur->Data == data;
+	}
+
+	// 다른 쓰레드가 접근하지 않을 때만 호출할 것
+	void Clear() {
+		TNode* pCur = TNode::Unmark(m_Head[0].LoadAcquire());
+
+		while (pCur != nullptr) {
+			TNode* pNext = TNode::Unmark(pCur->Next[0].LoadAcquire());
+			TNode::Destroy(pCur);
+			pCur = pNext;
+		}
+
+		for (int i = 0; i < MaxHeight; ++i) {
+			m_Head[i].Store(nullptr);
+		}
+
+		m_iLevelCount.Store(1);
+		m_iSize.Store(0);
+	}
+
+	// 동시 수정 중에는 근사값이다.
+	int Size() const { return m_iSize.LoadAcquire(); }
+	bool IsEmpty() const { return Size() == 0; }
+
+	TIterator Begin() const {
+		EpochGuard guard;
+		return TIterator(TNode::Unmark(m_Head[0].LoadAcquire()));
+	}
+
+	// data 이상인 첫번째 데이터 위치
+	TIterator LowerBound(const T& data) const {
+		EpochGuard guard;
+		return TIterator(FindLowerBound(data));
+	}
+
+	// data 초과인 첫번째 데이터 위치
+	TIterator UpperBound(const T& data) const {
+		TIterator it = LowerBound(data);
+
+		if (it.HasNext() && it.Current() == data) {
+			it.Next();
+		}
+
+		return it;
+	}
+
+	// 오름차순 순회 (약한 일관성)
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		TIterator it = Begin();
+
+		while (it.HasNext()) {
+			consumer(it.Next());
+		}
+	}
+private:
+	// pred가 nullptr이면 헤드
+	Atomic<TNode*>& NextOf(TNode* pred, int level) const {
+		return pred == nullptr ? m_Head[level] : pred->Next[level];
+	}
+
+	// 각 레벨에서 data 미만인 마지막 노드(pPreds)와 그 다음 노드(pSuccs)를 찾는다. (m_iLevelCount 미만의 레벨만 채운다)
+	// 지나가는 길에 삭제 표시된 노드를 만나면 연결을 끊는다. 끊기에 실패하면 처음부터 다시 찾는다.
+	bool Find(const T& data, TNode** pPreds, TNode** pSuccs) {
+	Retry:
+		TNode* pPred = nullptr;
+		TNode* pCur = nullptr;
+
+		for (int iLevel = m_iLevelCount.LoadAcquire() - 1; iLevel >= 0; --iLevel) {
+			pCur = TNode::Unmark(NextOf(pPred, iLevel).LoadAcquire());
+
+			while (pCur != nullptr) {
+				TNode* pSucc = pCur->Next[iLevel].LoadAcquire();
+
+				if (TNode::IsMarked(pSucc)) {
+					TNode* pExpected = pCur;
+					if (!NextOf(pPred, iLevel).CompareExchange(pExpected, TNode::Unmark(pSucc))) {
+						goto Retry;
+					}
+
+					pCur = TNode::Unmark(pSucc);
+					continue;
+				}
+
+				if (!(pCur->Data < data)) {
+					break;
+				}
+
+				pPred = pCur;
+				pCur = pSucc;
+			}
+
+			pPreds[iLevel] = pPred;
+			pSuccs[iLevel] = pCur;
+		}
+
+		return pCur != nullptr && pCur->Data == data;
+	}
+
+	// 연결을 끊지 않고 data 이상인 첫번째 살아있는 노드를 찾는다.
+	TNode* FindLowerBound(const T& data) const {
+		TNode* pPred = nullptr;
+		TNode* pCur = nullptr;
+
+		for (int iLevel = m_iLevelCount.LoadAcquire() - 1; iLevel >= 0; --iLevel) {
+			pCur = TNode::Unmark(NextOf(pPred, iLevel).LoadAcquire());
+
+			while (pCur != nullptr) {
+				TNode* pSucc = pCur->Next[iLevel].LoadAcquire();
+
+				if (TNode::IsMarked(pSucc)) {
+					pCur = TNode::Unmark(pSucc);
+					continue;
+				}
+
+				if (!(pCur->Data < data)) {
+					break;
+				}
+
+				pPred = pCur;
+				pCur = pSucc;
+			}
+		}
+
+		return pCur;
+	}
+
+	// 최하위 레벨에 연결된 노드를 나머지 레벨에도 연결한다.
+	// 도중에 삭제 표시가 보이면 더 연결하지 않는다.
+	void LinkUpperLevels(TNode* node, TNode** pPreds, TNode** pSuccs) {
+		for (int iLevel = 1; iLevel < node->Height; ++iLevel) {
+			for (;;) {
+				TNode* pNext = node->Next[iLevel].LoadAcquire();
+
+				if (TNode::IsMarked(pNext)) {
+					return;
+				}
+
+				// 다시 찾은 경우 다음 노드가 바뀌었을 수 있으므로 갱신한 뒤 연결한다.
+				if (pNext != pSuccs[iLevel] && !node->Next[iLevel].CompareExchange(pNext, pSuccs[iLevel])) {
+					continue;
+				}
+
+				TNode* pExpected = pSuccs[iLevel];
+				if (NextOf(pPreds[iLevel], iLevel).CompareExchange(pExpected, node)) {
+					break;
+				}
+
+				if (!Find(node->Data, pPreds, pSuccs) || pSuccs[0] != node) {
+					return;
+				}
+			}
+		}
+	}
+
+	// 노드를 height 레벨까지 연결하기 전에 호출한다. 줄어들지 않으므로 탐색은 이 값 아래의 레벨만 보면 된다.
+	void RaiseLevelCount(int height) {
+		int iLevelCount = m_iLevelCount.LoadAcquire();
+		while (iLevelCount < height && !m_iLevelCount.CompareExchange(iLevelCount, height)) {}
+	}
+
+	// 삽입 쓰레드와 삭제 쓰레드가 각각 한번씩 호출한다. 마지막으로 호출한 쪽이 회수한다.
+	void Release(TNode* node) {
+		if (node->Owners.Decrement() != 0) {
+			return;
+		}
+
+		// 삭제 쓰레드의 Find 이후에 삽입 쓰레드가 상위 레벨을 연결했을 수 있으므로
+		// 같은 데이터를 가진 노드 뒤에 숨어있는 경우까지 포함해서 모든 레벨에서 끊는다.
+		UnlinkMarked(node->Data);
+		EpochReclaimer::Instance().Retire(node, [](void* p) { TNode::Destroy(static_cast<TNode*>(p)); });
+	}
+
+	// 각 레벨에서 data 이하 구간의 표시된 노드를 모두 끊는다.
+	// 같은 데이터끼리의 순서는 레벨마다 다를 수 있으므로 다음 레벨은 data 미만인 마지막 노드(pLess)부터 시작한다.
+	void UnlinkMarked(const T& data) {
+	Retry:
+		TNode* pLess = nullptr;
+
+		for (int iLevel = m_iLevelCount.LoadAcquire() - 1; iLevel >= 0; --iLevel) {
+			TNode* pPred = pLess;
+			TNode* pCur = TNode::Unmark(NextOf(pPred, iLevel).LoadAcquire());
+
+			while (pCur != nullptr) {
+				TNode* pSucc = pCur->Next[iLevel].LoadAcquire();
+
+				if (TNode::IsMarked(pSucc)) {
+					TNode* pExpected = pCur;
+					if (!NextOf(pPred, iLevel).CompareExchange(pExpected, TNode::Unmark(pSucc))) {
+						goto Retry;
+					}
+
+					pCur = TNode::Unmark(pSucc);
+					continue;
+				}
+
+				if (data < pCur->Data) {
+					break;
+				}
+
+				if (pCur->Data < data) {
+					pLess = pCur;
+				}
+
+				pPred = pCur;
+				pCur = pSucc;
+			}
+		}
+	}
+
+	static int RandomHeight() {
+		thread_local Int64U ts_uiSeed = reinterpret_cast<Int64U>(&ts_uiSeed) * 0x9E3779B97F4A7C15ULL | 1;
+		ts_uiSeed ^= ts_uiSeed << 13;
+		ts_uiSeed ^= ts_uiSeed >> 7;
+		ts_uiSeed ^= ts_uiSeed << 17;
+
+		// 최하위 비트부터 연속된 0의 수는 k 이상일 확률이 1/2^k 이므로 그대로 높이로 쓴다.
+		return Math::Min(CountTrailingZero64(ts_uiSeed) + 1, MaxHeight);
+	}
+
+	mutable Atomic<TNode*> m_Head[MaxHeight];
+	mutable Atomic<int> m_iLevelCount;			// 지금까지 쓰인 가장 높은 레벨 + 1
+	mutable Atomic<int> m_iSize;
+};
+
+NS_JC_END
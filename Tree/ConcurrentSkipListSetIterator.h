@@ -0,0 +1,58 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 동시성 스킵리스트 셋 반복자
+ * 최하위 레벨을 따라가며 삭제 표시된 노드를 건너뛴다.
+ * 약한 일관성: 순회 도중 다른 쓰레드의 삽입/삭제는 보일수도 안보일수도 있지만
+ * 순회 시작 전부터 끝까지 계속 있던 데이터는 반드시 한번씩 오름차순으로 보인다.
+ *
+ * 반복자가 살아있는 동안 EpochGuard를 들고 있으므로 노드가 회수되지 않는다.
+ * 대신 그동안 전역 에폭이 전진하지 못하므로 반복자를 오래 들고 있으면 안된다.
+ */
+
+#pragma once
+
+#include "SkipListNode.h"
+#include "EpochReclaimer.h"
+
+NS_JC_BEGIN
+
+template <typename T>
+class ConcurrentSkipListSetIterator
+{
+	using TNode = SkipListNode<T>;
+public:
+	ConcurrentSkipListSetIterator(TNode* current = nullptr) : m_pCurrent(SkipRemoved(current)) {}
+
+	bool HasNext() const { return m_pCurrent != nullptr; }
+	bool IsEnd() const { return m_pCurrent == nullptr; }
+
+	const T& Current() const {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		return m_pCurrent->Data;
+	}
+
+	// 현재 데이터를 반환하고 다음 노드로 이동
+	const T& Next() {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		TNode* pCur = m_pCurrent;
+		m_pCurrent = SkipRemoved(TNode::Unmark(pCur->Next[0].LoadAcquire()));
+		return pCur->Data;
+	}
+
+	bool operator==(const ConcurrentSkipListSetIterator& other) const { return m_pCurrent == other.m_pCurrent; }
+	bool operator!=(const ConcurrentSkipListSetIterator& other) const { return m_pCurrent != other.m_pCurrent; }
+private:
+	static TNode* SkipRemoved(TNode* node) {
+		while (node != nullptr && node->IsRemoved()) {
+			node = TNode::Unmark(node->Next[0].LoadAcquire());
+		}
+
+		return node;
+	}
+
+	EpochGuard m_Guard;
+	TNode* m_pCurrent;
+};
+
+NS_JC_END
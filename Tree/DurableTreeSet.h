@@ -0,0 +1,377 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 재시작해도 유지되는 트리셋 (선행 기록 로그 + 체크포인트)
+ * 변경할 때마다 전체를 덤프하지 않고 Insert/Remove 연산만 로그 파일 끝에 덧붙인다.
+ * 로그가 커지면 트리 전체를 정렬된 이진 형식(TreeSet::Serialize)으로 체크포인트에 기록하고 로그를 비운다.
+ *
+ *  <path>.checkpoint      마지막 체크포인트 (세대 헤더 + TreeSerializer.h 형식)
+ *  <path>.checkpoint.tmp  체크포인트를 쓰는 중인 파일 (다 쓰고 fsync한 후 DurableFile::Replace로 .checkpoint를 원자적으로 교체)
+ *  <path>.wal             체크포인트 이후 연산 로그
+ *
+ * [그룹 커밋]
+ * 연산은 메모리 버퍼에 모아두었다가 GroupCommitCount개가 모이면(또는 Commit() 호출시) 한 프레임으로 한번에 쓰고 fsync한다.
+ * 순차 쓰기 1번 + fsync 1번을 여러 연산이 나눠 가지므로 연산당 쓰기 비용이 낮다.
+ * 아직 커밋되지 않은 연산은 프로세스가 죽으면 사라진다. (마지막으로 커밋된 프레임까지만 복구된다)
+ * 기록이나 fsync에 실패하면 RuntimeException을 던진다. 이때 로그 끝에 잘린 프레임이 남아있을 수 있으므로
+ * 다음 커밋은 로그에 덧붙이지 않고 체크포인트를 새로 만드는 것으로 대신한다. (대기중인 연산은 그대로 남아있다)
+ *
+ * [세대]
+ * 체크포인트를 만들 때마다 세대가 1씩 올라가고, 체크포인트와 그 다음에 시작한 로그의 헤더에 같은 세대를 기록한다.
+ * 체크포인트 교체 직후 로그를 새로 시작하기 전에 죽으면 이전 세대의 로그가 남는데, 그 로그의 연산은 모두 새 체크포인트에 들어있다.
+ * 이 로그를 다시 적용하면 체크포인트에 포함된 더 나중의 변경(커밋되지 않은 연산도 체크포인트에는 들어간다)을 되돌리므로 세대가 다른 로그는 버린다.
+ *
+ * [체크포인트 형식]
+ *  Int32U 매직, Byte 버전, Byte[3] 예약, Int64U 세대
+ *  TreeSet::Serialize 데이터
+ *
+ * [로그 형식]
+ *  Int32U 매직, Byte 버전, Byte 키 인코딩, Byte[2] 예약, Int64U 세대
+ *  프레임 반복: Int32U 페이로드 크기, Int64U 체크섬, Int32U 연산 수, 페이로드([Byte 연산][키]...)
+ *  체크섬은 연산 수부터 페이로드 끝까지 계산한다. (연산 수만 손상되면 프레임 일부만 적용될 수 있으므로)
+ *
+ * [복구]
+ * 체크포인트를 Deserialize로 O(n)에 만들고(하나씩 삽입하지 않는다) 그 위에 같은 세대의 로그 프레임을 순서대로 다시 적용한다.
+ * 크기나 체크섬이 맞지 않는 프레임을 만나면 쓰다가 죽은 마지막 프레임으로 보고 거기서 멈춘 후, 바로 체크포인트를 새로 만들어 로그를 정리한다.
+ * 로그가 이전 세대면 적용하지 않고 체크포인트를 새로 만든다.
+ *
+ * 트리셋처럼 스레드 안전하지 않다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Exception.h>
+#include <JCore/FileSystem/DurableFile.h>
+#include <JCore/FileSystem/File.h>
+#include <JCore/FileSystem/FileStream.h>
+#include <JCore/Primitives/StringUtil.h>
+
+#include "TreeSet.h"
+#include "TreeSerializer.h"
+
+NS_JC_BEGIN
+
+struct DurableTreeSetOptions
+{
+	int GroupCommitCount = 256;					// 연산이 이만큼 모이면 로그에 기록한다. (1이면 연산마다 기록)
+	bool SyncOnCommit = true;					// 기록할 때마다 fsync한다. (false면 전원이 꺼졌을 때 최근 프레임을 잃을 수 있다)
+	int CheckpointLogBytes = 64 * 1024 * 1024;	// 로그가 이 크기를 넘으면 체크포인트를 만든다.
+};
+
+enum class DurableTreeOperation : Byte
+{
+	Insert,
+	Remove
+};
+
+template <typename T, typename TBalancer = RedBlackBalancer>
+class DurableTreeSet
+{
+	using TTreeSet	= TreeSet<T, TBalancer>;
+	using TCodec	= TreeSerializeCodec<T, false>;
+
+	static constexpr Int32U CheckpointMagic = 0x504B434A;	// "JCKP"
+	static constexpr Byte CheckpointVersion = 1;
+	static constexpr int CheckpointHeaderSize = 16;
+	static constexpr Int32U LogMagic = 0x4C41574A;	// "JWAL"
+	static constexpr Byte LogVersion = 2;
+	static constexpr int LogHeaderSize = 16;
+	static constexpr int FrameHeaderSize = 16;
+	static constexpr int FrameChecksumBegin = 12;
+public:
+	// 기존 체크포인트와 로그가 있으면 복구한다. 체크포인트가 손상되었으면 RuntimeException을 던진다.
+	DurableTreeSet(const String& path, const DurableTreeSetOptions& options = {})
+		: m_CheckpointPath(StringUtil::Format("%s.checkpoint", path.Source()))
+		, m_TemporaryPath(StringUtil::Format("%s.checkpoint.tmp", path.Source()))
+		, m_LogPath(StringUtil::Format("%s.wal", path.Source()))
+		, m_Options(options)
+		, m_pLog(nullptr)
+		, m_iPendingCount(0)
+		, m_iCommitCount(0)
+		, m_iCheckpointCount(0)
+		, m_uiGeneration(0)
+		, m_bLogBroken(false)
+	{
+		Recover();
+	}
+
+	~DurableTreeSet() {
+		// 소멸자에서는 예외를 던질 수 없으므로 기록에 실패하면 마지막 그룹만 잃는다.
+		try {
+			Commit();
+		} catch (...) {}
+
+		JCORE_DELETE_SAFE(m_pLog);
+	}
+
+	DurableTreeSet(const DurableTreeSet&) = delete;
+	DurableTreeSet& operator=(const DurableTreeSet&) = delete;
+
+	bool Insert(const T& data) {
+		if (!m_Set.Insert(data)) {
+			return false;
+		}
+
+		Append(DurableTreeOperation::Insert, data);
+		return true;
+	}
+
+	bool Remove(const T& data) {
+		if (!m_Set.Remove(data)) {
+			return false;
+		}
+
+		Append(DurableTreeOperation::Remove, data);
+		return true;
+	}
+
+	// 모아둔 연산을 한 프레임으로 로그에 기록한다. 기록이나 fsync에 실패하면 RuntimeException을 던진다.
+	void Commit() {
+		if (m_iPendingCount == 0) {
+			return;
+		}
+
+		// 이전 기록이 중간에 실패했으면 잘린 프레임 뒤에 덧붙인 프레임은 복구할 때 읽히지 않는다.
+		if (m_bLogBroken) {
+			Checkpoint();
+			return;
+		}
+
+		Byte* pFrame = m_Pending.Source();
+		const Int32U uiPayloadLength = Int32U(m_Pending.Length() - FrameHeaderSize);
+		const Int32U uiOperationCount = Int32U(m_iPendingCount);
+		std::memcpy(pFrame, &uiPayloadLength, 4);
+		std::memcpy(pFrame + FrameChecksumBegin, &uiOperationCount, 4);
+		const Int64U uiChecksum = TreeChecksum64(pFrame + FrameChecksumBegin, m_Pending.Length() - FrameChecksumBegin);
+		std::memcpy(pFrame + 4, &uiChecksum, 8);
+
+		m_bLogBroken = true;
+		m_pLog->Write(pFrame, 0, m_Pending.Length());
+		if (m_Options.SyncOnCommit && !m_pLog->Flush()) {
+			throw RuntimeException(StringUtil::Format("%s 로그를 기록하지 못했습니다.", m_LogPath.Source()));
+		}
+		m_bLogBroken = false;
+
+		++m_iCommitCount;
+		ClearPending();
+
+		if (m_pLog->GetLength() >= m_Options.CheckpointLogBytes) {
+			Checkpoint();
+		}
+	}
+
+	// 현재 트리 전체를 다음 세대의 체크포인트로 기록하고 그 세대의 로그를 새로 시작한다.
+	// 커밋되지 않은 연산도 체크포인트에 포함된다. 이전 세대의 로그는 복구할 때 버려지므로 교체 직후에 죽어도 된다.
+	void Checkpoint() {
+		const Int64U uiGeneration = m_uiGeneration + 1;
+
+		{
+			Byte header[CheckpointHeaderSize] = {};
+			std::memcpy(header, &CheckpointMagic, 4);
+			header[4] = CheckpointVersion;
+			std::memcpy(header + 8, &uiGeneration, 8);
+
+			FileStream stream(m_TemporaryPath, eWrite, eCreate);
+			stream.Write(header, 0, CheckpointHeaderSize);
+			m_Set.Serialize(stream);
+			if (!stream.Flush()) {
+				throw RuntimeException(StringUtil::Format("%s 체크포인트를 기록하지 못했습니다.", m_TemporaryPath.Source()));
+			}
+		}
+
+		if (!DurableFile::Replace(m_TemporaryPath, m_CheckpointPath)) {
+			throw RuntimeException(StringUtil::Format("%s 체크포인트를 교체하지 못했습니다.", m_CheckpointPath.Source()));
+		}
+
+		m_uiGeneration = uiGeneration;
+		++m_iCheckpointCount;
+		ResetLog();
+	}
+
+	bool Search(const T& data) const { return m_Set.Search(data); }
+	int Size() const { return m_Set.Size(); }
+	bool IsEmpty() const { return m_Set.Size() == 0; }
+
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const { m_Set.ForEach(Forward<Consumer>(consumer)); }
+
+	const TTreeSet& GetSet() const { return m_Set; }
+	int GetLogBytes() const { return m_pLog ? m_pLog->GetLength() : 0; }
+	int GetPendingCount() const { return m_iPendingCount; }
+	Int64 GetCommitCount() const { return m_iCommitCount; }
+	Int64 GetCheckpointCount() const { return m_iCheckpointCount; }
+private:
+	void Append(DurableTreeOperation operation, const T& data) {
+		m_Pending.WriteByte(Byte(operation));
+		m_Codec.Write(m_Pending, data);
+
+		if (++m_iPendingCount >= m_Options.GroupCommitCount) {
+			Commit();
+		}
+	}
+
+	void ClearPending() {
+		m_Pending.Clear();
+		m_Pending.Grow(FrameHeaderSize);	// 커밋할 때 채운다.
+		m_iPendingCount = 0;
+	}
+
+	void Recover() {
+		ClearPending();
+
+		if (File::Exist(m_CheckpointPath)) {
+			FileStream stream(m_CheckpointPath, eRead, eOpen);
+			Byte header[CheckpointHeaderSize];
+			Int32U uiMagic;
+
+			if (stream.Read(header, 0, CheckpointHeaderSize) != CheckpointHeaderSize) {
+				throw RuntimeException(StringUtil::Format("%s 체크포인트가 손상되었습니다.", m_CheckpointPath.Source()));
+			}
+
+			std::memcpy(&uiMagic, header, 4);
+			std::memcpy(&m_uiGeneration, header + 8, 8);
+			if (uiMagic != CheckpointMagic || header[4] != CheckpointVersion || !m_Set.Deserialize(stream)) {
+				throw RuntimeException(StringUtil::Format("%s 체크포인트가 손상되었습니다.", m_CheckpointPath.Source()));
+			}
+		}
+
+		if (!File::Exist(m_LogPath)) {
+			ResetLog();
+			return;
+		}
+
+		if (!ReplayLog()) {
+			Checkpoint();
+			return;
+		}
+
+		m_pLog = dbg_new FileStream(m_LogPath, eWrite, eAppend);
+	}
+
+	// 로그를 끝까지 적용했으면 true, 중간에 잘리거나 손상된 프레임을 만나면 거기까지만 적용하고 false
+	// 이전 세대의 로그면 적용하지 않고 false, 체크포인트보다 나중 세대면(체크포인트를 잃음) RuntimeException을 던진다.
+	bool ReplayLog() {
+		FileStream stream(m_LogPath, eRead, eOpen);
+		TreeStreamReader reader(stream);
+		const int iFileLength = stream.GetLength();
+		Byte header[LogHeaderSize];
+		Int32U uiMagic;
+		Int64U uiGeneration;
+
+		if (!reader.ReadBytes(header, LogHeaderSize)) {
+			return false;
+		}
+
+		std::memcpy(&uiMagic, header, 4);
+		std::memcpy(&uiGeneration, header + 8, 8);
+		if (uiMagic != LogMagic || header[4] != LogVersion || header[5] != Byte(TCodec::Encoding)) {
+			return false;
+		}
+
+		if (uiGeneration > m_uiGeneration) {
+			throw RuntimeException(StringUtil::Format("%s 로그보다 오래된 체크포인트입니다. (로그 세대: %llu, 체크포인트 세대: %llu)",
+				m_CheckpointPath.Source(), uiGeneration, m_uiGeneration
+			));
+		}
+
+		if (uiGeneration < m_uiGeneration) {
+			return false;
+		}
+
+		TreeBufferWriter payload;
+		Byte frameHeader[FrameHeaderSize];
+		int iPosition = LogHeaderSize;
+
+		while (iPosition < iFileLength) {
+			Int32U uiPayloadLength, uiOperationCount;
+			Int64U uiChecksum;
+
+			if (iFileLength - iPosition < FrameHeaderSize || !reader.ReadBytes(frameHeader, FrameHeaderSize)) {
+				return false;
+			}
+
+			std::memcpy(&uiPayloadLength, frameHeader, 4);
+			std::memcpy(&uiChecksum, frameHeader + 4, 8);
+			std::memcpy(&uiOperationCount, frameHeader + FrameChecksumBegin, 4);
+			iPosition += FrameHeaderSize;
+
+			if (uiPayloadLength > Int32U(iFileLength - iPosition)) {
+				return false;
+			}
+
+			payload.Clear();
+			payload.WriteBytes(frameHeader + FrameChecksumBegin, FrameHeaderSize - FrameChecksumBegin);
+			Byte* pPayload = payload.Grow(int(uiPayloadLength));
+			if (!reader.ReadBytes(pPayload, int(uiPayloadLength)) || TreeChecksum64(payload.Source(), payload.Length()) != uiChecksum) {
+				return false;
+			}
+
+			if (!ApplyFrame(pPayload, int(uiPayloadLength), uiOperationCount)) {
+				return false;
+			}
+
+			iPosition += int(uiPayloadLength);
+		}
+
+		return true;
+	}
+
+	bool ApplyFrame(const Byte* payload, int length, Int32U operationCount) {
+		TreeBufferReader reader(payload, length);
+		TCodec codec;
+
+		for (Int32U i = 0; i < operationCount; ++i) {
+			Byte operation;
+			T data;
+
+			if (!reader.ReadByte(operation) || !codec.Read(reader, data)) {
+				return false;
+			}
+
+			switch (DurableTreeOperation(operation)) {
+			case DurableTreeOperation::Insert: m_Set.Insert(data); break;
+			case DurableTreeOperation::Remove: m_Set.Remove(data); break;
+			default: return false;
+			}
+		}
+
+		return reader.IsEnd();
+	}
+
+	// 현재 세대의 빈 로그를 만든다. 실패하면 다음 커밋이 다시 체크포인트를 만든다.
+	void ResetLog() {
+		m_bLogBroken = true;
+		JCORE_DELETE_SAFE(m_pLog);
+		m_pLog = dbg_new FileStream(m_LogPath, eWrite, eCreate);
+
+		Byte header[LogHeaderSize] = {};
+		std::memcpy(header, &LogMagic, 4);
+		header[4] = LogVersion;
+		header[5] = Byte(TCodec::Encoding);
+		std::memcpy(header + 8, &m_uiGeneration, 8);
+		m_pLog->Write(header, 0, LogHeaderSize);
+		if (!m_pLog->Flush() || !DurableFile::SyncDirectory(m_LogPath)) {
+			throw RuntimeException(StringUtil::Format("%s 로그를 기록하지 못했습니다.", m_LogPath.Source()));
+		}
+
+		m_bLogBroken = false;
+		ClearPending();
+	}
+
+	TTreeSet m_Set;
+	String m_CheckpointPath;
+	String m_TemporaryPath;
+	String m_LogPath;
+	DurableTreeSetOptions m_Options;
+	FileStream* m_pLog;
+	TreeBufferWriter m_Pending;		// 커밋 대기중인 프레임 (앞 FrameHeaderSize 바이트는 헤더 자리)
+	TCodec m_Codec;
+	int m_iPendingCount;
+	Int64 m_iCommitCount;
+	Int64 m_iCheckpointCount;
+	Int64U m_uiGeneration;		// 마지막 체크포인트의 세대 (체크포인트가 없으면 0)
+	bool m_bLogBroken;			// 로그 기록이 중간에 실패해서 끝이 어떤 상태인지 모른다.
+};
+
+NS_JC_END
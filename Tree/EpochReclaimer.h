@@ -0,0 +1,205 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 에폭 기반 메모리 회수 (Epoch Based Reclamation)
+ * 락프리 자료구조에서 링크를 끊은 노드는 다른 쓰레드가 아직 들고 있을 수 있어서 바로 delete 할 수 없다.
+ *
+ *  1. 노드에 접근하는 구간은 EpochGuard로 감싼다. 진입할 때 현재 전역 에폭을 자기 슬롯에 기록한다.
+ *  2. 링크를 끊은 노드는 Retire로 넘긴다. 넘긴 시점의 전역 에폭 바구니에 담아둔다.
+ *  3. 구간 안에 있는 모든 쓰레드가 현재 전역 에폭을 기록했으면 전역 에폭을 1 올린다.
+ *  4. 에폭 e에 넘긴 노드는 전역 에폭이 e + 2가 되면 아무도 들고 있을 수 없으므로 삭제한다.
+ *
+ * 모든 락프리 컨테이너가 하나의 인스턴스를 공유한다. (쓰레드 슬롯 관리를 한번만 하기 위함)
+ * 쓰레드가 종료되면 슬롯만 반납하고 바구니는 슬롯에 남겨둬서 다음에 슬롯을 받는 쓰레드가 이어서 비운다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Container/Vector.h>
+#include <JCore/Primitives/Atomic.h>
+
+NS_JC_BEGIN
+
+class EpochReclaimer
+{
+public:
+	static constexpr int MaxThreadCount = 128;
+	static constexpr int AdvanceInterval = 64;		// Retire를 이만큼 할때마다 전역 에폭 전진을 시도한다.
+
+	using TDeleter = void(*)(void*);
+
+	static EpochReclaimer& Instance() {
+		static EpochReclaimer s_Instance;
+		return s_Instance;
+	}
+
+	EpochReclaimer(const EpochReclaimer&) = delete;
+	EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+	~EpochReclaimer() {
+		for (int i = 0; i < MaxThreadCount; ++i) {
+			for (int j = 0; j < BucketCount; ++j) {
+				Free(m_Participants[i].Limbo[j]);
+			}
+		}
+	}
+
+	// 중첩 호출 가능
+	void Enter() {
+		ThreadSlot& slot = ts_Slot;
+
+		if (slot.Depth++ > 0) {
+			return;
+		}
+
+		if (slot.Index < 0) {
+			slot.Index = AcquireParticipant();
+		}
+
+		// Exchange는 전체 배리어이므로 이후의 노드 읽기가 에폭 기록보다 앞서지 않는다.
+		m_Participants[slot.Index].State.Exchange((m_uiGlobalEpoch.LoadAcquire() << 1) | 1);
+	}
+
+	void Leave() {
+		ThreadSlot& slot = ts_Slot;
+		DebugAssertMsg(slot.Depth > 0, "Enter 없이 Leave를 호출했습니다.");
+
+		if (--slot.Depth == 0) {
+			m_Participants[slot.Index].State.Exchange(0);
+		}
+	}
+
+	// ptr은 이미 자료구조에서 도달할 수 없는 상태여야 한다.
+	void Retire(void* ptr, TDeleter deleter) {
+		ThreadSlot& slot = ts_Slot;
+		DebugAssertMsg(slot.Depth > 0, "EpochGuard 구간 안에서만 Retire 할 수 있습니다.");
+
+		Participant& participant = m_Participants[slot.Index];
+		const Int64U uiEpoch = m_uiGlobalEpoch.LoadAcquire();
+		const int iBucket = int(uiEpoch % BucketCount);
+
+		// 같은 바구니를 쓰던 에폭은 현재보다 최소 3 작으므로 안전하게 비울 수 있다.
+		if (participant.LimboEpoch[iBucket] != uiEpoch) {
+			Free(participant.Limbo[iBucket]);
+			participant.LimboEpoch[iBucket] = uiEpoch;
+		}
+
+		participant.Limbo[iBucket].PushBack(Retired{ ptr, deleter });
+
+		if (++participant.RetireCount >= AdvanceInterval) {
+			participant.RetireCount = 0;
+
+			if (TryAdvance(uiEpoch)) {
+				Collect(participant, uiEpoch + 1);
+			}
+		}
+	}
+
+	template <typename T>
+	void Retire(T* ptr) {
+		Retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+	}
+
+	Int64U GetEpoch() { return m_uiGlobalEpoch.LoadAcquire(); }
+private:
+	static constexpr int BucketCount = 3;
+
+	struct Retired
+	{
+		void* Pointer;
+		TDeleter Deleter;
+	};
+
+	// 쓰레드마다 하나씩 쓰는 슬롯. 다른 쓰레드가 State를 계속 읽으므로 캐시라인을 분리한다.
+	struct alignas(64) Participant
+	{
+		Atomic<bool> InUse;
+		Atomic<Int64U> State;			// 0: 구간 밖, (에폭 << 1) | 1: 구간 안
+		Vector<Retired> Limbo[BucketCount];
+		Int64U LimboEpoch[BucketCount]{};
+		int RetireCount = 0;
+	};
+
+	struct ThreadSlot
+	{
+		ThreadSlot() : Index(-1), Depth(0) {}
+		~ThreadSlot() {
+			if (Index >= 0) {
+				Instance().m_Participants[Index].InUse.Exchange(false);
+			}
+		}
+
+		int Index;			// 사용중인 슬롯 인덱스 (-1: 아직 없음)
+		int Depth;			// Enter 중첩 횟수
+	};
+
+	EpochReclaimer() : m_uiGlobalEpoch(BucketCount), m_iParticipantCount(0) {}
+
+	int AcquireParticipant() {
+		for (int i = 0; i < MaxThreadCount; ++i) {
+			if (!m_Participants[i].InUse.TryCompareExchange(false, true)) {
+				continue;
+			}
+
+			// 전진 검사는 [0, m_iParticipantCount) 범위만 보므로 구간에 진입하기 전에 범위를 넓혀둔다.
+			int iCount = m_iParticipantCount.LoadAcquire();
+			while (iCount <= i && !m_iParticipantCount.CompareExchange(iCount, i + 1)) {}
+			return i;
+		}
+
+		DebugAssertMsg(false, "EpochReclaimer 슬롯이 부족합니다. (최대 %d 쓰레드)", MaxThreadCount);
+		return -1;
+	}
+
+	// 구간 안의 모든 쓰레드가 epoch를 보고 있으면 전역 에폭을 올린다.
+	bool TryAdvance(Int64U epoch) {
+		const int iCount = m_iParticipantCount.LoadAcquire();
+
+		for (int i = 0; i < iCount; ++i) {
+			const Int64U uiState = m_Participants[i].State.LoadAcquire();
+
+			if ((uiState & 1) && (uiState >> 1) != epoch) {
+				return false;
+			}
+		}
+
+		return m_uiGlobalEpoch.TryCompareExchange(epoch, epoch + 1);
+	}
+
+	// 전역 에폭이 globalEpoch일때 2 이상 지난 바구니를 비운다.
+	static void Collect(Participant& participant, Int64U globalEpoch) {
+		for (int i = 0; i < BucketCount; ++i) {
+			if (participant.LimboEpoch[i] + 2 <= globalEpoch) {
+				Free(participant.Limbo[i]);
+			}
+		}
+	}
+
+	static void Free(Vector<Retired>& limbo) {
+		for (int i = 0; i < limbo.Size(); ++i) {
+			limbo[i].Deleter(limbo[i].Pointer);
+		}
+
+		limbo.Clear();
+	}
+
+	Atomic<Int64U> m_uiGlobalEpoch;
+	Atomic<int> m_iParticipantCount;
+	Participant m_Participants[MaxThreadCount];
+
+	inline static thread_local ThreadSlot ts_Slot;
+};
+
+// 에폭 구간 RAII
+class EpochGuard
+{
+public:
+	EpochGuard() { EpochReclaimer::Instance().Enter(); }
+	EpochGuard(const EpochGuard&) { EpochReclaimer::Instance().Enter(); }
+	~EpochGuard() { EpochReclaimer::Instance().Leave(); }
+
+	EpochGuard& operator=(const EpochGuard&) { return *this; }
+};
+
+NS_JC_END
@@ -0,0 +1,185 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 메모리 맵 정렬 인덱스 (읽기 전용)
+ * 거의 바뀌지 않는 큰 셋을 파일로 만들어두고 역직렬화 없이 mmap한 상태 그대로 탐색한다.
+ * 여러 프로세스가 같은 파일을 열면 페이지 캐시의 한 사본을 공유하고, 여는 비용은 헤더 확인뿐이다.
+ *
+ * 데이터는 Eytzinger 배치(BFS 순서로 펼친 완전 이진 트리, 1번부터 시작, k의 자식은 2k, 2k + 1)로 저장한다.
+ * 정렬 배열의 이진 탐색은 처음 몇 단계가 매번 멀리 떨어진 캐시 라인/페이지를 건드리지만
+ * Eytzinger 배치는 상위 층이 배열 앞쪽에 모여있어서 항상 캐시에 남고, 분기 없이 다음 위치를 계산할 수 있다.
+ *
+ * [형식] 플랫폼 바이트 순서 그대로 (파일을 만든 곳과 같은 엔디언에서만 연다)
+ *  MappedTreeIndexHeader (64바이트)
+ *  T[Count + 1]  (0번은 쓰지 않는다. 새로 늘린 파일 영역이므로 0으로 채워져 있다)
+ *
+ * T는 trivially copyable 타입만 가능하다. (포인터로 바로 읽으므로)
+ * 파일 열기는 헤더와 파일 크기만 확인한다. 데이터 전체 체크섬은 O(n)이므로 필요할 때 VerifyChecksum()으로 확인한다.
+ *
+ * 다른 프로세스가 매핑하고 있는 파일을 제자리에서 다시 쓰면 그쪽은 잘린 영역을 읽다가 SIGBUS를 받거나 쓰는 중인 데이터를 읽는다.
+ * 그래서 Write는 <path>.tmp에 다 쓰고 디스크에 기록한 후 path 위로 이름을 바꿔 교체한다. (DurableFile::Replace)
+ * 이미 열려있던 인덱스는 이전 파일을 계속 보고, 새로 여는 쪽부터 새 파일을 본다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Bit.h>
+#include <JCore/Exception.h>
+#include <JCore/FileSystem/DurableFile.h>
+#include <JCore/FileSystem/MappedFile.h>
+
+#include <type_traits>
+
+#include "TreeSerializer.h"
+
+NS_JC_BEGIN
+
+struct MappedTreeIndexHeader
+{
+	static constexpr Int32U MagicValue = 0x5844494A;	// "JIDX"
+	static constexpr Int16U VersionValue = 1;
+
+	Int32U Magic;
+	Int16U Version;
+	Int16U ElementSize;		// sizeof(T)
+	Int64 Count;
+	Int64U Checksum;		// 데이터 영역 체크섬 (TreeChecksum64)
+	Byte Reserved[40];		// 데이터가 캐시 라인 경계에서 시작하도록 64바이트로 맞춘다.
+};
+
+static_assert(sizeof(MappedTreeIndexHeader) == 64);
+
+template <typename T>
+class MappedTreeIndex
+{
+	static_assert(std::is_trivially_copyable_v<T>, "... 메모리 맵 인덱스에는 trivially copyable 타입만 저장할 수 있습니다.");
+public:
+	// path의 인덱스 파일을 읽기 전용으로 연다. 형식이 다르면 RuntimeException을 던진다.
+	MappedTreeIndex(const String& path) : m_File(path, eRead), m_pData(nullptr), m_iCount(0) {
+		if (m_File.Size() < Int64(sizeof(MappedTreeIndexHeader))) {
+			throw RuntimeException(StringUtil::Format("%s 인덱스 파일이 너무 작습니다.", path.Source()));
+		}
+
+		const MappedTreeIndexHeader* pHeader = GetHeader();
+		if (pHeader->Magic != MappedTreeIndexHeader::MagicValue ||
+			pHeader->Version != MappedTreeIndexHeader::VersionValue ||
+			pHeader->ElementSize != sizeof(T) ||
+			pHeader->Count < 0 ||
+			m_File.Size() != FileSize(pHeader->Count)) {
+			throw RuntimeException(StringUtil::Format("%s 인덱스 파일 형식이 다릅니다.", path.Source()));
+		}
+
+		m_iCount = pHeader->Count;
+		m_pData = reinterpret_cast<const T*>(m_File.Data() + sizeof(MappedTreeIndexHeader));
+		m_File.Advise(MappedFileAdvice::Random);
+	}
+
+	// 오름차순으로 순회 가능한 셋(ForEach, Size)을 인덱스 파일로 기록한다. 이미 있으면 원자적으로 교체한다.
+	template <typename TSet>
+	static void Write(const TSet& set, const String& path) {
+		const Int64 iCount = set.Size();
+		const String temporaryPath = StringUtil::Format("%s.tmp", path.Source());
+
+		{
+			MappedFile file(temporaryPath, FileSize(iCount));
+			T* pData = reinterpret_cast<T*>(file.Data() + sizeof(MappedTreeIndexHeader));
+
+			// 정렬된 데이터를 완전 이진 트리의 중위 순서 위치에 차례대로 넣는다.
+			Int64 k = FirstInOrder(1, iCount);
+			set.ForEach([&](const T& data) {
+				pData[k] = data;
+				k = NextInOrder(k, iCount);
+			});
+
+			MappedTreeIndexHeader header{};
+			header.Magic = MappedTreeIndexHeader::MagicValue;
+			header.Version = MappedTreeIndexHeader::VersionValue;
+			header.ElementSize = sizeof(T);
+			header.Count = iCount;
+			header.Checksum = TreeChecksum64(reinterpret_cast<const Byte*>(pData), DataSize(iCount));
+			Memory::CopyUnsafe(file.Data(), &header, sizeof(header));
+
+			if (!file.Flush()) {
+				throw RuntimeException(StringUtil::Format("%s 인덱스 파일을 기록하지 못했습니다.", temporaryPath.Source()));
+			}
+		}
+
+		if (!DurableFile::Replace(temporaryPath, path)) {
+			throw RuntimeException(StringUtil::Format("%s 인덱스 파일을 교체하지 못했습니다.", path.Source()));
+		}
+	}
+
+	bool Search(const T& key) const {
+		const Int64 k = LowerBoundIndex(key);
+		return k != 0 && !(key < m_pData[k]);
+	}
+
+	// key 이상인 첫번째 데이터를 result에 담는다. 없으면 false
+	bool LowerBound(const T& key, JCORE_OUT T& result) const {
+		const Int64 k = LowerBoundIndex(key);
+		if (k == 0) return false;
+		result = m_pData[k];
+		return true;
+	}
+
+	// 오름차순 순회
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		for (Int64 k = FirstInOrder(1, m_iCount); k != 0; k = NextInOrder(k, m_iCount)) {
+			consumer(m_pData[k]);
+		}
+	}
+
+	bool VerifyChecksum() const {
+		return GetHeader()->Checksum == TreeChecksum64(reinterpret_cast<const Byte*>(m_pData), DataSize(m_iCount));
+	}
+
+	Int64 Size() const { return m_iCount; }
+	bool IsEmpty() const { return m_iCount == 0; }
+	Int64 FileBytes() const { return m_File.Size(); }
+private:
+	static Int64 DataSize(Int64 count) { return Int64(sizeof(T)) * (count + 1); }
+	static Int64 FileSize(Int64 count) { return Int64(sizeof(MappedTreeIndexHeader)) + DataSize(count); }
+
+	const MappedTreeIndexHeader* GetHeader() const {
+		return reinterpret_cast<const MappedTreeIndexHeader*>(m_File.Data());
+	}
+
+	// 왼쪽(key보다 크거나 같음) 또는 오른쪽(작음)으로 내려가면서 이동 경로를 k의 비트로 남긴다.
+	// 끝까지 내려간 후 마지막으로 왼쪽으로 꺾은 지점이 답이다. (경로 끝의 연속된 1(오른쪽)과 그 위 0 하나를 지운다)
+	// 모두 오른쪽으로만 내려갔다면 0이 된다. (key보다 크거나 같은 데이터가 없음)
+	Int64 LowerBoundIndex(const T& key) const {
+		Int64U k = 1;
+
+		while (k <= Int64U(m_iCount)) {
+			k = 2 * k + (m_pData[k] < key);
+		}
+
+		return Int64(k >> (CountTrailingZero64(~k) + 1));
+	}
+
+	// k 서브트리의 중위 순서 첫번째 위치 (가장 왼쪽)
+	static Int64 FirstInOrder(Int64 k, Int64 count) {
+		if (k > count) return 0;
+		while (2 * k <= count) k *= 2;
+		return k;
+	}
+
+	// 중위 순서의 다음 위치, 마지막이면 0
+	static Int64 NextInOrder(Int64 k, Int64 count) {
+		if (2 * k + 1 <= count) {
+			return FirstInOrder(2 * k + 1, count);
+		}
+
+		// 오른쪽 자식으로 내려온 동안은 계속 올라가고, 왼쪽 자식이었던 곳의 부모가 다음이다.
+		while (k & 1) k >>= 1;
+		return k >> 1;
+	}
+
+	MappedFile m_File;
+	const T* m_pData;
+	Int64 m_iCount;
+};
+
+NS_JC_END
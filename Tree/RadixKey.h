@@ -0,0 +1,64 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 기수 트리(Radix Tree) 키 변환
+ * 키를 바이트 단위로 사전순 비교했을 때 원래 키의 대소관계와 같아지도록 바이트열로 본다.
+ *
+ *  - 정수: 빅엔디언으로 배치하고 부호있는 정수는 부호 비트를 뒤집는다.
+ *  - String: 버퍼를 복사하지 않고 널문자까지 포함해서 그대로 사용한다.
+ *            널문자가 모든 문자보다 작으므로 "ab" < "abc"가 되고 어떤 키도 다른 키의 접두사가 되지 않는다.
+ */
+
+#pragma once
+
+#include <JCore/Type.h>
+#include <JCore/Primitives/String.h>
+
+#include <type_traits>
+
+NS_JC_BEGIN
+
+template <typename TKey, typename = void>
+struct RadixKey;
+
+template <typename TKey>
+struct RadixKey<TKey, std::enable_if_t<std::is_integral_v<TKey>>>
+{
+	RadixKey(TKey key) {
+		using TUnsigned = std::make_unsigned_t<TKey>;
+		TUnsigned uiKey = TUnsigned(key);
+
+		if constexpr (std::is_signed_v<TKey>) {
+			uiKey ^= TUnsigned(1) << (sizeof(TKey) * 8 - 1);
+		}
+
+		for (int i = sizeof(TKey) - 1; i >= 0; --i) {
+			m_Bytes[i] = Byte(uiKey & 0xff);
+			uiKey >>= 8;
+		}
+	}
+
+	const Byte* Source() const { return m_Bytes; }
+	int Length() const { return sizeof(TKey); }
+	Byte operator[](int idx) const { return m_Bytes[idx]; }
+private:
+	Byte m_Bytes[sizeof(TKey)];
+};
+
+template <>
+struct RadixKey<String>
+{
+	RadixKey(const String& key)
+		: m_pBytes(reinterpret_cast<const Byte*>(key.IsNull() ? String::EmptyString : key.Source()))
+		, m_iLength(key.IsNull() ? 1 : key.LengthWithNull())
+	{}
+
+	const Byte* Source() const { return m_pBytes; }
+	int Length() const { return m_iLength; }
+	Byte operator[](int idx) const { return m_pBytes[idx]; }
+private:
+	const Byte* m_pBytes;
+	int m_iLength;
+};
+
+NS_JC_END
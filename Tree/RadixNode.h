@@ -0,0 +1,409 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 적응형 기수 트리(ART) 노드
+ * Leis, Kemper, Neumann - The Adaptive Radix Tree: ARTful Indexing for Main-Memory Databases
+ *
+ * 내부 노드는 자식 수에 따라 4 / 16 / 48 / 256 크기 중 하나를 사용하고 자식이 늘거나 줄면 갈아탄다.
+ *  Node4, Node16  : 키 바이트를 정렬된 배열로 보관
+ *  Node48         : 256칸 인덱스 배열 -> 48칸 자식 배열 (인덱스 0은 비어있음을 뜻함)
+ *  Node256        : 키 바이트로 바로 자식 접근
+ *
+ * 경로 압축: 자식이 하나뿐인 경로는 Prefix에 최대 MaxPrefixLength 바이트까지 저장하고
+ * 그보다 긴 부분은 서브트리의 아무 리프 키나 꺼내서 비교한다.
+ * 가상함수 없이 Type으로 구분한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Memory.h>
+#include <JCore/Container/Pair.h>
+
+NS_JC_BEGIN
+
+enum class RadixNodeType : Byte
+{
+	Leaf,
+	Node4,
+	Node16,
+	Node48,
+	Node256
+};
+
+struct RadixNode
+{
+	RadixNodeType Type;
+
+	RadixNode(RadixNodeType type) : Type(type) {}
+
+	bool IsLeaf() const { return Type == RadixNodeType::Leaf; }
+};
+
+// 키 전체와 값을 들고있는 리프. 경로 압축으로 생략된 키 바이트는 리프의 키로 확인한다.
+template <typename TKey, typename TValue>
+struct RadixLeaf : RadixNode
+{
+	Pair<TKey, TValue> Item;
+
+	template <typename Key, typename Value>
+	RadixLeaf(Key&& key, Value&& value) : RadixNode(RadixNodeType::Leaf), Item{ Forward<Key>(key), Forward<Value>(value) } {}
+};
+
+struct RadixInnerNode : RadixNode
+{
+	static constexpr int MaxPrefixLength = 10;
+
+	int ChildCount;
+	int PrefixLength;
+	Byte Prefix[MaxPrefixLength];
+
+	RadixInnerNode(RadixNodeType type) : RadixNode(type), ChildCount(0), PrefixLength(0), Prefix{} {}
+
+	void CopyHeader(const RadixInnerNode* other) {
+		ChildCount = other->ChildCount;
+		PrefixLength = other->PrefixLength;
+		Memory::CopyUnsafe(Prefix, other->Prefix, MaxPrefixLength);
+	}
+
+	// key 바이트에 해당하는 자식 슬롯 (없으면 nullptr)
+	RadixNode** FindChild(Byte key);
+
+	// key 바이트가 fromKey 이상인 자식 중 가장 작은 자식 (fromKey는 0 ~ 256)
+	RadixNode* NextChild(int fromKey, JCORE_OUT int& key) const;
+
+	// node 슬롯의 노드에 자식을 추가한다. 가득 찬 경우 더 큰 노드로 교체된다.
+	static void AddChild(RadixNode** node, Byte key, RadixNode* child);
+
+	// node 슬롯의 노드에서 자식을 제거한다. 자식 수가 줄면 더 작은 노드로 교체된다.
+	// Node4의 자식이 하나만 남으면 경로 압축을 위해 남은 자식이 node 슬롯을 차지한다.
+	static void RemoveChild(RadixNode** node, Byte key);
+
+	static void Delete(RadixInnerNode* node);
+};
+
+struct RadixNode4 : RadixInnerNode
+{
+	Byte Keys[4];
+	RadixNode* Children[4];
+
+	RadixNode4() : RadixInnerNode(RadixNodeType::Node4), Keys{}, Children{} {}
+};
+
+struct RadixNode16 : RadixInnerNode
+{
+	Byte Keys[16];
+	RadixNode* Children[16];
+
+	RadixNode16() : RadixInnerNode(RadixNodeType::Node16), Keys{}, Children{} {}
+};
+
+struct RadixNode48 : RadixInnerNode
+{
+	Byte ChildIndex[256];		// 자식 배열 인덱스 + 1
+	RadixNode* Children[48];
+
+	RadixNode48() : RadixInnerNode(RadixNodeType::Node48), ChildIndex{}, Children{} {}
+};
+
+struct RadixNode256 : RadixInnerNode
+{
+	RadixNode* Children[256];
+
+	RadixNode256() : RadixInnerNode(RadixNodeType::Node256), Children{} {}
+};
+
+namespace Detail {
+	// 정렬된 키 배열에서 key 이상이 처음 나오는 위치
+	inline int RadixLowerBound(const Byte* keys, int count, int key) {
+		int i = 0;
+		while (i < count && keys[i] < key) ++i;
+		return i;
+	}
+
+	// 정렬된 키/자식 배열에 삽입
+	inline void RadixSortedInsert(Byte* keys, RadixNode** children, int count, Byte key, RadixNode* child) {
+		const int iPos = RadixLowerBound(keys, count, key);
+		for (int i = count; i > iPos; --i) {
+			keys[i] = keys[i - 1];
+			children[i] = children[i - 1];
+		}
+		keys[iPos] = key;
+		children[iPos] = child;
+	}
+
+	// 정렬된 키/자식 배열에서 제거
+	inline void RadixSortedRemove(Byte* keys, RadixNode** children, int count, int pos) {
+		for (int i = pos; i < count - 1; ++i) {
+			keys[i] = keys[i + 1];
+			children[i] = children[i + 1];
+		}
+	}
+}
+
+inline RadixNode** RadixInnerNode::FindChild(Byte key) {
+	switch (Type) {
+	case RadixNodeType::Node4: {
+		RadixNode4* pNode = static_cast<RadixNode4*>(this);
+		for (int i = 0; i < ChildCount; ++i) {
+			if (pNode->Keys[i] == key) return &pNode->Children[i];
+		}
+		return nullptr;
+	}
+	case RadixNodeType::Node16: {
+		RadixNode16* pNode = static_cast<RadixNode16*>(this);
+		const int iPos = Detail::RadixLowerBound(pNode->Keys, ChildCount, key);
+		if (iPos < ChildCount && pNode->Keys[iPos] == key) return &pNode->Children[iPos];
+		return nullptr;
+	}
+	case RadixNodeType::Node48: {
+		RadixNode48* pNode = static_cast<RadixNode48*>(this);
+		const int iIndex = pNode->ChildIndex[key];
+		return iIndex ? &pNode->Children[iIndex - 1] : nullptr;
+	}
+	case RadixNodeType::Node256: {
+		RadixNode256* pNode = static_cast<RadixNode256*>(this);
+		return pNode->Children[key] ? &pNode->Children[key] : nullptr;
+	}
+	default:
+		return nullptr;
+	}
+}
+
+inline RadixNode* RadixInnerNode::NextChild(int fromKey, JCORE_OUT int& key) const {
+	switch (Type) {
+	case RadixNodeType::Node4: {
+		const RadixNode4* pNode = static_cast<const RadixNode4*>(this);
+		const int iPos = Detail::RadixLowerBound(pNode->Keys, ChildCount, fromKey);
+		if (iPos == ChildCount) return nullptr;
+		key = pNode->Keys[iPos];
+		return pNode->Children[iPos];
+	}
+	case RadixNodeType::Node16: {
+		const RadixNode16* pNode = static_cast<const RadixNode16*>(this);
+		const int iPos = Detail::RadixLowerBound(pNode->Keys, ChildCount, fromKey);
+		if (iPos == ChildCount) return nullptr;
+		key = pNode->Keys[iPos];
+		return pNode->Children[iPos];
+	}
+	case RadixNodeType::Node48: {
+		const RadixNode48* pNode = static_cast<const RadixNode48*>(this);
+		for (int i = fromKey; i < 256; ++i) {
+			if (pNode->ChildIndex[i]) {
+				key = i;
+				return pNode->Children[pNode->ChildIndex[i] - 1];
+			}
+		}
+		return nullptr;
+	}
+	case RadixNodeType::Node256: {
+		const RadixNode256* pNode = static_cast<const RadixNode256*>(this);
+		for (int i = fromKey; i < 256; ++i) {
+			if (pNode->Children[i]) {
+				key = i;
+				return pNode->Children[i];
+			}
+		}
+		return nullptr;
+	}
+	default:
+		return nullptr;
+	}
+}
+
+inline void RadixInnerNode::AddChild(RadixNode** node, Byte key, RadixNode* child) {
+	RadixInnerNode* pInner = static_cast<RadixInnerNode*>(*node);
+
+	switch (pInner->Type) {
+	case RadixNodeType::Node4: {
+		RadixNode4* pNode = static_cast<RadixNode4*>(pInner);
+		if (pNode->ChildCount < 4) {
+			Detail::RadixSortedInsert(pNode->Keys, pNode->Children, pNode->ChildCount, key, child);
+			pNode->ChildCount++;
+			return;
+		}
+
+		RadixNode16* pGrown = dbg_new RadixNode16;
+		pGrown->CopyHeader(pNode);
+		Memory::CopyUnsafe(pGrown->Keys, pNode->Keys, sizeof(pNode->Keys));
+		Memory::CopyUnsafe(pGrown->Children, pNode->Children, sizeof(pNode->Children));
+		*node = pGrown;
+		delete pNode;
+		AddChild(node, key, child);
+		return;
+	}
+	case RadixNodeType::Node16: {
+		RadixNode16* pNode = static_cast<RadixNode16*>(pInner);
+		if (pNode->ChildCount < 16) {
+			Detail::RadixSortedInsert(pNode->Keys, pNode->Children, pNode->ChildCount, key, child);
+			pNode->ChildCount++;
+			return;
+		}
+
+		RadixNode48* pGrown = dbg_new RadixNode48;
+		pGrown->CopyHeader(pNode);
+		for (int i = 0; i < pNode->ChildCount; ++i) {
+			pGrown->Children[i] = pNode->Children[i];
+			pGrown->ChildIndex[pNode->Keys[i]] = Byte(i + 1);
+		}
+		*node = pGrown;
+		delete pNode;
+		AddChild(node, key, child);
+		return;
+	}
+	case RadixNodeType::Node48: {
+		RadixNode48* pNode = static_cast<RadixNode48*>(pInner);
+		if (pNode->ChildCount < 48) {
+			// 제거로 인해 중간이 비어있을 수 있으므로 빈칸을 찾는다.
+			int iSlot = 0;
+			while (pNode->Children[iSlot]) ++iSlot;
+			pNode->Children[iSlot] = child;
+			pNode->ChildIndex[key] = Byte(iSlot + 1);
+			pNode->ChildCount++;
+			return;
+		}
+
+		RadixNode256* pGrown = dbg_new RadixNode256;
+		pGrown->CopyHeader(pNode);
+		for (int i = 0; i < 256; ++i) {
+			if (pNode->ChildIndex[i]) {
+				pGrown->Children[i] = pNode->Children[pNode->ChildIndex[i] - 1];
+			}
+		}
+		*node = pGrown;
+		delete pNode;
+		AddChild(node, key, child);
+		return;
+	}
+	case RadixNodeType::Node256: {
+		RadixNode256* pNode = static_cast<RadixNode256*>(pInner);
+		pNode->Children[key] = child;
+		pNode->ChildCount++;
+		return;
+	}
+	default:
+		DebugAssertMsg(false, "내부 노드가 아닙니다.");
+	}
+}
+
+inline void RadixInnerNode::RemoveChild(RadixNode** node, Byte key) {
+	RadixInnerNode* pInner = static_cast<RadixInnerNode*>(*node);
+
+	switch (pInner->Type) {
+	case RadixNodeType::Node4: {
+		RadixNode4* pNode = static_cast<RadixNode4*>(pInner);
+		const int iPos = Detail::RadixLowerBound(pNode->Keys, pNode->ChildCount, key);
+		Detail::RadixSortedRemove(pNode->Keys, pNode->Children, pNode->ChildCount, iPos);
+		pNode->ChildCount--;
+
+		if (pNode->ChildCount > 1) {
+			return;
+		}
+
+		// 자식이 하나만 남으면 이 노드를 없애고 자식이 이 노드의 접두사 + 키 바이트를 이어받는다.
+		RadixNode* pChild = pNode->Children[0];
+		if (!pChild->IsLeaf()) {
+			RadixInnerNode* pChildInner = static_cast<RadixInnerNode*>(pChild);
+			int iPrefixLength = pNode->PrefixLength;
+
+			if (iPrefixLength < MaxPrefixLength) {
+				pNode->Prefix[iPrefixLength] = pNode->Keys[0];
+				iPrefixLength++;
+			}
+
+			if (iPrefixLength < MaxPrefixLength) {
+				const int iSubLength = Math::Min(pChildInner->PrefixLength, MaxPrefixLength - iPrefixLength);
+				Memory::CopyUnsafe(pNode->Prefix + iPrefixLength, pChildInner->Prefix, iSubLength);
+				iPrefixLength += iSubLength;
+			}
+
+			Memory::CopyUnsafe(pChildInner->Prefix, pNode->Prefix, Math::Min(iPrefixLength, MaxPrefixLength));
+			pChildInner->PrefixLength += pNode->PrefixLength + 1;
+		}
+
+		*node = pChild;
+		delete pNode;
+		return;
+	}
+	case RadixNodeType::Node16: {
+		RadixNode16* pNode = static_cast<RadixNode16*>(pInner);
+		const int iPos = Detail::RadixLowerBound(pNode->Keys, pNode->ChildCount, key);
+		Detail::RadixSortedRemove(pNode->Keys, pNode->Children, pNode->ChildCount, iPos);
+		pNode->ChildCount--;
+
+		if (pNode->ChildCount > 3) {
+			return;
+		}
+
+		RadixNode4* pShrunk = dbg_new RadixNode4;
+		pShrunk->CopyHeader(pNode);
+		Memory::CopyUnsafe(pShrunk->Keys, pNode->Keys, pNode->ChildCount);
+		Memory::CopyUnsafe(pShrunk->Children, pNode->Children, pNode->ChildCount * sizeof(RadixNode*));
+		*node = pShrunk;
+		delete pNode;
+		return;
+	}
+	case RadixNodeType::Node48: {
+		RadixNode48* pNode = static_cast<RadixNode48*>(pInner);
+		pNode->Children[pNode->ChildIndex[key] - 1] = nullptr;
+		pNode->ChildIndex[key] = 0;
+		pNode->ChildCount--;
+
+		if (pNode->ChildCount > 12) {
+			return;
+		}
+
+		RadixNode16* pShrunk = dbg_new RadixNode16;
+		pShrunk->CopyHeader(pNode);
+		int iCount = 0;
+		for (int i = 0; i < 256; ++i) {
+			if (pNode->ChildIndex[i]) {
+				pShrunk->Keys[iCount] = Byte(i);
+				pShrunk->Children[iCount] = pNode->Children[pNode->ChildIndex[i] - 1];
+				iCount++;
+			}
+		}
+		*node = pShrunk;
+		delete pNode;
+		return;
+	}
+	case RadixNodeType::Node256: {
+		RadixNode256* pNode = static_cast<RadixNode256*>(pInner);
+		pNode->Children[key] = nullptr;
+		pNode->ChildCount--;
+
+		if (pNode->ChildCount > 37) {
+			return;
+		}
+
+		RadixNode48* pShrunk = dbg_new RadixNode48;
+		pShrunk->CopyHeader(pNode);
+		int iCount = 0;
+		for (int i = 0; i < 256; ++i) {
+			if (pNode->Children[i]) {
+				pShrunk->Children[iCount] = pNode->Children[i];
+				pShrunk->ChildIndex[i] = Byte(iCount + 1);
+				iCount++;
+			}
+		}
+		*node = pShrunk;
+		delete pNode;
+		return;
+	}
+	default:
+		DebugAssertMsg(false, "내부 노드가 아닙니다.");
+	}
+}
+
+inline void RadixInnerNode::Delete(RadixInnerNode* node) {
+	switch (node->Type) {
+	case RadixNodeType::Node4:   delete static_cast<RadixNode4*>(node);   return;
+	case RadixNodeType::Node16:  delete static_cast<RadixNode16*>(node);  return;
+	case RadixNodeType::Node48:  delete static_cast<RadixNode48*>(node);  return;
+	case RadixNodeType::Node256: delete static_cast<RadixNode256*>(node); return;
+	default:
+		DebugAssertMsg(false, "내부 노드가 아닙니다.");
+	}
+}
+
+NS_JC_END
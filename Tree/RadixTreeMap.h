@@ -0,0 +1,665 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 적응형 기수 트리(ART) 기반 정렬 맵
+ * 키를 비교하면서 내려가는 트리셋과 달리 키 바이트를 한 바이트씩 인덱스로 사용해서 내려간다.
+ * 탐색 비용이 데이터 수가 아니라 키 길이에 비례하고 키 비교가 리프에서 딱 한번만 일어난다.
+ *
+ * 지원하는 키: 정수 타입, String (RadixKey.h 참고)
+ * String 키는 탐색시 버퍼를 복사하지 않고 그대로 바이트열로 사용한다.
+ *
+ * 트리셋과 같은 이름의 질의 함수를 제공한다. (Search, Begin, LowerBound, UpperBound, ForEach, Size)
+ * 반복자는 HashMap처럼 Pair<TKey, TValue>를 반환한다.
+ */
+
+#pragma once
+
+#include <JCore/Math.h>
+
+#include <cstring>
+
+#include "RadixKey.h"
+#include "RadixNode.h"
+#include "RadixTreeMapIterator.h"
+#include "TreeNode.h"
+#include "TreeSerializer.h"
+
+NS_JC_BEGIN
+
+template <typename TKey, typename TValue>
+class RadixTreeMap
+{
+	using TLeaf				= RadixLeaf<TKey, TValue>;
+	using TRadixKey			= RadixKey<TKey>;
+	using TRadixTreeMap		= RadixTreeMap<TKey, TValue>;
+	using TKeyValuePair		= Pair<TKey, TValue>;
+public:
+	using TIterator			= RadixTreeMapIterator<TKey, TValue>;
+
+	RadixTreeMap() : m_pRoot(nullptr), m_iSize(0) {}
+	RadixTreeMap(const TRadixTreeMap&) = delete;
+	~RadixTreeMap() { Clear(); }
+
+	TRadixTreeMap& operator=(const TRadixTreeMap&) = delete;
+
+	// 이미 있는 키면 false를 반환하고 값을 바꾸지 않는다.
+	template <typename Key, typename Value>
+	bool Insert(Key&& key, Value&& value) {
+		const TRadixKey radixKey(key);
+		RadixNode** ppSlot = &m_pRoot;
+		int iDepth = 0;
+
+		while (*ppSlot != nullptr) {
+			RadixNode* pNode = *ppSlot;
+
+			if (pNode->IsLeaf()) {
+				// 리프 자리에서 두 키가 갈라지는 지점까지를 접두사로 갖는 Node4로 교체한다.
+				TLeaf* pLeaf = static_cast<TLeaf*>(pNode);
+				const TRadixKey leafKey(pLeaf->Item.Key);
+
+				if (IsEqual(leafKey, radixKey)) {
+					return false;
+				}
+
+				const int iCommon = CommonPrefixLength(leafKey, radixKey, iDepth);
+				RadixNode4* pSplit = dbg_new RadixNode4;
+				pSplit->PrefixLength = iCommon;
+				Memory::CopyUnsafe(pSplit->Prefix, radixKey.Source() + iDepth, Math::Min(iCommon, RadixInnerNode::MaxPrefixLength));
+				*ppSlot = pSplit;
+				RadixInnerNode::AddChild(ppSlot, leafKey[iDepth + iCommon], pLeaf);
+				RadixInnerNode::AddChild(ppSlot, radixKey[iDepth + iCommon], NewLeaf(Forward<Key>(key), Forward<Value>(value)));
+				return true;
+			}
+
+			RadixInnerNode* pInner = static_cast<RadixInnerNode*>(pNode);
+
+			if (pInner->PrefixLength > 0) {
+				const int iMismatch = PrefixMismatch(pInner, radixKey, iDepth);
+
+				if (iMismatch < pInner->PrefixLength) {
+					// 압축된 접두사 중간에서 갈라지므로 갈라지는 지점에 Node4를 새로 끼워넣는다.
+					RadixNode4* pSplit = dbg_new RadixNode4;
+					pSplit->PrefixLength = iMismatch;
+					Memory::CopyUnsafe(pSplit->Prefix, pInner->Prefix, Math::Min(iMismatch, RadixInnerNode::MaxPrefixLength));
+					*ppSlot = pSplit;
+
+					if (pInner->PrefixLength <= RadixInnerNode::MaxPrefixLength) {
+						const Byte uiKey = pInner->Prefix[iMismatch];
+						pInner->PrefixLength -= iMismatch + 1;
+						ShiftPrefix(pInner, pInner->Prefix + iMismatch + 1);
+						RadixInnerNode::AddChild(ppSlot, uiKey, pInner);
+					} else {
+						// 저장되지 않은 접두사는 서브트리의 리프 키에서 가져온다.
+						const TRadixKey minKey(Minimum(pInner)->Item.Key);
+						pInner->PrefixLength -= iMismatch + 1;
+						ShiftPrefix(pInner, minKey.Source() + iDepth + iMismatch + 1);
+						RadixInnerNode::AddChild(ppSlot, minKey[iDepth + iMismatch], pInner);
+					}
+
+					RadixInnerNode::AddChild(ppSlot, radixKey[iDepth + iMismatch], NewLeaf(Forward<Key>(key), Forward<Value>(value)));
+					return true;
+				}
+
+				iDepth += pInner->PrefixLength;
+			}
+
+			RadixNode** ppChild = pInner->FindChild(radixKey[iDepth]);
+
+			if (ppChild == nullptr) {
+				RadixInnerNode::AddChild(ppSlot, radixKey[iDepth], NewLeaf(Forward<Key>(key), Forward<Value>(value)));
+				return true;
+			}
+
+			ppSlot = ppChild;
+			iDepth++;
+		}
+
+		*ppSlot = NewLeaf(Forward<Key>(key), Forward<Value>(value));
+		return true;
+	}
+
+	bool Remove(const TKey& key) {
+		const TRadixKey radixKey(key);
+		RadixNode** ppParentSlot = nullptr;
+		RadixNode** ppSlot = &m_pRoot;
+		int iDepth = 0;
+		Byte uiChildKey = 0;
+
+		while (*ppSlot != nullptr) {
+			RadixNode* pNode = *ppSlot;
+
+			if (pNode->IsLeaf()) {
+				TLeaf* pLeaf = static_cast<TLeaf*>(pNode);
+
+				if (!IsEqual(TRadixKey(pLeaf->Item.Key), radixKey)) {
+					return false;
+				}
+
+				if (ppParentSlot == nullptr) {
+					*ppSlot = nullptr;
+				} else {
+					RadixInnerNode::RemoveChild(ppParentSlot, uiChildKey);
+				}
+
+				delete pLeaf;
+				--m_iSize;
+				return true;
+			}
+
+			RadixInnerNode* pInner = static_cast<RadixInnerNode*>(pNode);
+
+			if (pInner->PrefixLength > 0) {
+				if (CheckPrefix(pInner, radixKey, iDepth) != Math::Min(pInner->PrefixLength, RadixInnerNode::MaxPrefixLength)) {
+					return false;
+				}
+
+				iDepth += pInner->PrefixLength;
+			}
+
+			if (iDepth >= radixKey.Length()) {
+				return false;
+			}
+
+			uiChildKey = radixKey[iDepth];
+			RadixNode** ppChild = pInner->FindChild(uiChildKey);
+
+			if (ppChild == nullptr) {
+				return false;
+			}
+
+			ppParentSlot = ppSlot;
+			ppSlot = ppChild;
+			iDepth++;
+		}
+
+		return false;
+	}
+
+	TValue* Find(const TKey& key) const {
+		TLeaf* pLeaf = FindLeaf(key);
+		return pLeaf ? &pLeaf->Item.Value : nullptr;
+	}
+
+	bool Search(const TKey& key) const { return FindLeaf(key) != nullptr; }
+
+	void Clear() {
+		DeleteNodeRecursive(m_pRoot);
+		m_pRoot = nullptr;
+		m_iSize = 0;
+	}
+
+	int Size() const { return m_iSize; }
+	bool IsEmpty() const { return m_iSize == 0; }
+
+	TIterator Begin() const {
+		TIterator it;
+		it.SeekFirst(m_pRoot);
+		return it;
+	}
+
+	// key 이상인 첫번째 데이터 위치
+	TIterator LowerBound(const TKey& key) const {
+		TIterator it;
+		SeekLowerBound(it, m_pRoot, TRadixKey(key), 0);
+		return it;
+	}
+
+	// key 초과인 첫번째 데이터 위치
+	TIterator UpperBound(const TKey& key) const {
+		TIterator it = LowerBound(key);
+
+		if (it.HasNext() && IsEqual(TRadixKey(it.Current().Key), TRadixKey(key))) {
+			it.Next();
+		}
+
+		return it;
+	}
+
+	// 오름차순 순회
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		ForEachRecursive(m_pRoot, consumer);
+	}
+
+	// 키 순서, 크기와 함께 노드 종류별 자식 수 범위, 접두사(생략된 부분 포함)와 자식 키 바이트가 서브트리의 리프 키와 맞는지 확인한다.
+	// 리프마다 모든 조상에서 한번씩 확인하므로 O(n * 키 길이)
+	TreeValidateError Validate() const {
+		const TLeaf* pPrev = nullptr;
+		int iCount = 0;
+		const TreeValidateError eError = ValidateRecursive(m_pRoot, 0, pPrev, iCount);
+
+		if (eError != TreeValidateError::None) {
+			return eError;
+		}
+
+		return iCount == m_iSize ? TreeValidateError::None : TreeValidateError::Size;
+	}
+
+	// type 종류의 노드 수 (Leaf면 데이터 수) O(n)
+	int NodeCount(RadixNodeType type) const {
+		return NodeCountRecursive(m_pRoot, type);
+	}
+
+	// 키 바이트열이 prefix로 시작하는 데이터를 오름차순으로 순회한다.
+	// String 키라면 널문자를 제외한 문자열 접두사로 검색하면 된다.
+	template <typename Consumer>
+	void ForEachPrefix(const Byte* prefix, int prefixLength, Consumer&& consumer) const {
+		RadixNode* pNode = m_pRoot;
+		int iDepth = 0;
+
+		while (pNode != nullptr) {
+			if (pNode->IsLeaf()) {
+				TLeaf* pLeaf = static_cast<TLeaf*>(pNode);
+				const TRadixKey leafKey(pLeaf->Item.Key);
+
+				if (leafKey.Length() >= prefixLength && memcmp(leafKey.Source(), prefix, prefixLength) == 0) {
+					consumer(pLeaf->Item);
+				}
+				return;
+			}
+
+			RadixInnerNode* pInner = static_cast<RadixInnerNode*>(pNode);
+
+			if (iDepth >= prefixLength) {
+				ForEachRecursive(pNode, consumer);
+				return;
+			}
+
+			if (pInner->PrefixLength > 0) {
+				// 접두사가 남은 검색 범위를 덮으면 서브트리 전체가 후보다. (생략된 접두사 때문에 리프 키로 한번 더 확인)
+				const int iMismatch = PrefixMismatch(pInner, prefix, prefixLength, iDepth);
+
+				if (iDepth + iMismatch >= prefixLength) {
+					const TRadixKey minKey(Minimum(pInner)->Item.Key);
+					if (minKey.Length() >= prefixLength && memcmp(minKey.Source(), prefix, prefixLength) == 0) {
+						ForEachRecursive(pNode, consumer);
+					}
+					return;
+				}
+
+				if (iMismatch < pInner->PrefixLength) {
+					return;
+				}
+
+				iDepth += pInner->PrefixLength;
+			}
+
+			RadixNode** ppChild = pInner->FindChild(prefix[iDepth]);
+			pNode = ppChild ? *ppChild : nullptr;
+			iDepth++;
+		}
+	}
+
+	template <typename Consumer>
+	void ForEachPrefix(const String& prefix, Consumer&& consumer) const {
+		ForEachPrefix(reinterpret_cast<const Byte*>(prefix.Source()), prefix.Length(), Forward<Consumer>(consumer));
+	}
+
+	// 오름차순으로 [키][값]을 stream에 기록한다. (형식은 TreeSerializer.h 참고)
+	void Serialize(Stream& stream) const {
+		TreeStreamWriter writer(stream);
+		TreeSerializeCodec<TKey, true> keyCodec;
+		TreeSerializeCodec<TValue, false> valueCodec;
+
+		TreeSerializeHeader::Write(writer, keyCodec.Encoding, valueCodec.Encoding, m_iSize);
+		ForEach([&](const TKeyValuePair& pair) {
+			keyCodec.Write(writer, pair.Key);
+			valueCodec.Write(writer, pair.Value);
+		});
+		writer.Flush();
+	}
+
+	// 기존 데이터를 모두 지우고 Serialize로 기록된 데이터를 읽는다.
+	// 기수 트리는 모양이 키로만 정해지므로 회전이 없고 삽입 비용도 키 길이에만 비례해서 그냥 순서대로 삽입한다.
+	// 형식이 다르거나 데이터가 잘렸거나 중복 키가 있으면 false를 반환하고 빈 맵이 된다.
+	bool Deserialize(Stream& stream) {
+		Clear();
+
+		TreeStreamReader reader(stream);
+		TreeSerializeCodec<TKey, true> keyCodec;
+		TreeSerializeCodec<TValue, false> valueCodec;
+		Int64 iCount;
+		bool bValid = TreeSerializeHeader::Read(reader, keyCodec.Encoding, valueCodec.Encoding, iCount);
+
+		for (Int64 i = 0; bValid && i < iCount; ++i) {
+			TKey key;
+			TValue value;
+			bValid = keyCodec.Read(reader, key) && valueCodec.Read(reader, value) && Insert(Move(key), Move(value));
+		}
+
+		reader.Finish();
+
+		if (!bValid) {
+			Clear();
+		}
+
+		return bValid;
+	}
+private:
+	template <typename Key, typename Value>
+	TLeaf* NewLeaf(Key&& key, Value&& value) {
+		++m_iSize;
+		return dbg_new TLeaf(Forward<Key>(key), Forward<Value>(value));
+	}
+
+	TLeaf* FindLeaf(const TKey& key) const {
+		const TRadixKey radixKey(key);
+		RadixNode* pNode = m_pRoot;
+		int iDepth = 0;
+
+		while (pNode != nullptr) {
+			if (pNode->IsLeaf()) {
+				TLeaf* pLeaf = static_cast<TLeaf*>(pNode);
+				return IsEqual(TRadixKey(pLeaf->Item.Key), radixKey) ? pLeaf : nullptr;
+			}
+
+			RadixInnerNode* pInner = static_cast<RadixInnerNode*>(pNode);
+
+			// 낙관적 검사: 저장된 접두사만 비교하고 생략된 부분은 리프에서 전체 키로 확인한다.
+			if (pInner->PrefixLength > 0) {
+				if (CheckPrefix(pInner, radixKey, iDepth) != Math::Min(pInner->PrefixLength, RadixInnerNode::MaxPrefixLength)) {
+					return nullptr;
+				}
+
+				iDepth += pInner->PrefixLength;
+			}
+
+			if (iDepth >= radixKey.Length()) {
+				return nullptr;
+			}
+
+			RadixNode** ppChild = pInner->FindChild(radixKey[iDepth]);
+			pNode = ppChild ? *ppChild : nullptr;
+			iDepth++;
+		}
+
+		return nullptr;
+	}
+
+	// it을 node 서브트리 기준 key 이상인 첫 리프에 위치시킨다. 서브트리에 없으면 스택에 남은 상위 노드에서 이어서 찾는다.
+	static void SeekLowerBound(TIterator& it, RadixNode* node, const TRadixKey& key, int depth) {
+		if (node == nullptr) {
+			it.Advance();
+			return;
+		}
+
+		if (node->IsLeaf()) {
+			TLeaf* pLeaf = static_cast<TLeaf*>(node);
+
+			if (Compare(TRadixKey(pLeaf->Item.Key), key) >= 0) {
+				it.m_pCurrent = pLeaf;
+			} else {
+				it.Advance();
+			}
+			return;
+		}
+
+		RadixInnerNode* pInner = static_cast<RadixInnerNode*>(node);
+
+		if (pInner->PrefixLength > 0) {
+			const TRadixKey minKey(Minimum(pInner)->Item.Key);
+
+			for (int i = 0; i < pInner->PrefixLength; ++i) {
+				const int iPrefixByte = minKey[depth + i];
+				const int iKeyByte = depth + i < key.Length() ? key[depth + i] : -1;
+
+				if (iKeyByte < iPrefixByte) {
+					// 서브트리 전체가 key보다 크다.
+					it.SeekFirst(node);
+					return;
+				}
+
+				if (iKeyByte > iPrefixByte) {
+					// 서브트리 전체가 key보다 작다.
+					it.Advance();
+					return;
+				}
+			}
+
+			depth += pInner->PrefixLength;
+		}
+
+		if (depth >= key.Length()) {
+			it.SeekFirst(node);
+			return;
+		}
+
+		const Byte uiKey = key[depth];
+		RadixNode** ppChild = pInner->FindChild(uiKey);
+
+		if (ppChild == nullptr) {
+			it.Push(pInner, uiKey);
+			it.Advance();
+			return;
+		}
+
+		it.Push(pInner, uiKey + 1);
+		SeekLowerBound(it, *ppChild, key, depth + 1);
+	}
+
+	template <typename Consumer>
+	static void ForEachRecursive(RadixNode* node, Consumer& consumer) {
+		if (node == nullptr) {
+			return;
+		}
+
+		if (node->IsLeaf()) {
+			consumer(static_cast<TLeaf*>(node)->Item);
+			return;
+		}
+
+		const RadixInnerNode* pInner = static_cast<RadixInnerNode*>(node);
+		int iKey = -1;
+		RadixNode* pChild;
+
+		while (iKey < 255 && (pChild = pInner->NextChild(iKey + 1, iKey)) != nullptr) {
+			ForEachRecursive(pChild, consumer);
+		}
+	}
+
+	// 노드를 바꾸는 기준 (AddChild, RemoveChild) 사이의 자식 수. Node4는 자식이 하나 남으면 없어진다.
+	static bool IsValidChildCount(const RadixInnerNode* node) {
+		switch (node->Type) {
+		case RadixNodeType::Node4:		return node->ChildCount >= 2 && node->ChildCount <= 4;
+		case RadixNodeType::Node16:		return node->ChildCount >= 4 && node->ChildCount <= 16;
+		case RadixNodeType::Node48:		return node->ChildCount >= 13 && node->ChildCount <= 48;
+		case RadixNodeType::Node256:	return node->ChildCount >= 38 && node->ChildCount <= 256;
+		default:						return false;
+		}
+	}
+
+	// child 서브트리의 모든 리프 키가 depth부터 node의 접두사, childKey 순서로 이어지는지 확인한다.
+	// 생략된 접두사 바이트는 node 서브트리의 가장 작은 리프 키와 비교한다.
+	static bool MatchesPath(RadixNode* child, RadixInnerNode* node, int depth, Byte childKey) {
+		const TRadixKey minKey(Minimum(node)->Item.Key);
+		const int iStoredLength = Math::Min(node->PrefixLength, RadixInnerNode::MaxPrefixLength);
+		const int iChildKeyDepth = depth + node->PrefixLength;
+		bool bMatched = true;
+
+		auto matcher = [&](const TKeyValuePair& item) {
+			const TRadixKey leafKey(item.Key);
+
+			if (leafKey.Length() <= iChildKeyDepth || leafKey[iChildKeyDepth] != childKey) {
+				bMatched = false;
+				return;
+			}
+
+			for (int i = 0; i < node->PrefixLength; ++i) {
+				const Byte uiExpected = i < iStoredLength ? node->Prefix[i] : minKey[depth + i];
+				if (leafKey[depth + i] != uiExpected) {
+					bMatched = false;
+					return;
+				}
+			}
+		};
+
+		ForEachRecursive(child, matcher);
+
+		return bMatched;
+	}
+
+	static TreeValidateError ValidateRecursive(RadixNode* node, int depth, const TLeaf*& prev, int& count) {
+		if (node == nullptr) {
+			return TreeValidateError::None;
+		}
+
+		if (node->IsLeaf()) {
+			const TLeaf* pLeaf = static_cast<TLeaf*>(node);
+
+			if (prev != nullptr && Compare(TRadixKey(prev->Item.Key), TRadixKey(pLeaf->Item.Key)) >= 0) {
+				return TreeValidateError::Order;
+			}
+
+			prev = pLeaf;
+			++count;
+			return TreeValidateError::None;
+		}
+
+		RadixInnerNode* pInner = static_cast<RadixInnerNode*>(node);
+
+		if (!IsValidChildCount(pInner)) {
+			return TreeValidateError::Structure;
+		}
+
+		int iKey = -1;
+		int iChildCount = 0;
+		RadixNode* pChild;
+
+		while (iKey < 255 && (pChild = pInner->NextChild(iKey + 1, iKey)) != nullptr) {
+			if (!MatchesPath(pChild, pInner, depth, Byte(iKey))) {
+				return TreeValidateError::Structure;
+			}
+
+			const TreeValidateError eError = ValidateRecursive(pChild, depth + pInner->PrefixLength + 1, prev, count);
+			if (eError != TreeValidateError::None) {
+				return eError;
+			}
+
+			++iChildCount;
+		}
+
+		return iChildCount == pInner->ChildCount ? TreeValidateError::None : TreeValidateError::Structure;
+	}
+
+	static int NodeCountRecursive(RadixNode* node, RadixNodeType type) {
+		if (node == nullptr) {
+			return 0;
+		}
+
+		int iCount = node->Type == type;
+		if (node->IsLeaf()) {
+			return iCount;
+		}
+
+		const RadixInnerNode* pInner = static_cast<RadixInnerNode*>(node);
+		int iKey = -1;
+		RadixNode* pChild;
+
+		while (iKey < 255 && (pChild = pInner->NextChild(iKey + 1, iKey)) != nullptr) {
+			iCount += NodeCountRecursive(pChild, type);
+		}
+
+		return iCount;
+	}
+
+	static void DeleteNodeRecursive(RadixNode* node) {
+		if (node == nullptr) {
+			return;
+		}
+
+		if (node->IsLeaf()) {
+			delete static_cast<TLeaf*>(node);
+			return;
+		}
+
+		RadixInnerNode* pInner = static_cast<RadixInnerNode*>(node);
+		int iKey = -1;
+		RadixNode* pChild;
+
+		while (iKey < 255 && (pChild = pInner->NextChild(iKey + 1, iKey)) != nullptr) {
+			DeleteNodeRecursive(pChild);
+		}
+
+		RadixInnerNode::Delete(pInner);
+	}
+
+	static TLeaf* Minimum(RadixNode* node) {
+		while (!node->IsLeaf()) {
+			int iKey;
+			node = static_cast<RadixInnerNode*>(node)->NextChild(0, iKey);
+		}
+
+		return static_cast<TLeaf*>(node);
+	}
+
+	static bool IsEqual(const TRadixKey& lhs, const TRadixKey& rhs) {
+		return lhs.Length() == rhs.Length() && memcmp(lhs.Source(), rhs.Source(), lhs.Length()) == 0;
+	}
+
+	static int Compare(const TRadixKey& lhs, const TRadixKey& rhs) {
+		const int iResult = memcmp(lhs.Source(), rhs.Source(), Math::Min(lhs.Length(), rhs.Length()));
+
+		if (iResult != 0) {
+			return iResult;
+		}
+
+		return lhs.Length() - rhs.Length();
+	}
+
+	static int CommonPrefixLength(const TRadixKey& lhs, const TRadixKey& rhs, int depth) {
+		const int iMaxLength = Math::Min(lhs.Length(), rhs.Length()) - depth;
+		int i = 0;
+		while (i < iMaxLength && lhs[depth + i] == rhs[depth + i]) ++i;
+		return i;
+	}
+
+	// 노드에 저장된 접두사 바이트만 비교해서 일치하는 길이를 반환한다.
+	static int CheckPrefix(const RadixInnerNode* node, const TRadixKey& key, int depth) {
+		const int iMaxLength = Math::Min(Math::Min(node->PrefixLength, RadixInnerNode::MaxPrefixLength), key.Length() - depth);
+		int i = 0;
+		while (i < iMaxLength && node->Prefix[i] == key[depth + i]) ++i;
+		return i;
+	}
+
+	// 생략된 접두사까지 포함해서 처음으로 어긋나는 위치를 반환한다.
+	static int PrefixMismatch(RadixInnerNode* node, const TRadixKey& key, int depth) {
+		return PrefixMismatch(node, key.Source(), key.Length(), depth);
+	}
+
+	static int PrefixMismatch(RadixInnerNode* node, const Byte* key, int keyLength, int depth) {
+		int iMaxLength = Math::Min(Math::Min(node->PrefixLength, RadixInnerNode::MaxPrefixLength), keyLength - depth);
+		int i = 0;
+
+		for (; i < iMaxLength; ++i) {
+			if (node->Prefix[i] != key[depth + i]) {
+				return i;
+			}
+		}
+
+		if (node->PrefixLength > RadixInnerNode::MaxPrefixLength) {
+			const TRadixKey minKey(Minimum(node)->Item.Key);
+			iMaxLength = Math::Min(Math::Min(minKey.Length(), keyLength) - depth, node->PrefixLength);
+
+			for (; i < iMaxLength; ++i) {
+				if (minKey[depth + i] != key[depth + i]) {
+					return i;
+				}
+			}
+		}
+
+		return i;
+	}
+
+	// 접두사를 잘라낸 나머지를 source에서 다시 채운다. (source가 node->Prefix 뒷부분이어도 앞에서부터 복사하므로 안전)
+	static void ShiftPrefix(RadixInnerNode* node, const Byte* source) {
+		const int iLength = Math::Min(node->PrefixLength, RadixInnerNode::MaxPrefixLength);
+		for (int i = 0; i < iLength; ++i) {
+			node->Prefix[i] = source[i];
+		}
+	}
+
+	RadixNode* m_pRoot;
+	int m_iSize;
+};
+
+NS_JC_END
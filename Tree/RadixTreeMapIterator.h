@@ -0,0 +1,100 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 기수 트리 맵 순회 반복자
+ * 기수 트리 노드는 부모 링크가 없으므로 (내부 노드, 다음에 볼 키 바이트)를 스택으로 들고 다닌다.
+ * 키 바이트 순서가 곧 키 순서이므로 깊이 우선으로 작은 바이트부터 내려가면 오름차순 순회가 된다.
+ */
+
+#pragma once
+
+#include <JCore/Container/ArrayStack.h>
+
+#include "RadixNode.h"
+
+NS_JC_BEGIN
+
+template <typename, typename> class RadixTreeMap;
+
+template <typename TKey, typename TValue>
+class RadixTreeMapIterator
+{
+	using TLeaf				= RadixLeaf<TKey, TValue>;
+	using TKeyValuePair		= Pair<TKey, TValue>;
+
+	struct Frame
+	{
+		const RadixInnerNode* Node;
+		int NextKey;			// 이 노드에서 다음으로 내려갈 자식의 최소 키 바이트 (0 ~ 256)
+	};
+public:
+	RadixTreeMapIterator() : m_Stack(8), m_pCurrent(nullptr) {}
+
+	bool HasNext() const { return m_pCurrent != nullptr; }
+	bool IsEnd() const { return m_pCurrent == nullptr; }
+
+	TKeyValuePair& Current() const {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		return m_pCurrent->Item;
+	}
+
+	// 현재 데이터를 반환하고 다음 리프로 이동
+	TKeyValuePair& Next() {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		TLeaf* pCur = m_pCurrent;
+		Advance();
+		return pCur->Item;
+	}
+private:
+	// node 서브트리의 가장 작은 리프부터 순회하도록 한다.
+	void SeekFirst(RadixNode* node) {
+		if (node == nullptr) {
+			m_pCurrent = nullptr;
+			return;
+		}
+
+		if (node->IsLeaf()) {
+			m_pCurrent = static_cast<TLeaf*>(node);
+			return;
+		}
+
+		Push(static_cast<RadixInnerNode*>(node), 0);
+		Advance();
+	}
+
+	void Push(const RadixInnerNode* node, int nextKey) {
+		m_Stack.Push(Frame{ node, nextKey });
+	}
+
+	// 스택 최상단 노드부터 아직 방문하지 않은 다음 자식으로 내려가서 리프를 찾는다.
+	void Advance() {
+		while (!m_Stack.IsEmpty()) {
+			Frame& frame = m_Stack.Top();
+			int iKey;
+			RadixNode* pChild = frame.NextKey < 256 ? frame.Node->NextChild(frame.NextKey, iKey) : nullptr;
+
+			if (pChild == nullptr) {
+				m_Stack.Pop();
+				continue;
+			}
+
+			frame.NextKey = iKey + 1;
+
+			if (pChild->IsLeaf()) {
+				m_pCurrent = static_cast<TLeaf*>(pChild);
+				return;
+			}
+
+			Push(static_cast<RadixInnerNode*>(pChild), 0);
+		}
+
+		m_pCurrent = nullptr;
+	}
+
+	ArrayStack<Frame> m_Stack;
+	TLeaf* m_pCurrent;
+
+	friend class RadixTreeMap<TKey, TValue>;
+};
+
+NS_JC_END
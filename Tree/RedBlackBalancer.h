@@ -0,0 +1,399 @@
+﻿/*
+ * 작성자: 윤정도
+ * 생성일: 5/26/2023
+ * =====================
+ * 레드블랙트리 균형 정책
+ * 학습결과 보고서: https://blog.naver.com/reversing_joa/223116951373
+ *
+ * 트리셋에서 레드블랙트리 속성 위반 수정 코드만 떼어낸 것이다.
+ * 탐색/회전/순회는 TreeSet이 담당하고 이 정책은 색상 변경과 회전 시점만 결정한다.
+ */
+
+#pragma once
+
+#include <JCore/Primitives/String.h>
+
+#include "TreeNode.h"
+#include "TreeStatistics.h"
+
+NS_JC_BEGIN
+
+struct RedBlackNodeTag
+{
+	TreeNodeColor Color = TreeNodeColor::Red;
+};
+
+template <typename TNode>
+struct TreeNodeFamily
+{
+	/* Not Null */ TNode* Parent;
+	/* Not Null */ TNode* Sibling;
+	/* Nullable */ TNode* NephewLine;
+	/* Nullable */ TNode* NephewTri;
+
+	TreeNodeColor ParentColor;
+	TreeNodeColor SiblingColor;
+	TreeNodeColor NephewLineColor;
+	TreeNodeColor NephewTriColor;
+
+	#pragma region PUBLIC FIELDS
+	TreeNodeFamily(TNode* child) {
+		const bool bRightChild = child->IsRight();
+		Parent = child->Parent;									// 부모 노드
+		DebugAssertMsg(Parent, "부모노드 없을 수 없습니다.");
+
+		Sibling = bRightChild ? Parent->Left : Parent->Right;	// 형제 노드 (child가 우측이면 부모의 왼쪽 노드가 형제 노드)
+		DebugAssertMsg(Sibling, "형제노드가 없을 수 없습니다.");
+
+		if (Sibling->IsLeft()) {
+			NephewLine = Sibling->Left;							// 조카 노드 (일렬로 나열)
+			NephewTri = Sibling->Right;							// 조카 노드 (꺽여서 나열)
+		}
+		else {
+			NephewLine = Sibling->Right;
+			NephewTri = Sibling->Left;
+		}
+
+		// 노드가 없는 경우 Black으로 판정토록한다.
+		ParentColor = Parent->Color;
+		SiblingColor = Sibling->Color;
+		NephewTriColor = NephewTri ? NephewTri->Color : TreeNodeColor::Black;
+		NephewLineColor = NephewLine ? NephewLine->Color : TreeNodeColor::Black;
+	}
+	#pragma endregion
+	// PUBLIC FIELDS
+
+};
+
+struct RedBlackBalancer
+{
+	using TNodeTag = RedBlackNodeTag;
+
+	// 삽입 위반 수정
+	template <typename TTree, typename TNode>
+	static void InsertFixup(TTree& tree, TNode* child) {
+
+		// (1) 루트 노드는 Black이다.
+		if (child == tree.m_pRoot) {
+			child->Color = TreeNodeColor::Black;
+			tree.m_Statistics.OnRecolor();
+			return;
+		}
+
+		TNode* pParent = child->Parent;		// (1)에서 종료되지 않았다면 무조건 부모가 존재함.
+		TreeNodeColor eParentColor = pParent->Color;
+
+		/*  (2) Red 노드의 자식은 Black이어야한다.
+		 *  만약 자식과 부모가 색상이 모두 빨간색이 아닌 경우 더이상 검사할 필요가 없다.
+		 *  조상님이 없는 경우, 즉 pParent가 루트 노드인 경우
+		 *  루트 노드는 무조건 Black이고 새로 삽입된 노드는 Red이므로 트리 높이가 2일때는 항상 RB트리의 모든 조건에 만족한다.
+		 *   => 따라서 InsertFixup 수행시 아무것도 할게 없다.
+		*
+		 *     5    root = parent (black)          5         root = parent (black)
+		 *   1	 ?	child (red)                  ?   10		 child (red)
+		 *
+		 */
+		if (eParentColor != TreeNodeColor::Red || child->Color != TreeNodeColor::Red) {
+			return;
+		}
+
+		// 노드 깊이(트리 높이)가 2인 경우는 모두 위 IF문에서 걸러지므로 이후로 GrandParent가 nullptr일 수 없다.
+		TNode* pGrandParent = pParent->Parent;
+		TNode* pUncle = nullptr;						// 삼촌 노드정보 (부모가 조상님의 왼쪽자식인 경우 조상님의 오른쪽 자식이 삼촌 노드)
+		if (pGrandParent != nullptr) {
+			if (pGrandParent->Left == pParent)
+				pUncle = pGrandParent->Right;
+			else
+				pUncle = pGrandParent->Left;
+		}
+		DebugAssertMsg(pGrandParent, "그랜드 부모가 NULL입니다.");
+		const TreeNodeColor eUncleColor = pUncle ? pUncle->Color : TreeNodeColor::Black; // 삼촌 노드는 있을 수도 없을 수도 있고. NIL 노드는 Black이다.
+
+
+		/*
+		 * Case 1: 삼촌 노드가 Black일 경우
+		 *			Case 1-1
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    5(R)	 ?(B)			<- parent, uncle
+		 *			  1(R) ?					<- child
+		 *
+		 *			Case 1-2
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *		       ?(B)   15(R)				<- uncle, parent
+		 *                       21(R)			<- child
+		 *
+		 *
+		 *		    Case 1-3 (삼각형 모양) - 5를 RR회전하여 Case 1-1의 모양으로 변환해줘야한다.
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    5(R)	 ?(B)			<- parent, uncle
+		 * 				   7(R) 				<- child
+		 *				              ↓ 변환 후
+		 *			       10(B)				<- grandparent
+		 *			     7(R)	 ?(B)			<- child, uncle	==>
+		 * 			  5(R) ?					<- parent
+		 *
+		 *		    Case 1-4 (삼각형 모양) - 5를 RR회전하여 Case 1-1의 모양으로 변환해줘야한다.
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    ?(B)	 15(R)			<- parent, uncle
+		 * 				      12(R) 			<- child
+		 *				              ↓ 변환 후
+		 *			       10(B)				<- grandparent
+		 *			    ?(B)	12(R)			<- child, uncle
+		 * 				            10(R) 		<- parent
+		 *
+		 *
+		 */
+
+		 // Case 1
+		if (eUncleColor == TreeNodeColor::Black) {
+			if (pParent->IsLeft()) {
+				if (child->IsLeft()) {
+					// Case 1-1 (조상이 루트노드였다면 회전시 부모가 루트로 올라온다.)
+					tree.m_Statistics.OnInsertCase(RedBlackInsertCase::Case1_1);
+					tree.m_Statistics.OnRecolor(2);
+					pGrandParent->Color = TreeNodeColor::Red;
+					pParent->Color = TreeNodeColor::Black;
+					tree.RotateLL(pGrandParent);
+				}
+				else {
+					// Case 1-3
+					tree.m_Statistics.OnInsertCase(RedBlackInsertCase::Case1_3);
+					tree.RotateRR(pParent);
+					InsertFixup(tree, pParent);
+				}
+			}
+			else {
+				if (child->IsRight()) {
+					// Case 1-2 (조상이 루트노드였다면 회전시 부모가 루트로 올라온다.)
+					tree.m_Statistics.OnInsertCase(RedBlackInsertCase::Case1_2);
+					tree.m_Statistics.OnRecolor(2);
+					pGrandParent->Color = TreeNodeColor::Red;
+					pParent->Color = TreeNodeColor::Black;
+					tree.RotateRR(pGrandParent);
+				}
+				else {
+					// Case 1-4
+					tree.m_Statistics.OnInsertCase(RedBlackInsertCase::Case1_4);
+					tree.RotateLL(pParent);
+					InsertFixup(tree, pParent);
+				}
+			}
+			return;
+		}
+
+
+		/*
+		 * Case 2: 삼촌 노드가 Red일 경우
+		 *     이경우 Case1보다 훨씬 단순하다. 부모, 삼촌의 색상과 조상님의 색상을 바꿔줌으로써
+		 *	   RB트리 속성 4번이 위배되지 않도록 만든다.
+		 *	   그리고 조상님이 Red가 되었기 때문에 조상님의 부모가 마찬가지로 Red일 수가 있으므로
+		 *	   조상님을 기준으로 다시 Fixup을 수행해주면 된다.
+		 *
+		 *			Case 1-1
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    5(R)	 15(R)			<- parent, uncle
+		 *			 1(R) 						<- child
+		 *
+		 *			Case 1-2
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *		        5(R)   15(R)			<- uncle, parent
+		 *                        21(R)			<- child
+		 *
+		*		    Case 1-3 (삼각형 모양)
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    5(R)	 15(R)			<- parent, uncle
+		 * 				   7(R) 				<- child
+		 *
+		 *		    Case 1-4 (삼각형 모양)
+		 *			----------------------------------------------
+		 *			       10(B)				<- grandparent
+		 *			    5(R)	 15(R)			<- parent, uncle
+		 * 				      12(R) 			<- child
+		 *
+		 * @참고: Uncle이 Red로 판정되었다는 말은 nullptr이 아니기도하다.
+		 */
+
+
+
+		tree.m_Statistics.OnInsertCase(RedBlackInsertCase::Case2);
+		tree.m_Statistics.OnRecolor(3);
+		pUncle->Color = TreeNodeColor::Black;
+		pParent->Color = TreeNodeColor::Black;
+		pGrandParent->Color = TreeNodeColor::Red;
+		InsertFixup(tree, pGrandParent);
+	}
+
+	// 삭제 위반 수정
+	// 삭제될 노드가 아직 트리에 매달려 있는 상태에서 호출된다.
+	template <typename TTree, typename TNode>
+	static void RemoveFixup(TTree& tree, TNode* child) {
+
+		if (child->Color == TreeNodeColor::Red) {
+			return;
+		}
+
+		// [1. 삭제될 노드가 자식이 1개 경우]
+		TNode* pChild = child->Any();
+		if (pChild) {
+			// 케이스 1. 자식이 한개만 있는경우 (이 자식은 무조건 Red일 것이다.)
+			DebugAssertMsg(child->Count() == 1, "1. 삭제될 노드에 자식이 1개만 있어야하는데 2개 있습니다.");
+			DebugAssert(child->Color == TreeNodeColor::Black);
+			DebugAssert(pChild->Color == TreeNodeColor::Red);
+			tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::SingleChild);
+			tree.m_Statistics.OnRecolor();
+			pChild->Color = TreeNodeColor::Black;
+			return;
+		}
+
+		if (child == tree.m_pRoot) {
+			return;
+		}
+
+		RemoveFixupExtraBlack(tree, child);
+	}
+
+	// 엑스트라 Black 속성이 부여된 노드를 대상으로 위반 수정
+	// 난 엑스트라 Black 속성이 이 함수에 들어온 것 자체로 부여되었다는 걸로 간주하기로 함.
+	template <typename TTree, typename TNode>
+	static void RemoveFixupExtraBlack(TTree& tree, TNode* child) {
+
+		if (tree.m_pRoot == child) {
+			// 루트는 엑스트라 Black속성이 부여될 경우 없애기만 하면 됨.
+			//	난 엑스트라 Black이라는 추가 정보를 굳이 노드에 담아서 표현할 필요 없다고 생각한다.
+			//	삭제중 일시적으로 존재하는 속성이기 떄문이다.
+			return;
+		}
+
+		const bool bRightChild = child->IsRight();
+		const TreeNodeFamily<TNode> family(child);
+
+
+		// 그룹 케이스 2: 부모의 색이 Black인 경우
+		if (family.ParentColor == TreeNodeColor::Black) {
+
+			// 케이스 5. (형제가 Red인 경우)
+			if (family.SiblingColor == TreeNodeColor::Red) {
+				tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group2Case5);
+				tree.m_Statistics.OnRecolor(2);
+				family.Parent->Color = TreeNodeColor::Red;
+				family.Sibling->Color = TreeNodeColor::Black;
+				tree.RotateNode(family.Parent, bRightChild ? TreeNodeRotateMode::LL : TreeNodeRotateMode::RR);
+				RemoveFixupExtraBlack(tree, child);
+				return;
+			}
+
+			// 케이스 1 ~ 4 (형제가 Black인 경우)
+			if (family.NephewTriColor == TreeNodeColor::Black &&
+				family.NephewLineColor == TreeNodeColor::Black) {
+				// 케이스 1. 조카 모두 Black인 경우
+				tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group2Case1);
+				tree.m_Statistics.OnRecolor();
+				family.Sibling->Color = TreeNodeColor::Red;
+				RemoveFixupExtraBlack(tree, family.Parent);		// Extra Black을 없앨 수 없으므로 부모로 전달
+				return;
+			}
+
+			if (family.NephewLineColor == TreeNodeColor::Red) {
+				// 케이스 2. 라인조카가 Red인 경우
+				tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group2Case2);
+				tree.m_Statistics.OnRecolor();
+				family.NephewLine->Color = TreeNodeColor::Black;
+				tree.RotateNode(family.Parent, bRightChild ? TreeNodeRotateMode::LL : TreeNodeRotateMode::RR);
+				return;
+			}
+
+			if (family.NephewTriColor == TreeNodeColor::Red) {
+				// 케이스 3. 꺽인조카가 Red인 경우
+				tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group2Case3);
+				tree.m_Statistics.OnRecolor(2);
+				family.NephewTri->Color = TreeNodeColor::Black;
+				family.Sibling->Color = TreeNodeColor::Red;
+				tree.RotateNode(family.Sibling, bRightChild ? TreeNodeRotateMode::RR : TreeNodeRotateMode::LL);
+				RemoveFixupExtraBlack(tree, child);	// 케이스 2로 처리하기위해 재호출
+				return;
+			}
+
+			return;
+		}
+
+		DebugAssertMsg(family.SiblingColor == TreeNodeColor::Black, "[그룹 케이스 1] 형제노드가 Black이 아닙니다.");
+		// 그룹 케이스 1: 부모의 색이 Red인 경우
+		if (family.NephewTriColor == TreeNodeColor::Black &&
+			family.NephewLineColor == TreeNodeColor::Black) {
+			// 케이스 1. 조카 모두 Black인 경우
+			tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group1Case1);
+			tree.m_Statistics.OnRecolor(2);
+			family.Sibling->Color = TreeNodeColor::Red;
+			family.Parent->Color = TreeNodeColor::Black;
+			return;
+		}
+
+		if (family.NephewLineColor == TreeNodeColor::Red) {
+			// 케이스 2. 라인조카가 Red인 경우
+			tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group1Case2);
+			tree.m_Statistics.OnRecolor(3);
+			family.NephewLine->Color = TreeNodeColor::Black;
+			family.Sibling->Color = TreeNodeColor::Red;
+			family.Parent->Color = TreeNodeColor::Black;
+			tree.RotateNode(family.Parent, bRightChild ? TreeNodeRotateMode::LL : TreeNodeRotateMode::RR);
+			return;
+		}
+
+		if (family.NephewTriColor == TreeNodeColor::Red) {
+			// 케이스 3. 꺽인조카가 Red인 경우
+			tree.m_Statistics.OnRemoveCase(RedBlackRemoveCase::Group1Case3);
+			tree.m_Statistics.OnRecolor(2);
+			family.NephewTri->Color = TreeNodeColor::Black;
+			family.Sibling->Color = TreeNodeColor::Red;
+			tree.RotateNode(family.Sibling, bRightChild ? TreeNodeRotateMode::RR : TreeNodeRotateMode::LL);
+			RemoveFixupExtraBlack(tree, child); // 케이스 2로 처리하기위해 재호출
+		}
+
+	}
+
+	// 레드블랙트리는 노드가 떨어지기 전에 RemoveFixup에서 수정을 끝내므로 할게 없다.
+	template <typename TTree, typename TNode>
+	static void RemoveRetrace(TTree&, TNode*) {}
+
+	// 가장 깊은 층만 Red로 두면 모든 경로의 블랙 높이가 같아진다. (빈 자리가 마지막 두 층에만 있으므로)
+	template <typename TNode>
+	static void BuildNode(TNode* node, int, bool bottom) {
+		node->Color = bottom ? TreeNodeColor::Red : TreeNodeColor::Black;
+	}
+
+	// 1. 루트는 Black
+	// 2. Red 노드의 자식은 모두 Black
+	// 3. 모든 경로의 블랙 높이가 같다. (height: 블랙 높이)
+	template <typename TNode>
+	static bool ValidateNode(const TNode* node, int leftHeight, int rightHeight, JCORE_OUT int& height) {
+		if (node->Parent == nullptr && node->Color == TreeNodeColor::Red) {
+			return false;
+		}
+
+		if (node->Color == TreeNodeColor::Red &&
+			((node->Left && node->Left->Color == TreeNodeColor::Red) || (node->Right && node->Right->Color == TreeNodeColor::Red))) {
+			return false;
+		}
+
+		if (leftHeight != rightHeight) {
+			return false;
+		}
+
+		height = leftHeight + (node->Color == TreeNodeColor::Black ? 1 : 0);
+		return true;
+	}
+
+	template <typename TNode>
+	static String DbgNodeTagString(const TNode* node) {
+		return TreeNodeColorName(node->Color);
+	}
+};
+
+NS_JC_END
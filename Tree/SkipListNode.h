@@ -0,0 +1,56 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 락프리 스킵리스트 노드
+ * 각 레벨의 다음 노드 포인터 최하위 비트를 삭제 표시로 사용한다. (노드는 최소 2바이트 정렬이므로 항상 0)
+ * 표시된 포인터는 "이 노드가 이 레벨에서 삭제되는 중"이라는 의미이고 표시된 이후에는 더이상 바뀌지 않는다.
+ *
+ * 탐색시 노드마다 데이터와 다음 포인터를 같이 읽으므로 다음 포인터 배열을 노드 뒤에 붙여서 한번에 할당한다.
+ * 그래서 new/delete 대신 Create/Destroy로 생성/해제한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Memory.h>
+#include <JCore/Primitives/Atomic.h>
+
+NS_JC_BEGIN
+
+template <typename T>
+struct SkipListNode
+{
+	using TNode = SkipListNode<T>;
+
+	static TNode* Create(const T& data, int height) {
+		TNode* pNode = Memory::Allocate<TNode*>(sizeof(TNode) + sizeof(Atomic<TNode*>) * (height - 1));
+		::new (pNode) TNode(data, height);
+		Memory::PlacementNewArray(pNode->Next + 1, height - 1);
+		return pNode;
+	}
+
+	static void Destroy(TNode* node) {
+		node->~TNode();
+		Memory::Deallocate(node);
+	}
+
+	SkipListNode(const TNode&) = delete;
+	TNode& operator=(const TNode&) = delete;
+
+	static TNode* Mark(TNode* node) { return reinterpret_cast<TNode*>(reinterpret_cast<Int64U>(node) | 1); }
+	static TNode* Unmark(TNode* node) { return reinterpret_cast<TNode*>(reinterpret_cast<Int64U>(node) & ~Int64U(1)); }
+	static bool IsMarked(TNode* node) { return (reinterpret_cast<Int64U>(node) & 1) != 0; }
+
+	// 최하위 레벨이 표시되면 논리적으로 삭제된 노드이다.
+	bool IsRemoved() { return IsMarked(Next[0].LoadAcquire()); }
+
+	T Data;
+	int Height;
+	Atomic<int> Owners;			// 삽입 쓰레드와 삭제 쓰레드가 모두 손을 떼야 회수할 수 있다.
+	Atomic<TNode*> Next[1];		// 실제 길이는 Height
+private:
+	SkipListNode(const T& data, int height) : Data(data), Height(height), Owners(2) {}
+	~SkipListNode() = default;
+};
+
+NS_JC_END
@@ -0,0 +1,329 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트립(Treap) 기반 셋
+ * 키 기준으로는 이진 탐색 트리, 무작위 우선순위 기준으로는 힙을 만족하도록 유지한다.
+ * 우선순위가 무작위이므로 기대 높이가 O(log n)이 된다.
+ *
+ * 모든 연산을 분할(Split)/병합(Join) 두가지로 구현하므로 트리 두개를 통째로 합치거나 빼는
+ * 일괄 연산이 간단하다. 크기 n, m (m <= n)인 두 트립의 합집합/차집합 기대 비용은 O(m log(n/m + 1))이다.
+ * 일괄 연산은 좌/우 서브트리를 독립적으로 처리하므로 parallelDepth를 주면 상위 parallelDepth 단계까지
+ * 한쪽 서브트리를 별도 쓰레드에서 처리한다. (최대 2^parallelDepth개 쓰레드)
+ *
+ * 탐색, 순회, 범위 질의는 TreeCollection을 그대로 사용하므로 TreeSet과 사용법이 같다.
+ */
+
+#pragma once
+
+#include <JCore/Threading/Thread.h>
+
+#include "TreeCollection.h"
+
+NS_JC_BEGIN
+
+struct TreapNodeTag
+{
+	Int32U Priority = 0;
+	int Size = 1;		// 서브트리 노드 수
+};
+
+template <typename T>
+class TreapSet : public TreeCollection<T, TreapNodeTag>
+{
+	using TTreeCollection	= TreeCollection<T, TreapNodeTag>;
+	using TNode				= typename TTreeCollection::TNode;
+	using TTreapSet			= TreapSet<T>;
+	using TTreeCollection::m_pRoot;
+	using TTreeCollection::m_iSize;
+public:
+	TreapSet() : m_uiSeed(Int32U(IntPtr(this) >> 4) * 2654435761u | 1u) {}
+
+	bool Insert(const T& data) {
+		if (this->FindNode(data) != nullptr) {
+			return false;
+		}
+
+		TNode* pNewNode = TTreeCollection::CreateNode(data);
+		pNewNode->Priority = NextPriority();
+		SetRoot(InsertRecursive(m_pRoot, pNewNode));
+		return true;
+	}
+
+	bool Remove(const T& data) {
+		if (this->FindNode(data) == nullptr) {
+			return false;
+		}
+
+		SetRoot(RemoveRecursive(m_pRoot, data));
+		return true;
+	}
+
+	// pivot 이상인 데이터를 모두 right로 옮긴다. right는 비어있어야한다.
+	void Split(const T& pivot, JCORE_OUT TTreapSet& right) {
+		DebugAssertMsg(right.IsEmpty(), "분할 대상 트립이 비어있지 않습니다.");
+		TNode* pLeft;
+		TNode* pRight;
+		SplitRecursive(m_pRoot, pivot, pLeft, pRight);
+		SetRoot(pLeft);
+		right.SetRoot(pRight);
+	}
+
+	// right의 모든 데이터를 옮겨온다. right의 모든 데이터는 이 트립의 모든 데이터보다 커야한다.
+	void Join(TTreapSet& right) {
+		DebugAssertMsg(this->IsEmpty() || right.IsEmpty() || TTreeCollection::FindBiggestNode(m_pRoot)->Data < TTreeCollection::FindSmallestNode(right.m_pRoot)->Data,
+			"병합 대상 트립의 데이터가 더 커야합니다.");
+		SetRoot(JoinRecursive(m_pRoot, right.m_pRoot));
+		right.SetRoot(nullptr);
+	}
+
+	// 합집합: other의 모든 데이터를 옮겨온다. 중복된 데이터의 노드는 해제되고 other는 비워진다.
+	void Union(TTreapSet& other, int parallelDepth = 0) {
+		if (this == &other) {
+			return;
+		}
+
+		SetRoot(UnionRecursive(m_pRoot, other.m_pRoot, parallelDepth));
+		other.SetRoot(nullptr);
+	}
+
+	// 차집합: other에 있는 데이터를 모두 제거한다. other는 변경되지 않는다.
+	void Difference(const TTreapSet& other, int parallelDepth = 0) {
+		if (this == &other) {
+			this->Clear();
+			return;
+		}
+
+		SetRoot(DifferenceRecursive(m_pRoot, other.m_pRoot, parallelDepth));
+	}
+
+	// predicate가 true를 반환하는 데이터만 남기고 제거된 데이터 수를 반환한다.
+	// parallelDepth > 0이면 같은 predicate 객체가 여러 쓰레드에서 동시에, 정해지지 않은 순서로 호출된다.
+	// 상태를 바꾸는 predicate(개수 세기, 결과 모으기 등)는 스스로 동기화하거나 parallelDepth를 0으로 둬야 한다.
+	template <typename Predicate>
+	int Filter(Predicate&& predicate, int parallelDepth = 0) {
+		const int iPrevSize = m_iSize;
+		SetRoot(FilterRecursive(m_pRoot, predicate, parallelDepth));
+		return iPrevSize - m_iSize;
+	}
+
+	// 키 순서, 부모 연결, 크기와 함께 우선순위 힙 속성, 서브트리 크기를 확인한다. O(n)
+	TreeValidateError Validate() const {
+		return this->ValidateTree([](const TNode* node, int leftSize, int rightSize, int& size) {
+			if ((node->Left && node->Left->Priority > node->Priority) || (node->Right && node->Right->Priority > node->Priority)) {
+				return false;
+			}
+
+			size = leftSize + rightSize + 1;
+			return node->Size == size;
+		});
+	}
+private:
+	static int SubtreeSize(const TNode* node) { return node ? node->Size : 0; }
+
+	// 자식이 바뀐 노드의 서브트리 크기와 자식들의 부모 링크를 갱신한다.
+	static void Update(TNode* node) {
+		node->Size = SubtreeSize(node->Left) + SubtreeSize(node->Right) + 1;
+		if (node->Left) node->Left->Parent = node;
+		if (node->Right) node->Right->Parent = node;
+	}
+
+	void SetRoot(TNode* root) {
+		m_pRoot = root;
+		if (m_pRoot) m_pRoot->Parent = nullptr;
+		m_iSize = SubtreeSize(m_pRoot);
+	}
+
+	// xorshift32
+	Int32U NextPriority() {
+		m_uiSeed ^= m_uiSeed << 13;
+		m_uiSeed ^= m_uiSeed >> 17;
+		m_uiSeed ^= m_uiSeed << 5;
+		return m_uiSeed;
+	}
+
+	// key 미만은 left, key 이상은 right
+	static void SplitRecursive(TNode* node, const T& key, JCORE_OUT TNode*& left, JCORE_OUT TNode*& right) {
+		if (node == nullptr) {
+			left = right = nullptr;
+			return;
+		}
+
+		if (node->Data < key) {
+			SplitRecursive(node->Right, key, node->Right, right);
+			left = node;
+		} else {
+			SplitRecursive(node->Left, key, left, node->Left);
+			right = node;
+		}
+
+		Update(node);
+	}
+
+	// key 미만은 left, key 초과는 right, key와 같은 노드는 떼어내서 반환한다.
+	static TNode* SplitExactRecursive(TNode* node, const T& key, JCORE_OUT TNode*& left, JCORE_OUT TNode*& right) {
+		if (node == nullptr) {
+			left = right = nullptr;
+			return nullptr;
+		}
+
+		TNode* pFound;
+
+		if (node->Data < key) {
+			pFound = SplitExactRecursive(node->Right, key, node->Right, right);
+			left = node;
+		} else if (key < node->Data) {
+			pFound = SplitExactRecursive(node->Left, key, left, node->Left);
+			right = node;
+		} else {
+			left = node->Left;
+			right = node->Right;
+			node->Left = node->Right = nullptr;
+			return node;
+		}
+
+		Update(node);
+		return pFound;
+	}
+
+	// left의 모든 데이터 < right의 모든 데이터
+	static TNode* JoinRecursive(TNode* left, TNode* right) {
+		if (left == nullptr) return right;
+		if (right == nullptr) return left;
+
+		if (left->Priority > right->Priority) {
+			left->Right = JoinRecursive(left->Right, right);
+			Update(left);
+			return left;
+		}
+
+		right->Left = JoinRecursive(left, right->Left);
+		Update(right);
+		return right;
+	}
+
+	static TNode* InsertRecursive(TNode* node, TNode* newNode) {
+		if (node == nullptr) {
+			return newNode;
+		}
+
+		// 새 노드의 우선순위가 더 높으면 이 자리에서 서브트리를 쪼개서 자식으로 단다.
+		if (newNode->Priority > node->Priority) {
+			SplitRecursive(node, newNode->Data, newNode->Left, newNode->Right);
+			Update(newNode);
+			return newNode;
+		}
+
+		if (newNode->Data < node->Data) {
+			node->Left = InsertRecursive(node->Left, newNode);
+		} else {
+			node->Right = InsertRecursive(node->Right, newNode);
+		}
+
+		Update(node);
+		return node;
+	}
+
+	static TNode* RemoveRecursive(TNode* node, const T& data) {
+		if (data == node->Data) {
+			TNode* pJoined = JoinRecursive(node->Left, node->Right);
+			TTreeCollection::DestroyNode(node);
+			return pJoined;
+		}
+
+		if (data < node->Data) {
+			node->Left = RemoveRecursive(node->Left, data);
+		} else {
+			node->Right = RemoveRecursive(node->Right, data);
+		}
+
+		Update(node);
+		return node;
+	}
+
+	// 좌측 작업은 새 쓰레드에서, 우측 작업은 현재 쓰레드에서 수행한다.
+	template <typename LeftTask, typename RightTask>
+	static void RunBoth(int parallelDepth, LeftTask&& leftTask, RightTask&& rightTask) {
+		if (parallelDepth <= 0) {
+			leftTask();
+			rightTask();
+			return;
+		}
+
+		Thread leftThread;
+		leftThread.Start([&leftTask](void*) { leftTask(); });
+		rightTask();
+		leftThread.Join();
+	}
+
+	static TNode* UnionRecursive(TNode* lhs, TNode* rhs, int parallelDepth) {
+		if (lhs == nullptr) return rhs;
+		if (rhs == nullptr) return lhs;
+
+		// 우선순위가 높은 쪽이 루트가 되고 다른 쪽을 그 키로 쪼갠다.
+		if (lhs->Priority < rhs->Priority) {
+			TNode* pTemp = lhs;
+			lhs = rhs;
+			rhs = pTemp;
+		}
+
+		TNode* pLeft;
+		TNode* pRight;
+		TNode* pDuplicated = SplitExactRecursive(rhs, lhs->Data, pLeft, pRight);
+		TTreeCollection::DestroyNode(pDuplicated);
+
+		RunBoth(parallelDepth,
+			[&] { lhs->Left = UnionRecursive(lhs->Left, pLeft, parallelDepth - 1); },
+			[&] { lhs->Right = UnionRecursive(lhs->Right, pRight, parallelDepth - 1); }
+		);
+
+		Update(lhs);
+		return lhs;
+	}
+
+	static TNode* DifferenceRecursive(TNode* lhs, const TNode* rhs, int parallelDepth) {
+		if (lhs == nullptr || rhs == nullptr) {
+			return lhs;
+		}
+
+		TNode* pLeft;
+		TNode* pRight;
+		TNode* pDuplicated = SplitExactRecursive(lhs, rhs->Data, pLeft, pRight);
+		TTreeCollection::DestroyNode(pDuplicated);
+
+		RunBoth(parallelDepth,
+			[&] { pLeft = DifferenceRecursive(pLeft, rhs->Left, parallelDepth - 1); },
+			[&] { pRight = DifferenceRecursive(pRight, rhs->Right, parallelDepth - 1); }
+		);
+
+		return JoinRecursive(pLeft, pRight);
+	}
+
+	template <typename Predicate>
+	static TNode* FilterRecursive(TNode* node, Predicate& predicate, int parallelDepth) {
+		if (node == nullptr) {
+			return nullptr;
+		}
+
+		TNode* pLeft;
+		TNode* pRight;
+
+		RunBoth(parallelDepth,
+			[&] { pLeft = FilterRecursive(node->Left, predicate, parallelDepth - 1); },
+			[&] { pRight = FilterRecursive(node->Right, predicate, parallelDepth - 1); }
+		);
+
+		if (predicate(node->Data)) {
+			node->Left = pLeft;
+			node->Right = pRight;
+			Update(node);
+			return node;
+		}
+
+		TTreeCollection::DestroyNode(node);
+		return JoinRecursive(pLeft, pRight);
+	}
+
+	Int32U m_uiSeed;
+};
+
+NS_JC_END
@@ -0,0 +1,309 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 이진 탐색 트리 기반 컨테이너의 공통 구현
+ * 트리셋(회전 기반 균형)과 트립셋(분할/병합 기반 균형) 모두 같은 노드 구조를 쓰므로
+ * 탐색, 순회, 범위 질의(LowerBound, Scan), 통계 함수는 여기서 한번만 구현한다.
+ * 균형을 어떻게 맞추는지(삽입/삭제)만 상속받는 쪽에서 구현한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Allocator/DefaultAllocator.h>
+#include <JCore/Container/MemoryUsage.h>
+
+#include "TreeNode.h"
+#include "TreeSetIterator.h"
+#include "TreeRangeCursor.h"
+
+NS_JC_BEGIN
+
+/*=====================================================================================
+								이진 탐색 트리 컬렉션
+						트리셋, 트립셋의 공통 질의 인터페이스 정의
+=====================================================================================*/
+
+// 노드는 TAllocator로 하나씩 할당한다. (ArenaAllocator를 쓰면 해제 비용이 없다)
+template <typename T, typename TNodeTag, typename TAllocator = DefaultAllocator>
+class TreeCollection
+{
+protected:
+	using TNode					= TreeNode<T, TNodeTag>;
+	using TTreeCollection		= TreeCollection<T, TNodeTag, TAllocator>;
+public:
+	using TIterator				= TreeSetIterator<T, TNodeTag>;
+	using TRangeCursor			= TreeRangeCursor<T, TNodeTag>;
+
+	TreeCollection(const TTreeCollection&) = delete;
+	TTreeCollection& operator=(const TTreeCollection&) = delete;
+
+	bool Search(const T& data) const { return FindNode(data) != nullptr; }
+
+	void Clear() {
+		DeleteNodeRecursive(m_pRoot);
+		m_pRoot = nullptr;
+		m_iSize = 0;
+	}
+
+	int Size() const { return m_iSize; }
+	bool IsEmpty() const { return m_iSize == 0; }
+
+	// 노드를 직접 순회하며 갯수를 센다.
+	int Count() const {
+		int iCount = 0;
+		CountRecursive(m_pRoot, iCount);
+		return iCount;
+	}
+
+	int GetMaxHeight() const {
+		int iMaxHeight = 0;
+		GetMaxHeightRecursive(m_pRoot, 1, iMaxHeight);
+		return iMaxHeight;
+	}
+
+	// 모든 노드의 평균 깊이 (루트의 깊이는 1)
+	// 탐색 1회에 평균적으로 몇개의 노드를 방문하는지와 같다.
+	double GetAverageDepth() const {
+		if (m_iSize == 0) return 0.0;
+
+		Int64 iDepthSum = 0;
+		SumDepthRecursive(m_pRoot, 1, iDepthSum);
+		return double(iDepthSum) / m_iSize;
+	}
+
+	// 노드는 하나씩 할당하므로 남는 용량이 없다. (힙 관리자의 블록 헤더는 알 수 없으므로 제외)
+	MemoryUsage GetMemoryUsage() const {
+		MemoryUsage usage;
+		usage.ElementCount = m_iSize;
+		usage.ElementBytes = Int64(sizeof(T)) * m_iSize;
+		usage.NodeBytes = Int64(sizeof(TNode)) * m_iSize;
+		return usage;
+	}
+
+	TIterator Begin() const {
+		return TIterator(m_pRoot ? FindSmallestNode(m_pRoot) : nullptr);
+	}
+
+	TIterator Last() const {
+		return TIterator(m_pRoot ? FindBiggestNode(m_pRoot) : nullptr);
+	}
+
+	// data 이상인 첫번째 데이터 위치
+	TIterator LowerBound(const T& data) const {
+		return TIterator(FindLowerBoundNode(data));
+	}
+
+	// data 초과인 첫번째 데이터 위치
+	TIterator UpperBound(const T& data) const {
+		TNode* pCur = m_pRoot;
+		TNode* pFound = nullptr;
+
+		while (pCur != nullptr) {
+			if (data < pCur->Data) {
+				pFound = pCur;
+				pCur = pCur->Left;
+			} else {
+				pCur = pCur->Right;
+			}
+		}
+
+		return TIterator(pFound);
+	}
+
+	// 오름차순 순회
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		for (TNode* pCur = m_pRoot ? FindSmallestNode(m_pRoot) : nullptr; pCur != nullptr; pCur = pCur->Next()) {
+			consumer(pCur->Data);
+		}
+	}
+
+	// [lo, hi) 범위를 버퍼에 묶음으로 읽는 커서 (TreeRangeCursor.h 참고)
+	TRangeCursor ScanCursor(const T& lo, const T& hi) const {
+		return TRangeCursor(m_pRoot, lo, hi);
+	}
+
+	// lo 이상인 데이터를 끝까지 읽는 커서
+	TRangeCursor ScanCursor(const T& lo) const {
+		return TRangeCursor(m_pRoot, lo);
+	}
+
+	// [lo, hi) 범위를 오름차순으로 visitor(const T&)에 넘기고 방문한 수를 반환한다.
+	template <typename Visitor>
+	Int64 Scan(const T& lo, const T& hi, Visitor&& visitor) const {
+		return ScanCursor(lo, hi).ForEach(Forward<Visitor>(visitor));
+	}
+protected:
+	TreeCollection() : m_pRoot(nullptr), m_iSize(0) {}
+	~TreeCollection() { Clear(); }
+
+	TNode* FindNode(const T& data) const {
+		int iDepth;
+		return FindNode(data, iDepth);
+	}
+
+	// depth: 찾는 동안 방문한 노드 수
+	TNode* FindNode(const T& data, JCORE_OUT int& depth) const {
+		TNode* pCur = m_pRoot;
+		depth = 0;
+
+		while (pCur != nullptr) {
+			++depth;
+
+			if (data == pCur->Data) {
+				return pCur;
+			}
+
+			if (data > pCur->Data) {
+				pCur = pCur->Right;
+			}
+			else {
+				pCur = pCur->Left;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// 이진 탐색 트리 속성(키 순서, 부모 연결, 크기)과 균형 속성을 한번의 순회로 확인한다. O(n)
+	// validator(node, leftHeight, rightHeight, JCORE_OUT height): 두 자식 서브트리가 돌려준 높이로 node의 균형 속성을 확인한다.
+	// 높이가 무엇인지는 validator가 정한다. (레드블랙트리는 블랙 높이, 없는 노드는 0)
+	template <typename NodeValidator>
+	TreeValidateError ValidateTree(NodeValidator&& validator) const {
+		if (m_pRoot && m_pRoot->Parent != nullptr) {
+			return TreeValidateError::ParentLink;
+		}
+
+		const TNode* pPrev = nullptr;
+		int iCount = 0;
+		int iHeight = 0;
+		const TreeValidateError eError = ValidateRecursive(m_pRoot, pPrev, iCount, iHeight, validator);
+
+		if (eError != TreeValidateError::None) {
+			return eError;
+		}
+
+		return iCount == m_iSize ? TreeValidateError::None : TreeValidateError::Size;
+	}
+
+	TNode* FindLowerBoundNode(const T& data) const {
+		TNode* pCur = m_pRoot;
+		TNode* pFound = nullptr;
+
+		while (pCur != nullptr) {
+			if (pCur->Data < data) {
+				pCur = pCur->Right;
+			} else {
+				pFound = pCur;
+				pCur = pCur->Left;
+			}
+		}
+
+		return pFound;
+	}
+
+	static TNode* FindBiggestNode(TNode* cur) {
+		while (cur != nullptr) {
+			if (cur->Right == nullptr) {
+				return cur;
+			}
+
+			cur = cur->Right;
+		}
+
+		return cur;
+	}
+
+	static TNode* FindSmallestNode(TNode* cur) {
+		while (cur != nullptr) {
+			if (cur->Left == nullptr) {
+				return cur;
+			}
+
+			cur = cur->Left;
+		}
+
+		return cur;
+	}
+
+	static TNode* CreateNode(const T& data) {
+		return TAllocator::template AllocateInit<TNode>(data);
+	}
+
+	static void DestroyNode(TNode* node) {
+		if (node == nullptr) return;
+		node->~TNode();
+		TAllocator::template Deallocate<TNode>(node);
+	}
+
+	static void DeleteNodeRecursive(TNode* node) {
+		if (node == nullptr) return;
+		DeleteNodeRecursive(node->Left);
+		DeleteNodeRecursive(node->Right);
+		DestroyNode(node);
+	}
+	static void GetMaxHeightRecursive(TNode* node, int height, int& maxHeight) {
+		if (node == nullptr) {
+			maxHeight = Math::Max(maxHeight, height);
+			return;
+		}
+
+		GetMaxHeightRecursive(node->Left, height + 1, maxHeight);
+		GetMaxHeightRecursive(node->Right, height + 1, maxHeight);
+	}
+	static void CountRecursive(TNode* node, int& count) {
+		if (node == nullptr) {
+			return;
+		}
+		count++;
+		CountRecursive(node->Left, count);
+		CountRecursive(node->Right, count);
+	}
+	// 중위 순회하며 직전 노드(prev)보다 큰지 확인한다.
+	template <typename NodeValidator>
+	static TreeValidateError ValidateRecursive(const TNode* node, const TNode*& prev, int& count, int& height, NodeValidator& validator) {
+		if (node == nullptr) {
+			height = 0;
+			return TreeValidateError::None;
+		}
+
+		if ((node->Left && node->Left->Parent != node) || (node->Right && node->Right->Parent != node)) {
+			return TreeValidateError::ParentLink;
+		}
+
+		int iLeftHeight;
+		int iRightHeight;
+		TreeValidateError eError = ValidateRecursive(node->Left, prev, count, iLeftHeight, validator);
+		if (eError != TreeValidateError::None) {
+			return eError;
+		}
+
+		if (prev && !(prev->Data < node->Data)) {
+			return TreeValidateError::Order;
+		}
+
+		prev = node;
+		++count;
+
+		eError = ValidateRecursive(node->Right, prev, count, iRightHeight, validator);
+		if (eError != TreeValidateError::None) {
+			return eError;
+		}
+
+		return validator(node, iLeftHeight, iRightHeight, height) ? TreeValidateError::None : TreeValidateError::Balance;
+	}
+	static void SumDepthRecursive(TNode* node, int depth, Int64& depthSum) {
+		if (node == nullptr) {
+			return;
+		}
+		depthSum += depth;
+		SumDepthRecursive(node->Left, depth + 1, depthSum);
+		SumDepthRecursive(node->Right, depth + 1, depthSum);
+	}
+
+	TNode* m_pRoot;
+	int m_iSize;
+};
+
+NS_JC_END
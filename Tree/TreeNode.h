@@ -0,0 +1,148 @@
+﻿/*
+ * 작성자: 윤정도
+ * 생성일: 5/26/2023
+ * =====================
+ * 균형 이진 탐색 트리 공용 노드
+ * 균형 정책(Balancer)마다 노드에 추가로 저장해야하는 정보(색상, 랭크)가 다르므로
+ * TNodeTag를 상속받아 정책별 정보를 노드에 붙인다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+
+NS_JC_BEGIN
+
+enum class TreeNodeColor
+{
+	Red,
+	Black
+};
+
+enum class TreeNodeRotateMode
+{
+	RR,
+	LL,
+	RL,
+	LR
+};
+
+// Validate() 결과
+enum class TreeValidateError
+{
+	None,
+	Order,			// 중위 순회 순서가 오름차순이 아님 (중복 포함)
+	ParentLink,		// 자식의 Parent가 부모를 가리키지 않음
+	Size,			// 실제 노드 수와 m_iSize가 다름
+	Balance,		// 균형 정책의 속성 위반
+	Structure		// 노드 구조 위반 (RadixTreeMap: 노드 종류별 자식 수, 접두사와 리프 키 불일치 / BitmapSet: 빈 노드, 자식 배열 불일치)
+};
+
+inline const char* TreeNodeColorName(TreeNodeColor color) {
+	return color == TreeNodeColor::Red ? "Red" : "Black";
+}
+
+inline const char* TreeValidateErrorName(TreeValidateError error) {
+	switch (error) {
+	case TreeValidateError::None:		return "None";
+	case TreeValidateError::Order:		return "Order";
+	case TreeValidateError::ParentLink:	return "ParentLink";
+	case TreeValidateError::Size:		return "Size";
+	case TreeValidateError::Balance:	return "Balance";
+	case TreeValidateError::Structure:	return "Structure";
+	}
+	return "Unknown";
+}
+
+template <typename T, typename TNodeTag>
+struct TreeNode : TNodeTag
+{
+	T Data;
+	TreeNode* Parent;
+	TreeNode* Left;
+	TreeNode* Right;
+
+	#pragma region PUBLIC FIELDS
+	TreeNode(const T& data)
+		: Data(data)
+		, Parent(nullptr)
+		, Left(nullptr)
+		, Right(nullptr)
+	{}
+
+	// 둘중 할당된 자식 아무거나 반환
+	TreeNode* Any() const { return Left ? Left : Right; }
+
+	// 둥중 하나의 자식 아무거나 반환 및 자식이 몇개있는지도 같이 반환
+	TreeNode* AnyWithChildrenCount(JCORE_OUT int& count) const {
+		if (Left && Right) {
+			count = 2;
+			return Left;
+		}
+		if (Left) {
+			count = 1;
+			return Left;
+		}
+		if (Right) {
+			count = 1;
+			return Right;
+		}
+		count = 0;
+		return nullptr;
+	}
+	bool IsLeft() const { return Parent->Left == this; }
+	bool IsRight() const { return Parent->Right == this; }
+	int Count() const {
+		if (Left && Right) return 2;
+		if (Left) return 1;
+		if (Right) return 1;
+		return 0;
+	}
+
+	// 중위 순회 기준 다음 노드 (없으면 nullptr)
+	TreeNode* Next() const {
+		if (Right) {
+			TreeNode* pCur = Right;
+			while (pCur->Left) pCur = pCur->Left;
+			return pCur;
+		}
+
+		const TreeNode* pCur = this;
+		while (pCur->Parent && pCur->IsRight()) pCur = pCur->Parent;
+		return pCur->Parent;
+	}
+
+	// 중위 순회 기준 이전 노드 (없으면 nullptr)
+	TreeNode* Previous() const {
+		if (Left) {
+			TreeNode* pCur = Left;
+			while (pCur->Right) pCur = pCur->Right;
+			return pCur;
+		}
+
+		const TreeNode* pCur = this;
+		while (pCur->Parent && pCur->IsLeft()) pCur = pCur->Parent;
+		return pCur->Parent;
+	}
+	#pragma endregion
+	// PUBLIC FIELDS
+
+	#pragma region PUBLIC FIELDS (DEBUG)
+	static void DbgConnectLeft(TreeNode* parent, TreeNode* child) {
+		DebugAssertMsg(parent->Left == nullptr, "부모(%d)의 좌측자식(%d)가 이미할당되어있음. %d 자식 연결불가능", parent->Data, parent->Left->Data, child->Data);
+		DebugAssertMsg(child->Parent == nullptr, "자식(%d)의 부모(%d)가 이미할당되어있음. %d 부모 연결불가능", child->Data, child->Parent->Data, parent->Data);
+		parent->Left = child;
+		child->Parent = parent;
+	}
+
+	static void DbgConnectRight(TreeNode* parent, TreeNode* child) {
+		DebugAssertMsg(parent->Right == nullptr, "부모(%d)의 우측자식(%d)가 이미할당되어있음. %d 자식 연결불가능", parent->Data, parent->Right->Data, child->Data);
+		DebugAssertMsg(child->Parent == nullptr, "자식(%d)의 부모(%d)가 이미할당되어있음. %d 부모 연결불가능", child->Data, child->Parent->Data, parent->Data);
+		parent->Right = child;
+		child->Parent = parent;
+	}
+	#pragma endregion
+	// PUBLIC FIELDS (DEBUG)
+};
+
+NS_JC_END
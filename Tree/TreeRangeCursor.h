@@ -0,0 +1,146 @@
+/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리 범위 커서
+ * [lo, hi) 범위의 데이터를 호출한 쪽이 준 버퍼에 고정 크기 묶음으로 채워준다.
+ *
+ *  int buffer[256];
+ *  auto cursor = set.ScanCursor(lo, hi);
+ *  for (int iCount; (iCount = cursor.Read(buffer, 256)) > 0;) {
+ *      ... buffer[0 ~ iCount - 1] 처리
+ *  }
+ *
+ * 반복자(Node::Next)는 다음 노드를 찾을 때마다 부모/오른쪽 자식 포인터를 하나씩 따라가므로
+ * 노드가 메모리에 흩어져 있으면 캐시 미스가 하나씩 차례대로 일어난다.
+ * 커서는 아직 방문하지 않은 조상(다음에 방문할 노드들)을 스택에 들고 있다가 스택에 넣는 순간 그 노드의 오른쪽 자식을 미리 가져온다.
+ * 오른쪽 서브트리는 한참 뒤에 방문하므로 그 사이에 여러 노드의 메모리 읽기가 겹쳐서 진행된다.
+ *
+ * 스택은 StackCapacity개까지만 들고 넘치면 가장 오래된(가장 나중에 방문할) 조상을 버린다.
+ * 스택이 비면 마지막으로 방문한 노드의 부모 링크로 다음 노드를 찾으므로 트립처럼 높이가 제한되지 않은 트리에서도 결과는 같다.
+ *
+ * 커서가 살아있는 동안 트리를 수정하면 안된다. (반복자와 같다)
+ */
+
+#pragma once
+
+#include <JCore/Primitives/ArraySegment.h>
+
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+template <typename T, typename TNodeTag>
+class TreeRangeCursor
+{
+	using TNode = TreeNode<T, TNodeTag>;
+public:
+	// 레드블랙트리의 최대 높이(2 * log2(n + 1))가 int 범위의 데이터 수에서 62이므로 트리셋은 넘치지 않는다.
+	static constexpr int StackCapacity = 64;
+
+	// root 트리에서 lo 이상인 데이터를 끝까지 읽는다.
+	TreeRangeCursor(TNode* root, const T& lo) : m_pLast(nullptr), m_iTop(0), m_Hi(), m_bBounded(false) {
+		Seek(root, lo);
+	}
+
+	// root 트리에서 [lo, hi) 범위를 읽는다.
+	TreeRangeCursor(TNode* root, const T& lo, const T& hi) : m_pLast(nullptr), m_iTop(0), m_Hi(hi), m_bBounded(true) {
+		Seek(root, lo);
+	}
+
+	bool HasNext() const { return m_iTop > 0; }
+
+	// buffer에 최대 capacity개를 채우고 채운 수를 반환한다. 다 읽었으면 0
+	int Read(JCORE_OUT T* buffer, int capacity) {
+		int iCount = 0;
+
+		while (iCount < capacity && m_iTop > 0) {
+			TNode* pNode = Pop();
+
+			if (m_bBounded && !(pNode->Data < m_Hi)) {
+				m_iTop = 0;
+				break;
+			}
+
+			buffer[iCount++] = pNode->Data;
+			Advance(pNode);
+		}
+
+		return iCount;
+	}
+
+	int Read(JCORE_OUT ArraySegment<T>& buffer) {
+		return Read(buffer.Source(), buffer.Length());
+	}
+
+	// 버퍼를 거치지 않고 visitor(const T&)로 바로 넘긴다. 방문한 수를 반환
+	template <typename Visitor>
+	Int64 ForEach(Visitor&& visitor) {
+		Int64 iCount = 0;
+
+		while (m_iTop > 0) {
+			TNode* pNode = Pop();
+
+			if (m_bBounded && !(pNode->Data < m_Hi)) {
+				m_iTop = 0;
+				break;
+			}
+
+			visitor(pNode->Data);
+			++iCount;
+			Advance(pNode);
+		}
+
+		return iCount;
+	}
+private:
+	// lo로 내려가면서 왼쪽으로 꺾은 노드(lo 이상이고 아직 방문하지 않은 조상)를 쌓는다. 맨 위가 lo의 LowerBound
+	void Seek(TNode* root, const T& lo) {
+		for (TNode* pCur = root; pCur != nullptr;) {
+			if (pCur->Data < lo) {
+				pCur = pCur->Right;
+			} else {
+				Push(pCur);
+				pCur = pCur->Left;
+			}
+		}
+	}
+
+	// node 다음 노드들을 준비한다. (오른쪽 서브트리의 왼쪽 끝까지 쌓기)
+	void Advance(TNode* node) {
+		m_pLast = node;
+
+		for (TNode* pCur = node->Right; pCur != nullptr; pCur = pCur->Left) {
+			Push(pCur);
+		}
+
+		// 넘쳐서 버린 조상이 있을 수 있으므로 비면 부모 링크로 다음 노드를 찾는다. (끝이면 nullptr)
+		if (m_iTop == 0) {
+			TNode* pNext = m_pLast->Next();
+			if (pNext) Push(pNext);
+		}
+	}
+
+	void Push(TNode* node) {
+		if (m_iTop == StackCapacity) {
+			// 아래쪽 절반(가장 나중에 방문할 조상)을 버린다.
+			constexpr int Keep = StackCapacity / 2;
+			for (int i = 0; i < Keep; ++i) {
+				m_Stack[i] = m_Stack[StackCapacity - Keep + i];
+			}
+			m_iTop = Keep;
+		}
+
+		JCORE_PREFETCH(node->Right);
+		m_Stack[m_iTop++] = node;
+	}
+
+	TNode* Pop() { return m_Stack[--m_iTop]; }
+
+	TNode* m_Stack[StackCapacity];
+	TNode* m_pLast;
+	int m_iTop;
+	T m_Hi;
+	bool m_bBounded;
+};
+
+NS_JC_END
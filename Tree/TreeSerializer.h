@@ -0,0 +1,424 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 정렬 컨테이너 이진 직렬화
+ * TreeSet, RadixTreeMap의 데이터를 오름차순으로 Stream(FileStream 등)에 기록하고 다시 읽어온다.
+ * 오름차순으로 기록되어 있으므로 TreeSet은 삽입 없이 O(n)으로 균형 잡힌 트리를 바로 만든다. (TreeSet::Deserialize 참고)
+ *
+ * [형식] 리틀엔디언
+ *  Int32U	매직 (TreeSerializeHeader::Magic)
+ *  Byte	버전
+ *  Byte	키 인코딩 (TreeSerializeEncoding)
+ *  Byte	값 인코딩 (셋은 None)
+ *  varint	데이터 수
+ *  이후 데이터 수만큼 [키][값]
+ *
+ * [인코딩]
+ *  - Integer: 첫 키는 지그재그 varint, 이후는 직전 키와의 차이를 varint로 기록한다. (촘촘한 키는 1바이트)
+ *             값은 정렬되어 있지 않으므로 차이 없이 매번 지그재그 varint로 기록한다.
+ *  - String:  길이 varint + 널문자를 뺀 바이트열
+ *  - Raw:     sizeof(T) 바이트 그대로 (trivially copyable 타입)
+ *
+ * Stream::Write/Read는 가상 함수이고 FileStream은 호출마다 시스템 콜을 하므로 BufferSize 단위로 모아서 읽고 쓴다.
+ * 코덱은 메모리 버퍼(TreeBufferWriter/Reader)에도 같은 방식으로 쓰고 읽을 수 있다. (로그 레코드 등 체크섬을 붙일 단위를 먼저 모을 때 사용)
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Math.h>
+#include <JCore/Limit.h>
+#include <JCore/Stream.h>
+#include <JCore/Primitives/String.h>
+
+#include <cstring>
+#include <type_traits>
+
+NS_JC_BEGIN
+
+enum class TreeSerializeEncoding : Byte
+{
+	None,
+	Integer,
+	String,
+	Raw
+};
+
+// 쓰기 버퍼
+class TreeStreamWriter
+{
+public:
+	static constexpr int BufferSize = 64 * 1024;
+
+	TreeStreamWriter(Stream& stream) : m_Stream(stream), m_iPosition(0) {}
+	~TreeStreamWriter() { Flush(); }
+
+	TreeStreamWriter(const TreeStreamWriter&) = delete;
+	TreeStreamWriter& operator=(const TreeStreamWriter&) = delete;
+
+	void WriteByte(Byte data) {
+		if (m_iPosition == BufferSize) Flush();
+		m_Buffer[m_iPosition++] = data;
+	}
+
+	void WriteBytes(const void* data, int len) {
+		const Byte* pData = static_cast<const Byte*>(data);
+
+		while (len > 0) {
+			if (m_iPosition == BufferSize) Flush();
+
+			const int iCopy = Math::Min(len, BufferSize - m_iPosition);
+			std::memcpy(m_Buffer + m_iPosition, pData, iCopy);
+			m_iPosition += iCopy;
+			pData += iCopy;
+			len -= iCopy;
+		}
+	}
+
+	// 7비트씩 하위부터 기록하고 뒤에 바이트가 더 있으면 최상위 비트를 켠다.
+	void WriteVarint(Int64U data) {
+		if (BufferSize - m_iPosition < MaxVarintSize) Flush();
+
+		while (data >= 0x80) {
+			m_Buffer[m_iPosition++] = Byte(data | 0x80);
+			data >>= 7;
+		}
+		m_Buffer[m_iPosition++] = Byte(data);
+	}
+
+	void Flush() {
+		if (m_iPosition == 0) return;
+		m_Stream.Write(m_Buffer, 0, m_iPosition);
+		m_iPosition = 0;
+	}
+
+	static constexpr int MaxVarintSize = 10;
+private:
+	Stream& m_Stream;
+	int m_iPosition;
+	Byte m_Buffer[BufferSize];
+};
+
+// 읽기 버퍼
+// 버퍼 크기만큼 미리 읽으므로 다 읽은 후 Finish()로 읽지 않은 부분만큼 스트림 위치를 되돌린다.
+class TreeStreamReader
+{
+public:
+	static constexpr int BufferSize = 64 * 1024;
+
+	TreeStreamReader(Stream& stream) : m_Stream(stream), m_iPosition(0), m_iLength(0) {}
+
+	TreeStreamReader(const TreeStreamReader&) = delete;
+	TreeStreamReader& operator=(const TreeStreamReader&) = delete;
+
+	bool ReadByte(JCORE_OUT Byte& data) {
+		if (m_iPosition == m_iLength && !Fill()) return false;
+		data = m_Buffer[m_iPosition++];
+		return true;
+	}
+
+	bool ReadBytes(JCORE_OUT void* data, int len) {
+		Byte* pData = static_cast<Byte*>(data);
+
+		while (len > 0) {
+			if (m_iPosition == m_iLength && !Fill()) return false;
+
+			const int iCopy = Math::Min(len, m_iLength - m_iPosition);
+			std::memcpy(pData, m_Buffer + m_iPosition, iCopy);
+			m_iPosition += iCopy;
+			pData += iCopy;
+			len -= iCopy;
+		}
+
+		return true;
+	}
+
+	bool ReadVarint(JCORE_OUT Int64U& data) {
+		data = 0;
+
+		for (int iShift = 0; iShift < 64; iShift += 7) {
+			Byte byte;
+			if (!ReadByte(byte)) return false;
+
+			data |= Int64U(byte & 0x7f) << iShift;
+			if ((byte & 0x80) == 0) return true;
+		}
+
+		return false;	// 10바이트를 넘는 varint는 손상된 데이터
+	}
+
+	void Finish() {
+		const int iUnread = m_iLength - m_iPosition;
+
+		if (iUnread > 0 && m_Stream.CanSeek()) {
+			m_Stream.Seek(-iUnread, Stream::eCurrent);
+		}
+
+		m_iPosition = m_iLength = 0;
+	}
+private:
+	bool Fill() {
+		m_iPosition = 0;
+		m_iLength = Math::Max(m_Stream.Read(m_Buffer, 0, BufferSize), 0);
+		return m_iLength > 0;
+	}
+
+	Stream& m_Stream;
+	int m_iPosition;
+	int m_iLength;
+	Byte m_Buffer[BufferSize];
+};
+
+// 메모리 버퍼 쓰기 (필요한 만큼 2배씩 늘어난다)
+class TreeBufferWriter
+{
+public:
+	TreeBufferWriter() : m_pBuffer(nullptr), m_iCapacity(0), m_iLength(0) {}
+	~TreeBufferWriter() { JCORE_DELETE_ARRAY_SAFE(m_pBuffer); }
+
+	TreeBufferWriter(const TreeBufferWriter&) = delete;
+	TreeBufferWriter& operator=(const TreeBufferWriter&) = delete;
+
+	void WriteByte(Byte data) {
+		Reserve(1);
+		m_pBuffer[m_iLength++] = data;
+	}
+
+	void WriteBytes(const void* data, int len) {
+		Reserve(len);
+		std::memcpy(m_pBuffer + m_iLength, data, len);
+		m_iLength += len;
+	}
+
+	void WriteVarint(Int64U data) {
+		Reserve(TreeStreamWriter::MaxVarintSize);
+
+		while (data >= 0x80) {
+			m_pBuffer[m_iLength++] = Byte(data | 0x80);
+			data >>= 7;
+		}
+		m_pBuffer[m_iLength++] = Byte(data);
+	}
+
+	// len 바이트를 늘리고 늘어난 영역의 시작 위치를 반환한다. (직접 채운다)
+	Byte* Grow(int len) {
+		Reserve(len);
+		m_iLength += len;
+		return m_pBuffer + m_iLength - len;
+	}
+
+	Byte* Source() { return m_pBuffer; }
+	const Byte* Source() const { return m_pBuffer; }
+	int Length() const { return m_iLength; }
+	void Clear() { m_iLength = 0; }
+private:
+	void Reserve(int len) {
+		if (m_iLength + len <= m_iCapacity) {
+			return;
+		}
+
+		const int iCapacity = Math::Max(Math::Max(m_iCapacity * 2, m_iLength + len), 256);
+		Byte* pBuffer = dbg_new Byte[iCapacity];
+		if (m_iLength > 0) std::memcpy(pBuffer, m_pBuffer, m_iLength);
+		JCORE_DELETE_ARRAY_SAFE(m_pBuffer);
+		m_pBuffer = pBuffer;
+		m_iCapacity = iCapacity;
+	}
+
+	Byte* m_pBuffer;
+	int m_iCapacity;
+	int m_iLength;
+};
+
+// 메모리 버퍼 읽기 (버퍼를 복사하지 않는다)
+class TreeBufferReader
+{
+public:
+	TreeBufferReader(const Byte* buffer, int length) : m_pBuffer(buffer), m_iPosition(0), m_iLength(length) {}
+
+	bool ReadByte(JCORE_OUT Byte& data) {
+		if (m_iPosition == m_iLength) return false;
+		data = m_pBuffer[m_iPosition++];
+		return true;
+	}
+
+	bool ReadBytes(JCORE_OUT void* data, int len) {
+		if (len > m_iLength - m_iPosition) return false;
+		std::memcpy(data, m_pBuffer + m_iPosition, len);
+		m_iPosition += len;
+		return true;
+	}
+
+	bool ReadVarint(JCORE_OUT Int64U& data) {
+		data = 0;
+
+		for (int iShift = 0; iShift < 64; iShift += 7) {
+			Byte byte;
+			if (!ReadByte(byte)) return false;
+
+			data |= Int64U(byte & 0x7f) << iShift;
+			if ((byte & 0x80) == 0) return true;
+		}
+
+		return false;
+	}
+
+	bool IsEnd() const { return m_iPosition == m_iLength; }
+private:
+	const Byte* m_pBuffer;
+	int m_iPosition;
+	int m_iLength;
+};
+
+// 8바이트씩 읽는 FNV-1a 변형 (손상 확인용이므로 암호학적 안전성은 필요없다)
+inline Int64U TreeChecksum64(const Byte* data, Int64 size) {
+	constexpr Int64U Prime = 0x100000001B3;
+	Int64U uiHash = 0xCBF29CE484222325;
+	Int64 i = 0;
+
+	for (; i + 8 <= size; i += 8) {
+		Int64U uiWord;
+		std::memcpy(&uiWord, data + i, 8);
+		uiHash = (uiHash ^ uiWord) * Prime;
+	}
+
+	for (; i < size; ++i) {
+		uiHash = (uiHash ^ data[i]) * Prime;
+	}
+
+	return uiHash;
+}
+
+/*=====================================================================================
+									데이터 인코딩
+				Delta가 true면 직전 데이터와의 차이를 기록한다. (정렬된 정수 키 전용)
+=====================================================================================*/
+
+template <typename T, bool Delta, typename = void>
+struct TreeSerializeCodec
+{
+	static_assert(std::is_trivially_copyable_v<T>, "... 직렬화할 수 없는 타입입니다. (정수, String, trivially copyable 타입만 가능)");
+	static constexpr TreeSerializeEncoding Encoding = TreeSerializeEncoding::Raw;
+
+	template <typename TWriter> void Write(TWriter& writer, const T& data) { writer.WriteBytes(&data, sizeof(T)); }
+	template <typename TReader> bool Read(TReader& reader, JCORE_OUT T& data) { return reader.ReadBytes(&data, sizeof(T)); }
+};
+
+template <typename T, bool Delta>
+struct TreeSerializeCodec<T, Delta, std::enable_if_t<std::is_integral_v<T>>>
+{
+	static constexpr TreeSerializeEncoding Encoding = TreeSerializeEncoding::Integer;
+
+	// 정렬된 키는 항상 직전 키보다 크므로 64비트 부호없는 정수로 본 차이도 항상 실제 차이와 같다.
+	template <typename TWriter>
+	void Write(TWriter& writer, const T& data) {
+		const Int64U uiData = ToUnsigned(data);
+
+		if (Delta && m_bHasPrevious) {
+			writer.WriteVarint(uiData - m_uiPrevious);
+		} else {
+			writer.WriteVarint(std::is_signed_v<T> ? ZigZag(Int64(data)) : uiData);
+		}
+
+		m_uiPrevious = uiData;
+		m_bHasPrevious = true;
+	}
+
+	template <typename TReader>
+	bool Read(TReader& reader, JCORE_OUT T& data) {
+		Int64U uiEncoded;
+		if (!reader.ReadVarint(uiEncoded)) return false;
+
+		if (Delta && m_bHasPrevious) {
+			m_uiPrevious += uiEncoded;
+		} else {
+			m_uiPrevious = std::is_signed_v<T> ? Int64U(UnZigZag(uiEncoded)) : uiEncoded;
+		}
+
+		data = T(m_uiPrevious);
+		m_bHasPrevious = true;
+		return true;
+	}
+private:
+	static Int64U ToUnsigned(T data) {
+		if constexpr (std::is_signed_v<T>) return Int64U(Int64(data));
+		else return Int64U(data);
+	}
+
+	static Int64U ZigZag(Int64 data) { return (Int64U(data) << 1) ^ Int64U(data >> 63); }
+	static Int64 UnZigZag(Int64U data) { return Int64(data >> 1) ^ -Int64(data & 1); }
+
+	Int64U m_uiPrevious = 0;
+	bool m_bHasPrevious = false;
+};
+
+template <bool Delta>
+struct TreeSerializeCodec<String, Delta>
+{
+	static constexpr TreeSerializeEncoding Encoding = TreeSerializeEncoding::String;
+
+	TreeSerializeCodec() : m_pScratch(nullptr), m_iScratchCapacity(0) {}
+	~TreeSerializeCodec() { JCORE_DELETE_ARRAY_SAFE(m_pScratch); }
+
+	template <typename TWriter>
+	void Write(TWriter& writer, const String& data) {
+		const int iLength = data.IsNull() ? 0 : data.Length();
+		writer.WriteVarint(Int64U(iLength));
+		writer.WriteBytes(data.Source(), iLength);
+	}
+
+	template <typename TReader>
+	bool Read(TReader& reader, JCORE_OUT String& data) {
+		Int64U uiLength;
+		if (!reader.ReadVarint(uiLength) || uiLength >= Int64U(MaxInt32_v)) return false;
+
+		const int iLength = int(uiLength);
+		if (iLength + 1 > m_iScratchCapacity) {
+			JCORE_DELETE_ARRAY_SAFE(m_pScratch);
+			m_iScratchCapacity = Math::Max(iLength + 1, 64);
+			m_pScratch = dbg_new char[m_iScratchCapacity];
+		}
+
+		if (!reader.ReadBytes(m_pScratch, iLength)) return false;
+		m_pScratch[iLength] = '\0';
+		data = String(m_pScratch, iLength + 1);
+		return true;
+	}
+private:
+	char* m_pScratch;
+	int m_iScratchCapacity;
+};
+
+struct TreeSerializeHeader
+{
+	static constexpr Int32U Magic = 0x4652534A;	// "JSRF"
+	static constexpr Byte Version = 1;
+
+	static void Write(TreeStreamWriter& writer, TreeSerializeEncoding keyEncoding, TreeSerializeEncoding valueEncoding, Int64 count) {
+		writer.WriteBytes(&Magic, sizeof(Magic));
+		writer.WriteByte(Version);
+		writer.WriteByte(Byte(keyEncoding));
+		writer.WriteByte(Byte(valueEncoding));
+		writer.WriteVarint(Int64U(count));
+	}
+
+	// 매직, 버전, 인코딩이 모두 일치해야한다.
+	static bool Read(TreeStreamReader& reader, TreeSerializeEncoding keyEncoding, TreeSerializeEncoding valueEncoding, JCORE_OUT Int64& count) {
+		Int32U uiMagic;
+		Byte version, key, value;
+		Int64U uiCount;
+
+		if (!reader.ReadBytes(&uiMagic, sizeof(uiMagic)) || !reader.ReadByte(version) || !reader.ReadByte(key) || !reader.ReadByte(value) || !reader.ReadVarint(uiCount)) {
+			return false;
+		}
+
+		if (uiMagic != Magic || version != Version || key != Byte(keyEncoding) || value != Byte(valueEncoding) || uiCount > Int64U(MaxInt32_v)) {
+			return false;
+		}
+
+		count = Int64(uiCount);
+		return true;
+	}
+};
+
+NS_JC_END
@@ -0,0 +1,509 @@
+﻿/*
+ * 작성자: 윤정도
+ * 생성일: 5/26/2023
+ * =====================
+ * 균형 이진 탐색 트리 기반 셋
+ * 학습결과 보고서: https://blog.naver.com/reversing_joa/223116951373
+ *
+ * 탐색, 순회, 회전은 모든 트리가 공유하고 균형을 맞추는 방법만 TBalancer로 갈아끼울 수 있다.
+ *  - RedBlackBalancer : 회전이 적어 삽입/삭제 위주 작업에 유리 (기본값)
+ *  - AvlBalancer      : 트리가 가장 낮게 유지되어 탐색 위주 작업에 유리
+ *  - WavlBalancer     : 삭제가 없으면 AVL과 같은 높이, 회전 횟수는 레드블랙트리 수준
+ *
+ * 균형 정책은 아래 함수들을 제공해야한다.
+ *  InsertFixup(tree, node)     : 새 노드가 매달린 직후 호출
+ *  RemoveFixup(tree, node)     : 삭제될 노드가 트리에서 떨어지기 직전 호출
+ *  RemoveRetrace(tree, parent) : 삭제될 노드가 트리에서 떨어진 직후 그 부모를 대상으로 호출
+ *  ValidateNode(node, leftHeight, rightHeight, height) : Validate()에서 노드마다 호출 (TreeCollection::ValidateTree 참고)
+ *  BuildNode(node, height, bottom) : Deserialize로 정렬된 데이터에서 트리를 바로 만들 때 노드마다 호출
+ *                                    (height: 서브트리 높이, bottom: 루트가 아니면서 가장 깊은 층의 노드인지)
+ *
+ * TStatistics로 회전/색상 변경/케이스/탐색 깊이/할당 횟수를 기록할 수 있다. (TreeStatistics.h 참고)
+ * TAllocator로 노드를 할당한다. 요청 하나 동안만 쓰는 셋은 ArenaAllocator를 쓰면 노드 해제 비용이 없다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+
+#include <JCore/Container/Vector.h>
+#include <JCore/Container/HashMap.h>
+
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Utils/Console.h>
+
+#include "TreeCollection.h"
+#include "RedBlackBalancer.h"
+#include "AvlBalancer.h"
+#include "WavlBalancer.h"
+#include "TreeStatistics.h"
+#include "TreeSerializer.h"
+
+NS_JC_BEGIN
+
+template <typename T, typename TBalancer = RedBlackBalancer, typename TStatistics = NullTreeStatistics, typename TAllocator = DefaultAllocator>
+class TreeSet : public TreeCollection<T, typename TBalancer::TNodeTag, TAllocator>
+{
+	using TTreeCollection	= TreeCollection<T, typename TBalancer::TNodeTag, TAllocator>;
+	using TNode				= typename TTreeCollection::TNode;
+	using TTreeCollection::m_pRoot;
+	using TTreeCollection::m_iSize;
+public:
+	#pragma region PUBLIC FIELDS
+	TreeSet() = default;
+
+	bool Insert(const T& data) {
+
+		TNode* pNewNode;
+
+		// 1. 데이터를 먼저 넣는다.
+		if (m_pRoot == nullptr) {
+			pNewNode = m_pRoot = TTreeCollection::CreateNode(data);
+			m_Statistics.OnAllocate();
+		}
+		else {
+			// data가 삽입될 부모 노드를 찾는다. (이미 있는 데이터면 nullptr)
+			TNode* pParent = FindParentDataInserted(data);
+
+			if (pParent == nullptr) {
+				return false;
+			}
+
+			pNewNode = TTreeCollection::CreateNode(data);
+			pNewNode->Parent = pParent;
+			m_Statistics.OnAllocate();
+
+			if (data > pParent->Data) {
+				pParent->Right = pNewNode;
+			}
+			else {
+				pParent->Left = pNewNode;
+			}
+		}
+
+		++m_iSize;
+
+		// 2. 삽입된 노드를 기준으로 균형 속성이 위반되는지 확인하여 바로잡는다.
+		TBalancer::InsertFixup(*this, pNewNode);
+		return true;
+	}
+
+	bool Remove(const T& data) {
+		TNode* pDelNode = FindNodeRecorded(data);
+
+		if (pDelNode == nullptr) {
+			return false;
+		}
+
+		// 자식이 없는 경우 그냥 바로 제거 진행
+		int iCount = 0;
+		TNode* pChild = pDelNode->AnyWithChildrenCount(iCount);
+
+		if (iCount == 2) {
+			// 자식이 둘 다 있는 경우
+			TNode* pPredecessor = TTreeCollection::FindBiggestNode(pDelNode->Left);
+
+			// 전임자는 값을 복사해주고 전임자의 자식을 전임자의 부모와 다시 이어줘야한다.
+			pDelNode->Data = pPredecessor->Data;
+
+			if (pPredecessor->Left)
+				ConnectPredecessorChildToParent(pPredecessor, pPredecessor->Left);
+
+			// 전임자가 실제로 삭제될 노드이다.
+			pDelNode = pPredecessor;
+		}
+		else if (iCount == 1) {
+			// 자식이 한쪽만 있는 경우
+			TNode* pParent = pDelNode->Parent;
+			pChild->Parent = pParent;
+
+			// 삭제되는 노드의 부모가 있을 경우, 삭제되는 노드의 자식과 부모를 올바른 위치로 연결해준다.
+			if (pParent) {
+				if (pParent->Left == pDelNode)
+					pParent->Left = pChild;
+				else
+					pParent->Right = pChild;
+			}
+			else {
+				// pDelNode의 부모가 없다는 말은
+				//  => pDelNode = 루트라는 뜻이므로, 자식을 루트로 만들어준다.
+				m_pRoot = pChild;
+			}
+		}
+
+		TBalancer::RemoveFixup(*this, pDelNode);
+
+		// 균형 수정중 회전이 일어났을 수 있으므로 떨어지기 직전의 부모를 기준으로 한다.
+		TNode* pDelNodeParent = pDelNode->Parent;
+		DeleteNode(pDelNode);
+		--m_iSize;
+
+		TBalancer::RemoveRetrace(*this, pDelNodeParent);
+		return true;
+	}
+
+	bool Search(const T& data) const { return FindNodeRecorded(data) != nullptr; }
+
+	void Clear() {
+		m_Statistics.OnDeallocate(m_iSize);
+		TTreeCollection::Clear();
+	}
+
+	// 오름차순으로 stream에 기록한다. (형식은 TreeSerializer.h 참고)
+	void Serialize(Stream& stream) const {
+		TreeStreamWriter writer(stream);
+		TreeSerializeCodec<T, true> codec;
+
+		TreeSerializeHeader::Write(writer, codec.Encoding, TreeSerializeEncoding::None, m_iSize);
+		this->ForEach([&writer, &codec](const T& data) { codec.Write(writer, data); });
+		writer.Flush();
+	}
+
+	// 기존 데이터를 모두 지우고 Serialize로 기록된 데이터를 읽는다.
+	// 데이터가 이미 정렬되어있으므로 삽입/회전 없이 중위 순서대로 노드를 만들어 매달면서 O(n)으로 균형 잡힌 트리를 만든다.
+	// 형식이 다르거나 데이터가 잘렸거나 오름차순이 아니면 false를 반환하고 빈 트리가 된다.
+	bool Deserialize(Stream& stream) {
+		Clear();
+
+		TreeStreamReader reader(stream);
+		TreeSerializeCodec<T, true> codec;
+		Int64 iCount;
+
+		if (!TreeSerializeHeader::Read(reader, codec.Encoding, TreeSerializeEncoding::None, iCount)) {
+			reader.Finish();
+			return false;
+		}
+
+		// 중간 분할로 만든 트리는 모든 빈 자리가 마지막 두 층에만 있다. (가장 깊은 층 = floor(log2(n)) + 1)
+		int iBottomDepth = 0;
+		for (Int64 i = iCount; i > 0; i >>= 1) {
+			++iBottomDepth;
+		}
+
+		BuildContext context{ reader, nullptr, iBottomDepth, true };
+		int iHeight;
+		m_pRoot = BuildRecursive(context, codec, int(iCount), 1, iHeight);
+		reader.Finish();
+
+		if (!context.Valid) {
+			m_iSize = this->Count();
+			Clear();
+			return false;
+		}
+
+		m_iSize = int(iCount);
+		return true;
+	}
+
+	// 키 순서, 부모 연결, 크기, 균형 정책의 속성을 모두 확인한다. O(n)
+	TreeValidateError Validate() const {
+		return this->ValidateTree([](const TNode* node, int leftHeight, int rightHeight, int& height) {
+			return TBalancer::ValidateNode(node, leftHeight, rightHeight, height);
+		});
+	}
+
+	// TStatistics가 NullTreeStatistics면 항상 0
+	TreeStatistics GetStatistics() const { return m_Statistics.Snapshot(); }
+	void ResetStatistics() { m_Statistics.Reset(); }
+
+	#pragma endregion
+	// PUBLIC FIELDS
+
+	#pragma region PUBLIC FIELDS (DEBUG)
+	void DbgGenerateTreeWithString(String data) {
+		this->Clear();
+		data.Split(" ").ForEach([this](String& s) {
+			int a = StringUtil::ToNumber<Int32>(s.Source());
+			Insert(a);
+		});
+	}
+	void DbgRemoveWithString(String data) {
+		Console::WriteLine("데이터 갯수: %d", this->Count());
+		DbgPrintHierarchical();
+		data.Split(" ").ForEach([this, &data](String& s) {
+			int a = StringUtil::ToNumber<Int32>(s.Source());
+			Console::WriteLine("%d 삭제", a);
+			DebugAssertMsg(Remove(a), "%d 노드 삭제 실패", a);
+			Console::WriteLine("데이터 갯수: %d", this->Count());
+			DbgPrintHierarchical();
+		});
+	}
+	void DbgRoot(TNode* root) {
+		TTreeCollection::DeleteNodeRecursive(m_pRoot);
+		m_pRoot = root;
+		m_iSize = this->Count();
+	}
+	void DbgPrintHierarchical() {
+
+		HashMap<int, Vector<TNode*>> hHierarchy;
+		for (int i = 0; i < 200; ++i) {
+			hHierarchy.Insert(i, Vector<TNode*>{});
+		}
+		RecordDataOnHierarchy(m_pRoot, 1, hHierarchy);
+		static const char* Left = "L";
+		static const char* Right = "R";
+		static const char* None = "-";
+		for (int i = 1; i < 200; ++i) {
+			auto& nodes = hHierarchy[i];
+			if (nodes.Size() <= 0) continue;
+			Console::Write("[%d] ", i);
+			for (int j = 0; j < nodes.Size(); ++j) {
+				const char* l = nullptr;
+				if (nodes[j]->Parent == nullptr) {
+					l = None;
+				}
+				else {
+					if (nodes[j]->Parent->Left == nodes[j])
+						l = Left;
+					else
+						l = Right;
+				}
+				Console::Write("%d(%s, %d, %s) ",
+					nodes[j]->Data,
+					TBalancer::DbgNodeTagString(nodes[j]).Source(),
+					nodes[j]->Parent ? nodes[j]->Parent->Data : -1,
+					l
+				);
+			}
+			Console::WriteLine("");
+		}
+		Console::WriteLine("==============================");
+	}
+	#pragma endregion
+	// DEBUG_METHODS (DEBUG)
+private:
+
+	#pragma region PRIVATE FIELDS
+	// data가 삽입될 부모를 찾는다.
+	// 이미 같은 데이터가 있으면 nullptr을 반환한다.
+	TNode* FindParentDataInserted(const T& data) const {
+		TNode* pParent = nullptr;
+		TNode* pCur = m_pRoot;
+		int iDepth = 0;
+
+		while (pCur != nullptr) {
+			++iDepth;
+
+			if (data == pCur->Data) {
+				m_Statistics.OnSearch(iDepth);
+				return nullptr;
+			}
+
+			pParent = pCur;
+
+			if (data > pCur->Data) {
+				pCur = pCur->Right;
+			}
+			else {
+				pCur = pCur->Left;
+			}
+		}
+
+		m_Statistics.OnSearch(iDepth);
+		return pParent;
+	}
+
+	struct BuildContext
+	{
+		TreeStreamReader& Reader;
+		TNode* Previous;	// 직전에 만든 노드 (오름차순 확인용)
+		int BottomDepth;
+		bool Valid;
+	};
+
+	// 왼쪽 서브트리 -> 자신 -> 오른쪽 서브트리 순서(중위 순서)로 만들면 스트림을 앞에서부터 순서대로 읽게 된다.
+	// 읽기에 실패해도 지금까지 만든 노드는 모두 반환된 트리에 매달려있으므로 호출한 쪽에서 한번에 지운다.
+	template <typename TCodec>
+	TNode* BuildRecursive(BuildContext& context, TCodec& codec, int count, int depth, JCORE_OUT int& height) {
+		height = 0;
+
+		if (count == 0 || !context.Valid) {
+			return nullptr;
+		}
+
+		const int iLeftCount = (count - 1) / 2;
+		int iLeftHeight;
+		int iRightHeight;
+		TNode* pLeft = BuildRecursive(context, codec, iLeftCount, depth + 1, iLeftHeight);
+
+		T data;
+		if (!context.Valid || !codec.Read(context.Reader, data) || (context.Previous && !(context.Previous->Data < data))) {
+			context.Valid = false;
+			return pLeft;
+		}
+
+		TNode* pNode = TTreeCollection::CreateNode(data);
+		m_Statistics.OnAllocate();
+		context.Previous = pNode;
+
+		pNode->Left = pLeft;
+		if (pLeft) pLeft->Parent = pNode;
+
+		TNode* pRight = BuildRecursive(context, codec, count - 1 - iLeftCount, depth + 1, iRightHeight);
+		pNode->Right = pRight;
+		if (pRight) pRight->Parent = pNode;
+
+		height = Math::Max(iLeftHeight, iRightHeight) + 1;
+		TBalancer::BuildNode(pNode, height, depth > 1 && depth == context.BottomDepth);
+		return pNode;
+	}
+
+	TNode* FindNodeRecorded(const T& data) const {
+		int iDepth;
+		TNode* pNode = this->FindNode(data, iDepth);
+		m_Statistics.OnSearch(iDepth);
+		return pNode;
+	}
+
+	void DeleteNode(TNode* node) {
+		m_Statistics.OnDeallocate();
+
+		if (node == m_pRoot) {
+			TTreeCollection::DestroyNode(m_pRoot);
+			m_pRoot = nullptr;
+			return;
+		}
+
+		if (node->Parent) {
+			if (node->Parent->Left == node)
+				node->Parent->Left = nullptr;
+			else if (node->Parent->Right == node)	// 부유 상태의 node일 수 있으므로 무조건 체크
+				node->Parent->Right = nullptr;
+		}
+
+		TTreeCollection::DestroyNode(node);
+	}
+
+	void ConnectPredecessorChildToParent(TNode* predecessor, TNode* predecessorLeftChild) {
+
+		if (predecessor->IsRight()) {
+			predecessor->Parent->Right = predecessorLeftChild;
+			predecessorLeftChild->Parent = predecessor->Parent;
+			return;
+		}
+
+		predecessor->Parent->Left = predecessorLeftChild;
+		predecessorLeftChild->Parent = predecessor->Parent;
+	}
+
+	void RotateNode(TNode* node, TreeNodeRotateMode mode) {
+		switch (mode) {
+		case TreeNodeRotateMode::RR: RotateRR(node); return;
+		case TreeNodeRotateMode::LL: RotateLL(node); return;
+		case TreeNodeRotateMode::RL: RotateRL(node); return;
+		case TreeNodeRotateMode::LR: RotateLR(node); return;
+		}
+	}
+
+	void RotateLL(TNode* node) {
+		RotateRight(node);
+		m_Statistics.OnRotate(TreeNodeRotateMode::LL);
+	}
+	void RotateRR(TNode* node) {
+		RotateLeft(node);
+		m_Statistics.OnRotate(TreeNodeRotateMode::RR);
+	}
+	void RotateLR(TNode* cur) {
+		RotateLeft(cur->Left);
+		RotateRight(cur);
+		m_Statistics.OnRotate(TreeNodeRotateMode::LR);
+	}
+	void RotateRL(TNode* cur) {
+		RotateRight(cur->Right);
+		RotateLeft(cur);
+		m_Statistics.OnRotate(TreeNodeRotateMode::RL);
+	}
+
+	// 노드가 왼쪽/왼쪽으로 붙은 경우 (LL)
+	void RotateRight(TNode* node) {
+		//        ?		- pParent
+		//      5		- pCur
+		//    3			- pChild
+		//  1   ?		- pChildRight
+
+		//      ?		- pParent
+		//    3			- pChild
+		//  1   5		- pCur
+		//    ?			- pChildRight
+
+		TNode* pParent = node->Parent;
+		TNode* pCur = node;
+		TNode* pChild = node->Left;
+		TNode* pChildRight = node->Left->Right;
+
+		if (pParent) {
+			if (pParent->Left == pCur)
+				pParent->Left = pChild;
+			else
+				pParent->Right = pChild;
+		}
+		pChild->Parent = pParent;
+
+		pCur->Left = pChildRight;
+		if (pChildRight)
+			pChildRight->Parent = pCur;
+
+		pChild->Right = pCur;
+		pCur->Parent = pChild;
+
+		// 회전으로 인한 루트 변경 업데이트
+		if (m_pRoot == pCur) {
+			m_pRoot = pChild;
+		}
+	}
+	// 노드가 오른쪽/오른쪽으로 붙은 경우 (RR)
+	void RotateLeft(TNode* node) {
+		//  ?   		- ? : pParent
+		//    1 		- 1 : pCur
+		//      3		- 3 : pChild
+		//    ?	  5  	- ? : pChildLeft
+		//
+		//         ↓ 변환 후
+		//  ?			- ? : pParent
+		//    3			- 3 : pChild
+		//  1   5		- 1 : pCur
+		//   ?			- ? : pChildLeft
+
+		TNode* pParent = node->Parent;
+		TNode* pCur = node;
+		TNode* pChild = node->Right;
+		TNode* pChildLeft = node->Right->Left;
+
+		if (pParent) {
+			if (pParent->Left == pCur)
+				pParent->Left = pChild;
+			else
+				pParent->Right = pChild;
+		}
+		pChild->Parent = pParent;
+
+
+		pCur->Right = pChildLeft;
+		if (pChildLeft)
+			pChildLeft->Parent = pCur;
+
+		pChild->Left = pCur;
+		pCur->Parent = pChild;
+
+		// 회전으로 인한 루트 변경 업데이트
+		if (m_pRoot == pCur) {
+			m_pRoot = pChild;
+		}
+	}
+	static void RecordDataOnHierarchy(TNode* node, int depth, HashMap<int, Vector<TNode*>>& hierarchy) {
+		if (node == nullptr) return;
+		hierarchy[depth].PushBack(node);
+		RecordDataOnHierarchy(node->Left, depth + 1, hierarchy);
+		RecordDataOnHierarchy(node->Right, depth + 1, hierarchy);
+	}
+
+	JCORE_NO_UNIQUE_ADDRESS mutable TStatistics m_Statistics;
+
+	friend TBalancer;
+
+	#pragma endregion
+	// PRIVATE FIELDS
+
+};
+
+NS_JC_END
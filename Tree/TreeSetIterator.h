@@ -0,0 +1,57 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리셋 중위 순회 반복자
+ * JCore 컨테이너 반복자처럼 HasNext()/Next() 형태로 사용한다.
+ * 가상함수 없이 노드 포인터 하나만 들고 다니는 가벼운 반복자이다.
+ *
+ *  auto it = set.Begin();
+ *  while (it.HasNext()) {
+ *      const int& v = it.Next();
+ *  }
+ */
+
+#pragma once
+
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+template <typename T, typename TNodeTag>
+class TreeSetIterator
+{
+	using TNode = TreeNode<T, TNodeTag>;
+public:
+	TreeSetIterator(TNode* current = nullptr) : m_pCurrent(current) {}
+
+	bool HasNext() const { return m_pCurrent != nullptr; }
+	bool IsEnd() const { return m_pCurrent == nullptr; }
+
+	const T& Current() const {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		return m_pCurrent->Data;
+	}
+
+	// 현재 데이터를 반환하고 다음 노드로 이동
+	const T& Next() {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		TNode* pCur = m_pCurrent;
+		m_pCurrent = pCur->Next();
+		return pCur->Data;
+	}
+
+	// 현재 데이터를 반환하고 이전 노드로 이동
+	const T& Previous() {
+		DebugAssertMsg(m_pCurrent, "반복자가 끝에 도달했습니다.");
+		TNode* pCur = m_pCurrent;
+		m_pCurrent = pCur->Previous();
+		return pCur->Data;
+	}
+
+	bool operator==(const TreeSetIterator& other) const { return m_pCurrent == other.m_pCurrent; }
+	bool operator!=(const TreeSetIterator& other) const { return m_pCurrent != other.m_pCurrent; }
+private:
+	TNode* m_pCurrent;
+};
+
+NS_JC_END
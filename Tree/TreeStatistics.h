@@ -0,0 +1,133 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 트리셋 통계 기록 정책
+ * 어떤 트리셋이 왜 느린지(회전이 잦은지, 트리가 깊은지) 확인하기 위한 카운터이다.
+ *
+ * TreeSet<T, TBalancer, TStatistics>의 세번째 인자로 정책을 고른다.
+ *  - NullTreeStatistics     : 아무것도 기록하지 않는다. (기본값, 모든 함수가 비어있으므로 인라인되면 비용이 없다)
+ *  - CountingTreeStatistics : TreeStatistics에 누적한다.
+ *
+ * 회전은 형태(TreeNodeRotateMode)별로 센다. 이중 회전(LR, RL)은 LR/RL로 1회만 세고 LL/RR로는 세지 않는다.
+ * (레드블랙트리는 삽입 케이스 1-3/1-4를 한번 회전해서 1-1/1-2로 바꾸므로 LR/RL이 기록되지 않는다. LR/RL은 AVL/WAVL에서만 나온다)
+ * 탐색 깊이는 Search뿐만 아니라 Insert/Remove가 위치를 찾으며 방문한 노드 수도 포함한다. (루트만 방문하면 1)
+ * 삽입/삭제 케이스는 레드블랙트리 균형 정책의 주석에 적힌 케이스 번호를 그대로 따른다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Math.h>
+#include <JCore/Container/Arrays.h>
+
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+enum class RedBlackInsertCase
+{
+	Case1_1,		// 삼촌 Black, 부모/자식 모두 왼쪽
+	Case1_2,		// 삼촌 Black, 부모/자식 모두 오른쪽
+	Case1_3,		// 삼촌 Black, 삼각형 (부모 왼쪽, 자식 오른쪽)
+	Case1_4,		// 삼촌 Black, 삼각형 (부모 오른쪽, 자식 왼쪽)
+	Case2,			// 삼촌 Red
+	Max
+};
+
+enum class RedBlackRemoveCase
+{
+	SingleChild,		// 삭제될 Black 노드의 Red 자식이 대신 Black이 된다.
+	Group1Case1,		// 부모 Red, 조카 모두 Black
+	Group1Case2,		// 부모 Red, 라인조카 Red
+	Group1Case3,		// 부모 Red, 꺽인조카 Red
+	Group2Case1,		// 부모 Black, 형제 Black, 조카 모두 Black
+	Group2Case2,		// 부모 Black, 형제 Black, 라인조카 Red
+	Group2Case3,		// 부모 Black, 형제 Black, 꺽인조카 Red
+	Group2Case5,		// 부모 Black, 형제 Red
+	Max
+};
+
+// 지표 수집용 스냅샷
+struct TreeStatistics
+{
+	TreeStatistics() { Reset(); }
+
+	Int64 RotationCount[4];									// TreeNodeRotateMode별 회전 횟수
+	Int64 RecolorCount;										// 색상 변경 횟수
+	Int64 InsertCaseCount[int(RedBlackInsertCase::Max)];	// 삽입 위반 수정 케이스별 횟수
+	Int64 RemoveCaseCount[int(RedBlackRemoveCase::Max)];	// 삭제 위반 수정 케이스별 횟수
+	Int64 SearchCount;										// 위치를 찾은 횟수 (Search, Insert, Remove)
+	Int64 SearchDepthSum;									// 위치를 찾으며 방문한 노드 수 (누계)
+	int SearchDepthMax;										// 위치를 찾으며 방문한 노드 수 (최대)
+	Int64 AllocationCount;									// 노드 할당 횟수
+	Int64 DeallocationCount;								// 노드 해제 횟수
+
+	Int64 GetRotationCount(TreeNodeRotateMode mode) const { return RotationCount[int(mode)]; }
+	Int64 GetInsertCaseCount(RedBlackInsertCase c) const { return InsertCaseCount[int(c)]; }
+	Int64 GetRemoveCaseCount(RedBlackRemoveCase c) const { return RemoveCaseCount[int(c)]; }
+
+	Int64 GetTotalRotationCount() const {
+		return RotationCount[0] + RotationCount[1] + RotationCount[2] + RotationCount[3];
+	}
+
+	// 이중 회전(LR, RL)을 단일 회전 2회로 센 횟수 (균형 정책끼리 포인터를 바꾼 횟수를 비교할 때)
+	Int64 GetSingleRotationCount() const {
+		return GetRotationCount(TreeNodeRotateMode::LL) + GetRotationCount(TreeNodeRotateMode::RR) +
+			2 * (GetRotationCount(TreeNodeRotateMode::LR) + GetRotationCount(TreeNodeRotateMode::RL));
+	}
+
+	double GetAverageSearchDepth() const {
+		return SearchCount == 0 ? 0.0 : double(SearchDepthSum) / double(SearchCount);
+	}
+
+	void Reset() {
+		Arrays::Fill(RotationCount, Int64(0));
+		Arrays::Fill(InsertCaseCount, Int64(0));
+		Arrays::Fill(RemoveCaseCount, Int64(0));
+		RecolorCount = 0;
+		SearchCount = 0;
+		SearchDepthSum = 0;
+		SearchDepthMax = 0;
+		AllocationCount = 0;
+		DeallocationCount = 0;
+	}
+};
+
+struct NullTreeStatistics
+{
+	void OnRotate(TreeNodeRotateMode) {}
+	void OnRecolor(int = 1) {}
+	void OnInsertCase(RedBlackInsertCase) {}
+	void OnRemoveCase(RedBlackRemoveCase) {}
+	void OnSearch(int) {}
+	void OnAllocate() {}
+	void OnDeallocate(Int64 = 1) {}
+
+	TreeStatistics Snapshot() const { return {}; }
+	void Reset() {}
+};
+
+class CountingTreeStatistics
+{
+public:
+	void OnRotate(TreeNodeRotateMode mode) { ++m_Statistics.RotationCount[int(mode)]; }
+	void OnRecolor(int count = 1) { m_Statistics.RecolorCount += count; }
+	void OnInsertCase(RedBlackInsertCase c) { ++m_Statistics.InsertCaseCount[int(c)]; }
+	void OnRemoveCase(RedBlackRemoveCase c) { ++m_Statistics.RemoveCaseCount[int(c)]; }
+
+	void OnSearch(int depth) {
+		++m_Statistics.SearchCount;
+		m_Statistics.SearchDepthSum += depth;
+		m_Statistics.SearchDepthMax = Math::Max(m_Statistics.SearchDepthMax, depth);
+	}
+
+	void OnAllocate() { ++m_Statistics.AllocationCount; }
+	void OnDeallocate(Int64 count = 1) { m_Statistics.DeallocationCount += count; }
+
+	TreeStatistics Snapshot() const { return m_Statistics; }
+	void Reset() { m_Statistics.Reset(); }
+private:
+	TreeStatistics m_Statistics;
+};
+
+NS_JC_END
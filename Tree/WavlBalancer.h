@@ -0,0 +1,167 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * WAVL(Weak AVL) 트리 균형 정책
+ * Haeupler, Sen, Tarjan - Rank-Balanced Trees
+ *
+ * 노드마다 랭크를 두고 (부모 랭크 - 자식 랭크)를 랭크 차이라고 한다. 없는 노드의 랭크는 -1이다.
+ *  1. 모든 랭크 차이는 1 또는 2이다.
+ *  2. 리프노드의 랭크는 0이다. (즉, 리프노드는 1,1 노드)
+ *
+ * 삭제가 없으면 AVL 트리와 완전히 동일한 모양을 가지며, 삭제가 섞이더라도 높이가 레드블랙트리보다 높아지지 않는다.
+ * 삽입/삭제 모두 회전이 최대 2번으로 제한되므로 AVL보다 회전 횟수가 적다.
+ */
+
+#pragma once
+
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Primitives/String.h>
+
+#include "TreeNode.h"
+
+NS_JC_BEGIN
+
+struct WavlNodeTag
+{
+	int Rank = 0;
+};
+
+struct WavlBalancer
+{
+	using TNodeTag = WavlNodeTag;
+
+	// 삽입된 노드가 0-자식(부모와 랭크가 같음)이 되면 위반이다.
+	template <typename TTree, typename TNode>
+	static void InsertFixup(TTree& tree, TNode* child) {
+		TNode* pParent = child->Parent;
+
+		while (pParent && pParent->Rank == child->Rank) {
+			const bool bLeftChild = child->IsLeft();
+			TNode* pSibling = bLeftChild ? pParent->Right : pParent->Left;
+
+			// 형제가 1-자식이면 부모를 승급시키고 위로 전파한다.
+			if (pParent->Rank - Rank(pSibling) == 1) {
+				pParent->Rank++;
+				child = pParent;
+				pParent = pParent->Parent;
+				continue;
+			}
+
+			// 형제가 2-자식이면 회전으로 끝낸다.
+			// child는 승급되어 올라온 노드이므로 1,2 노드이다. 안쪽 자식이 2-자식이면 단일 회전, 1-자식이면 이중 회전
+			TNode* pInner = bLeftChild ? child->Right : child->Left;
+
+			if (child->Rank - Rank(pInner) == 2) {
+				tree.RotateNode(pParent, bLeftChild ? TreeNodeRotateMode::LL : TreeNodeRotateMode::RR);
+				pParent->Rank--;
+			} else {
+				tree.RotateNode(pParent, bLeftChild ? TreeNodeRotateMode::LR : TreeNodeRotateMode::RL);
+				pInner->Rank++;
+				child->Rank--;
+				pParent->Rank--;
+			}
+			return;
+		}
+	}
+
+	// WAVL은 노드가 떨어진 후에 랭크 차이를 확인한다.
+	template <typename TTree, typename TNode>
+	static void RemoveFixup(TTree&, TNode*) {}
+
+	// 노드가 떨어지면 parent에 2,2 리프가 생기거나 3-자식이 생길 수 있다.
+	template <typename TTree, typename TNode>
+	static void RemoveRetrace(TTree& tree, TNode* parent) {
+		if (parent == nullptr) {
+			return;
+		}
+
+		// 리프의 랭크는 0이어야한다.
+		if (parent->Left == nullptr && parent->Right == nullptr && parent->Rank == 1) {
+			parent->Rank = 0;
+			parent = parent->Parent;
+		}
+
+		while (parent) {
+			const int iLeftDiff = parent->Rank - Rank(parent->Left);
+			const int iRightDiff = parent->Rank - Rank(parent->Right);
+
+			if (iLeftDiff != 3 && iRightDiff != 3) {
+				return;
+			}
+
+			const bool bLeftChild = iLeftDiff == 3;		// 3-자식이 어느쪽인지
+			TNode* pSibling = bLeftChild ? parent->Right : parent->Left;
+
+			// 형제가 2-자식이면 부모를 강등시키고 위로 전파한다.
+			if (parent->Rank - pSibling->Rank == 2) {
+				parent->Rank--;
+				parent = parent->Parent;
+				continue;
+			}
+
+			// 형제가 1-자식인데 2,2 노드이면 부모와 형제를 같이 강등시키고 위로 전파한다.
+			TNode* pOuter = bLeftChild ? pSibling->Right : pSibling->Left;
+			TNode* pInner = bLeftChild ? pSibling->Left : pSibling->Right;
+			const int iOuterDiff = pSibling->Rank - Rank(pOuter);
+			const int iInnerDiff = pSibling->Rank - Rank(pInner);
+
+			if (iOuterDiff == 2 && iInnerDiff == 2) {
+				parent->Rank--;
+				pSibling->Rank--;
+				parent = parent->Parent;
+				continue;
+			}
+
+			// 회전으로 끝낸다.
+			if (iOuterDiff == 1) {
+				tree.RotateNode(parent, bLeftChild ? TreeNodeRotateMode::RR : TreeNodeRotateMode::LL);
+				pSibling->Rank++;
+				parent->Rank--;
+
+				if (parent->Left == nullptr && parent->Right == nullptr) {
+					parent->Rank--;
+				}
+			} else {
+				tree.RotateNode(parent, bLeftChild ? TreeNodeRotateMode::RL : TreeNodeRotateMode::LR);
+				pInner->Rank += 2;
+				pSibling->Rank--;
+				parent->Rank -= 2;
+			}
+			return;
+		}
+	}
+
+	// AVL 트리는 랭크를 (높이 - 1)로 두면 WAVL 트리이다.
+	template <typename TNode>
+	static void BuildNode(TNode* node, int height, bool) {
+		node->Rank = height - 1;
+	}
+
+	// 랭크 차이가 1 또는 2이고 리프의 랭크가 0인지 확인한다. (height는 쓰지 않는다)
+	template <typename TNode>
+	static bool ValidateNode(const TNode* node, int, int, JCORE_OUT int& height) {
+		const int iLeftDiff = node->Rank - Rank(node->Left);
+		const int iRightDiff = node->Rank - Rank(node->Right);
+
+		if (iLeftDiff < 1 || iLeftDiff > 2 || iRightDiff < 1 || iRightDiff > 2) {
+			return false;
+		}
+
+		if (node->Left == nullptr && node->Right == nullptr && node->Rank != 0) {
+			return false;
+		}
+
+		height = node->Rank;
+		return true;
+	}
+
+	template <typename TNode>
+	static String DbgNodeTagString(const TNode* node) {
+		return StringUtil::Format("R%d", node->Rank);
+	}
+private:
+	template <typename TNode>
+	static int Rank(const TNode* node) { return node ? node->Rank : -1; }
+};
+
+NS_JC_END
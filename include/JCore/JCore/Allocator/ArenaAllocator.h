@@ -0,0 +1,246 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 단조(monotonic) 아레나 할당자
+ * 요청 하나를 처리하는 동안만 쓰고 버리는 컨테이너용
+ *
+ *  - 할당: 현재 블록의 커서를 정렬만큼 올리고 요청 크기만큼 민다. 블록이 모자라면 새 블록을 받는다.
+ *  - 해제: 아무것도 하지 않는다. 메모리는 Reset으로 한꺼번에 되돌린다.
+ *  - Reset: 블록은 운영체제에 돌려주지 않고 다음 요청에서 다시 쓴다. (BlockSize의 절반보다 큰 할당은 따로 받은 블록이라 해제한다)
+ *
+ * 컨테이너의 TAllocator는 정적 함수만 쓰므로 ArenaAllocator는 "이 쓰레드의 현재 아레나"에서 할당한다.
+ * 현재 아레나는 쓰레드마다 하나씩 있는 기본 아레나이고 ArenaScope로 잠깐 다른 아레나로 바꿀 수 있다.
+ *
+ *	Arena arena;
+ *	{
+ *		ArenaScope scope(arena);
+ *		Vector<int, ArenaAllocator> vec;
+ *		HashMap<int, int, ArenaAllocator> map;
+ *		...
+ *	}	// 컨테이너가 먼저 소멸한 후
+ *	arena.Reset();
+ *
+ * Reset하면 그 아레나에서 받은 메모리는 모두 무효가 되므로 그 전에 컨테이너를 소멸시켜야 한다.
+ * 아레나는 쓰레드에 안전하지 않다. 다른 쓰레드로 넘긴 컨테이너에 원소를 추가하면 안된다.
+ */
+
+#pragma once
+
+#include <JCore/Memory.h>
+
+NS_JC_BEGIN
+
+class Arena
+{
+	// 블록 머리. 데이터는 바로 뒤부터 시작한다.
+	struct alignas(16) Block
+	{
+		Block* Next;
+		int Size;			// 머리를 제외한 데이터 크기
+	};
+public:
+	static constexpr int DefaultBlockSize = 64 * 1024;
+	static constexpr int DefaultAlignment = 16;
+
+	Arena(int blockSize = DefaultBlockSize)
+		: m_iBlockSize(blockSize)
+		, m_pBlocks(nullptr)
+		, m_pFreeBlocks(nullptr)
+		, m_pLargeBlocks(nullptr)
+		, m_pCursor(nullptr)
+		, m_pEnd(nullptr)
+		, m_uiUsedBytes(0)
+		, m_uiReservedBytes(0)
+	{
+		DebugAssertMsg(blockSize >= 1024, "블록 크기가 너무 작습니다.");
+	}
+
+	Arena(const Arena&) = delete;
+	~Arena() { Release(); }
+
+	Arena& operator=(const Arena&) = delete;
+
+	// alignment는 2의 거듭제곱이어야 한다.
+	void* Allocate(int size, int alignment = DefaultAlignment) {
+		DebugAssertMsg(size >= 0 && alignment > 0 && (alignment & (alignment - 1)) == 0, "올바르지 않은 할당 요청입니다. (%d바이트, %d정렬)", size, alignment);
+
+		if (size > m_iBlockSize / 2) {
+			return AllocateLarge(size, alignment);
+		}
+
+		Byte* pAligned = AlignUp(m_pCursor, alignment);
+		if (pAligned == nullptr || pAligned + size > m_pEnd) {
+			NextBlock();
+			pAligned = AlignUp(m_pCursor, alignment);
+		}
+
+		m_pCursor = pAligned + size;
+		m_uiUsedBytes += size;
+		return pAligned;
+	}
+
+	// 받은 메모리를 모두 무효로 만든다. 일반 블록은 다음 할당에서 다시 쓴다.
+	void Reset() {
+		ReleaseBlocks(m_pLargeBlocks);
+
+		while (m_pBlocks != nullptr) {
+			Block* pNext = m_pBlocks->Next;
+			m_pBlocks->Next = m_pFreeBlocks;
+			m_pFreeBlocks = m_pBlocks;
+			m_pBlocks = pNext;
+		}
+
+		m_pCursor = nullptr;
+		m_pEnd = nullptr;
+		m_uiUsedBytes = 0;
+	}
+
+	// Reset 후 블록까지 모두 해제한다.
+	void Release() {
+		Reset();
+		ReleaseBlocks(m_pFreeBlocks);
+	}
+
+	Int64U UsedBytes() const { return m_uiUsedBytes; }				// Reset 이후 요청받은 바이트 수 (정렬 여유분 제외)
+	Int64U ReservedBytes() const { return m_uiReservedBytes; }		// 블록으로 받아둔 바이트 수
+	int BlockSize() const { return m_iBlockSize; }
+private:
+	static Byte* AlignUp(Byte* ptr, int alignment) {
+		return reinterpret_cast<Byte*>((IntPtr(ptr) + alignment - 1) & ~IntPtr(alignment - 1));
+	}
+
+	static Byte* DataOf(Block* block) {
+		return reinterpret_cast<Byte*>(block + 1);
+	}
+
+	Block* NewBlock(int size) {
+		Block* pBlock = Memory::Allocate<Block*>(sizeof(Block) + size);
+		pBlock->Size = size;
+		m_uiReservedBytes += size;
+		return pBlock;
+	}
+
+	void NextBlock() {
+		Block* pBlock = m_pFreeBlocks;
+
+		if (pBlock != nullptr) {
+			m_pFreeBlocks = pBlock->Next;
+		} else {
+			pBlock = NewBlock(m_iBlockSize);
+		}
+
+		pBlock->Next = m_pBlocks;
+		m_pBlocks = pBlock;
+		m_pCursor = DataOf(pBlock);
+		m_pEnd = m_pCursor + pBlock->Size;
+	}
+
+	// 큰 할당은 블록을 따로 받아서 일반 블록의 남은 공간을 버리지 않는다.
+	void* AllocateLarge(int size, int alignment) {
+		const int iPadding = alignment > int(alignof(Block)) ? alignment - 1 : 0;
+		Block* pBlock = NewBlock(size + iPadding);
+		pBlock->Next = m_pLargeBlocks;
+		m_pLargeBlocks = pBlock;
+		m_uiUsedBytes += size;
+		return AlignUp(DataOf(pBlock), alignment);
+	}
+
+	void ReleaseBlocks(Block*& blocks) {
+		while (blocks != nullptr) {
+			Block* pNext = blocks->Next;
+			m_uiReservedBytes -= blocks->Size;
+			Memory::Deallocate(blocks);
+			blocks = pNext;
+		}
+	}
+private:
+	int m_iBlockSize;
+	Block* m_pBlocks;			// 사용중인 일반 블록 (맨 앞이 현재 블록)
+	Block* m_pFreeBlocks;		// Reset으로 돌려받은 일반 블록
+	Block* m_pLargeBlocks;		// BlockSize의 절반보다 큰 할당용 블록
+	Byte* m_pCursor;
+	Byte* m_pEnd;
+	Int64U m_uiUsedBytes;
+	Int64U m_uiReservedBytes;
+};
+
+NS_DETAIL_BEGIN
+
+inline thread_local Arena ThreadArena_v;
+inline thread_local Arena* CurrentArena_v = nullptr;
+
+NS_DETAIL_END
+
+// 범위 안에서 이 쓰레드의 ArenaAllocator가 arena를 쓰도록 한다. 중첩할 수 있다.
+class ArenaScope
+{
+public:
+	ArenaScope(Arena& arena) : m_pPrevious(Detail::CurrentArena_v) { Detail::CurrentArena_v = &arena; }
+	ArenaScope(const ArenaScope&) = delete;
+	~ArenaScope() { Detail::CurrentArena_v = m_pPrevious; }
+
+	ArenaScope& operator=(const ArenaScope&) = delete;
+private:
+	Arena* m_pPrevious;
+};
+
+class ArenaAllocator
+{
+public:
+	// 이 쓰레드의 현재 아레나 (ArenaScope가 없으면 쓰레드 기본 아레나)
+	static Arena& Current() {
+		Arena* pArena = Detail::CurrentArena_v;
+		return pArena ? *pArena : Detail::ThreadArena_v;
+	}
+
+	// 현재 아레나를 되돌린다. 요청 처리가 끝날 때 호출할 것
+	static void Reset() { Current().Reset(); }
+
+	template <typename T>
+	static auto Allocate() {	// Static
+		return static_cast<RemovePointer_t<T>*>(Current().Allocate(sizeof(T), AlignmentOf<T>()));
+	}
+
+	template <typename T = void*>	// 명시하지 않을 경우 void* 반환
+	static auto Allocate(int size, int& allocatedSize) {	// Dynamic
+		allocatedSize = size;
+		return static_cast<RemovePointer_t<T>*>(Current().Allocate(size, AlignmentOf<T>()));
+	}
+
+	template <typename T, typename... Args>
+	static auto AllocateInit(Args&&... args) {	// Static
+		auto pRet = Allocate<T>();
+		Memory::PlacementNew(pRet, Forward<Args>(args)...);
+		return pRet;
+	}
+
+	template <typename T = void*, typename... Args>	// 명시하지 않을 경우 void* 반환
+	static auto AllocateInit(int size, int& allocatedSize, Args&&... args) {	// Dynamic
+		auto pRet = Allocate<T>(size, allocatedSize);
+		Memory::PlacementNew(pRet, Forward<Args>(args)...);
+		return pRet;
+	}
+
+	// 해제는 Reset에서 한꺼번에 한다.
+	template <typename T>
+	static void Deallocate(void*) {}
+	static void Deallocate(void*, int) {}
+
+	static int AllocatedSize(int requestSize) {
+		return requestSize;
+	}
+private:
+	// void*로 받으면 어떤 타입이 올지 모르므로 기본 정렬을 쓴다.
+	template <typename T>
+	static constexpr int AlignmentOf() {
+		using TElement = RemovePointer_t<T>;
+
+		if constexpr (IsVoidType_v<TElement>) {
+			return Arena::DefaultAlignment;
+		} else {
+			return int(alignof(TElement));
+		}
+	}
+};
+
+NS_JC_END
@@ -33,6 +33,7 @@ public:
 
 	template <typename T = void*>	// 명시하지 않을 경우 void* 반환
     static auto Allocate(int size, int& allocatedSize) {	// Dynamic
+		allocatedSize = size;
 		return Memory::Allocate<RemovePointer_t<T>*>(size);
 	}
 
@@ -45,6 +46,7 @@ public:
 
 	template <typename T = void*, typename... Args>	// 명시하지 않을 경우 void* 반환
 	static auto AllocateInit(int size, int& allocatedSize, Args&&... args) {	// Dynamic
+		allocatedSize = size;
 		auto pRet = Memory::Allocate<RemovePointer_t<T>*>(size);
 		Memory::PlacementNew(pRet, Forward<Args>(args)...);
 		return pRet;
@@ -59,6 +61,11 @@ public:
 		Memory::Deallocate(del);
 	}
 
+	// Dynamic 할당시 실제로 반환되는 크기 (힙 관리자의 내부 여유분은 알 수 없으므로 요청 크기 그대로)
+	static int AllocatedSize(int requestSize) {
+		return requestSize;
+	}
+
 
 };
 
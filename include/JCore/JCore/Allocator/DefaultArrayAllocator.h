@@ -70,6 +70,11 @@ public:
 	static void Deallocate(void* del, int size) {
 		ArrayAllocatorPool_v.DynamicPush(del, size);
 	}
+
+	// Dynamic 할당시 실제로 반환되는 크기 (DynamicPop의 realAllocatedSize와 같다)
+	static int AllocatedSize(int requestSize) {
+		return Detail::AllocationLengthMapConverter::ToSize(Detail::AllocationLengthMapConverter::ToIndex(requestSize));
+	}
 };
 
 NS_JC_END
@@ -23,7 +23,7 @@ NS_JC_END
 		#define DebugAssertMsg(expect, fmt, ...)																\
 		do {																									\
 			if ((expect)) break;																				\
-			JCore::Detail::__DebugAssertMsgImpl(__FILE__, __LINE__, __FUNCTION__, fmt, __VA_ARGS__);			\
+			JCore::Detail::__DebugAssertMsgImpl(__FILE__, __LINE__, __FUNCTION__, fmt, ##__VA_ARGS__);			\
 		} while (0)
         #define DebugAssert(expect)            DebugAssertMsg(expect, "메시지 없음")
 
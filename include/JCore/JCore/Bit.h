@@ -9,6 +9,8 @@
 #include <JCore/Limit.h>
 #include <JCore/Type.h>
 
+#include <bit>
+
 NS_JC_BEGIN
 
 // 오른쪽부터 1을 몇번 채울지
@@ -55,4 +57,39 @@ constexpr int BitIsSet32(int source, int target) {
 	return (source & target) == target;
 }
 
+
+constexpr Int64U Bit64(int pos) {
+	return Int64U(1) << pos;
+}
+
+// 1인 비트의 수
+// PopCount64(0b1011) -> 3
+constexpr int PopCount64(Int64U value) {
+	return std::popcount(value);
+}
+
+// 오른쪽부터 연속된 0의 수 = 가장 낮은 1 비트의 위치 (value가 0이면 64)
+// CountTrailingZero64(0b1000) -> 3
+constexpr int CountTrailingZero64(Int64U value) {
+	return std::countr_zero(value);
+}
+
+// 왼쪽부터 연속된 0의 수 (value가 0이면 64)
+// 63 - CountLeadingZero64(value) -> 가장 높은 1 비트의 위치
+constexpr int CountLeadingZero64(Int64U value) {
+	return std::countl_zero(value);
+}
+
+// pos 미만 위치의 비트만 1인 마스크
+// BitMaskBelow64(3) -> ... (생략) 0000 0111
+constexpr Int64U BitMaskBelow64(int pos) {
+	return pos >= 64 ? ~Int64U(0) : Bit64(pos) - 1;
+}
+
+// pos 이상 위치의 비트만 1인 마스크
+// BitMaskFrom64(3) -> 1111 ... (생략) 1111 1000
+constexpr Int64U BitMaskFrom64(int pos) {
+	return ~BitMaskBelow64(pos);
+}
+
 NS_JC_END
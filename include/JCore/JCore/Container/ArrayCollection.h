@@ -10,6 +10,7 @@
 
 #include <JCore/Container/Arrays.h>
 #include <JCore/Container/Collection.h>
+#include <JCore/Container/MemoryUsage.h>
 #include <JCore/Container/ArrayCollectionIterator.h>
 
 
@@ -91,6 +92,21 @@ public:
 		return m_iCapacity;
 	}
 
+	// 남는 용량과 할당자가 더 크게 준 크기를 SlackBytes로 센다.
+	MemoryUsage GetMemoryUsage() const {
+		MemoryUsage usage;
+		usage.ElementCount = this->m_iSize;
+		usage.ElementBytes = Int64(sizeof(T)) * this->m_iSize;
+		usage.NodeBytes = usage.ElementBytes;
+
+		if (m_pArray) {
+			const Int64 iArrayBytes = Int64(sizeof(T)) * m_iCapacity;
+			usage.SlackBytes = iArrayBytes - usage.NodeBytes + (TAllocator::AllocatedSize(int(iArrayBytes)) - iArrayBytes);
+		}
+
+		return usage;
+	}
+
 	/// <summary>
 	/// 내부 원소 모두 제거
 	/// 
@@ -423,7 +439,7 @@ protected:
 	T* m_pArray;
 	int m_iCapacity;
 
-	friend class TArrayCollectionIterator;
+	friend TArrayCollectionIterator;
 };
 
 template <typename T, typename TAllocator>
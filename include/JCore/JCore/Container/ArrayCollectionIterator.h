@@ -65,7 +65,7 @@ protected:
 
 	TArrayCollection* CastArrayCollection() const {
 		this->ThrowIfIteratorIsNotValid();
-		return this->Watcher.Get<TArrayCollection*>();
+		return this->Watcher.template Get<TArrayCollection*>();
 	}
 protected:
 	int m_iPos;
@@ -457,7 +457,7 @@ protected:
 
 	*/
 
-	friend class TArrayQueueIterator;
+	friend TArrayQueueIterator;
 };
 
 NS_JC_END
\ No newline at end of file
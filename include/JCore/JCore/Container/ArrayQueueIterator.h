@@ -104,7 +104,7 @@ protected:
 
 	TArrayQueue* CastArrayQueue() const {
 		this->ThrowIfIteratorIsNotValid();
-		return this->Watcher.Get<TArrayQueue*>();
+		return this->Watcher.template Get<TArrayQueue*>();
 	}
 };
 
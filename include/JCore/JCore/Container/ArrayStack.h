@@ -98,7 +98,7 @@ public:
 	ContainerType GetContainerType() override { return ContainerType::ArrayStack; }
 
 protected:
-	friend class TArrayStackIterator;
+	friend TArrayStackIterator;
 };
 
 
@@ -29,7 +29,7 @@ public:
 	CollectionStreamIterator(VoidOwner& owner, TStreamNode* current) : TIterator(owner) {
 		m_pCurrent = current;
 
-		TCollectionStream* pList = owner.Get<TCollectionStream*>();
+		TCollectionStream* pList = owner.template Get<TCollectionStream*>();
 		m_pHead = pList->m_pHead;
 		m_pTail = pList->m_pTail;
 	}
@@ -89,7 +89,7 @@ protected:
 	TStreamNode* m_pHead;
 	TStreamNode* m_pTail;
 
-	friend class TCollectionStream;
+	friend TCollectionStream;
 };
 
 NS_JC_END
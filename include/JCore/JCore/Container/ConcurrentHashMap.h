@@ -0,0 +1,209 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 락 스트라이핑 동시성 해시맵
+ * 키 공간을 여러 세그먼트로 나누고 세그먼트마다 HashMap 하나와 락 하나를 둔다.
+ * 서로 다른 세그먼트에 접근하는 쓰레드끼리는 경쟁하지 않으므로 전역 락 하나로 감싼 HashMap보다 잘 확장된다.
+ *
+ *  - 세그먼트 선택: 해쉬의 상위 비트를 쓴다. 세그먼트 안의 HashMap은 하위 비트로 버킷을 고르므로
+ *                   같은 비트를 쓰면 세그먼트마다 버킷의 일부만 쓰이게 된다.
+ *  - 확장: 세그먼트마다 따로 한다. 한 세그먼트가 확장하는 동안에도 다른 세그먼트는 그대로 쓸 수 있고
+ *          SetIncrementalRehash를 켜면 그 세그먼트 안에서도 확장이 여러 삽입에 나눠서 진행된다.
+ *  - 락: TLock이 IRwLock(NormalRwLock)이면 탐색/순회는 읽기 락, 변경은 쓰기 락을 잡는다.
+ *        ILock(SpinLock 등)이면 모두 같은 락을 잡는다. 임계 구역이 짧아서 보통 SpinLock이 더 빠르다.
+ *
+ * 다른 쓰레드가 언제든 지울 수 있으므로 값의 주소는 밖으로 내주지 않는다. 탐색은 값을 복사해서 돌려주고
+ * 값을 그 자리에서 바꿔야 하면 Update로 세그먼트 락을 잡은 채로 바꾼다.
+ * Size와 ForEach는 세그먼트 단위로 일관성을 가진다. (세그먼트를 하나씩 잠그므로 전체를 한 순간에 본 결과는 아니다)
+ * 소멸자는 다른 쓰레드가 접근하지 않을 때만 호출해야 한다.
+ */
+
+#pragma once
+
+#include <JCore/Container/HashMap.h>
+#include <JCore/Sync/SpinLock.h>
+#include <JCore/Sync/IRwLock.h>
+
+NS_JC_BEGIN
+
+template <typename TKey, typename TValue, typename TLock = SpinLock, typename TAllocator = DefaultAllocator>
+class ConcurrentHashMap
+{
+	using THashMap				= HashMap<TKey, TValue, TAllocator>;
+	using THasher				= Hasher<TKey>;
+	using TKeyValuePair			= Pair<TKey, TValue>;
+	using TConcurrentHashMap	= ConcurrentHashMap<TKey, TValue, TLock, TAllocator>;
+
+	static constexpr bool IsRwLock_v = IsBaseOf_v<IRwLock, TLock>;
+
+	using TReadGuard			= Conditional_t<IsRwLock_v, RwLockGuard<TLock, RwLockMode::Read>, LockGuard<TLock>>;
+	using TWriteGuard			= Conditional_t<IsRwLock_v, RwLockGuard<TLock, RwLockMode::Write>, LockGuard<TLock>>;
+
+	// 이웃한 세그먼트의 락끼리 같은 캐시라인을 쓰지 않도록 한다.
+	struct alignas(64) Segment
+	{
+		TLock Lock;
+		THashMap Map;
+	};
+public:
+	static constexpr int DefaultSegmentCount = 64;
+	static constexpr int MaxSegmentCount = 1 << 16;
+
+	// segmentCount는 2의 거듭제곱으로 올림한다.
+	ConcurrentHashMap(int segmentCount = DefaultSegmentCount) {
+		DebugAssertMsg(segmentCount > 0 && segmentCount <= MaxSegmentCount, "세그먼트 수는 1 ~ %d 사이여야 합니다.", MaxSegmentCount);
+
+		m_iSegmentShift = 32;
+		m_iSegmentCount = 1;
+		while (m_iSegmentCount < segmentCount) {
+			m_iSegmentCount <<= 1;
+			--m_iSegmentShift;
+		}
+
+		m_pSegments = dbg_new Segment[m_iSegmentCount];
+	}
+
+	ConcurrentHashMap(const TConcurrentHashMap&) = delete;
+	~ConcurrentHashMap() { delete[] m_pSegments; }
+
+	TConcurrentHashMap& operator=(const TConcurrentHashMap&) = delete;
+
+	// 이미 있는 키면 false를 반환한다.
+	template <typename Ky, typename Vy>
+	bool Insert(Ky&& key, Vy&& value) {
+		return TryEmplace(Forward<Ky>(key), Forward<Vy>(value));
+	}
+
+	// 키가 없을 때만 args로 값을 생성해서 넣는다. 넣었으면 true
+	template <typename Ky, typename... Args>
+	bool TryEmplace(Ky&& key, Args&&... args) {
+		Segment& segment = SegmentOf(key);
+		TWriteGuard guard(segment.Lock);
+		return segment.Map.TryEmplace(Forward<Ky>(key), Forward<Args>(args)...);
+	}
+
+	// 키가 있으면 값을 바꾸고 없으면 넣는다. 넣었으면 true, 바꿨으면 false
+	template <typename Ky, typename Vy>
+	bool InsertOrAssign(Ky&& key, Vy&& value) {
+		Segment& segment = SegmentOf(key);
+		TWriteGuard guard(segment.Lock);
+		return segment.Map.InsertOrAssign(Forward<Ky>(key), Forward<Vy>(value));
+	}
+
+	// 키가 있으면 updater(TValue&)를 세그먼트 락을 잡은 채로 호출한다. 호출했으면 true
+	// updater 안에서 이 맵에 다시 접근하면 교착 상태에 빠진다.
+	template <typename TLookupKey, typename Updater>
+	bool Update(const TLookupKey& key, Updater&& updater) {
+		Segment& segment = SegmentOf(key);
+		TWriteGuard guard(segment.Lock);
+		TValue* pValue = segment.Map.Find(key);
+
+		if (pValue == nullptr) {
+			return false;
+		}
+
+		updater(*pValue);
+		return true;
+	}
+
+	template <typename TLookupKey>
+	bool Remove(const TLookupKey& key) {
+		Segment& segment = SegmentOf(key);
+		TWriteGuard guard(segment.Lock);
+		return segment.Map.Remove(key);
+	}
+
+	template <typename TLookupKey>
+	bool Exist(const TLookupKey& key) const {
+		Segment& segment = SegmentOf(key);
+		TReadGuard guard(segment.Lock);
+		return segment.Map.Exist(key);
+	}
+
+	// 키가 있으면 값을 value에 복사하고 true를 반환한다.
+	template <typename TLookupKey>
+	bool TryGet(const TLookupKey& key, TValue& value) const {
+		Segment& segment = SegmentOf(key);
+		TReadGuard guard(segment.Lock);
+		TValue* pValue = segment.Map.Find(key);
+
+		if (pValue == nullptr) {
+			return false;
+		}
+
+		value = *pValue;
+		return true;
+	}
+
+	// 세그먼트를 하나씩 잠그고 consumer(const Pair<TKey, TValue>&)를 호출한다.
+	// 다른 쓰레드의 삽입/삭제와 동시에 호출해도 안전하며 이미 지나간 세그먼트의 변경은 보이지 않는다.
+	// consumer 안에서 이 맵에 다시 접근하면 교착 상태에 빠진다.
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) const {
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TReadGuard guard(segment.Lock);
+			segment.Map.ForEach([&consumer](const TKeyValuePair& pair) { consumer(pair); });
+		}
+	}
+
+	int Size() const {
+		int iSize = 0;
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TReadGuard guard(segment.Lock);
+			iSize += segment.Map.Size();
+		}
+		return iSize;
+	}
+
+	bool IsEmpty() const {
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TReadGuard guard(segment.Lock);
+			if (segment.Map.Size() > 0) return false;
+		}
+		return true;
+	}
+
+	void Clear() {
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TWriteGuard guard(segment.Lock);
+			segment.Map.Clear();
+		}
+	}
+
+	// 전체 count개가 고르게 나뉜다고 보고 세그먼트마다 미리 키운다.
+	void Reserve(int count) {
+		const int iPerSegment = (count + m_iSegmentCount - 1) / m_iSegmentCount;
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TWriteGuard guard(segment.Lock);
+			segment.Map.Reserve(iPerSegment + iPerSegment / 8);
+		}
+	}
+
+	// 세그먼트마다 점진적 재해쉬를 켜거나 끈다. (HashMap::SetIncrementalRehash 참고)
+	void SetIncrementalRehash(bool enabled) {
+		for (int i = 0; i < m_iSegmentCount; ++i) {
+			Segment& segment = m_pSegments[i];
+			TWriteGuard guard(segment.Lock);
+			segment.Map.SetIncrementalRehash(enabled);
+		}
+	}
+
+	int SegmentCount() const { return m_iSegmentCount; }
+protected:
+	template <typename TLookupKey>
+	Segment& SegmentOf(const TLookupKey& key) const {
+		const Int32U uiHash = THasher()(key);
+		return m_pSegments[Int64U(uiHash) >> m_iSegmentShift];
+	}
+protected:
+	Segment* m_pSegments;
+	int m_iSegmentCount;
+	int m_iSegmentShift;		// 해쉬를 이만큼 밀면 세그먼트 인덱스가 된다. (세그먼트가 1개면 32)
+};
+
+NS_JC_END
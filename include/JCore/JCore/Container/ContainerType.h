@@ -21,5 +21,6 @@ enum class ContainerType {
 	TreeMap,
 	ReferenceStream,
 	HashMapKeyCollection,
-	HashMapValueCollection
+	HashMapValueCollection,
+	FlatHashMap
 };
\ No newline at end of file
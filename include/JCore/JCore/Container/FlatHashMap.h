@@ -0,0 +1,646 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 개방 주소법 해쉬맵 (스위스 테이블 방식)
+ * HashMap은 테이블 칸마다 따로 할당한 노드 배열을 들고 있어서 탐색할 때마다 테이블 -> 노드 배열 순서로 두번 포인터를 따라가고
+ * 데이터 수만큼 작은 할당이 생긴다. FlatHashMap은 데이터를 슬롯 배열에 바로 넣고 슬롯마다 1바이트 컨트롤 태그를 따로 둔다.
+ *
+ *  [컨트롤 Byte * 용량][Pair<TKey, TValue> * 용량]   <- 한번에 할당 (확장할 때만 새로 할당)
+ *
+ * 컨트롤 태그: 0x80 빈 슬롯, 0xFE 삭제된 슬롯, 0x00 ~ 0x7F 데이터가 든 슬롯 (해쉬 하위 7비트, H2)
+ * 해쉬 나머지 비트(H1)로 16슬롯 그룹을 고르고 그룹의 태그 16개를 SSE2로 한번에 H2와 비교한다. (SSE2가 없으면 스칼라로 비교)
+ * 태그가 같은 슬롯만 키를 비교하므로 키 비교는 거의 한번에 끝나고, 빈 슬롯이 있는 그룹을 만나면 더 볼 필요가 없다.
+ * 태그를 읽을 때 같은 그룹의 슬롯도 미리 가져오므로(JCORE_PREFETCH) 태그와 슬롯의 캐시 미스가 차례대로가 아니라 겹쳐서 일어난다.
+ * 그룹이 꽉 차 있으면 다음 그룹으로 넘어간다. (1, 2, 3... 그룹씩 건너뛰는 삼각수 탐사, 그룹 수가 2의 거듭제곱이면 모든 그룹을 한번씩 방문한다)
+ *
+ * 삭제는 슬롯이 속한 그룹에 빈 슬롯이 있으면 빈 슬롯으로, 없으면 삭제 표시로 바꾼다.
+ * 빈 슬롯이 있는 그룹은 어떤 탐색도 지나쳐가지 않으므로 바로 비워도 된다.
+ * 데이터 + 삭제 표시가 용량의 7/8에 도달하면 확장한다. (삭제 표시가 대부분이면 같은 크기로 다시 배치해서 정리만 한다)
+ *
+ * HashMap과 같은 MapCollection 인터페이스와 ForEach/ForEachKey/ForEachValue, GetMemoryUsage를 제공한다.
+ * 해쉬를 한번만 계산하는 TryEmplace/InsertOrAssign/FindOrInsert와 String 키의 이종 탐색도 HashMap과 같다.
+ * 확장하면 데이터가 다른 슬롯으로 옮겨지므로 Insert 이후에는 Find로 얻은 포인터와 반복자를 다시 얻어야한다.
+ */
+
+#pragma once
+
+#include <JCore/Bit.h>
+#include <JCore/Hasher.h>
+#include <JCore/Limit.h>
+#include <JCore/Math.h>
+#include <JCore/Memory.h>
+
+#include <JCore/Container/MapCollection.h>
+#include <JCore/Container/MemoryUsage.h>
+#include <JCore/Container/FlatHashMapIterator.h>
+
+#include <cstring>
+
+NS_JC_BEGIN
+
+// 컨트롤 태그 16개 묶음
+struct FlatHashGroup
+{
+	static constexpr int Width = 16;
+	static constexpr Byte Empty = 0x80;
+	static constexpr Byte Deleted = 0xFE;
+
+	explicit FlatHashGroup(const Byte* control) {
+	#if JCORE_SSE2
+		m_Control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+	#else
+		std::memcpy(m_Control, control, Width);
+	#endif
+	}
+
+	// 비트 i가 켜져 있으면 i번 슬롯의 태그가 h2
+	Int32U Match(Byte h2) const {
+	#if JCORE_SSE2
+		return Int32U(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Control, _mm_set1_epi8(char(h2)))));
+	#else
+		return MatchIf([h2](Byte control) { return control == h2; });
+	#endif
+	}
+
+	Int32U MatchEmpty() const {
+	#if JCORE_SSE2
+		return Int32U(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Control, _mm_set1_epi8(char(Empty)))));
+	#else
+		return MatchIf([](Byte control) { return control == Empty; });
+	#endif
+	}
+
+	// 빈 슬롯과 삭제된 슬롯만 최상위 비트가 켜져 있다.
+	Int32U MatchEmptyOrDeleted() const {
+	#if JCORE_SSE2
+		return Int32U(_mm_movemask_epi8(m_Control));
+	#else
+		return MatchIf([](Byte control) { return (control & 0x80) != 0; });
+	#endif
+	}
+
+	Int32U MatchFull() const {
+		return ~MatchEmptyOrDeleted() & 0xFFFF;
+	}
+
+	// 켜진 비트 중 가장 낮은 위치를 꺼내고 지운다.
+	static int PopLowest(Int32U& mask) {
+		const int iLowest = CountTrailingZero64(mask);
+		mask &= mask - 1;
+		return iLowest;
+	}
+private:
+#if JCORE_SSE2
+	__m128i m_Control;
+#else
+	template <typename Predicate>
+	Int32U MatchIf(Predicate&& predicate) const {
+		Int32U uiMask = 0;
+		for (int i = 0; i < Width; ++i) {
+			if (predicate(m_Control[i])) {
+				uiMask |= 1u << i;
+			}
+		}
+		return uiMask;
+	}
+
+	Byte m_Control[Width];
+#endif
+};
+
+template <typename TKey, typename TValue, typename TAllocator = DefaultAllocator>
+class FlatHashMap : public MapCollection<TKey, TValue, TAllocator>
+{
+public:
+	using THasher					= Hasher<TKey>;
+	using TMapCollection			= MapCollection<TKey, TValue, TAllocator>;
+	using TKeyValuePair				= Pair<TKey, TValue>;
+	using TIterator					= Iterator<TKeyValuePair, TAllocator>;
+	using TFlatHashMap				= FlatHashMap<TKey, TValue, TAllocator>;
+	using TFlatHashMapIterator		= FlatHashMapIterator<TKey, TValue, TAllocator>;
+
+	static_assert(alignof(TKeyValuePair) <= FlatHashGroup::Width, "... 슬롯 배열은 16바이트 정렬까지만 보장합니다.");
+public:
+	// capacity개를 넣어도 확장하지 않는 크기로 시작한다.
+	FlatHashMap(int capacity = ms_iTableDefaultCapacity)
+		: TMapCollection()
+		, m_pControl(nullptr)
+		, m_pSlots(nullptr)
+		, m_iCapacity(0)
+		, m_iDeletedCount(0)
+	{
+		Allocate(CalculateExpandCapacity(capacity));
+	}
+
+	FlatHashMap(const TFlatHashMap& other) : TFlatHashMap(other.m_iSize) {
+		operator=(other);
+	}
+
+	FlatHashMap(TFlatHashMap&& other) noexcept
+		: TMapCollection()
+		, m_pControl(nullptr)
+		, m_pSlots(nullptr)
+		, m_iCapacity(0)
+		, m_iDeletedCount(0)
+	{
+		operator=(Move(other));
+	}
+
+	FlatHashMap(std::initializer_list<TKeyValuePair> ilist) : TFlatHashMap(int(ilist.size())) {
+		operator=(ilist);
+	}
+
+	~FlatHashMap() noexcept override {
+		TFlatHashMap::Clear();
+		Deallocate();
+	}
+public:
+	TFlatHashMap& operator=(const TFlatHashMap& other) {
+		if (this == &other) {
+			return *this;
+		}
+
+		TFlatHashMap::Clear();
+		ExpandIfNeeded(other.m_iSize);
+
+		// 키가 겹치지 않으므로 찾지 않고 바로 빈 슬롯에 넣는다.
+		other.ForEachSlot([this](const TKeyValuePair& pair) {
+			const Int64U uiHash = Hash(pair.Key);
+			const int iSlot = FindInsertSlot(uiHash);
+			SetControl(iSlot, H2(uiHash));
+			Memory::PlacementNew(m_pSlots[iSlot], pair);
+		});
+
+		this->m_iSize = other.m_iSize;
+		return *this;
+	}
+
+	// 반복자가 이 맵을 가리키고 있으므로 소유자(m_Owner)는 옮기지 않는다.
+	TFlatHashMap& operator=(TFlatHashMap&& other) noexcept {
+		if (this == &other) {
+			return *this;
+		}
+
+		TFlatHashMap::Clear();
+		Deallocate();
+
+		m_pControl = other.m_pControl;
+		m_pSlots = other.m_pSlots;
+		m_iCapacity = other.m_iCapacity;
+		m_iDeletedCount = other.m_iDeletedCount;
+		this->m_iSize = other.m_iSize;
+
+		other.m_pControl = nullptr;
+		other.m_pSlots = nullptr;
+		other.m_iCapacity = 0;
+		other.m_iDeletedCount = 0;
+		other.m_iSize = 0;
+		return *this;
+	}
+
+	TFlatHashMap& operator=(std::initializer_list<TKeyValuePair> ilist) {
+		TFlatHashMap::Clear();
+		ExpandIfNeeded(int(ilist.size()));
+
+		for (auto it = ilist.begin(); it != ilist.end(); ++it) {
+			Insert(*it);
+		}
+
+		return *this;
+	}
+
+	TValue& operator[](const TKey& key) {
+		return Get(key);
+	}
+
+	template <typename Ky, typename Vy>
+	bool Insert(Ky&& key, Vy&& value) {
+		return TryEmplace(Forward<Ky>(key), Forward<Vy>(value));
+	}
+
+	bool Insert(const TKeyValuePair& pair) override {
+		bool bInserted;
+		const int iSlot = FindOrPrepareInsert(pair.Key, bInserted);
+
+		if (!bInserted) {
+			return false;
+		}
+
+		Memory::PlacementNew(m_pSlots[iSlot], pair);
+		return true;
+	}
+
+	bool Insert(TKeyValuePair&& pair) override {
+		bool bInserted;
+		const int iSlot = FindOrPrepareInsert(pair.Key, bInserted);
+
+		if (!bInserted) {
+			return false;
+		}
+
+		Memory::PlacementNew(m_pSlots[iSlot], Move(pair));
+		return true;
+	}
+
+	// 키가 없을 때만 args로 값을 생성해서 넣는다. 넣었으면 true
+	template <typename Ky, typename... Args>
+	bool TryEmplace(Ky&& key, Args&&... args) {
+		bool bInserted;
+		const int iSlot = FindOrPrepareInsert(key, bInserted);
+
+		if (!bInserted) {
+			return false;
+		}
+
+		Memory::PlacementNew(m_pSlots[iSlot], TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), TValue(Forward<Args>(args)...) });
+		return true;
+	}
+
+	// 키가 있으면 값을 바꾸고 없으면 넣는다. 넣었으면 true, 바꿨으면 false
+	template <typename Ky, typename Vy>
+	bool InsertOrAssign(Ky&& key, Vy&& value) {
+		bool bInserted;
+		const int iSlot = FindOrPrepareInsert(key, bInserted);
+
+		if (!bInserted) {
+			m_pSlots[iSlot].Value = Forward<Vy>(value);
+			return false;
+		}
+
+		Memory::PlacementNew(m_pSlots[iSlot], TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), static_cast<TValue>(Forward<Vy>(value)) });
+		return true;
+	}
+
+	// 키에 대응하는 값을 반환한다. 없으면 args로 값을 생성해서 넣은 후 반환한다.
+	template <typename Ky, typename... Args>
+	TValue& FindOrInsert(Ky&& key, Args&&... args) {
+		bool bInserted;
+		const int iSlot = FindOrPrepareInsert(key, bInserted);
+
+		if (bInserted) {
+			Memory::PlacementNew(m_pSlots[iSlot], TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), TValue(Forward<Args>(args)...) });
+		}
+
+		return m_pSlots[iSlot].Value;
+	}
+
+	bool Exist(const TKey& key) const override {
+		return FindSlot(key, Hash(key)) != -1;
+	}
+
+	virtual TValue* Find(const TKey& key) const {
+		return FindValue(key);
+	}
+
+	TValue& Get(const TKey& key) const override {
+		return GetValue(key);
+	}
+
+	bool Remove(const TKey& key) override {
+		return RemoveByKey(key);
+	}
+
+	// 이종 탐색: String 키 맵을 임시 String 없이 const char*, StaticString으로 찾는다. (IsHeterogeneousKey_v)
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	bool Exist(const TLookupKey& key) const {
+		return FindSlot(key, Hash(key)) != -1;
+	}
+
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	TValue* Find(const TLookupKey& key) const {
+		return FindValue(key);
+	}
+
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	TValue& Get(const TLookupKey& key) const {
+		return GetValue(key);
+	}
+
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	bool Remove(const TLookupKey& key) {
+		return RemoveByKey(key);
+	}
+
+	// 데이터만 지우고 슬롯 배열은 그대로 둔다.
+	void Clear() noexcept override {
+		if (m_pControl == nullptr) {
+			return;
+		}
+
+		if (this->m_iSize > 0) {
+			ForEachSlot([](TKeyValuePair& pair) { Memory::PlacementDelete(pair); });
+		}
+
+		std::memset(m_pControl, FlatHashGroup::Empty, m_iCapacity);
+		this->m_iSize = 0;
+		m_iDeletedCount = 0;
+	}
+
+	virtual bool Valid() const {
+		return m_pControl != nullptr;
+	}
+
+	int Capacity() const { return m_iCapacity; }
+	int DeletedCount() const { return m_iDeletedCount; }
+
+	// 컨트롤 배열은 TableBytes, 비어있거나 삭제된 슬롯과 할당자 여유분은 SlackBytes로 센다.
+	// 노드가 따로 없으므로 NodeBytes는 데이터가 든 슬롯 크기 합이다.
+	MemoryUsage GetMemoryUsage() const {
+		MemoryUsage usage;
+		usage.ElementCount = this->m_iSize;
+		usage.ElementBytes = Int64(sizeof(TKeyValuePair)) * this->m_iSize;
+		usage.NodeBytes = usage.ElementBytes;
+
+		if (m_pControl == nullptr) {
+			return usage;
+		}
+
+		const Int64 iAllocationBytes = AllocationSize(m_iCapacity);
+		usage.TableBytes = m_iCapacity;
+		usage.SlackBytes = Int64(sizeof(TKeyValuePair)) * (m_iCapacity - this->m_iSize);
+		usage.SlackBytes += TAllocator::AllocatedSize(int(iAllocationBytes)) - iAllocationBytes;
+		return usage;
+	}
+
+	// ==========================================
+	// 동적할당 안하고 해쉬맵 순회할 수 있도록 기능 구현
+	// ==========================================
+	template <typename Consumer>
+	void ForEach(Consumer&& consumer) {
+		ForEachSlot([&consumer](TKeyValuePair& pair) { consumer(pair); });
+	}
+
+	template <typename Consumer>
+	void ForEachKey(Consumer&& consumer) {
+		ForEachSlot([&consumer](TKeyValuePair& pair) { consumer(pair.Key); });
+	}
+
+	template <typename Consumer>
+	void ForEachValue(Consumer&& consumer) {
+		ForEachSlot([&consumer](TKeyValuePair& pair) { consumer(pair.Value); });
+	}
+
+	SharedPtr<TIterator> Begin() const override {
+		return MakeShared<TFlatHashMapIterator, TAllocator>(this->GetOwner(), this, NextFullSlot(0));
+	}
+
+	SharedPtr<TIterator> End() const override {
+		return MakeShared<TFlatHashMapIterator, TAllocator>(this->GetOwner(), this, PreviousFullSlot(m_iCapacity - 1));
+	}
+
+	ContainerType GetContainerType() override { return ContainerType::FlatHashMap; }
+
+	// size개를 넣어도 확장하지 않도록 미리 늘린다.
+	bool ExpandIfNeeded(int size) {
+		const int iCapacity = CalculateExpandCapacity(size);
+
+		if (iCapacity <= m_iCapacity) {
+			return false;
+		}
+
+		Rehash(iCapacity);
+		return true;
+	}
+protected:
+	// 용량 capacity에서 삭제 표시 포함 몇개까지 채울 수 있는지 (7/8)
+	static int GrowthLimit(int capacity) {
+		return capacity - capacity / 8;
+	}
+
+	static Int64 AllocationSize(int capacity) {
+		return Int64(capacity) * (1 + sizeof(TKeyValuePair));
+	}
+
+	/// <summary>
+	/// size개를 넣어도 확장하지 않는 용량 (그룹 크기 이상인 2의 거듭제곱)
+	/// </summary>
+	int CalculateExpandCapacity(int size) const {
+		int iExpectedCapacity = Math::Max(m_iCapacity, ms_iTableDefaultCapacity);
+
+		while (GrowthLimit(iExpectedCapacity) <= size) {
+			iExpectedCapacity *= 2;
+		}
+
+		return iExpectedCapacity;
+	}
+
+	void Allocate(int capacity) {
+		DebugAssertMsg(capacity % FlatHashGroup::Width == 0 && (capacity & (capacity - 1)) == 0, "용량은 그룹 크기 이상인 2의 거듭제곱이어야 합니다.");
+		DebugAssertMsg(AllocationSize(capacity) <= MaxInt32_v, "할당 크기가 너무 큽니다.");
+
+		int iAllocatedSize;
+		m_pControl = TAllocator::template Allocate<Byte*>(int(AllocationSize(capacity)), iAllocatedSize);
+		m_pSlots = reinterpret_cast<TKeyValuePair*>(m_pControl + capacity);
+		m_iCapacity = capacity;
+		m_iDeletedCount = 0;
+		std::memset(m_pControl, FlatHashGroup::Empty, capacity);
+	}
+
+	void Deallocate() {
+		if (m_pControl == nullptr) {
+			return;
+		}
+
+		TAllocator::Deallocate(m_pControl, int(AllocationSize(m_iCapacity)));
+		m_pControl = nullptr;
+		m_pSlots = nullptr;
+		m_iCapacity = 0;
+	}
+
+	// 모든 데이터를 capacity 크기의 새 슬롯 배열로 옮긴다. (삭제 표시는 사라진다)
+	void Rehash(int capacity) {
+		Byte* pPrevControl = m_pControl;
+		TKeyValuePair* pPrevSlots = m_pSlots;
+		const int iPrevCapacity = m_iCapacity;
+
+		Allocate(capacity);
+
+		for (int i = 0; i < iPrevCapacity; i++) {
+			if (pPrevControl[i] & 0x80) {
+				continue;
+			}
+
+			TKeyValuePair& prevSlot = pPrevSlots[i];
+			const Int64U uiHash = Hash(prevSlot.Key);
+			const int iSlot = FindInsertSlot(uiHash);
+			SetControl(iSlot, H2(uiHash));
+			Memory::PlacementNew(m_pSlots[iSlot], Move(prevSlot));
+			Memory::PlacementDelete(prevSlot);
+		}
+
+		TAllocator::Deallocate(pPrevControl, int(AllocationSize(iPrevCapacity)));
+	}
+
+	// 키가 든 슬롯을 반환한다. 없으면 컨트롤 태그를 채운 새 슬롯을 잡아서 반환하고 inserted를 true로 한다. (슬롯에 데이터를 생성하는건 호출한 쪽)
+	// 해쉬는 한번만 계산한다.
+	template <typename TLookupKey>
+	int FindOrPrepareInsert(const TLookupKey& key, JCORE_OUT bool& inserted) {
+		const Int64U uiHash = Hash(key);
+		const int iFound = FindSlot(key, uiHash);
+
+		if (iFound != -1) {
+			inserted = false;
+			return iFound;
+		}
+
+		if (this->m_iSize + m_iDeletedCount >= GrowthLimit(m_iCapacity)) {
+			// 절반 이상이 삭제 표시면 같은 크기로 정리만 한다.
+			Rehash(this->m_iSize * 2 < GrowthLimit(m_iCapacity) ? m_iCapacity : m_iCapacity * 2);
+		}
+
+		const int iSlot = FindInsertSlot(uiHash);
+
+		if (m_pControl[iSlot] == FlatHashGroup::Deleted) {
+			--m_iDeletedCount;
+		}
+
+		SetControl(iSlot, H2(uiHash));
+		++this->m_iSize;
+		inserted = true;
+		return iSlot;
+	}
+
+	template <typename TLookupKey>
+	TValue* FindValue(const TLookupKey& key) const {
+		const int iSlot = FindSlot(key, Hash(key));
+
+		if (iSlot == -1) {
+			return nullptr;
+		}
+
+		return AddressOf(m_pSlots[iSlot].Value);
+	}
+
+	template <typename TLookupKey>
+	TValue& GetValue(const TLookupKey& key) const {
+		const int iSlot = FindSlot(key, Hash(key));
+
+		if (iSlot == -1) {
+			throw InvalidArgumentException("해당 키값에 대응하는 값이 존재하지 않습니다.");
+		}
+
+		return m_pSlots[iSlot].Value;
+	}
+
+	template <typename TLookupKey>
+	bool RemoveByKey(const TLookupKey& key) {
+		const int iSlot = FindSlot(key, Hash(key));
+
+		if (iSlot == -1) {
+			return false;
+		}
+
+		Memory::PlacementDelete(m_pSlots[iSlot]);
+
+		// 그룹에 빈 슬롯이 있으면 이 그룹을 지나쳐간 탐색이 없으므로 바로 비운다.
+		const int iGroupStart = iSlot & ~(FlatHashGroup::Width - 1);
+		if (FlatHashGroup(m_pControl + iGroupStart).MatchEmpty() != 0) {
+			m_pControl[iSlot] = FlatHashGroup::Empty;
+		} else {
+			m_pControl[iSlot] = FlatHashGroup::Deleted;
+			++m_iDeletedCount;
+		}
+
+		--this->m_iSize;
+		return true;
+	}
+
+	template <typename TLookupKey>
+	int FindSlot(const TLookupKey& key, Int64U hash) const {
+		const Byte uiH2 = H2(hash);
+		const int iGroupMask = m_iCapacity / FlatHashGroup::Width - 1;
+		int iGroup = H1(hash) & iGroupMask;
+
+		for (int iStep = 1; ; ++iStep) {
+			const int iGroupStart = iGroup * FlatHashGroup::Width;
+			JCORE_PREFETCH(m_pSlots + iGroupStart);
+			const FlatHashGroup group(m_pControl + iGroupStart);
+
+			for (Int32U uiMatch = group.Match(uiH2); uiMatch != 0;) {
+				const int iSlot = iGroupStart + FlatHashGroup::PopLowest(uiMatch);
+				if (m_pSlots[iSlot].Key == key) {
+					return iSlot;
+				}
+			}
+
+			// 삭제/확장 규칙상 빈 슬롯이 남은 그룹 너머로 밀려난 키는 없다.
+			if (group.MatchEmpty() != 0 || iStep > iGroupMask) {
+				return -1;
+			}
+
+			iGroup = (iGroup + iStep) & iGroupMask;
+		}
+	}
+
+	// 탐사 순서상 첫번째 빈 슬롯 또는 삭제된 슬롯 (확장 규칙상 항상 있다)
+	int FindInsertSlot(Int64U hash) const {
+		const int iGroupMask = m_iCapacity / FlatHashGroup::Width - 1;
+		int iGroup = H1(hash) & iGroupMask;
+
+		for (int iStep = 1; ; ++iStep) {
+			const int iGroupStart = iGroup * FlatHashGroup::Width;
+			Int32U uiMatch = FlatHashGroup(m_pControl + iGroupStart).MatchEmptyOrDeleted();
+
+			if (uiMatch != 0) {
+				return iGroupStart + FlatHashGroup::PopLowest(uiMatch);
+			}
+
+			iGroup = (iGroup + iStep) & iGroupMask;
+		}
+	}
+
+	void SetControl(int slot, Byte h2) {
+		m_pControl[slot] = h2;
+	}
+
+	// Hasher 결과는 하위 비트가 키의 하위 비트에만 의존하므로 한번 더 섞어서 그룹 번호와 태그로 나눠 쓴다.
+	template <typename TLookupKey>
+	static Int64U Hash(const TLookupKey& key) {
+		const Int64U uiHash = Int64U(THasher()(key)) * 0x9E3779B97F4A7C15ULL;
+		return uiHash ^ (uiHash >> 32);
+	}
+
+	static int H1(Int64U hash) { return int(hash >> 7); }
+	static Byte H2(Int64U hash) { return Byte(hash & 0x7F); }
+
+	template <typename Consumer>
+	void ForEachSlot(Consumer&& consumer) const {
+		for (int iGroupStart = 0; iGroupStart < m_iCapacity; iGroupStart += FlatHashGroup::Width) {
+			for (Int32U uiMatch = FlatHashGroup(m_pControl + iGroupStart).MatchFull(); uiMatch != 0;) {
+				consumer(m_pSlots[iGroupStart + FlatHashGroup::PopLowest(uiMatch)]);
+			}
+		}
+	}
+
+	// from부터 앞으로 데이터가 든 첫 슬롯, 없으면 용량
+	int NextFullSlot(int from) const {
+		for (int i = from; i < m_iCapacity; i++) {
+			if ((m_pControl[i] & 0x80) == 0) return i;
+		}
+		return m_iCapacity;
+	}
+
+	// from부터 뒤로 데이터가 든 첫 슬롯, 없으면 -1
+	int PreviousFullSlot(int from) const {
+		for (int i = from; i >= 0; i--) {
+			if ((m_pControl[i] & 0x80) == 0) return i;
+		}
+		return -1;
+	}
+
+	TKeyValuePair& SlotAt(int slot) const {
+		DebugAssert(slot >= 0 && slot < m_iCapacity && (m_pControl[slot] & 0x80) == 0);
+		return m_pSlots[slot];
+	}
+
+	static constexpr int ms_iTableDefaultCapacity = 16;	// 테이블 초기 크기 (그룹 1개)
+protected:
+	Byte* m_pControl;			// 슬롯마다 1바이트 태그, 슬롯 배열과 한번에 할당한 메모리의 시작
+	TKeyValuePair* m_pSlots;
+	int m_iCapacity;
+	int m_iDeletedCount;
+
+	friend TFlatHashMapIterator;
+}; // class FlatHashMap<TKey, TValue>
+
+NS_JC_END
@@ -0,0 +1,72 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * FlatHashMap 반복자
+ * 슬롯 배열을 앞에서부터 훑으면서 데이터가 든 슬롯만 돌려준다.
+ */
+
+#pragma once
+
+#include <JCore/Container/MapCollectionIterator.h>
+
+NS_JC_BEGIN
+
+// 전방 선언
+class VoidOwner;
+template <typename, typename, typename> class FlatHashMap;
+template <typename, typename> struct Pair;
+
+template <typename TKey, typename TValue, typename TAllocator>
+class FlatHashMapIterator : public MapCollectionIterator<TKey, TValue, TAllocator>
+{
+	using TFlatHashMap			 = FlatHashMap<TKey, TValue, TAllocator>;
+	using TKeyValuePair			 = Pair<TKey, TValue>;
+	using TMapCollectionIterator = MapCollectionIterator<TKey, TValue, TAllocator>;
+public:
+	// slot은 데이터가 든 슬롯이거나 범위 밖(-1 또는 용량)이어야 한다.
+	FlatHashMapIterator(VoidOwner& owner, const TFlatHashMap* map, int slot)
+		: TMapCollectionIterator(owner)
+		, m_pMap(map)
+		, m_iSlot(slot)
+	{}
+
+	~FlatHashMapIterator() noexcept override = default;
+public:
+	bool HasNext() const override {
+		return this->IsValid() && m_iSlot >= 0 && m_iSlot < m_pMap->Capacity();
+	}
+
+	bool HasPrevious() const override {
+		return this->IsValid() && m_iSlot >= 0 && m_iSlot < m_pMap->Capacity();
+	}
+
+	TKeyValuePair& Next() override {
+		TKeyValuePair& val = m_pMap->SlotAt(m_iSlot);
+		m_iSlot = m_pMap->NextFullSlot(m_iSlot + 1);
+		return val;
+	}
+
+	TKeyValuePair& Previous() override {
+		TKeyValuePair& val = m_pMap->SlotAt(m_iSlot);
+		m_iSlot = m_pMap->PreviousFullSlot(m_iSlot - 1);
+		return val;
+	}
+
+	TKeyValuePair& Current() override {
+		return m_pMap->SlotAt(m_iSlot);
+	}
+
+	bool IsEnd() const override {
+		return HasNext() == false;
+	}
+
+	bool IsBegin() const override {
+		return HasPrevious() == false;
+	}
+protected:
+	const TFlatHashMap* m_pMap;
+	int m_iSlot;
+	friend TFlatHashMap;
+};
+
+NS_JC_END
@@ -8,6 +8,7 @@
 #include <JCore/Memory.h>
 
 #include <JCore/Container/MapCollection.h>
+#include <JCore/Container/MemoryUsage.h>
 #include <JCore/Container/LinkedList.h>
 #include <JCore/Container/HashMapIterator.h>
 
@@ -16,7 +17,7 @@ NS_JC_BEGIN
 template <typename TKey, typename TValue>
 struct BucketNode
 {
-	using TKeyValuePair	 = Pair<TKey, TValue>;
+	using TKeyValuePair	 = JCore::Pair<TKey, TValue>;
 	using TBucketNode	 = BucketNode<TKey, TValue>;
 
 	bool operator==(const TBucketNode& other) {
@@ -192,31 +193,46 @@ struct Bucket
 		Size = 0;
 	}
 
-	bool ExistByKey(const TKey& key) {
-		for (int i = 0; i < Size; i++) {
-			if (DynamicArray[i].Pair.Key == key) {
-				return true;
-			}
+	// Clear 후 노드 배열까지 반납한다. (다시 넣으면 처음처럼 1칸부터 시작)
+	void Release() {
+		Clear();
+		JCORE_ALLOCATOR_DYNAMIC_DEALLOCATE_SAFE(DynamicArray, sizeof(TBucketNode) * Capacity);
+		Capacity = 1;
+	}
+
+	// TLookupKey는 TKey 또는 TKey와 바로 비교할 수 있는 타입 (IsHeterogeneousKey_v)
+	template <typename TLookupKey>
+	bool ExistByKey(const TLookupKey& key) {
+		return FindNodeByKey(key) != nullptr;
+	}
+
+	template <typename TLookupKey>
+	TValue* FindByKey(const TLookupKey& key) {
+		TBucketNode* pNode = FindNodeByKey(key);
+
+		if (pNode == nullptr) {
+			return nullptr;
 		}
 
-		return false;
+		return AddressOf(pNode->Pair.Value);
 	}
 
-	TValue* FindByKey(const TKey& key) {
+	template <typename TLookupKey>
+	TBucketNode* FindNodeByKey(const TLookupKey& key) {
 		for (int i = 0; i < Size; i++) {
 			if (DynamicArray[i].Pair.Key == key) {
-				return AddressOf(DynamicArray[i].Pair.Value);
+				return DynamicArray + i;
 			}
 		}
 
 		return nullptr;
 	}
 
-	bool RemoveByKey(const TKey& key) {
+	template <typename TLookupKey>
+	bool RemoveByKey(const TLookupKey& key) {
 		int iFind = -1;
 		for (int i = 0; i < Size; i++) {
 			if (DynamicArray[i].Pair.Key == key) {
-				Memory::PlacementDelete(DynamicArray[i]);
 				iFind = i;
 				break;
 			}
@@ -226,11 +242,12 @@ struct Bucket
 			return false;
 		}
 
+		// 소멸시킨 노드에 이동 대입하면 String 키의 버퍼를 두번 해제하므로 앞으로 당긴 후 마지막 노드를 소멸시킨다.
 		for (int i = iFind; i < Size - 1; i++) {
 			DynamicArray[i] = Move(DynamicArray[i + 1]);
 		}
 
-		--Size;
+		Memory::PlacementDelete(DynamicArray[--Size]);
 		return true;
 	}
 
@@ -301,6 +318,13 @@ public:
 		, m_pHeadBucket(nullptr)
 		, m_pTailBucket(nullptr)
 		, m_iCapacity(capacity)
+		, m_pOldTable(nullptr)
+		, m_iOldCapacity(0)
+		, m_iRehashIndex(0)
+		, m_pNextTable(nullptr)
+		, m_iNextCapacity(0)
+		, m_iNextConstructed(0)
+		, m_bIncrementalRehash(false)
 	{
 		int iAllocatedSize;
 		m_pTable = TAllocator::template Allocate<TBucket*>(sizeof(TBucket) * capacity, iAllocatedSize);
@@ -315,6 +339,14 @@ public:
 		: m_pTable(nullptr)
 		, m_pHeadBucket(nullptr)
 		, m_pTailBucket(nullptr)
+		, m_iCapacity(0)
+		, m_pOldTable(nullptr)
+		, m_iOldCapacity(0)
+		, m_iRehashIndex(0)
+		, m_pNextTable(nullptr)
+		, m_iNextCapacity(0)
+		, m_iNextConstructed(0)
+		, m_bIncrementalRehash(false)
 	{
 		operator=(Move(other));
 	}
@@ -326,9 +358,7 @@ public:
 
 	~HashMap() noexcept override {
 		THashMap::Clear();
-
-		JCORE_PLACEMENT_DELETE_ARRAY_SAFE(m_pTable, m_iCapacity);
-		JCORE_ALLOCATOR_DYNAMIC_DEALLOCATE_SAFE(m_pTable, m_iCapacity * sizeof(TBucket));
+		DeleteTables();
 	}
 public:
 
@@ -336,13 +366,20 @@ public:
 	THashMap& operator=(const THashMap& other) {
 		THashMap::Clear();
 		ExpandIfNeeded(other.m_iSize);
+		m_bIncrementalRehash = other.m_bIncrementalRehash;
 
+		// 재해쉬 중인 맵이어도 이전/새 테이블의 버킷이 모두 목록에 연결되어 있다.
 		TBucket* pOtherBucketCur = other.m_pHeadBucket;
 		while (pOtherBucketCur != nullptr) {
 			for (int i = 0; i < pOtherBucketCur->Size; i++) {
 				TBucketNode& node = pOtherBucketCur->GetAt(i);
-				Int32U uiBucket = BucketIndex(node.Hash);
-				m_pTable[uiBucket].PushBack(node);
+				TBucket& bucket = m_pTable[BucketIndex(node.Hash)];
+
+				if (bucket.IsEmpty()) {
+					PushBackNewBucket(&bucket);
+				}
+
+				bucket.PushBack(node);
 			}
 			pOtherBucketCur = pOtherBucketCur->Next;
 		}
@@ -353,18 +390,27 @@ public:
 
 	THashMap& operator=(THashMap&& other) noexcept {
 		Clear();
-		JCORE_ALLOCATOR_DYNAMIC_DEALLOCATE_SAFE(m_pTable, sizeof(TBucket) * m_iCapacity);
+		DeleteTables();
 
 		this->m_Owner = Move(other.m_Owner);
 		this->m_iSize = other.m_iSize;
 		this->m_iCapacity = other.m_iCapacity;
 		this->m_pTable = other.m_pTable;
 		this->m_pHeadBucket = other.m_pHeadBucket;
-		this->m_pTailBucket = other.m_pTailBucket;;
+		this->m_pTailBucket = other.m_pTailBucket;
+		this->m_pOldTable = other.m_pOldTable;
+		this->m_iOldCapacity = other.m_iOldCapacity;
+		this->m_iRehashIndex = other.m_iRehashIndex;
+		this->m_pNextTable = other.m_pNextTable;
+		this->m_iNextCapacity = other.m_iNextCapacity;
+		this->m_iNextConstructed = other.m_iNextConstructed;
+		this->m_bIncrementalRehash = other.m_bIncrementalRehash;
 
 		other.m_pTable = nullptr;
 		other.m_pHeadBucket = nullptr;
 		other.m_pTailBucket = nullptr;
+		other.m_pOldTable = nullptr;
+		other.m_pNextTable = nullptr;
 		other.m_iSize = 0;
 
 		return *this;
@@ -388,106 +434,131 @@ public:
 
 	template <typename Ky, typename Vy>
 	bool Insert(Ky&& key, Vy&& value) {
-		if (IsFull()) {
-			Expand(m_iCapacity * ms_iTableExpandingFactor);
-		}
+		return TryEmplace(Forward<Ky>(key), Forward<Vy>(value));
+	}
 
-		if (Exist(key)) {
+	bool Insert(const TKeyValuePair& pair) override {
+		const Int32U uiHash = Hash(pair.Key);
+
+		if (FindNode(pair.Key, uiHash) != nullptr) {
 			return false;
 		}
 
-		Int32U uiHash = Hash(key);
-		Int32U uiBucket = BucketIndex(uiHash);
+		EmplaceNode(uiHash, pair);
+		return true;
+	}
+
+	bool Insert(TKeyValuePair&& pair) override {
+		const Int32U uiHash = Hash(pair.Key);
 
-		if (m_pTable[uiBucket].IsEmpty()) {
-			PushBackNewBucket(&m_pTable[uiBucket]);
+		if (FindNode(pair.Key, uiHash) != nullptr) {
+			return false;
 		}
 
-		m_pTable[uiBucket].EmplaceBack(TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), static_cast<TValue>(Forward<Vy>(value))}, uiHash);
-		++this->m_iSize;
+		EmplaceNode(uiHash, Move(pair));
 		return true;
 	}
 
-	bool Insert(const TKeyValuePair& pair) override {
-		if (IsFull()) {
-			Expand(m_iCapacity * ms_iTableExpandingFactor);
-		}
+	// ==========================================
+	// 키를 한번만 해쉬하는 삽입 기능
+	// Exist로 확인하고 Insert하면 해쉬 계산과 버킷 탐색을 두번씩 하게 되므로 아래 함수를 쓰자.
+	// String 키 맵에 const char*를 넘기면 실제로 삽입할 때만 String을 만든다.
+	// ==========================================
+
+	// 키가 없을 때만 args로 값을 생성해서 넣는다. 넣었으면 true
+	template <typename Ky, typename... Args>
+	bool TryEmplace(Ky&& key, Args&&... args) {
+		const Int32U uiHash = Hash(key);
 
-		if (Exist(pair.Key)) {
+		if (FindNode(key, uiHash) != nullptr) {
 			return false;
 		}
 
-		Int32U uiHash = Hash(pair.Key);
-		Int32U uiBucket = BucketIndex(uiHash);
-
-		if (m_pTable[uiBucket].IsEmpty()) {
-			PushBackNewBucket(&m_pTable[uiBucket]);
-		} 
-
-		m_pTable[uiBucket].EmplaceBack(pair, uiHash);
-		++this->m_iSize;
+		EmplaceNode(uiHash, TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), TValue(Forward<Args>(args)...) });
 		return true;
 	}
 
-	bool Insert(TKeyValuePair&& pair) override {
-		if (IsFull()) {
-			Expand(m_iCapacity * ms_iTableExpandingFactor);
-		}
+	// 키가 있으면 값을 바꾸고 없으면 넣는다. 넣었으면 true, 바꿨으면 false
+	template <typename Ky, typename Vy>
+	bool InsertOrAssign(Ky&& key, Vy&& value) {
+		const Int32U uiHash = Hash(key);
+		TBucketNode* pNode = FindNode(key, uiHash);
 
-		if (Exist(pair.Key)) {
+		if (pNode != nullptr) {
+			pNode->Pair.Value = Forward<Vy>(value);
 			return false;
 		}
 
-		Int32U uiHash = Hash(pair.Key);
-		Int32U uiBucket = BucketIndex(uiHash);
+		EmplaceNode(uiHash, TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), static_cast<TValue>(Forward<Vy>(value)) });
+		return true;
+	}
+
+	// 키에 대응하는 값을 반환한다. 없으면 args로 값을 생성해서 넣은 후 반환한다.
+	// 다음 삽입으로 버킷이 확장/이동되면 반환된 참조는 더 이상 유효하지 않다.
+	template <typename Ky, typename... Args>
+	TValue& FindOrInsert(Ky&& key, Args&&... args) {
+		const Int32U uiHash = Hash(key);
+		TBucketNode* pNode = FindNode(key, uiHash);
 
-		if (m_pTable[uiBucket].IsEmpty()) {
-			PushBackNewBucket(&m_pTable[uiBucket]);
+		if (pNode != nullptr) {
+			return pNode->Pair.Value;
 		}
 
-		m_pTable[uiBucket].EmplaceBack(Move(pair), uiHash);
-		++this->m_iSize;
-		return true;
+		return EmplaceNode(uiHash, TKeyValuePair{ static_cast<TKey>(Forward<Ky>(key)), TValue(Forward<Args>(args)...) }).Pair.Value;
 	}
 
 	bool Exist(const TKey& key) const override {
-		return m_pTable[HashBucket(key)].ExistByKey(key);
+		return FindNode(key, Hash(key)) != nullptr;
 	}
 
 	virtual TValue* Find(const TKey& key) const {
-		TValue* pVal = m_pTable[HashBucket(key)].FindByKey(key);
-
-		if (pVal == nullptr) {
-			return nullptr;
-		}
-
-		return pVal;
+		TBucketNode* pNode = FindNode(key, Hash(key));
+		return pNode ? AddressOf(pNode->Pair.Value) : nullptr;
 	}
 
 	TValue& Get(const TKey& key) const override {
-		TValue* pVal = m_pTable[HashBucket(key)].FindByKey(key);
+		TBucketNode* pNode = FindNode(key, Hash(key));
 
-		if (pVal == nullptr) {
+		if (pNode == nullptr) {
 			throw InvalidArgumentException("해당 키값에 대응하는 값이 존재하지 않습니다.");
 		}
 
-		return *pVal;
+		return pNode->Pair.Value;
 	}
 
 	bool Remove(const TKey& key) override {
-		TBucket& bucket = m_pTable[HashBucket(key)];
+		return RemoveByKey(key);
+	}
 
-		if (!bucket.RemoveByKey(key)) {
-			return false;
-		}
+	// ==========================================
+	// 이종 탐색: String 키 맵을 임시 String 없이 const char*, StaticString으로 찾는다. (IsHeterogeneousKey_v)
+	// 해쉬값이 같게 나오도록 Hasher<String>이 같은 바이트열로 계산한다.
+	// ==========================================
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	bool Exist(const TLookupKey& key) const {
+		return FindNode(key, Hash(key)) != nullptr;
+	}
 
-		// 버킷이 비었으면 연결을 끊어준다.
-		if (bucket.IsEmpty()) {
-			RemoveBucket(&bucket);
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	TValue* Find(const TLookupKey& key) const {
+		TBucketNode* pNode = FindNode(key, Hash(key));
+		return pNode ? AddressOf(pNode->Pair.Value) : nullptr;
+	}
+
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	TValue& Get(const TLookupKey& key) const {
+		TBucketNode* pNode = FindNode(key, Hash(key));
+
+		if (pNode == nullptr) {
+			throw InvalidArgumentException("해당 키값에 대응하는 값이 존재하지 않습니다.");
 		}
-	
-		--this->m_iSize;
-		return true;
+
+		return pNode->Pair.Value;
+	}
+
+	template <typename TLookupKey, DefaultEnableIf_t<IsHeterogeneousKey_v<TKey, TLookupKey>> = nullptr>
+	bool Remove(const TLookupKey& key) {
+		return RemoveByKey(key);
 	}
 
 	void RemoveBucket(TBucket* bucket) {
@@ -505,27 +576,47 @@ public:
 	}
 
 	void Clear() noexcept override {
-		if (this->m_iSize == 0) {
-			return;
-		}
+		if (this->m_iSize != 0) {
+			TBucket* pCur = m_pHeadBucket;
+			while (pCur != nullptr) {
+				pCur->Clear();
+				pCur = pCur->Next;
+			}
 
-		TBucket* pCur = m_pHeadBucket;
-		while (pCur != nullptr) {
-			TBucket* pTemp = pCur;
-			pCur->Clear();
-			pCur = pCur->Next;
-		}
+			this->m_iSize = 0;
 
-		this->m_iSize = 0;
+			m_pHeadBucket = nullptr;
+			m_pTailBucket = nullptr;
+		}
 
-		m_pHeadBucket = nullptr;
-		m_pTailBucket = nullptr;
+		// 옮기던 이전 테이블은 다 비었으므로 더 옮길 필요가 없다. (준비 중인 테이블은 계속 준비한다)
+		DeleteTable(m_pOldTable, m_iOldCapacity, m_iOldCapacity);
+		m_iRehashIndex = 0;
 	}
 
 	virtual bool Valid() const {
 		return m_pTable != nullptr;
 	}
 
+	// 버킷 배열(테이블)은 TableBytes, 버킷마다 잡힌 노드 배열의 남는 용량과 할당자 여유분은 SlackBytes로 센다.
+	// 비워진 버킷도 노드 배열을 계속 들고있으므로 Clear/Remove 후에는 SlackBytes가 남는다.
+	MemoryUsage GetMemoryUsage() const {
+		MemoryUsage usage;
+		usage.ElementCount = this->m_iSize;
+		usage.ElementBytes = Int64(sizeof(TKeyValuePair)) * this->m_iSize;
+		usage.NodeBytes = Int64(sizeof(TBucketNode)) * this->m_iSize;
+
+		if (m_pTable == nullptr) {
+			return usage;
+		}
+
+		// 재해쉬 중이면 이전 테이블과 준비 중인 테이블도 센다.
+		AddTableUsage(usage, m_pTable, m_iCapacity, m_iCapacity);
+		AddTableUsage(usage, m_pOldTable, m_iOldCapacity, m_iOldCapacity);
+		AddTableUsage(usage, m_pNextTable, m_iNextConstructed, m_iNextCapacity);
+		return usage;
+	}
+
 	int BucketCount() {
 		int iCount = 0;
 		for (int i = 0; i < m_iCapacity; i++) {
@@ -534,9 +625,17 @@ public:
 			}
 			++iCount;
 		}
+
+		for (Int32U i = m_pOldTable ? m_iRehashIndex : 0; i < m_iOldCapacity; i++) {
+			iCount += !m_pOldTable[i].IsEmpty();
+		}
 		return iCount;
 	}
 
+	int Capacity() const {
+		return m_iCapacity;
+	}
+
 
 	// ==========================================
 	// 동적할당 안하고 해쉬맵 순회할 수 있도록 기능 구현
@@ -621,6 +720,7 @@ public:
 	}
 
 	void Expand(int capacity) {
+		FinishRehash();
 		DebugAssertMsg(capacity > m_iCapacity, "이전 해쉬맵 크기보다 커야합니다.");
 
 		int iAllocatedSize;
@@ -668,7 +768,194 @@ public:
 		Expand(iCapacity);
 		return true;
 	}
+
+	// count개를 넣을 때까지 확장하지 않도록 테이블을 딱 count 크기로 미리 키운다. (이미 충분하면 아무것도 안함)
+	void Reserve(int count) {
+		FinishRehash();
+
+		if (count > int(m_iCapacity)) {
+			Expand(count);
+		}
+	}
+
+	// ==========================================
+	// 점진적 재해쉬
+	// 기본 동작은 꽉 찼을 때 Expand로 모든 데이터를 한번에 옮기므로 데이터가 많으면 그 삽입 한번이 매우 오래 걸린다.
+	// 점진적 재해쉬를 켜면 확장을 두 단계로 나눠서 삽입/삭제할 때마다 조금씩 진행한다.
+	//  1. 준비: 새 테이블을 할당만 해두고 버킷을 조금씩 생성한다. 이 동안은 기존 테이블에 계속 넣으므로 잠깐 용량을 넘는다.
+	//  2. 이동: 새 테이블로 교체하고 이전 테이블의 버킷을 조금씩 옮긴다. 탐색은 새 테이블에 없으면 아직 안 옮긴 이전 버킷도 본다.
+	// 삽입/삭제가 뜸하면 진행이 안되므로 RehashStep을 직접(예: 한가한 프레임마다) 호출하거나 FinishRehash로 한번에 끝낼 수 있다.
+	// ==========================================
+	void SetIncrementalRehash(bool enabled) {
+		if (!enabled) {
+			FinishRehash();
+		}
+
+		m_bIncrementalRehash = enabled;
+	}
+
+	bool IsIncrementalRehash() const {
+		return m_bIncrementalRehash;
+	}
+
+	bool IsRehashing() const {
+		return m_pNextTable != nullptr || m_pOldTable != nullptr;
+	}
+
+	// 이전 테이블의 데이터가 든 버킷을 최대 bucketCount개 옮긴다. (준비 단계면 bucketCount * ms_iRehashConstructFactor개의 버킷을 생성)
+	// 재해쉬가 아직 남았으면 true
+	bool RehashStep(int bucketCount = ms_iRehashMigrateStep) {
+		if (m_pNextTable != nullptr) {
+			ConstructNextTable(Int64(bucketCount) * ms_iRehashConstructFactor);
+			return true;
+		}
+
+		if (m_pOldTable == nullptr) {
+			return false;
+		}
+
+		MigrateOldBuckets(bucketCount);
+		return m_pOldTable != nullptr;
+	}
+
+	void FinishRehash() {
+		while (m_pNextTable != nullptr) {
+			ConstructNextTable(m_iNextCapacity);
+		}
+
+		while (m_pOldTable != nullptr) {
+			MigrateOldBuckets(int(m_iOldCapacity));
+		}
+	}
 protected:
+	// 점진적 재해쉬 준비 단계 시작 (새 테이블은 할당만 한다)
+	void BeginRehash(Int32U capacity) {
+		FinishRehash();
+
+		int iAllocatedSize;
+		m_pNextTable = TAllocator::template Allocate<TBucket*>(sizeof(TBucket) * capacity, iAllocatedSize);
+		m_iNextCapacity = capacity;
+		m_iNextConstructed = 0;
+		RehashStep();
+	}
+
+	void ConstructNextTable(Int64 bucketCount) {
+		const Int64 iRemain = m_iNextCapacity - m_iNextConstructed;
+		const int iCount = int(bucketCount < iRemain ? bucketCount : iRemain);
+		Memory::PlacementNewArray(m_pNextTable + m_iNextConstructed, iCount);
+		m_iNextConstructed += iCount;
+
+		if (m_iNextConstructed < m_iNextCapacity) {
+			return;
+		}
+
+		// 다 만들었으면 교체하고 이동 단계로 넘어간다. (버킷 목록은 그대로 두고 옮길 때 하나씩 뺀다)
+		DebugAssertMsg(m_pOldTable == nullptr, "이전 테이블을 다 옮기기 전에 교체할 수 없습니다.");
+		m_pOldTable = m_pTable;
+		m_iOldCapacity = m_iCapacity;
+		m_iRehashIndex = 0;
+		m_pTable = m_pNextTable;
+		m_iCapacity = m_iNextCapacity;
+		m_pNextTable = nullptr;
+		m_iNextCapacity = 0;
+		m_iNextConstructed = 0;
+	}
+
+	// 빈 버킷은 bucketCount * ms_iRehashEmptyVisitFactor개까지만 지나간다. (빈 버킷이 길게 이어져도 한번에 오래 걸리지 않도록)
+	void MigrateOldBuckets(int bucketCount) {
+		Int64 iEmptyVisitCount = Int64(bucketCount) * ms_iRehashEmptyVisitFactor;
+
+		while (bucketCount > 0 && m_iRehashIndex < m_iOldCapacity) {
+			TBucket& oldBucket = m_pOldTable[m_iRehashIndex++];
+
+			if (oldBucket.IsEmpty()) {
+				if (--iEmptyVisitCount <= 0) break;
+				continue;
+			}
+
+			RemoveBucket(&oldBucket);
+
+			for (int i = 0; i < oldBucket.Size; i++) {
+				TBucketNode& bucketNode = oldBucket.GetAt(i);
+				TBucket& newBucket = m_pTable[BucketIndex(bucketNode.Hash)];
+
+				if (newBucket.IsEmpty()) {
+					PushBackNewBucket(&newBucket);
+				}
+
+				newBucket.PushBack(Move(bucketNode));
+			}
+
+			oldBucket.Release();
+			--bucketCount;
+		}
+
+		if (m_iRehashIndex == m_iOldCapacity) {
+			DeleteTable(m_pOldTable, m_iOldCapacity, m_iOldCapacity);
+			m_iOldCapacity = 0;
+			m_iRehashIndex = 0;
+		}
+	}
+
+	// 꽉 찼을 때 확장 (점진적 재해쉬면 준비 단계만 시작한다)
+	void Grow() {
+		if (!m_bIncrementalRehash) {
+			Expand(m_iCapacity * ms_iTableExpandingFactor);
+			return;
+		}
+
+		if (m_pNextTable == nullptr) {
+			BeginRehash(m_iCapacity * ms_iTableExpandingFactor);
+		}
+	}
+
+	// 아직 안 옮긴 이전 테이블 버킷 (재해쉬 중이 아니거나 이미 옮겼으면 nullptr)
+	TBucket* FindOldBucket(const Int32U hash) const {
+		if (m_pOldTable == nullptr) {
+			return nullptr;
+		}
+
+		const Int32U uiIndex = hash % m_iOldCapacity;
+		return uiIndex >= m_iRehashIndex ? m_pOldTable + uiIndex : nullptr;
+	}
+
+	// constructedCount개의 버킷만 생성된 테이블을 해제한다.
+	static void DeleteTable(TBucket*& table, Int32U constructedCount, Int32U capacity) {
+		JCORE_PLACEMENT_DELETE_ARRAY_SAFE(table, constructedCount);
+		JCORE_ALLOCATOR_DYNAMIC_DEALLOCATE_SAFE(table, sizeof(TBucket) * capacity);
+	}
+
+	void DeleteTables() {
+		DeleteTable(m_pTable, m_iCapacity, m_iCapacity);
+		DeleteTable(m_pOldTable, m_iOldCapacity, m_iOldCapacity);
+		DeleteTable(m_pNextTable, m_iNextConstructed, m_iNextCapacity);
+		m_iOldCapacity = 0;
+		m_iRehashIndex = 0;
+		m_iNextCapacity = 0;
+		m_iNextConstructed = 0;
+	}
+
+	static void AddTableUsage(MemoryUsage& usage, const TBucket* table, Int32U constructedCount, Int32U capacity) {
+		if (table == nullptr) {
+			return;
+		}
+
+		const Int64 iTableBytes = Int64(sizeof(TBucket)) * capacity;
+		usage.TableBytes += iTableBytes;
+		usage.SlackBytes += TAllocator::AllocatedSize(int(iTableBytes)) - iTableBytes;
+
+		for (Int32U i = 0; i < constructedCount; i++) {
+			const TBucket& bucket = table[i];
+
+			if (bucket.DynamicArray == nullptr) {
+				continue;
+			}
+
+			const Int64 iArrayBytes = Int64(sizeof(TBucketNode)) * bucket.Capacity;
+			usage.SlackBytes += Int64(sizeof(TBucketNode)) * (bucket.Capacity - bucket.Size);
+			usage.SlackBytes += TAllocator::AllocatedSize(int(iArrayBytes)) - iArrayBytes;
+		}
+	}
 
 
 
@@ -701,6 +988,10 @@ protected:
 	/// bucket 바로 전에 다른 bucket을 삽입한다.
 	/// </summary>
 	void PushBackNewBucket(TBucket* bucket) {
+		// 비워지면서 목록에서 빠졌던 버킷은 이전 연결이 남아있으므로 끊고 시작한다. (남겨두면 목록이 순환할 수 있다)
+		bucket->Next = nullptr;
+		bucket->Previous = nullptr;
+
 		if (m_pHeadBucket == nullptr) {
 			m_pHeadBucket = bucket;
 			m_pTailBucket = bucket;
@@ -728,25 +1019,101 @@ protected:
 		return hash % m_iCapacity;
 	}
 
-	Int32U Hash(const TKey& key) const {
+	template <typename TLookupKey>
+	Int32U Hash(const TLookupKey& key) const {
 		return THasher()(key);
 	}
 
-	Int32U HashBucket(const TKey& key) const {
+	template <typename TLookupKey>
+	Int32U HashBucket(const TLookupKey& key) const {
 		return BucketIndex(Hash(key));
 	}
 
+	// 미리 계산한 해쉬로 키가 든 노드를 찾는다. 없으면 nullptr
+	// 재해쉬 중이면 아직 안 옮긴 이전 버킷도 찾는다.
+	template <typename TLookupKey>
+	TBucketNode* FindNode(const TLookupKey& key, const Int32U hash) const {
+		TBucketNode* pNode = m_pTable[BucketIndex(hash)].FindNodeByKey(key);
+
+		if (pNode == nullptr && m_pOldTable != nullptr) {
+			TBucket* pOldBucket = FindOldBucket(hash);
+			if (pOldBucket) pNode = pOldBucket->FindNodeByKey(key);
+		}
+
+		return pNode;
+	}
+
+	// 키가 없는걸 확인한 후 호출한다. 확장이 필요하면 확장하고 미리 계산한 해쉬로 버킷을 다시 고른다.
+	template <typename... Args>
+	TBucketNode& EmplaceNode(const Int32U hash, Args&&... pair) {
+		if (IsRehashing()) {
+			RehashStep();
+		}
+
+		if (IsFull()) {
+			Grow();
+		}
+
+		TBucket& bucket = m_pTable[BucketIndex(hash)];
+
+		if (bucket.IsEmpty()) {
+			PushBackNewBucket(&bucket);
+		}
+
+		bucket.EmplaceBack(Forward<Args>(pair)..., hash);
+		++this->m_iSize;
+		return bucket.GetAt(bucket.Size - 1);
+	}
+
+	template <typename TLookupKey>
+	bool RemoveByKey(const TLookupKey& key) {
+		const Int32U uiHash = Hash(key);
+		TBucket* pBucket = m_pTable + BucketIndex(uiHash);
+
+		if (!pBucket->RemoveByKey(key)) {
+			pBucket = FindOldBucket(uiHash);
+
+			if (pBucket == nullptr || !pBucket->RemoveByKey(key)) {
+				return false;
+			}
+		}
+
+		// 버킷이 비었으면 연결을 끊어준다.
+		if (pBucket->IsEmpty()) {
+			RemoveBucket(pBucket);
+		}
+
+		--this->m_iSize;
+
+		if (IsRehashing()) {
+			RehashStep();
+		}
+
+		return true;
+	}
+
+	// 점진적 재해쉬의 준비 단계에서는 기존 테이블에 계속 넣으므로 용량을 넘을 수 있다.
 	bool IsFull() const {
-		return this->m_iSize == m_iCapacity;
+		return Int32U(this->m_iSize) >= m_iCapacity;
 	}
 	
 	static constexpr Int32U	ms_iTableExpandingFactor = 4;	// 테이블 크기만큼 데이터가 들어가면 확장하는데 몇배나 확장할 지
 	static constexpr Int32U	ms_iTableDefaultCapacity = 16;	// 테이블 초기 크기
+	static constexpr int	ms_iRehashMigrateStep = 4;		// 점진적 재해쉬: 연산마다 옮길 (데이터가 든) 이전 버킷 수
+	static constexpr int	ms_iRehashConstructFactor = 64;	// 점진적 재해쉬: 준비 단계에서 옮길 버킷 1개 대신 생성할 새 버킷 수
+	static constexpr int	ms_iRehashEmptyVisitFactor = 10;	// 점진적 재해쉬: 옮길 버킷 1개 대신 지나갈 수 있는 빈 버킷 수
 protected:
 	TBucket* m_pTable;
 	TBucket* m_pHeadBucket;
 	TBucket* m_pTailBucket;
 	Int32U m_iCapacity;
+	TBucket* m_pOldTable;			// 점진적 재해쉬 이동 단계: 아직 다 옮기지 못한 이전 테이블
+	Int32U m_iOldCapacity;
+	Int32U m_iRehashIndex;			// m_pOldTable에서 다음에 옮길 버킷 위치 (앞쪽은 이미 옮김)
+	TBucket* m_pNextTable;			// 점진적 재해쉬 준비 단계: 버킷을 생성 중인 다음 테이블
+	Int32U m_iNextCapacity;
+	Int32U m_iNextConstructed;		// m_pNextTable에서 생성을 마친 버킷 수
+	bool m_bIncrementalRehash;
 public:
 	struct HashMapKeyCollection : public TKeyCollection
 	{
@@ -860,7 +1227,7 @@ public:
 	};
 
 
-	friend class THashMapIterator;
+	friend THashMapIterator;
 
 }; // class HashMap<TKey, TValue>
 
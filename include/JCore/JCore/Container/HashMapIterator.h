@@ -110,7 +110,7 @@ protected:
 	int m_iCurrentBucketIndex;
 	TBucket* m_pCurrentBucket;
 	THashMap* m_pMap;
-	friend class THashMap;
+	friend THashMap;
 };
 
 NS_JC_END
\ No newline at end of file
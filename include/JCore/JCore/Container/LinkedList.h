@@ -130,7 +130,7 @@ public:
 
 	ContainerType GetContainerType() override { return ContainerType::LinkedList; }
 protected:
-	friend class TLinkedListIterator;
+	friend TLinkedListIterator;
 	template <typename, typename, typename> friend class HashMapIterator;
 };
 
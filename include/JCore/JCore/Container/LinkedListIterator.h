@@ -52,7 +52,7 @@ public:
 		return TListCollectionIterator::IsBegin();
 	}
 
-	friend class TLinkedList;
+	friend TLinkedList;
 };
 
 NS_JC_END
\ No newline at end of file
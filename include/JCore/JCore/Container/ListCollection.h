@@ -506,7 +506,7 @@ protected:
 	TListNode* m_pHead;
 	TListNode* m_pTail;
 
-	friend class TListCollectionIterator;
+	friend TListCollectionIterator;
 };
 
 
@@ -23,7 +23,7 @@ public:
 	ListCollectionIterator(VoidOwner& owner, TListNode* current) : TIterator(owner) {
 		m_pCurrent = current;
 
-		TListCollection* pList = owner.Get<TListCollection*>();
+		TListCollection* pList = owner.template Get<TListCollection*>();
 		m_pHead = pList->m_pHead;
 		m_pTail = pList->m_pTail;
 	}
@@ -82,14 +82,14 @@ public:
 protected:
 	TListCollection* CastListCollection() const {
 		this->ThrowIfIteratorIsNotValid();
-		return this->Watcher.Get<TListCollection>();
+		return this->Watcher.template Get<TListCollection>();
 	}
 protected:
 	TListNode* m_pCurrent;
 	TListNode* m_pHead;
 	TListNode* m_pTail;
 
-	friend class TListCollection;
+	friend TListCollection;
 };
 
 
@@ -81,7 +81,7 @@ public:
 
 	ContainerType GetContainerType() override { return ContainerType::ListQueue; }
 protected:
-	friend class TListQueueIterator;
+	friend TListQueueIterator;
 };
 
 NS_JC_END
\ No newline at end of file
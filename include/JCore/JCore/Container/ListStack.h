@@ -81,7 +81,7 @@ public:
 
 	ContainerType GetContainerType() override { return ContainerType::ListStack; }
 protected:
-	friend class TListStackIterator;
+	friend TListStackIterator;
 };
 
 NS_JC_END
\ No newline at end of file
@@ -0,0 +1,43 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 컨테이너 메모리 사용량
+ * 컨테이너마다 GetMemoryUsage()로 몇 바이트를 쓰는지 돌려준다.
+ * 컨테이너 객체 자체의 크기(sizeof)는 포함하지 않는다. (객체를 가진 쪽에서 센다)
+ * 프로세스 전체 사용량은 MemoryUsageRegistry.h 참고
+ */
+
+#pragma once
+
+#include <JCore/Type.h>
+#include <JCore/Namespace.h>
+
+NS_JC_BEGIN
+
+struct MemoryUsage
+{
+	Int64 ElementCount{};	// 원소 수
+	Int64 ElementBytes{};	// 원소 자체 크기 합 (sizeof(원소) * 원소 수)
+	Int64 NodeBytes{};		// 원소를 담고있는 노드/슬롯 크기 합 (링크, 해시값, 균형 정보 포함)
+	Int64 TableBytes{};		// 원소 수와 상관없이 잡혀있는 구조 (해시맵의 버킷 배열 등)
+	Int64 SlackBytes{};		// 잡혀있지만 쓰지 않는 용량 + 할당자가 요청보다 더 크게 준 크기
+
+	Int64 TotalBytes() const { return NodeBytes + TableBytes + SlackBytes; }
+	Int64 OverheadBytes() const { return TotalBytes() - ElementBytes; }
+
+	// 원소 1개당 원소 자체 크기 외에 추가로 드는 바이트
+	double OverheadPerElement() const {
+		return ElementCount == 0 ? double(OverheadBytes()) : double(OverheadBytes()) / double(ElementCount);
+	}
+
+	MemoryUsage& operator+=(const MemoryUsage& other) {
+		ElementCount += other.ElementCount;
+		ElementBytes += other.ElementBytes;
+		NodeBytes += other.NodeBytes;
+		TableBytes += other.TableBytes;
+		SlackBytes += other.SlackBytes;
+		return *this;
+	}
+};
+
+NS_JC_END
@@ -0,0 +1,95 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 프로세스 전체 메모리 사용량 등록소
+ * 등록된 컨테이너들의 GetMemoryUsage()를 호출해서 이름별/전체 사용량을 모은다. (용량 계획, 릭 추적용)
+ * 등록된 컨테이너는 소멸되기 전에 반드시 해제해야하므로 MemoryUsageRegistration을 멤버로 두는 것을 권장한다.
+ */
+
+#pragma once
+
+#include <JCore/Container/MemoryUsage.h>
+#include <JCore/Container/HashMap.h>
+#include <JCore/Sync/NormalLock.h>
+
+NS_JC_BEGIN
+
+class MemoryUsageRegistry
+{
+	using TReporter = MemoryUsage(*)(const void*);
+
+	struct Entry
+	{
+		const char* Name;
+		const void* Container;
+		TReporter Reporter;
+	};
+public:
+	// 반환된 핸들로 Unregister 해야한다. name은 등록이 해제될 때까지 유효해야한다.
+	template <typename TContainer>
+	static int Register(const char* name, const TContainer* container) {
+		State& state = GetState();
+		NormalLock::TGuard guard(state.Lock);
+		const int iHandle = ++state.LastHandle;
+		state.Entries.Insert(iHandle, Entry{ name, container, [](const void* c) { return static_cast<const TContainer*>(c)->GetMemoryUsage(); } });
+		return iHandle;
+	}
+
+	static bool Unregister(int handle) {
+		State& state = GetState();
+		NormalLock::TGuard guard(state.Lock);
+		return state.Entries.Remove(handle);
+	}
+
+	// consumer(const char* name, const MemoryUsage& usage)
+	template <typename Consumer>
+	static void ForEach(Consumer&& consumer) {
+		State& state = GetState();
+		NormalLock::TGuard guard(state.Lock);
+		state.Entries.ForEachValue([&consumer](const Entry& entry) {
+			consumer(entry.Name, entry.Reporter(entry.Container));
+		});
+	}
+
+	static MemoryUsage Total() {
+		MemoryUsage total;
+		ForEach([&total](const char*, const MemoryUsage& usage) { total += usage; });
+		return total;
+	}
+
+	static int Count() {
+		State& state = GetState();
+		NormalLock::TGuard guard(state.Lock);
+		return state.Entries.Size();
+	}
+private:
+	struct State
+	{
+		NormalLock Lock;
+		HashMap<int, Entry> Entries;
+		int LastHandle = 0;
+	};
+
+	// 전역 컨테이너가 정적 초기화중에 등록할 수 있으므로 처음 사용할 때 생성한다.
+	static State& GetState() {
+		static State s_State;
+		return s_State;
+	}
+};
+
+// 생성될 때 등록하고 소멸될 때 해제한다.
+class MemoryUsageRegistration
+{
+public:
+	template <typename TContainer>
+	MemoryUsageRegistration(const char* name, const TContainer* container)
+		: m_iHandle(MemoryUsageRegistry::Register(name, container)) {}
+	~MemoryUsageRegistration() { MemoryUsageRegistry::Unregister(m_iHandle); }
+
+	MemoryUsageRegistration(const MemoryUsageRegistration&) = delete;
+	MemoryUsageRegistration& operator=(const MemoryUsageRegistration&) = delete;
+private:
+	int m_iHandle;
+};
+
+NS_JC_END
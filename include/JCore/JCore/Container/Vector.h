@@ -422,7 +422,7 @@ public:
 	Iterator end() { return Iterator(End()); }
 
 protected:
-	friend class TVectorIterator;
+	friend TVectorIterator;
 };
 
 NS_JC_END
\ No newline at end of file
@@ -16,8 +16,12 @@
 #include <iostream>
 #include <thread>
 
+#include <JCore/Platform.h>
+
+#if JCORE_PLATFORM_WINDOWS
 #include <Windows.h>
 #include <winnt.h>
+#endif
 #include <exception>
 #include <random>
 
@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include <JCore/Platform.h>
+
+#if JCORE_PLATFORM_WINDOWS
 #include <crtdbg.h>
+#endif
 
 #include <JCore/Type.h>
 #include <JCore/TypeCast.h>
@@ -20,6 +24,7 @@
 NS_JC_BEGIN
 
 
+#if JCORE_PLATFORM_WINDOWS
 // CrtMemBlockHeader
 struct MemHeader
 {
@@ -37,6 +42,7 @@ struct MemHeader
 	// unsigned char    _data[_data_size];
 	// unsigned char    _another_gap[no_mans_land_size];
 };
+#endif
 
 
 
@@ -49,7 +55,12 @@ public:
     bool Detecting() { return m_bDetecting; }
     int StopDetect();
 protected:
+#if JCORE_PLATFORM_WINDOWS
     _CrtMemState m_State{};
+#else
+    // CRT 디버그 힙이 없는 환경에서는 탐지 시작시점의 할당 바이트 수만 기록한다.
+    Int64U m_State{};
+#endif
     bool m_bDetecting{};
 };
 
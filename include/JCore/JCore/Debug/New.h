@@ -18,7 +18,8 @@
  *     -> 시도해봤는데 너무 느림. 모든 동적할당시마다 stacktrace를 얻는거 자체가 말도안된다.
  */
 
-#if DebugMode
+// CRT 디버그 힙(_NORMAL_BLOCK)은 윈도우에서만 쓸 수 있다.
+#if DebugMode && JCORE_PLATFORM_WINDOWS
 	#define dbg_new new (_NORMAL_BLOCK, JCORE_FILENAME, __LINE__)
 	#define dbg_operator_new(size) operator new((size), _NORMAL_BLOCK, JCORE_FILENAME, __LINE__)
 #else
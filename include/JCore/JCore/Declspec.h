@@ -14,6 +14,14 @@
 
  // novtable이란?
  // @내가 쓴 글 : https://blog.naver.com/wjdeh313/222733324896
-#define JCORE_NOVTABLE	__declspec(novtable)
-#define JCORE_EXPORT    __declspec(dllexport)
-#define JCORE_IMPORT    __declspec(dllimport)
\ No newline at end of file
+#include <JCore/Platform.h>
+
+#if JCORE_COMPILER_MSVC
+	#define JCORE_NOVTABLE	__declspec(novtable)
+	#define JCORE_EXPORT    __declspec(dllexport)
+	#define JCORE_IMPORT    __declspec(dllimport)
+#else
+	#define JCORE_NOVTABLE
+	#define JCORE_EXPORT    __attribute__((visibility("default")))
+	#define JCORE_IMPORT
+#endif
\ No newline at end of file
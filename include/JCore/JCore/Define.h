@@ -2,6 +2,8 @@
 
     #define __JCORE_DEFINE_H__
 
+	#include <JCore/Platform.h>
+
 	// https://stackoverflow.com/questions/8487986/file-macro-shows-full-path
 	#define JCORE_FILENAME (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
 	#define JCORE_PASS do { int JCORE_CONCAT_COUNTER(__pass__); } while(0)
@@ -38,9 +40,15 @@
 	 */
 
 
+#if JCORE_COMPILER_MSVC
     #define JCORE_STDCALL        __stdcall
     #define JCORE_CDECL          __cdecl
     #define JCORE_FORCEINLINE    __forceinline
+#else
+    #define JCORE_STDCALL
+    #define JCORE_CDECL
+    #define JCORE_FORCEINLINE    inline __attribute__((always_inline))
+#endif
     #define JCORE_INFINITE       0xffffffff
 
     #define JCORE_MAKE_NULL(x	)		\
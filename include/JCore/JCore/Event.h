@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <typeinfo>
 #include <JCore/Functional.h>
 #include <JCore/Container/LinkedList.h>
 
@@ -33,7 +34,7 @@ private:
 			this->Action(Forward<Args>(args)...);
 		}
 
-		const type_info& TargetType() {
+		const std::type_info& TargetType() {
 			return this->Action.target_type();
 		}
 	};
@@ -52,7 +53,7 @@ public:
 		});
 	}
 
-	bool UnregisterByType(const type_info& fnType) {
+	bool UnregisterByType(const std::type_info& fnType) {
 		return m_MethodChain.RemoveIf([&fnType](Callback& call) {
 			return fnType == call.TargetType();
 		});
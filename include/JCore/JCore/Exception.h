@@ -8,15 +8,30 @@
 #pragma once
 
 #include <exception>
-#include <stacktrace>
+#include <JCore/Platform.h>
 #include <JCore/Primitives/String.h>
 
+#if JCORE_COMPILER_MSVC
+#include <stacktrace>
+#endif
+
 NS_JC_BEGIN
 
+#if JCORE_COMPILER_MSVC
 struct Exception : public std::exception
 {
 	Exception(const char* msg) : std::exception(msg) {}
 };
+#else
+// std::exception(const char*) 생성자는 MSVC 확장이므로 메시지를 직접 보관한다.
+struct Exception : public std::exception
+{
+	Exception(const char* msg) : m_Message(msg ? msg : "") {}
+	const char* what() const noexcept override { return m_Message.c_str(); }
+private:
+	std::string m_Message;
+};
+#endif
 
 struct NullPointerException : Exception
 {
@@ -0,0 +1,59 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 파일 교체의 내구성 보장
+ * 임시 파일을 다 쓰고 fsync한 후 대상 파일 위로 이름을 바꾸는 방식으로 파일을 교체할 때 쓴다.
+ * 교체 도중에 죽어도 대상 경로에는 이전 파일이나 새 파일 중 하나가 온전히 남는다.
+ *
+ * 윈도우: MoveFileEx(MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)로 한번에 교체한다.
+ *         (File::Move는 대상이 있으면 실패하므로 지우고 옮겨야 하는데 그 사이에 죽으면 둘 다 잃는다)
+ * 그 외: rename으로 교체한 후 디렉토리를 fsync해야 이름 바뀐 사실이 디스크에 남는다.
+ *
+ * 미리 빌드된 JCore.lib에 없는 기능이라 MappedFile.h처럼 헤더에 플랫폼별로 구현한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+
+#if JCORE_PLATFORM_POSIX
+	#include <cstdio>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+NS_JC_BEGIN
+
+class DurableFile
+{
+public:
+	// 이미 fsync를 마친 srcPath로 dstPath를 원자적으로 교체하고 교체 사실이 디스크에 기록될 때까지 기다린다.
+	static bool Replace(const String& srcPath, const String& dstPath) {
+	#if JCORE_PLATFORM_WINDOWS
+		return MoveFileExA(srcPath.Source(), dstPath.Source(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+	#else
+		return rename(srcPath.Source(), dstPath.Source()) == 0 && SyncDirectory(dstPath);
+	#endif
+	}
+
+	// path가 들어있는 디렉토리의 항목 변경(생성, 이름 변경)을 디스크에 기록한다.
+	// 윈도우는 파일 시스템이 메타데이터 변경을 저널링하므로 할 일이 없다.
+	static bool SyncDirectory([[maybe_unused]] const String& path) {
+	#if JCORE_PLATFORM_WINDOWS
+		return true;
+	#else
+		const int iSeparator = path.FindReverse("/");
+		const String directory = iSeparator < 0 ? String(".") : iSeparator == 0 ? String("/") : path.GetRange(0, iSeparator - 1);
+		const int iFd = open(directory.Source(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (iFd == -1) {
+			return false;
+		}
+
+		const bool bSynced = fsync(iFd) == 0;
+		close(iFd);
+		return bSynced;
+	#endif
+	}
+};
+
+NS_JC_END
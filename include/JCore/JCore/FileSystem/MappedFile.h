@@ -0,0 +1,237 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 메모리 맵 파일
+ * 파일을 프로세스 주소 공간에 그대로 매핑해서 포인터로 읽고 쓴다.
+ * 읽기 전용으로 매핑하면 같은 파일을 연 모든 프로세스가 페이지 캐시의 한 사본을 공유한다. (RSS도 공유됨)
+ * 실제로 접근한 페이지만 디스크에서 읽으므로 큰 파일도 여는 비용은 거의 없다.
+ *
+ * FileStream과 달리 크기/위치가 Int64라서 2GB를 넘는 파일도 다룰 수 있다.
+ * 미리 빌드된 JCore.lib에 없는 기능이라 헤더에 플랫폼별로 모두 구현한다. (윈도우: CreateFileMapping, 그 외: mmap)
+ * 열기/매핑에 실패하면 FileStream과 같이 RuntimeException을 던진다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Exception.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/FileSystem/FileAccess.h>
+
+#if JCORE_PLATFORM_POSIX
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+NS_JC_BEGIN
+
+// 접근 방식 힌트 (운영체제가 미리 읽기 양을 정하는데 사용한다)
+enum class MappedFileAdvice
+{
+	Normal,
+	Random,			// 탐색 위주 (미리 읽기를 줄인다)
+	Sequential,		// 처음부터 끝까지 순회
+	WillNeed		// 곧 전부 읽을 예정이므로 미리 페이지 캐시에 올려둔다.
+};
+
+class MappedFile
+{
+public:
+	// 이미 있는 파일을 매핑한다. (eRead: 읽기 전용, eWrite/eReadWrite: 수정하면 파일에 반영)
+	MappedFile(const String& path, FileAccess access = eRead)
+		: m_pData(nullptr)
+		, m_iSize(0)
+		, m_bWritable(access != eRead)
+	{
+		OpenHandle(path, false);
+		m_iSize = QueryFileSize(path);
+		Map(path);
+	}
+
+	// size 크기의 파일을 새로 만들어서 읽기/쓰기로 매핑한다. (이미 있으면 덮어쓴다)
+	MappedFile(const String& path, Int64 size)
+		: m_pData(nullptr)
+		, m_iSize(size)
+		, m_bWritable(true)
+	{
+		OpenHandle(path, true);
+		ResizeFile(path, size);
+		Map(path);
+	}
+
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	Byte* Data() { return m_pData; }
+	const Byte* Data() const { return m_pData; }
+	Int64 Size() const { return m_iSize; }
+	bool IsWritable() const { return m_bWritable; }
+	bool IsClosed() const { return m_pData == nullptr && m_hFile == InvalidHandle(); }
+
+	// 수정한 내용을 디스크에 기록할 때까지 기다린다.
+	// msync는 매핑된 페이지만 기록하므로 새로 만든 파일의 크기 같은 메타데이터는 fsync로 따로 기록한다.
+	bool Flush() {
+		if (m_pData == nullptr || !m_bWritable) {
+			return true;
+		}
+
+	#if JCORE_PLATFORM_WINDOWS
+		return FlushViewOfFile(m_pData, 0) && FlushFileBuffers(m_hFile);
+	#else
+		return msync(m_pData, Size_t(m_iSize), MS_SYNC) == 0 && fsync(ToFileDescriptor(m_hFile)) == 0;
+	#endif
+	}
+
+	void Advise(MappedFileAdvice advice) {
+		if (m_pData == nullptr) {
+			return;
+		}
+
+	#if JCORE_PLATFORM_WINDOWS
+		// 윈도우는 WillNeed만 대응하는 기능이 있다.
+		if (advice == MappedFileAdvice::WillNeed) {
+			WIN32_MEMORY_RANGE_ENTRY range{ m_pData, Size_t(m_iSize) };
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+	#else
+		int iAdvice = MADV_NORMAL;
+		switch (advice) {
+		case MappedFileAdvice::Normal:		iAdvice = MADV_NORMAL; break;
+		case MappedFileAdvice::Random:		iAdvice = MADV_RANDOM; break;
+		case MappedFileAdvice::Sequential:	iAdvice = MADV_SEQUENTIAL; break;
+		case MappedFileAdvice::WillNeed:	iAdvice = MADV_WILLNEED; break;
+		}
+		madvise(m_pData, Size_t(m_iSize), iAdvice);
+	#endif
+	}
+
+	void Close() {
+	#if JCORE_PLATFORM_WINDOWS
+		if (m_pData) UnmapViewOfFile(m_pData);
+		if (m_hMapping) CloseHandle(m_hMapping);
+		if (m_hFile != InvalidHandle()) CloseHandle(m_hFile);
+		m_hMapping = nullptr;
+	#else
+		if (m_pData) munmap(m_pData, Size_t(m_iSize));
+		if (m_hFile != InvalidHandle()) close(ToFileDescriptor(m_hFile));
+	#endif
+		m_pData = nullptr;
+		m_hFile = InvalidHandle();
+	}
+private:
+#if JCORE_PLATFORM_WINDOWS
+	static IoHandle InvalidHandle() { return INVALID_HANDLE_VALUE; }
+
+	void OpenHandle(const String& path, bool create) {
+		m_hFile = CreateFileA(path.Source(),
+			m_bWritable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_DELETE,	// 열어둔 동안에도 다른 프로세스가 이름을 바꿔 교체할 수 있게 한다.
+			nullptr,
+			create ? CREATE_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr);
+
+		if (m_hFile == InvalidHandle()) {
+			Fail(path, "파일을 열지 못했습니다.", Int64(GetLastError()));
+		}
+	}
+
+	Int64 QueryFileSize(const String& path) {
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_hFile, &size)) {
+			Fail(path, "파일 크기를 얻지 못했습니다.", Int64(GetLastError()));
+		}
+		return Int64(size.QuadPart);
+	}
+
+	void ResizeFile(const String& path, Int64 size) {
+		LARGE_INTEGER position;
+		position.QuadPart = size;
+		if (!SetFilePointerEx(m_hFile, position, nullptr, FILE_BEGIN) || !SetEndOfFile(m_hFile)) {
+			Fail(path, "파일 크기를 바꾸지 못했습니다.", Int64(GetLastError()));
+		}
+	}
+
+	void Map(const String& path) {
+		m_hMapping = nullptr;
+
+		// 크기가 0인 파일은 매핑할 수 없으므로 빈 상태로 둔다.
+		if (m_iSize == 0) {
+			return;
+		}
+
+		m_hMapping = CreateFileMappingA(m_hFile, nullptr, m_bWritable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+		if (m_hMapping == nullptr) {
+			Fail(path, "파일 매핑을 만들지 못했습니다.", Int64(GetLastError()));
+		}
+
+		m_pData = static_cast<Byte*>(MapViewOfFile(m_hMapping, m_bWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+		if (m_pData == nullptr) {
+			Fail(path, "파일을 매핑하지 못했습니다.", Int64(GetLastError()));
+		}
+	}
+#else
+	static IoHandle InvalidHandle() { return reinterpret_cast<IoHandle>(IntPtr(-1)); }
+	static int ToFileDescriptor(IoHandle handle) { return int(IntPtr(handle)); }
+
+	void OpenHandle(const String& path, bool create) {
+		int iFlags = m_bWritable ? O_RDWR : O_RDONLY;
+		if (create) iFlags |= O_CREAT | O_TRUNC;
+
+		const int iFd = open(path.Source(), iFlags | O_CLOEXEC, 0644);
+		m_hFile = reinterpret_cast<IoHandle>(IntPtr(iFd));
+
+		if (iFd == -1) {
+			Fail(path, "파일을 열지 못했습니다.", errno);
+		}
+	}
+
+	Int64 QueryFileSize(const String& path) {
+		struct stat info;
+		if (fstat(ToFileDescriptor(m_hFile), &info) != 0) {
+			Fail(path, "파일 크기를 얻지 못했습니다.", errno);
+		}
+		return Int64(info.st_size);
+	}
+
+	void ResizeFile(const String& path, Int64 size) {
+		if (ftruncate(ToFileDescriptor(m_hFile), off_t(size)) != 0) {
+			Fail(path, "파일 크기를 바꾸지 못했습니다.", errno);
+		}
+	}
+
+	void Map(const String& path) {
+		if (m_iSize == 0) {
+			return;
+		}
+
+		void* pData = mmap(nullptr, Size_t(m_iSize), m_bWritable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, ToFileDescriptor(m_hFile), 0);
+		if (pData == MAP_FAILED) {
+			Fail(path, "파일을 매핑하지 못했습니다.", errno);
+		}
+
+		m_pData = static_cast<Byte*>(pData);
+	}
+#endif
+
+	// 생성자에서 던지면 소멸자가 호출되지 않으므로 열어둔 핸들을 먼저 닫는다.
+	[[noreturn]] void Fail(const String& path, const char* reason, Int64 error) {
+		Close();
+		throw RuntimeException(StringUtil::Format("%s %s (오류: %lld)", path.Source(), reason, error));
+	}
+
+	Byte* m_pData;
+	Int64 m_iSize;
+	bool m_bWritable;
+	IoHandle m_hFile = InvalidHandle();
+#if JCORE_PLATFORM_WINDOWS
+	IoHandle m_hMapping = nullptr;
+#endif
+};
+
+NS_JC_END
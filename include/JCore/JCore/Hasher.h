@@ -1,31 +1,266 @@
 ﻿/*
 	작성자 : 윤정도
 	해쉬 생성기
+
+	정수: 곱셈-xorshift 믹서(Detail::Mix64)를 쓴다. 나머지 연산이 없고 순차 키(0, 1, 2..)도 모든 비트가 고르게 바뀐다.
+	바이트열: HashBytes64 (64비트 결과)
+	 - 16바이트 이하: 앞/뒤를 겹쳐 읽은 두 워드를 128비트 곱으로 섞는다.
+	 - 128바이트 이하: 16바이트씩 128비트 곱으로 섞는다. (48바이트 이상은 독립된 3줄로 나눠서)
+	 - 그 이상: 64바이트 묶음(스트라이프)을 8개의 64비트 누산기에 누적한다.
+	   SSE2가 있으면 누산기 2개를 레지스터 하나로 한번에 계산하고, 없으면 같은 계산을 스칼라로 한다. (결과는 같다)
+	   스트라이프마다 다른 키를 쓰고 8개(512바이트)마다 누산기를 휘저어서 묶음 순서가 바뀌면 결과도 바뀐다.
+
+	Hasher의 결과는 32비트이므로 HashBytes64의 하위 32비트를 쓴다.
 */
 
 #pragma once
 
 #include <JCore/Type.h>
+#include <JCore/Platform.h>
 #include <JCore/Primitives/String.h>
 #include <JCore/TypeTraits.h>
 
+#include <cstring>
+
 #pragma warning (push)
 #pragma warning (disable : 4244)  // 'argument': conversion from 'double' to 'float', possible loss of data, double을 강제로 float으로 바꿀라캐서 Hasher<double>  땜에
 
 NS_JC_BEGIN
-	
-constexpr Int32U PrimeInt32U_v = 0x087b840FU;			// 1억 부근 암거나 - 142,312,463
-constexpr Int64U PrimeInt64U_v = 0x0000050B00000002ULL;	// 5조 부근 암거나 - 5,544,802,779,138
-constexpr Int64U HashXorKey_v = 0x3e4dc77d;				// Xor 키값 암거나 - 1,045,284,733
+
+	NS_DETAIL_BEGIN
+	// splitmix64의 마무리 함수 (곱셈 2번 + xorshift 3번으로 입력 1비트가 바뀌면 출력의 절반 정도가 바뀐다)
+	constexpr Int64U Mix64(Int64U val) {
+		val ^= val >> 30;
+		val *= 0xBF58476D1CE4E5B9ULL;
+		val ^= val >> 27;
+		val *= 0x94D049BB133111EBULL;
+		val ^= val >> 31;
+		return val;
+	}
+
+	// 바이트열 해쉬에 쓰는 키 (고정된 시드로 splitmix64 수열을 만든다)
+	struct HashSecretTable
+	{
+		static constexpr int Count = 32;
+
+		constexpr HashSecretTable() : Value() {
+			Int64U uiState = 0x243F6A8885A308D3ULL;	// 파이의 소수부
+			for (int i = 0; i < Count; ++i) {
+				uiState += 0x9E3779B97F4A7C15ULL;
+				Value[i] = Mix64(uiState) | 1;	// 홀수로 만들어서 곱했을 때 정보가 사라지지 않도록
+			}
+		}
+
+		alignas(16) Int64U Value[Count];
+	};
+
+	inline constexpr HashSecretTable HashSecret_v{};
+
+	// a * b의 128비트 결과를 a(하위), b(상위)에 담는다.
+	inline void Multiply128(Int64U& a, Int64U& b) {
+	#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 uiProduct = static_cast<unsigned __int128>(a) * b;
+		a = static_cast<Int64U>(uiProduct);
+		b = static_cast<Int64U>(uiProduct >> 64);
+	#elif JCORE_COMPILER_MSVC && defined(_M_X64)
+		a = _umul128(a, b, &b);
+	#else
+		// 32비트 곱 4번으로 만든다.
+		const Int64U uiLL = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+		const Int64U uiLH = (a & 0xFFFFFFFF) * (b >> 32);
+		const Int64U uiHL = (a >> 32) * (b & 0xFFFFFFFF);
+		const Int64U uiHH = (a >> 32) * (b >> 32);
+		const Int64U uiMid = (uiLL >> 32) + (uiLH & 0xFFFFFFFF) + (uiHL & 0xFFFFFFFF);
+		a = (uiLL & 0xFFFFFFFF) | (uiMid << 32);
+		b = uiHH + (uiLH >> 32) + (uiHL >> 32) + (uiMid >> 32);
+	#endif
+	}
+
+	// 128비트 곱의 상위/하위를 xor로 접는다.
+	inline Int64U Mum(Int64U a, Int64U b) {
+		Multiply128(a, b);
+		return a ^ b;
+	}
+
+	inline Int64U Read64(const Byte* source) {
+		Int64U uiVal;
+		std::memcpy(&uiVal, source, sizeof(Int64U));
+		return uiVal;
+	}
+
+	inline Int64U Read32(const Byte* source) {
+		Int32U uiVal;
+		std::memcpy(&uiVal, source, sizeof(Int32U));
+		return uiVal;
+	}
+
+	constexpr int HashStripeSize = 64;
+	constexpr int HashStripesPerBlock = 8;
+	constexpr Int32U HashScramblePrime = 0x9E3779B1;	// 32비트 황금비
+
+	// 스트라이프 하나를 누산기 8개에 누적한다. (누산기 i에 자기 워드의 32x32 곱과 짝 워드를 더한다)
+	inline void AccumulateStripe(Int64U* acc, const Byte* stripe, const Int64U* key) {
+		for (int i = 0; i < 8; ++i) {
+			const Int64U uiData = Read64(stripe + i * 8);
+			const Int64U uiKeyed = uiData ^ key[i];
+			acc[i ^ 1] += uiData;
+			acc[i] += (uiKeyed & 0xFFFFFFFF) * (uiKeyed >> 32);
+		}
+	}
+
+	inline void ScrambleAccumulator(Int64U* acc, const Int64U* key) {
+		for (int i = 0; i < 8; ++i) {
+			acc[i] = (acc[i] ^ (acc[i] >> 47) ^ key[i]) * HashScramblePrime;
+		}
+	}
+
+#if JCORE_SSE2
+	inline __m128i AccumulateStripeLane(__m128i acc, const Byte* stripe, const Int64U* key) {
+		const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe));
+		const __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+		const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+		const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+		return _mm_add_epi64(acc, _mm_add_epi64(product, swapped));
+	}
+
+	inline __m128i ScrambleLane(__m128i acc, const Int64U* key) {
+		const __m128i prime = _mm_set1_epi32(int(HashScramblePrime));
+		acc = _mm_xor_si128(_mm_xor_si128(acc, _mm_srli_epi64(acc, 47)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+
+		// SSE2에는 64비트 곱이 없으므로 하위/상위 32비트를 따로 곱해서 더한다.
+		const __m128i low = _mm_mul_epu32(acc, prime);
+		const __m128i high = _mm_mul_epu32(_mm_srli_epi64(acc, 32), prime);
+		return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+	}
+#endif
+
+	// 128바이트 초과
+	inline Int64U HashLongBytes(const Byte* source, int length, Int64U seed) {
+		const Int64U* pSecret = HashSecret_v.Value;
+		const int iStripeCount = (length - 1) / HashStripeSize;	// 마지막 스트라이프는 끝에 맞춰 따로 읽는다.
+		alignas(16) Int64U acc[8];
+
+		for (int i = 0; i < 8; ++i) {
+			acc[i] = pSecret[i] ^ seed;
+		}
+
+	#if JCORE_SSE2
+		__m128i lane[4];
+		for (int i = 0; i < 4; ++i) {
+			lane[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(acc + i * 2));
+		}
+
+		// 블록(스트라이프 8개) 단위로 돌려서 키 위치 계산과 스크램블 검사를 블록마다 한번만 한다.
+		const int iBlockCount = iStripeCount / HashStripesPerBlock;
+		const Byte* pStripe = source;
+
+		for (int iBlock = 0; iBlock < iBlockCount; ++iBlock) {
+			for (int iStripe = 0; iStripe < HashStripesPerBlock; ++iStripe, pStripe += HashStripeSize) {
+				for (int i = 0; i < 4; ++i) {
+					lane[i] = AccumulateStripeLane(lane[i], pStripe + i * 16, pSecret + iStripe + i * 2);
+				}
+			}
+
+			for (int i = 0; i < 4; ++i) {
+				lane[i] = ScrambleLane(lane[i], pSecret + 16 + i * 2);
+			}
+		}
+
+		for (int iStripe = 0; iStripe < iStripeCount % HashStripesPerBlock; ++iStripe, pStripe += HashStripeSize) {
+			for (int i = 0; i < 4; ++i) {
+				lane[i] = AccumulateStripeLane(lane[i], pStripe + i * 16, pSecret + iStripe + i * 2);
+			}
+		}
+
+		for (int i = 0; i < 4; ++i) {
+			lane[i] = AccumulateStripeLane(lane[i], source + length - HashStripeSize + i * 16, pSecret + 9 + i * 2);
+			_mm_store_si128(reinterpret_cast<__m128i*>(acc + i * 2), lane[i]);
+		}
+	#else
+		for (int iStripe = 0; iStripe < iStripeCount; ++iStripe) {
+			AccumulateStripe(acc, source + iStripe * HashStripeSize, pSecret + iStripe % HashStripesPerBlock);
+
+			if (iStripe % HashStripesPerBlock == HashStripesPerBlock - 1) {
+				ScrambleAccumulator(acc, pSecret + 16);
+			}
+		}
+
+		AccumulateStripe(acc, source + length - HashStripeSize, pSecret + 9);
+	#endif
+
+		Int64U uiResult = Int64U(length) * 0x9E3779B97F4A7C15ULL ^ seed;
+		for (int i = 0; i < 4; ++i) {
+			uiResult += Mum(acc[i * 2] ^ pSecret[24 + i * 2], acc[i * 2 + 1] ^ pSecret[25 + i * 2]);
+		}
+
+		return Mix64(uiResult);
+	}
+	NS_DETAIL_END
+
+// 바이트열의 64비트 해쉬 (같은 입력과 시드면 플랫폼/SSE2 사용 여부와 관계없이 결과가 같다)
+inline Int64U HashBytes64(const void* source, int length, Int64U seed = 0) {
+	const Byte* pSource = static_cast<const Byte*>(source);
+	const Int64U* pSecret = Detail::HashSecret_v.Value;
+	Int64U a, b;
+
+	if (length > 128) {
+		return Detail::HashLongBytes(pSource, length, seed);
+	}
+
+	seed ^= Detail::Mum(seed ^ pSecret[0], pSecret[1]);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			// 4 ~ 16바이트: 앞쪽 두 워드와 뒤쪽 두 워드 (길이가 8 미만이면 서로 겹친다)
+			const int iMiddle = (length >> 3) << 2;
+			a = (Detail::Read32(pSource) << 32) | Detail::Read32(pSource + iMiddle);
+			b = (Detail::Read32(pSource + length - 4) << 32) | Detail::Read32(pSource + length - 4 - iMiddle);
+		} else if (length > 0) {
+			a = (Int64U(pSource[0]) << 16) | (Int64U(pSource[length >> 1]) << 8) | pSource[length - 1];
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		int iRemain = length;
+
+		if (iRemain > 48) {
+			Int64U uiSeed1 = seed, uiSeed2 = seed;
+			do {
+				seed = Detail::Mum(Detail::Read64(pSource) ^ pSecret[1], Detail::Read64(pSource + 8) ^ seed);
+				uiSeed1 = Detail::Mum(Detail::Read64(pSource + 16) ^ pSecret[2], Detail::Read64(pSource + 24) ^ uiSeed1);
+				uiSeed2 = Detail::Mum(Detail::Read64(pSource + 32) ^ pSecret[3], Detail::Read64(pSource + 40) ^ uiSeed2);
+				pSource += 48;
+				iRemain -= 48;
+			} while (iRemain > 48);
+			seed ^= uiSeed1 ^ uiSeed2;
+		}
+
+		while (iRemain > 16) {
+			seed = Detail::Mum(Detail::Read64(pSource) ^ pSecret[1], Detail::Read64(pSource + 8) ^ seed);
+			pSource += 16;
+			iRemain -= 16;
+		}
+
+		// 마지막 16바이트 (앞에서 읽은 부분과 겹칠 수 있다)
+		a = Detail::Read64(pSource + iRemain - 16);
+		b = Detail::Read64(pSource + iRemain - 8);
+	}
+
+	a ^= pSecret[1];
+	b ^= seed;
+	Detail::Multiply128(a, b);
+	return Detail::Mum(a ^ pSecret[0] ^ Int64U(length), b ^ pSecret[1]);
+}
 
 template <typename T>
 struct Hasher
 {
 	constexpr Int32U operator()(T val) const {
 		if constexpr (JCore::IsFundamentalType_v<T>)
-			return ((val ^ HashXorKey_v) % PrimeInt32U_v) * PrimeInt32U_v;
+			return Int32U(Detail::Mix64(Int64U(val)));
 		else {	// 다른 타입이면 강제로 형변환 후 진행
-			return ((static_cast<int>(val) ^ HashXorKey_v) % PrimeInt32U_v) * PrimeInt32U_v;
+			return Int32U(Detail::Mix64(Int64U(static_cast<int>(val))));
 		}
 	}
 };
@@ -61,43 +296,59 @@ struct Hasher<double>
 	}
 };
 
+// 64비트 주소의 상위 비트까지 섞는다. (정렬 때문에 항상 0인 하위 비트만 다른 주소도 잘 퍼진다)
 template <typename T>
 struct Hasher<T*>
 {
-	constexpr Int32U operator()(T* val) const {
-		return Hasher<Int32U>()((Int32U)val);
+	Int32U operator()(T* val) const {
+		return Int32U(Detail::Mix64(Int64U(reinterpret_cast<IntPtr>(val))));
 	}
 };
 
 
+template <Int32U> struct StaticString;
+
 template <>
 struct Hasher<String> {
 	Int32U operator()(const String& val) const {
-		Int32U uiConv = PrimeInt32U_v;
-		char* pBuffer = val.Source();
-#if defined(_WIN64)
-		using TStepType = Int64U;
-#else
-		using TStepType = Int32U;
-#endif
-		constexpr int iStep = sizeof(TStepType);	// 플랫폼에 따라.. 다르게
-		const int iStepCount = val.Length() / iStep;
+		return HashBytes(val.Source(), val.Length());
+	}
 
-		int i = 0;
-		for (; i < iStepCount; i += iStep) {
-			uiConv ^= Hasher<TStepType>()(*reinterpret_cast<TStepType*>(pBuffer + i));
-			uiConv *= PrimeInt32U_v;
-		}
+	// 임시 String을 만들지 않고 같은 해쉬값을 얻는다. (HashMap 이종 탐색용)
+	Int32U operator()(const char* val) const {
+		return HashBytes(val, int(std::strlen(val)));
+	}
 
-		for (; i < val.Length(); ++i) {
-			uiConv ^= pBuffer[i] ^ HashXorKey_v;
-			uiConv *= PrimeInt32U_v;
-		}
+	template <Int32U Size>
+	Int32U operator()(const StaticString<Size>& val) const {
+		return operator()(val.Source);
+	}
 
-		return uiConv;
+	static Int32U HashBytes(const char* source, const int length) {
+		return Int32U(HashBytes64(source, length));
 	}
 };
 
+	NS_DETAIL_BEGIN
+	template <typename T>
+	struct IsHeterogeneousStringKey : FalseType {};
+
+	template <>
+	struct IsHeterogeneousStringKey<char*> : TrueType {};
+	template <>
+	struct IsHeterogeneousStringKey<const char*> : TrueType {};
+	template <Int32U Size>
+	struct IsHeterogeneousStringKey<char[Size]> : TrueType {};
+	template <Int32U Size>
+	struct IsHeterogeneousStringKey<const char[Size]> : TrueType {};
+	template <Int32U Size>
+	struct IsHeterogeneousStringKey<StaticString<Size>> : TrueType {};
+	NS_DETAIL_END
+
+// TKey로 변환하지 않고 TLookupKey 그대로 해쉬/비교해도 되는지 (String 키 맵을 const char*, StaticString으로 탐색)
+template <typename TKey, typename TLookupKey>
+constexpr bool IsHeterogeneousKey_v = IsSameType_v<TKey, String> && Detail::IsHeterogeneousStringKey<NaturalType_t<TLookupKey>>::Value;
+
 NS_JC_END
 
-#pragma warning (pop)
\ No newline at end of file
+#pragma warning (pop)
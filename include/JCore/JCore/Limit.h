@@ -30,12 +30,12 @@ constexpr Int16		MaxShort_v = (1 << 15) - 1;
 constexpr Int16		MinShort_v = (1 << 15);
 constexpr Int16U	MaxInt16U_v = (1 << 16) - 1;
 constexpr int		MaxInt32_v = 0x7fffffff;
-constexpr int		MinInt32_v = MaxInt32_v + 1;
+constexpr int		MinInt32_v = -MaxInt32_v - 1;
 constexpr int		MaxInt_v = 0x7fffffff;
-constexpr int		MinInt_v = MaxInt32_v + 1;
+constexpr int		MinInt_v = -MaxInt32_v - 1;
 constexpr Int32U	MaxInt32U_v = 0xffffffffU;
 constexpr Int64		MaxInt64_v = 0x7fffffffffffffffLL;
-constexpr Int64		MinInt64_v = MaxInt64_v + 1LL;
+constexpr Int64		MinInt64_v = -MaxInt64_v - 1LL;
 constexpr Int64U	MaxInt64U_v = 0xffffffffffffffffLLU;
 constexpr int		BytePerBit_v = 8;
 constexpr int		EnumSize_v = sizeof(Detail::ForSizeCheck);
@@ -0,0 +1,53 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 플랫폼/컴파일러 판별 및 MSVC 전용 기능의 대체 정의
+ * 윈도우가 아닌 환경(Linux, GCC/Clang)에서도 JCore 헤더를 그대로 쓸 수 있도록 한다.
+ */
+
+#pragma once
+
+#if defined(_WIN32)
+	#define JCORE_PLATFORM_WINDOWS	1
+	#define JCORE_PLATFORM_POSIX	0
+#else
+	#define JCORE_PLATFORM_WINDOWS	0
+	#define JCORE_PLATFORM_POSIX	1
+#endif
+
+#if defined(_MSC_VER)
+	#define JCORE_COMPILER_MSVC		1
+#else
+	#define JCORE_COMPILER_MSVC		0
+#endif
+
+// 빈 멤버가 크기를 차지하지 않도록 한다. (MSVC는 표준 속성을 무시하므로 전용 속성을 사용)
+#if JCORE_COMPILER_MSVC
+	#define JCORE_NO_UNIQUE_ADDRESS	[[msvc::no_unique_address]]
+#else
+	#define JCORE_NO_UNIQUE_ADDRESS	[[no_unique_address]]
+#endif
+
+// 곧 읽을 주소를 캐시로 미리 가져온다. (결과를 기다리지 않으며 잘못된 주소여도 안전하다)
+#if JCORE_COMPILER_MSVC
+	#include <intrin.h>
+	#define JCORE_PREFETCH(address)	_mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+	#define JCORE_PREFETCH(address)	__builtin_prefetch(address)
+#endif
+
+// SSE2 사용 가능 여부 (x64는 항상 지원한다. 그 외 아키텍처는 스칼라 구현을 사용)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define JCORE_SSE2	1
+	#include <emmintrin.h>
+#else
+	#define JCORE_SSE2	0
+#endif
+
+#if !JCORE_COMPILER_MSVC
+	#include <cstdio>
+
+	// MSVC 보안 CRT 함수 대체 (Console.h 등에서 사용)
+	#define printf_s	printf
+	#define sprintf_s	snprintf
+#endif
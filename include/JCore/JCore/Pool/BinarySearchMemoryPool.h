@@ -25,6 +25,8 @@ NS_JC_BEGIN
  * =====================================================================
  *
  * 이진 탐색기반 메모리풀
+ * 예전에는 블록 크기 표를 이진 탐색해서 인덱스를 찾았지만 지금은 IndexedMemoryPool과 같은
+ * 사이즈 클래스 계산(AllocationLengthMapConverter, O(1))을 쓴다. 이름과 eBinarySearch는 호환을 위해 남겨둔다.
  *
  * =====================================================================
  */
@@ -54,8 +56,8 @@ public:
 		constexpr int iFitSize = Detail::AllocationLengthMapConverter::ToSize<iIndex>();
 
 		bool bNewAlloc;
-		void* pMemoryBlock = m_Pool[iIndex]->Pop(bNewAlloc);
-		AddAllocated(iIndex, bNewAlloc);
+		void* pMemoryBlock = m_ThreadCache.Pop(m_Pool[iIndex], iIndex, bNewAlloc);
+		AddAllocated(iIndex, bNewAlloc, RequestSize);
 
 		return pMemoryBlock;
 	}
@@ -66,8 +68,8 @@ public:
 
 		realAllocatedSize = iFitSize;
 		bool bNewAlloc;
-		void* pMemoryBlock = m_Pool[iIndex]->Pop(bNewAlloc);
-		AddAllocated(iIndex, bNewAlloc);
+		void* pMemoryBlock = m_ThreadCache.Pop(m_Pool[iIndex], iIndex, bNewAlloc);
+		AddAllocated(iIndex, bNewAlloc, requestSize);
 		return pMemoryBlock;
 	}
 
@@ -76,21 +78,21 @@ public:
 		// static_assert(Detail::AllocationLengthMapConverter::ValidateSize<PushSize>());
 		int index = Detail::AllocationLengthMapConverter::ToIndex<PushSize>();
 		AddDeallocated(index);
-		m_Pool[index]->Push(memory);
+		m_ThreadCache.Push(m_Pool[index], index, memory);
 	}
 
+	// returnSize는 요청한 크기와 실제로 받은 크기 중 아무거나 써도 같은 블록으로 돌아간다.
 	void DynamicPush(void* memory, int returnSize) override {
-		// DebugAssertMessage(Detail::AllocationLengthMapConverter::ValidateSize(returnSize), "뭐야! 사이즈가 안맞자나!");
 		int index = Detail::AllocationLengthMapConverter::ToIndex(returnSize);
 		AddDeallocated(index);
-		m_Pool[index]->Push(memory);
+		m_ThreadCache.Push(m_Pool[index], index, memory);
 	}
 
 
 	void CreatePool() {
 		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
 			int iChunkSize = Detail::AllocationLengthMapConverter::ToSize(i);
-			m_Pool[i] = dbg_new MemoryChunckQueue(iChunkSize, 0);
+			m_Pool[i] = dbg_new MemoryChunckQueue(iChunkSize, 0, m_SlabPolicies[i]);
 		}
 	}
 
@@ -104,10 +106,11 @@ public:
 			DebugAssertMsg(Detail::AllocationLengthMapConverter::ValidateSize(iSize), "뭐야! 사이즈가 안맞자나!");
 
 			if (m_Pool[iIndex]) {
+				m_ThreadCache.Flush();
 				JCORE_DELETE_SAFE(m_Pool[iIndex]);
 			}
 			
-			m_Pool[iIndex] = dbg_new MemoryChunckQueue(iSize, iCount);
+			m_Pool[iIndex] = dbg_new MemoryChunckQueue(iSize, iCount, m_SlabPolicies[iIndex]);
 			AddInitBlock(iIndex, iCount);
 		});
 
@@ -118,11 +121,29 @@ public:
 	void Finalize() override {
 		DebugAssertMsg(HasUsingBlock() == false, "현재 사용중인 블록이 있습니다. !!!");
 
+		m_ThreadCache.Flush();
 		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
 			JCORE_DELETE_SAFE(m_Pool[i]);
 		}
 	}
 
+	void SetSlabPolicy(int blockSize, const MemorySlabPolicy& policy) override {
+		const int iIndex = Detail::AllocationLengthMapConverter::ToIndex(blockSize);
+		m_SlabPolicies[iIndex] = policy;
+		if (m_Pool[iIndex]) m_Pool[iIndex]->SetSlabPolicy(policy);
+	}
+
+	Int64U ReleaseEmptySlabs() override {
+		Int64U uiReleasedBytes = 0;
+
+		m_ThreadCache.Flush();
+		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
+			if (m_Pool[i]) uiReleasedBytes += m_Pool[i]->ReleaseEmptySlabs();
+		}
+
+		return uiReleasedBytes;
+	}
+
 	int Algorithm() override { return eBinarySearch; }
 	
 private:
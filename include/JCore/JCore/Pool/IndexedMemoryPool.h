@@ -27,6 +27,11 @@
  * 3. 고정 사이즈를 할당해주는 효율적인 방법은 없을까?
  *    이건 나중에 고민하는걸로
  *
+ * 4. 2번의 Low/High 타게터는 512바이트를 기준으로 인덱싱 규칙이 달라서
+ *    요청한 크기로만 반납해야 하는 문제가 있었고 (받은 크기로 반납하면 다른 블록으로 감)
+ *    2의 거듭제곱 블록이라 낭비도 컸다.
+ *    지금은 BinarySearchMemoryPool과 같은 사이즈 클래스 표(MemoryPoolDetail.h)를 쓰고
+ *    크기 -> 블록 인덱스를 비트 연산으로 바로 계산하므로 타게터 배열이 필요없다.
  *
  * ======================================================================
  */
@@ -37,7 +42,6 @@
 #include <JCore/Limit.h>
 
 #include <JCore/Container/Arrays.h>
-#include <JCore/Container/Vector.h>
 #include <JCore/Container/HashMap.h>
 
 #include <JCore/Pool/MemoryPoolAllocationAlgorithm.h>
@@ -49,22 +53,18 @@ NS_JC_BEGIN
 
 class IndexedMemoryPool : public MemoryPoolAbstract
 {
-	using MemoryChunkQueueTargetrList = JCore::Vector<MemoryChunckQueue**>;
 public:
 	IndexedMemoryPool(const HashMap<int, int>& allocationMap) : MemoryPoolAbstract(false) {
 		IndexedMemoryPool::Initialize(allocationMap);
 		IndexedMemoryPool::CreatePool();
-		IndexedMemoryPool::CreateTargeters();
 	}
 
 	IndexedMemoryPool(bool skipInitialize) : MemoryPoolAbstract(skipInitialize) {
 		IndexedMemoryPool::CreatePool();
-		IndexedMemoryPool::CreateTargeters();
 	}
 
 	IndexedMemoryPool(int slot, const String& name, bool skipInitialize = false) : MemoryPoolAbstract(slot, name, skipInitialize) {
 		IndexedMemoryPool::CreatePool();
-		IndexedMemoryPool::CreateTargeters();
 	}
 
 	~IndexedMemoryPool() override {
@@ -73,93 +73,65 @@ public:
 
 	template <int RequestSize>
 	void* StaticPop() {
+		static_assert(RequestSize <= MaxAllocatableSize, "... too big to allocate [IndexedMemoryPool]");
 		constexpr int iIndex = Detail::AllocationLengthMapConverter::ToIndex<RequestSize>();
 
 		bool bNewAlloc;
-		MemoryChunckQueue* pChuckQueue = GetChunckQueue(RequestSize);
-
-		if (pChuckQueue == nullptr) {
-			return nullptr;
-		}
-
-		void* pMemoryBlock = pChuckQueue->Pop(bNewAlloc);
+		void* pMemoryBlock = m_ThreadCache.Pop(m_Pool[iIndex], iIndex, bNewAlloc);
 #ifdef DebugMode
-		AddAllocated(iIndex, bNewAlloc);
+		AddAllocated(iIndex, bNewAlloc, RequestSize);
 #endif
 		return pMemoryBlock;
 	}
 
-
-	// TODO: 메모리할당 규칙이 Low와 High가 틀리기떄문에 벌어지는 현상이다.
-	//       BinarySearch와 Indexed를 똑같이 사용하기 위해서는 "요청한" 값을 기록해놓고 "요청한" 값을 반납해야한다.
-	//		 좀더 유연한 구조로 개선 필요. ㅠㅠ
 	void* DynamicPop(int requestSize, int& realAllocatedSize) override {
+		const int iIndex = ChunckQueueIndex(requestSize);
+		if (iIndex == Detail::InvalidSlot_v) return nullptr;
 
 		bool bNewAlloc;
-		MemoryChunckQueue* pChuckQueue = GetChunckQueue(requestSize);
-		if (pChuckQueue == nullptr) return nullptr;
-		void* pMemoryBlock = pChuckQueue->Pop(bNewAlloc);
-		realAllocatedSize = pChuckQueue->ChunkSize();
+		void* pMemoryBlock = m_ThreadCache.Pop(m_Pool[iIndex], iIndex, bNewAlloc);
+		realAllocatedSize = Detail::AllocationLengthMapConverter::ToSize(iIndex);
 #ifdef DebugMode
-		const int iIndex = Detail::AllocationLengthMapConverter::ToIndex(pChuckQueue->ChunkSize());
-		AddAllocated(iIndex, bNewAlloc);
+		AddAllocated(iIndex, bNewAlloc, requestSize);
 #endif
 		return pMemoryBlock;
 	}
 
 	template <int PushSize>
 	void StaticPush(void* memory) {
-		MemoryChunckQueue* pChuckQueue = GetChunckQueue(PushSize);
-		if (pChuckQueue == nullptr) return;
-		const int iIndex = Detail::AllocationLengthMapConverter::ToIndex(pChuckQueue->ChunkSize());
+		constexpr int iIndex = Detail::AllocationLengthMapConverter::ToIndex<PushSize>();
 		AddDeallocated(iIndex);
-		pChuckQueue->Push(memory);
+		m_ThreadCache.Push(m_Pool[iIndex], iIndex, memory);
 	}
 
+	// returnSize는 요청한 크기와 실제로 받은 크기 중 아무거나 써도 같은 블록으로 돌아간다.
 	void DynamicPush(void* memory, int returnSize) override {
-		MemoryChunckQueue* pChuckQueue = GetChunckQueue(returnSize);
-		if (pChuckQueue == nullptr) return;
-		const int index = Detail::AllocationLengthMapConverter::ToIndex(pChuckQueue->ChunkSize());
-		AddDeallocated(index);
-		pChuckQueue->Push(memory);
+		const int iIndex = ChunckQueueIndex(returnSize);
+		if (iIndex == Detail::InvalidSlot_v) return;
+
+		AddDeallocated(iIndex);
+		m_ThreadCache.Push(m_Pool[iIndex], iIndex, memory);
 	}
 
 	MemoryChunckQueue* GetChunckQueue(int size) {
-		MemoryChunkQueueTargetrList* pTargeterList;
-		int iChunkQueueIndex = -1;
+		const int iIndex = ChunckQueueIndex(size);
+		return iIndex == Detail::InvalidSlot_v ? nullptr : m_Pool[iIndex];
+	}
 
+	// 할당할 수 없는 크기면 InvalidSlot_v
+	static int ChunckQueueIndex(int size) {
 		if (size > MaxAllocatableSize) {
 			DebugAssertMsg(false, "풀인덱싱은 최대 %d 만큼만 할당가능합니다. (%d바이트)", MaxAllocatableSize, size);
-			return nullptr;
-		}
-
-		if (size > LowBoundarySize) {
-			iChunkQueueIndex = size / BoundarySizeMax;
-			pTargeterList = m_PoolTargeterHigh;
-
-			if (iChunkQueueIndex <= 0 || iChunkQueueIndex >= HighTargeterListCapacity) {
-				DebugAssertMsg(false, "올바르지 않은 청크큐 인덱스입니다. %d바이트 [%s]", size, "하이");
-				return nullptr;
-			}
+			return Detail::InvalidSlot_v;
 		}
-		else {
-			iChunkQueueIndex = size;
-			pTargeterList = m_PoolTargeterLow;
 
-			if (iChunkQueueIndex < 0 || iChunkQueueIndex >= LowTargeterListCapacity) {
-				DebugAssertMsg(false, "올바르지 않은 청크큐 인덱스입니다. %d바이트 [%s]", size, "하이");
-				return nullptr;
-			}
-		}
-
-		MemoryChunckQueue* pChuckQueue = *pTargeterList->At(iChunkQueueIndex);
-		return pChuckQueue;
+		return Detail::AllocationLengthMapConverter::ToIndex(size);
 	}
 
 	void CreatePool() {
-		for (int i = 0; i <= HighBoundaryIndex; ++i) {
+		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
 			int iChunkSize = Detail::AllocationLengthMapConverter::ToSize(i);
-			if (m_Pool[i] == nullptr) m_Pool[i] = dbg_new MemoryChunckQueue(iChunkSize, 0);
+			if (m_Pool[i] == nullptr) m_Pool[i] = dbg_new MemoryChunckQueue(iChunkSize, 0, m_SlabPolicies[i]);
 		}
 	}
 
@@ -172,10 +144,12 @@ public:
 			const int iIndex = Detail::AllocationLengthMapConverter::ToIndex(iSize);
 			DebugAssertMsg(iSize <= MaxAllocatableSize, "이 풀 인덱싱은 최대 %d 만큼만 할당가능합니다. (%d바이트 블록을 초기화하려함)", MaxAllocatableSize, iSize);
 			DebugAssertMsg(Detail::AllocationLengthMapConverter::ValidateSize(iSize), "뭐야! 사이즈가 안맞자나!");
-			if (m_Pool[iIndex])
+			if (m_Pool[iIndex]) {
+				m_ThreadCache.Flush();
 				JCORE_DELETE_SAFE(m_Pool[iIndex]);
+			}
 
-			m_Pool[iIndex] = dbg_new MemoryChunckQueue(iSize, iCount);
+			m_Pool[iIndex] = dbg_new MemoryChunckQueue(iSize, iCount, m_SlabPolicies[iIndex]);
 			AddInitBlock(iIndex, iCount);
 		});
 
@@ -186,101 +160,37 @@ public:
 	void Finalize() override {
 		DebugAssertMsg(HasUsingBlock() == false, "현재 사용중인 블록이 있습니다. !!!");
 
-		for (int i = 0; i <= HighBoundaryIndex; ++i) {
+		m_ThreadCache.Flush();
+		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
 			JCORE_DELETE_SAFE(m_Pool[i]);
 		}
-
-		if (m_PoolTargeterLow != nullptr) {
-			for (int i = 0; i < m_PoolTargeterLow->Size(); ++i) {
-				m_PoolTargeterLow->At(i) = nullptr;
-			}
-			JCORE_DELETE_SAFE(m_PoolTargeterLow);
-		}
-
-		if (m_PoolTargeterHigh != nullptr) {
-			for (int i = 0; i < m_PoolTargeterHigh->Size(); ++i) {
-				m_PoolTargeterHigh->At(i) = nullptr;
-			}
-			JCORE_DELETE_SAFE(m_PoolTargeterHigh);
-		}
 	}
 
-	int Algorithm() override { return eFullIndexing; }
-
-
-	void CreateTargeters() {
-
-		DebugAssertMsg(m_PoolTargeterLow == nullptr, "이미 Low 타게터 세팅이 되어있습니다.");
-		DebugAssertMsg(m_PoolTargeterHigh == nullptr, "이미 High 타게터 세팅이 되어있습니다.");
-
-		m_PoolTargeterLow = dbg_new MemoryChunkQueueTargetrList(LowTargeterListCapacity, nullptr);	// 513
-		m_PoolTargeterHigh = dbg_new MemoryChunkQueueTargetrList(HighTargeterListCapacity, nullptr);	// 524
-		int iBeforeMax = 0;
+	void SetSlabPolicy(int blockSize, const MemorySlabPolicy& policy) override {
+		const int iIndex = Detail::AllocationLengthMapConverter::ToIndex(blockSize);
+		m_SlabPolicies[iIndex] = policy;
+		if (m_Pool[iIndex]) m_Pool[iIndex]->SetSlabPolicy(policy);
+	}
 
-		// 1 ~ 512 바이트 (Low 타게터 할당)
-		for (int i = 0; i <= LowBoundaryIndex; ++i) {
-			
-			int iMaxSize = 1 << i;
+	Int64U ReleaseEmptySlabs() override {
+		Int64U uiReleasedBytes = 0;
 
-			// 1: 0 ~ 1 (0 제외)
-			// 2: 2
-			// 4: 3 ~ 4
-			// 8: 5 ~ 8
-			for (int iSize = iBeforeMax + 1; iSize <= iMaxSize; ++iSize) {
-				m_PoolTargeterLow->At(iSize) = &m_Pool[i];
-			}
-
-			iBeforeMax = iMaxSize;
+		m_ThreadCache.Flush();
+		for (int i = 0; i < Detail::MemoryBlockSizeMapSize_v; ++i) {
+			if (m_Pool[i]) uiReleasedBytes += m_Pool[i]->ReleaseEmptySlabs();
 		}
 
-
-		// 513 ~ 524288 바이트 (High 타게터 할당)
-		iBeforeMax = 0;
-		for (int i = LowBoundaryIndex + 1; i <= HighBoundaryIndex; ++i) {
-			int iMaxSize = (1 << i) / BoundarySizeMax;
-
-
-			// iMaxSize    1000으로 나눴을때 몫
-			// 1024  : -> 0
-			// 2048  : -> 1
-			// 4096  : -> 2 ~ 3
-			// 8192  : -> 4 ~ 7
-			// 16384 : -> 8 ~ 15
-			// 
-			// 4001바이트를 주문하면 8192바이트를 주게되네
-			// 살짝 손해가 있긴하다.
-
-			for (int iSize = iBeforeMax; iSize <= iMaxSize - 1; ++iSize) {
-				m_PoolTargeterHigh->At(iSize) = &m_Pool[i];
-			}
-
-			
-			iBeforeMax = iMaxSize;
-		}
+		return uiReleasedBytes;
 	}
 
-
-
+	int Algorithm() override { return eFullIndexing; }
 public:
-	static constexpr int LowBoundaryIndex = 9;
-	static constexpr int HighBoundaryIndex = 19;
-
-	static constexpr int LowBoundarySize = 1 << LowBoundaryIndex;		// 512		3자리 중 제일 큰 수
-	static constexpr int HighBoundarySize = 1 << HighBoundaryIndex;		// 524'288	6자리 중 제일 큰 수
-	static constexpr int BoundarySizeMax = 1000;						// 3자리수 최대 + 1
-
-	static constexpr int LowTargeterListCapacity = LowBoundarySize + 1;	// 513
-	static constexpr int HighTargeterListCapacity = HighBoundarySize / BoundarySizeMax;	// 524
-
-	static constexpr int MaxAllocatableSize = (HighBoundarySize / 1000 - 1) * 1000;	// 최대 할당 가능한 메모리 (523'000)
+	static constexpr int MaxAllocatableSize = Detail::MemoryBlockSizeMax_v;	// 최대 할당 가능한 메모리 (16MB)
 private:
 	MemoryChunckQueue* m_Pool[Detail::MemoryBlockSizeMapSize_v]{};
-	MemoryChunkQueueTargetrList* m_PoolTargeterLow{};
-	MemoryChunkQueueTargetrList* m_PoolTargeterHigh{};
 };
 
 
 using IndexedMemoryPoolPtr = SharedPtr<IndexedMemoryPool>;
 
 NS_JC_END
-
@@ -2,37 +2,494 @@
  * 작성자: 윤정도
  * 생성일: 2/7/2023 2:38:40 PM
  * =====================
+ * 같은 크기의 청크를 모아두는 락프리 스택 (Treiber 스택)
+ * 비어있는 청크의 앞부분에 다음 청크 주소를 적어서 청크끼리 연결하므로 따로 배열이 필요없다.
+ * Push/Pop은 머리 포인터에 CAS 한번이다.
  *
+ * [슬랩]
+ * 청크가 모자라면 슬랩(MemorySlab.h) 하나를 받아서 여러 청크로 나눈 뒤 한번에 넣는다.
+ * 슬랩은 MemorySlabPolicy에 따라 할당할수록 커지며 슬랩을 받는 동안만 m_RefillLock을 잡는다.
+ * (여러 쓰레드가 동시에 비어있는 큐를 만나도 슬랩은 하나만 받는다)
+ * 정책의 InitialSlabBytes가 0이면 예전처럼 청크를 하나씩 Memory::Allocate로 할당한다.
+ *
+ * [ABA 문제]
+ * A를 꺼내려고 머리(A)와 A의 다음(B)을 읽은 사이에 다른 쓰레드가 A, B를 꺼내고 A만 다시 넣으면
+ * 머리는 여전히 A이므로 CAS가 성공하고 이미 사용중인 B가 머리가 되어버린다.
+ * 그래서 머리를 바꿀 때마다 1씩 늘어나는 태그를 포인터와 같이 CAS한다.
+ *  - x64: 16바이트 정렬된 [포인터][Int64U 태그] 쌍을 128비트 CAS(cmpxchg16b)로 바꾼다.
+ *         (MSVC: _InterlockedCompareExchange128, 그 외: 인라인 어셈블리. Atomic/Interlocked는 128비트를 지원하지 않는다)
+ *         태그가 64비트라서 한바퀴 도는 일이 없으므로 ABA가 생기지 않는다.
+ *  - 그 외 64비트 (대체 방식): 사용자 영역 주소는 하위 48비트만 쓰고 청크는 8바이트 정렬(간격이 8의 배수)이므로
+ *         주소의 하위 3비트를 버린 45비트를 위에 두고 하위 19비트를 태그로 써서 Int64U 하나로 CAS한다.
+ *         태그가 한바퀴 돌 수 있어서 ABA를 완전히 막지는 못한다. 머리를 읽고 CAS하기 전에 선점당한 동안
+ *         머리가 정확히 2^19(524,288)의 배수만큼 바뀌고 같은 청크가 다시 머리에 있어야 생긴다.
+ *  - 32비트 (대체 방식): 상위 32비트가 태그
+ *
+ * 128비트 CAS를 쓸 때 머리는 8바이트씩 따로 읽는다. 두 값이 서로 다른 시점의 값이어도
+ * CAS가 쌍 전체를 비교하므로 실패하고 현재 값을 다시 받는다.
+ *
+ * 꺼낸 청크의 다음 주소를 읽을 때 그 청크가 이미 다른 쓰레드에게 넘어가 있을 수 있지만
+ * 청크는 소멸자와 ReleaseEmptySlabs에서만 해제되므로 (둘 다 다른 쓰레드가 접근하지 않을 때만 호출한다)
+ * 읽기 자체는 안전하고 태그가 바뀌었으므로 CAS가 실패한다.
  */
 
 
 #pragma once
 
-#include <JCore/Sync/NormalLock.h>
-#include <JCore/Container/ArrayStack.h>
+#include <JCore/Memory.h>
+#include <JCore/Primitives/Atomic.h>
+#include <JCore/Sync/SpinLock.h>
+#include <JCore/Container/Arrays.h>
+
+#include <JCore/Pool/MemorySlab.h>
+
+// 0으로 정의하고 빌드하면 x64에서도 대체 방식(64비트 압축)을 쓴다.
+#ifndef JCORE_CHUNK_QUEUE_WIDE_CAS
+	#if defined(_M_X64) || defined(__x86_64__)
+		#define JCORE_CHUNK_QUEUE_WIDE_CAS 1
+	#else
+		#define JCORE_CHUNK_QUEUE_WIDE_CAS 0
+	#endif
+#endif
+
+#if JCORE_CHUNK_QUEUE_WIDE_CAS && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
 
 NS_JC_BEGIN
 
 class MemoryChunckQueue
 {
-	using QueueGuard = NormalLockGuard;
+	struct ChunkNode
+	{
+		ChunkNode* Next;
+	};
+
+	// 머리 청크와 머리를 바꿀 때마다 1씩 늘어나는 태그
+	struct alignas(16) TaggedHead
+	{
+		ChunkNode* Node;
+		Int64U Tag;
+	};
+
+	using TSlab = Detail::MemorySlab;
 public:
-	MemoryChunckQueue(int chunkSize, int chunkCount);
-	~MemoryChunckQueue();
+	// chunkCount만큼은 슬랩 하나에 미리 담아둔다.
+	MemoryChunckQueue(int chunkSize, int chunkCount, const MemorySlabPolicy& policy = {})
+		: m_iFreeCount(0)
+		, m_iChunkSize(chunkSize)
+		, m_iTotalChunkCount(0)
+		, m_SlabPolicy(policy)
+		, m_pSlabs(nullptr)
+		, m_iSlabCount(0)
+		, m_uiNextSlabBytes(policy.InitialSlabBytes)
+	{
+		if (chunkCount <= 0) {
+			return;
+		}
+
+		if (m_SlabPolicy.IsSlabDisabled()) {
+			for (int i = 0; i < chunkCount; ++i) {
+				Push(AllocateChunk());
+			}
+			m_iTotalChunkCount.Store(chunkCount);
+			return;
+		}
+
+		AllocateSlab(Detail::SlabHeaderSize_v + Size_t(ChunkStride()) * chunkCount, false);
+	}
+
+	// 다른 쓰레드가 접근하지 않을 때만 호출해야 한다.
+	// 사용중인(꺼내간) 청크는 해제하지 않는다. 그런 청크가 들어있는 슬랩도 그대로 남겨둔다.
+	~MemoryChunckQueue() {
+		ReleaseEmptySlabs();
+	}
+
+	MemoryChunckQueue(const MemoryChunckQueue&) = delete;
+	MemoryChunckQueue& operator=(const MemoryChunckQueue&) = delete;
+
+	void Push(void* chunk) {
+		ChunkNode* pNode = static_cast<ChunkNode*>(chunk);
+		PushChain(pNode, pNode, 1);
+	}
+
+	// newAlloc은 이번 Pop 때문에 운영체제(시스템 할당자)에서 메모리를 새로 받았으면 true이다.
+	// 슬랩을 쓰면 슬랩 하나를 받을 때만 true이고 그 슬랩에서 나눈 나머지 청크는 false로 나간다.
+	void* Pop(JCORE_OUT bool& newAlloc) {
+		ChunkNode* pNode = PopNode();
+
+		if (pNode == nullptr) {
+			return Refill(newAlloc);
+		}
+
+		newAlloc = false;
+		m_iFreeCount.Decrement();
+		return pNode;
+	}
+
+	// count개를 꺼낸다. 그 중 새로 할당한 청크 수를 반환한다.
+	// 여러 개를 한번에 떼어내려면 두번째 이후 청크의 주소를 따라가야 하는데, 그 청크가 이미 다른 쓰레드에게
+	// 넘어가 있으면 엉뚱한 주소를 따라가게 되므로 하나씩 꺼낸다.
+	int PopBatch(void** chunks, int count) {
+		int iNewAllocCount = 0;
+
+		for (int i = 0; i < count; ++i) {
+			bool bNewAlloc;
+			chunks[i] = Pop(bNewAlloc);
+			iNewAllocCount += bNewAlloc;
+		}
+
+		return iNewAllocCount;
+	}
+
+	// 넣을 청크들은 아직 이 쓰레드만 알고 있으므로 먼저 서로 연결해두고 CAS 한번으로 넣는다.
+	void PushBatch(void** chunks, int count) {
+		if (count <= 0) {
+			return;
+		}
+
+		for (int i = 0; i < count - 1; ++i) {
+			static_cast<ChunkNode*>(chunks[i])->Next = static_cast<ChunkNode*>(chunks[i + 1]);
+		}
+
+		PushChain(static_cast<ChunkNode*>(chunks[0]), static_cast<ChunkNode*>(chunks[count - 1]), count);
+	}
+
+	// 이후에 받는 슬랩의 크기를 바꾼다.
+	// 슬랩을 쓰는지 여부는 청크를 하나도 할당하지 않았을 때만 바꿀 수 있다.
+	void SetSlabPolicy(const MemorySlabPolicy& policy) {
+		SpinLockGuard guard(m_RefillLock);
+		DebugAssertMsg(policy.IsSlabDisabled() == m_SlabPolicy.IsSlabDisabled() || m_iTotalChunkCount.Load() == 0,
+			"청크를 할당한 후에는 슬랩 사용 여부를 바꿀 수 없습니다.");
+		DebugAssertMsg(policy.IsSlabDisabled() || (policy.MaxSlabBytes >= policy.InitialSlabBytes && policy.GrowthFactor >= 1),
+			"올바르지 않은 슬랩 정책입니다.");
+		m_SlabPolicy = policy;
+		m_uiNextSlabBytes = policy.InitialSlabBytes;
+	}
+
+	// 모든 청크가 반환된 슬랩을 운영체제에 돌려주고 돌려준 바이트 수를 반환한다.
+	// 슬랩을 쓰지 않으면 비어있는 청크를 모두 해제한다.
+	// 다른 쓰레드가 이 큐에 접근하지 않을 때만 호출해야 한다. (쓰레드 캐시에 담긴 청크는 사용중으로 보므로 먼저 비울 것)
+	Int64U ReleaseEmptySlabs() {
+		SpinLockGuard guard(m_RefillLock);
+		ChunkNode* pFreeList = DetachHead();
+		const int iFreeCount = m_iFreeCount.Exchange(0);
+
+		if (m_SlabPolicy.IsSlabDisabled()) {
+			while (pFreeList != nullptr) {
+				ChunkNode* pNext = pFreeList->Next;
+				Memory::Deallocate(pFreeList);
+				pFreeList = pNext;
+			}
+
+			m_iTotalChunkCount.Add(-iFreeCount);
+			return Int64U(iFreeCount) * ChunkStride();
+		}
+
+		if (pFreeList == nullptr) {
+			return 0;
+		}
+
+		// 1. 청크가 어느 슬랩에 속하는지 이진 탐색으로 찾을 수 있도록 슬랩을 주소 순으로 정렬한다.
+		TSlab** pSortedSlabs = Memory::Allocate<TSlab**>(sizeof(TSlab*) * m_iSlabCount);
+		int iSlabCount = 0;
+		for (TSlab* pSlab = m_pSlabs; pSlab != nullptr; pSlab = pSlab->Next) {
+			pSlab->FreeCount = 0;
+			pSortedSlabs[iSlabCount++] = pSlab;
+		}
+		Arrays::Sort(pSortedSlabs, iSlabCount);
+
+		// 2. 슬랩마다 비어있는 청크 수를 센다.
+		for (ChunkNode* pNode = pFreeList; pNode != nullptr; pNode = pNode->Next) {
+			++FindSlab(pSortedSlabs, iSlabCount, pNode)->FreeCount;
+		}
+
+		// 3. 돌려줄 슬랩에 속하지 않은 청크만 다시 연결해서 넣는다. 슬랩을 해제하면 머리를 읽을 수 없으므로 먼저 한다.
+		ChunkNode* pKeepFirst = nullptr;
+		ChunkNode* pKeepLast = nullptr;
+		int iKeepCount = 0;
+
+		while (pFreeList != nullptr) {
+			ChunkNode* pNext = pFreeList->Next;
+			const TSlab* pSlab = FindSlab(pSortedSlabs, iSlabCount, pFreeList);
+
+			if (pSlab->FreeCount != pSlab->ChunkCount) {
+				if (pKeepLast == nullptr) pKeepLast = pFreeList;
+				pFreeList->Next = pKeepFirst;
+				pKeepFirst = pFreeList;
+				++iKeepCount;
+			}
+
+			pFreeList = pNext;
+		}
+
+		if (pKeepFirst != nullptr) {
+			PushChain(pKeepFirst, pKeepLast, iKeepCount);
+		}
+
+		// 4. 비어있는 슬랩을 해제하고 나머지로 목록을 다시 만든다.
+		Int64U uiReleasedBytes = 0;
+		m_pSlabs = nullptr;
+		m_iSlabCount = 0;
+
+		for (int i = 0; i < iSlabCount; ++i) {
+			TSlab* pSlab = pSortedSlabs[i];
+
+			if (pSlab->FreeCount == pSlab->ChunkCount) {
+				uiReleasedBytes += pSlab->Bytes;
+				m_iTotalChunkCount.Add(-pSlab->ChunkCount);
+				MemoryPage::Deallocate(pSlab, pSlab->Bytes);
+				continue;
+			}
+
+			pSlab->Next = m_pSlabs;
+			m_pSlabs = pSlab;
+			++m_iSlabCount;
+		}
+
+		Memory::Deallocate(pSortedSlabs);
+
+		if (m_pSlabs == nullptr) {
+			m_uiNextSlabBytes = m_SlabPolicy.InitialSlabBytes;
+		}
 
-	void Push(void* chunk);
-	void* Pop(JCORE_OUT bool& newAlloc);
-	int FreeCount() { return m_ChunkQueue.Size();  }
-	int TotalCount() { return m_iTotalChunkCount; }
+		return uiReleasedBytes;
+	}
+
+	int FreeCount() { return m_iFreeCount.Load(); }
+	int TotalCount() { return m_iTotalChunkCount.Load(); }
 	int ChunkSize() { return m_iChunkSize; }
+	int SlabCount() { return m_iSlabCount; }			// 슬랩을 받는 중이면 정확하지 않다.
+	const MemorySlabPolicy& SlabPolicy() { return m_SlabPolicy; }
 private:
+	// first부터 last까지 연결된 count개의 청크를 머리에 붙인다.
+	void PushChain(ChunkNode* first, ChunkNode* last, int count) {
+		TaggedHead head = LoadHead();
+
+		for (;;) {
+			last->Next = head.Node;
+
+			if (CompareExchangeHead(head, { first, head.Tag + 1 })) {
+				break;
+			}
+		}
+
+		m_iFreeCount.Add(count);
+	}
+
+	ChunkNode* PopNode() {
+		TaggedHead head = LoadHead();
+
+		for (;;) {
+			ChunkNode* pTop = head.Node;
+
+			if (pTop == nullptr) {
+				return nullptr;
+			}
+
+			if (CompareExchangeHead(head, { pTop->Next, head.Tag + 1 })) {
+				return pTop;
+			}
+		}
+	}
+
+	void* Refill(JCORE_OUT bool& newAlloc) {
+		if (m_SlabPolicy.IsSlabDisabled()) {
+			newAlloc = true;
+			m_iTotalChunkCount.Increment();
+			return AllocateChunk();
+		}
+
+		SpinLockGuard guard(m_RefillLock);
+
+		// 락을 기다리는 동안 다른 쓰레드가 슬랩을 채웠을 수 있다.
+		ChunkNode* pNode = PopNode();
+		if (pNode != nullptr) {
+			newAlloc = false;
+			m_iFreeCount.Decrement();
+			return pNode;
+		}
+
+		newAlloc = true;
+		void* pChunk = AllocateSlab(m_uiNextSlabBytes, true);
+
+		const Size_t uiGrown = m_uiNextSlabBytes * m_SlabPolicy.GrowthFactor;
+		m_uiNextSlabBytes = uiGrown > Size_t(m_SlabPolicy.MaxSlabBytes) ? Size_t(m_SlabPolicy.MaxSlabBytes) : uiGrown;
+		return pChunk;
+	}
+
+	// bytes 크기의 슬랩을 받아서 청크로 나누고 큐에 넣는다. (청크가 하나도 안들어가면 하나가 들어갈 만큼 키운다)
+	// keepFirst면 첫 청크는 넣지 않고 반환한다. m_RefillLock을 잡은 상태이거나 생성자에서만 호출한다.
+	void* AllocateSlab(Size_t bytes, bool keepFirst) {
+		const Size_t uiStride = ChunkStride();
+
+		if (bytes < Detail::SlabHeaderSize_v + uiStride) {
+			bytes = Detail::SlabHeaderSize_v + uiStride;
+		}
+
+		// 큰 청크가 슬랩 끝에 다 못 들어가서 버려지는 부분이 없도록 청크 수에 맞춰 줄인 후
+		// 페이지 단위로 올림하고 남는 부분까지 청크로 쓴다.
+		const Size_t uiFitCount = (bytes - Detail::SlabHeaderSize_v) / uiStride;
+		bytes = MemoryPage::RoundUp(Detail::SlabHeaderSize_v + uiFitCount * uiStride, MemoryPage::PageSize);
+		const int iChunkCount = int((bytes - Detail::SlabHeaderSize_v) / uiStride);
+
+		bool bHugePage;
+		Byte* pMemory = static_cast<Byte*>(MemoryPage::Allocate(bytes, bHugePage));
+		TSlab* pSlab = reinterpret_cast<TSlab*>(pMemory);
+		pSlab->Bytes = bytes;
+		pSlab->ChunkCount = iChunkCount;
+		pSlab->FreeCount = 0;
+		pSlab->HugePage = bHugePage;
+		pSlab->Next = m_pSlabs;
+		m_pSlabs = pSlab;
+		++m_iSlabCount;
+
+		// 주소 순서대로 꺼내지도록 연결해서 연속으로 할당한 청크가 메모리에서도 이웃하게 한다.
+		Byte* pFirst = pMemory + Detail::SlabHeaderSize_v;
+		for (int i = 0; i < iChunkCount - 1; ++i) {
+			reinterpret_cast<ChunkNode*>(pFirst + i * uiStride)->Next = reinterpret_cast<ChunkNode*>(pFirst + (i + 1) * uiStride);
+		}
+
+		ChunkNode* pHead = reinterpret_cast<ChunkNode*>(pFirst);
+		ChunkNode* pTail = reinterpret_cast<ChunkNode*>(pFirst + (iChunkCount - 1) * uiStride);
+		m_iTotalChunkCount.Add(iChunkCount);
+
+		if (!keepFirst) {
+			PushChain(pHead, pTail, iChunkCount);
+			return nullptr;
+		}
+
+		if (iChunkCount > 1) {
+			PushChain(pHead->Next, pTail, iChunkCount - 1);
+		}
+
+		return pHead;
+	}
+
+	// 청크 하나가 차지하는 간격. 다음 주소를 적을 수 있도록 포인터 크기의 배수로 맞춘다.
+	// 슬랩의 첫 청크는 64바이트 경계에 있으므로 청크 크기가 16의 배수면 모든 청크가 16바이트 정렬된다.
+	Size_t ChunkStride() const {
+		return MemoryPage::RoundUp(m_iChunkSize < 1 ? 1 : m_iChunkSize, sizeof(ChunkNode));
+	}
+
+	// 1, 2, 4바이트 청크도 다음 주소를 적을 수 있도록 최소 포인터 크기만큼 할당한다.
+	void* AllocateChunk() {
+		return Memory::Allocate<void*>(int(ChunkStride()));
+	}
+
+	static TSlab* FindSlab(TSlab** sortedSlabs, int slabCount, ChunkNode* node) {
+		const int iIndex = Arrays::UpperBound(sortedSlabs, slabCount, reinterpret_cast<TSlab*>(node)) - 1;
+		DebugAssertMsg(iIndex >= 0, "어느 슬랩에도 속하지 않은 청크입니다.");
+		return sortedSlabs[iIndex];
+	}
+
+#if JCORE_CHUNK_QUEUE_WIDE_CAS
+	TaggedHead LoadHead() {
+		TaggedHead head;
+		head.Tag = std::atomic_ref<Int64U>(m_Head.Tag).load(std::memory_order_acquire);
+		head.Node = std::atomic_ref<ChunkNode*>(m_Head.Node).load(std::memory_order_acquire);
+		return head;
+	}
+
+	// 실패하면 expected에 현재 머리를 담는다.
+	bool CompareExchangeHead(TaggedHead& expected, TaggedHead desired) {
+	#if defined(_MSC_VER)
+		return _InterlockedCompareExchange128(
+			reinterpret_cast<volatile long long*>(&m_Head),
+			Int64(desired.Tag),
+			Int64(IntPtr(desired.Node)),
+			reinterpret_cast<long long*>(&expected)
+		) != 0;
+	#else
+		bool bExchanged;
+		__asm__ __volatile__(
+			"lock cmpxchg16b %1"
+			: "=@ccz"(bExchanged), "+m"(m_Head), "+a"(expected.Node), "+d"(expected.Tag)
+			: "b"(desired.Node), "c"(desired.Tag)
+			: "memory"
+		);
+		return bExchanged;
+	#endif
+	}
+#else
+	TaggedHead LoadHead() {
+		const Int64U uiHead = m_uiHead.LoadAcquire();
+		return { Unpack(uiHead), TagOf(uiHead) };
+	}
+
+	bool CompareExchangeHead(TaggedHead& expected, TaggedHead desired) {
+		Int64U uiExpected = Pack(expected.Node, expected.Tag);
+
+		if (m_uiHead.CompareExchange(uiExpected, Pack(desired.Node, desired.Tag))) {
+			return true;
+		}
+
+		expected = { Unpack(uiExpected), TagOf(uiExpected) };
+		return false;
+	}
+
+	// 태그는 태그 영역을 넘치면 0으로 돌아간다.
+	static Int64U Pack(ChunkNode* node, Int64U tag) {
+		if constexpr (sizeof(void*) == 8) {
+			const Int64U uiAddress = Int64U(IntPtr(node));
+			DebugAssertMsg((uiAddress >> AddressBits) == 0, "주소가 48비트를 넘어서 태그를 붙일 수 없습니다.");
+			DebugAssertMsg((uiAddress & AlignmentMask) == 0, "청크가 8바이트 정렬되어 있지 않습니다.");
+			return ((uiAddress >> AlignmentBits) << TagBits) | (tag & TagMask);
+		} else {
+			return (tag << 32) | Int64U(Int32U(IntPtr(node)));
+		}
+	}
+
+	static ChunkNode* Unpack(Int64U value) {
+		if constexpr (sizeof(void*) == 8) {
+			return reinterpret_cast<ChunkNode*>(IntPtr((value >> TagBits) << AlignmentBits));
+		} else {
+			return reinterpret_cast<ChunkNode*>(IntPtr(Int32U(value)));
+		}
+	}
+
+	static Int64U TagOf(Int64U value) {
+		if constexpr (sizeof(void*) == 8) {
+			return value & TagMask;
+		} else {
+			return value >> 32;
+		}
+	}
+
+	// 64비트 머리 구성: [주소 >> 3 (45비트)][태그 (19비트)]
+	static constexpr int AddressBits = 48;
+	static constexpr int AlignmentBits = 3;
+	static constexpr int TagBits = 64 - (AddressBits - AlignmentBits);
+	static constexpr Int64U AlignmentMask = (Int64U(1) << AlignmentBits) - 1;
+	static constexpr Int64U TagMask = (Int64U(1) << TagBits) - 1;
+
+	static_assert(sizeof(ChunkNode) == (1 << AlignmentBits) || sizeof(void*) != 8, "청크 간격이 정렬 비트와 맞지 않습니다.");
+#endif
+
+	// 모든 청크를 떼어내고 머리를 비운다. 다른 쓰레드가 접근하지 않을 때만 호출한다.
+	ChunkNode* DetachHead() {
+		TaggedHead head = LoadHead();
+		while (!CompareExchangeHead(head, { nullptr, head.Tag + 1 })) {}
+		return head.Node;
+	}
+private:
+#if JCORE_CHUNK_QUEUE_WIDE_CAS
+	TaggedHead m_Head{};				// 128비트 CAS로 바꾼다.
+#else
+	Atomic<Int64U> m_uiHead{ 0 };		// 청크 주소 + 태그 (Pack 참고)
+#endif
+	Atomic<int> m_iFreeCount;			// 머리와 같은 캐시라인에 둬서 CAS 직후 갱신 비용을 줄인다.
 	int m_iChunkSize;
-	int m_iTotalChunkCount;
-	JCore::ArrayStack<void*> m_ChunkQueue;
-	JCore::NormalLock m_Lock;
+	Atomic<int> m_iTotalChunkCount;
+
+	// 아래는 m_RefillLock을 잡고 접근한다.
+	SpinLock m_RefillLock;
+	MemorySlabPolicy m_SlabPolicy;
+	TSlab* m_pSlabs;					// 받은 슬랩 목록
+	int m_iSlabCount;
+	Size_t m_uiNextSlabBytes;			// 다음에 받을 슬랩 크기
 };
 
 
 
 NS_JC_END
-
@@ -1,4 +1,4 @@
-/*
+﻿/*
  * 작성자: 윤정도
  * 생성일: 12/13/2022 4:01:33 PM
  * =====================
@@ -12,6 +12,7 @@
 
 #include <JCore/Pool/MemoryPoolStatistics.h>
 #include <JCore/Pool/MemoryPoolCaptured.h>
+#include <JCore/Pool/MemoryPoolThreadCache.h>
 
 NS_JC_BEGIN
 
@@ -31,6 +32,18 @@ public:
 	int Slot() { return m_iSlot; }
 	const String& Name() { return m_Name; }
 	bool IsInitialized() { return m_bInitialized; }
+
+	// 쓰레드 캐시를 켜면 대부분의 Push/Pop이 락 없이 쓰레드별 매거진에서 끝난다. (MemoryPoolThreadCache.h 참고)
+	// 다른 쓰레드가 풀을 쓰지 않을 때 호출할 것
+	void SetThreadCache(bool enabled) { m_ThreadCache.SetEnabled(enabled); }
+	bool IsThreadCacheEnabled() { return m_ThreadCache.IsEnabled(); }
+
+	// blockSize 크기 블록의 청크큐가 이후에 받는 슬랩의 정책을 정한다. (MemorySlab.h 참고)
+	virtual void SetSlabPolicy(int blockSize, const MemorySlabPolicy& policy) = 0;
+
+	// 모든 블록이 반환된 슬랩을 운영체제에 돌려주고 돌려준 바이트 수를 반환한다.
+	// 쓰레드 캐시를 먼저 비우므로 다른 쓰레드가 풀을 쓰지 않을 때 호출할 것
+	virtual Int64U ReleaseEmptySlabs() = 0;
 	
 #if DebugMode 
 	Int64U GetTotalAllocated() { return m_Statistics.GetTotalAllocated();  }
@@ -38,6 +51,9 @@ public:
 	Int64U GetTotalReturned() { return m_Statistics.GetTotalReturned(); }
 	Int64U GetInitAllocated() { return m_Statistics.GetInitAllocated(); }
 	Int64U GetNewAllocated() { return m_Statistics.GetNewAllocated(); }
+	Int64U GetTotalRequested() { return m_Statistics.GetTotalRequested(); }
+	Int64U GetTotalWasted() { return m_Statistics.GetTotalWasted(); }
+	double GetWasteRatio() { return m_Statistics.GetWasteRatio(); }
 
 	int GetBlockTotalCounter(int blockIndex) {
 		DebugAssertMsg(blockIndex >= 0 && blockIndex <= Detail::MemoryBlockSizeMapSize_v, "유효한 범위의 블록인덱스가 아닙니다.");
@@ -59,6 +75,11 @@ public:
 		return m_Statistics.m_pBlockUsingCounter[blockIndex];
 	}
 
+	Int64U GetBlockWasted(int blockIndex) {
+		DebugAssertMsg(blockIndex >= 0 && blockIndex <= Detail::MemoryBlockSizeMapSize_v, "유효한 범위의 블록인덱스가 아닙니다.");
+		return m_Statistics.m_pBlockWasted[blockIndex];
+	}
+
 	void ResetStatistics() { m_Statistics.Reset(); }
 	bool HasUsingBlock() { return m_Statistics.HasUsingBlock();  }
 	
@@ -99,8 +120,8 @@ public:
 
 protected:
 	void AddInitBlock(Int32 blockIndex, Int32 blockCount) { m_Statistics.AddInitBlock(blockIndex, blockCount); }
-	void AddAllocated(Int32 blockIndex, bool createNew) {
-		m_Statistics.AddAllocated(blockIndex, createNew);
+	void AddAllocated(Int32 blockIndex, bool createNew, Int32 requestSize) {
+		m_Statistics.AddAllocated(blockIndex, createNew, requestSize);
 		if (m_bDetecting) ++m_pBlockUsedCounter[blockIndex];
 	}
 	void AddDeallocated(Int32 blockIndex) {
@@ -124,11 +145,15 @@ public:
 	Int64U GetTotalReturned() { return 0; }
 	Int64U GetInitAllocated() { return 0; }
 	Int64U GetNewAllocated() { return 0; }
+	Int64U GetTotalRequested() { return 0; }
+	Int64U GetTotalWasted() { return 0; }
+	double GetWasteRatio() { return 0.0; }
 
 	int GetBlockTotalCounter(int blockIndex) { return 0; }
 	int GetBlockUsedCounter(int blockIndex) { return 0; }
 	int GetBlockNewAllocCounter(int blockIndex) { return 0;  }
 	int GetBlockUsingCounter(int blockIndex) { return 0; }
+	Int64U GetBlockWasted(int blockIndex) { return 0; }
 	void ResetStatistics() { }
 	bool HasUsingBlock() { return false; }
 
@@ -139,13 +164,15 @@ public:
 	void CancelDetectLeak() {}
 protected:
 	void AddInitBlock(Int32 blockIndex, Int32 blockCount) { }
-	void AddAllocated(Int32 blockIndex, bool createNew) { }
+	void AddAllocated(Int32 blockIndex, bool createNew, Int32 requestSize) { }
 	void AddDeallocated(Int32 blockIndex) { }
 #endif 
 protected:
 	int m_iSlot;
 	String m_Name;
 	bool m_bInitialized;
+	MemoryPoolThreadCache m_ThreadCache;
+	MemorySlabPolicy m_SlabPolicies[Detail::MemoryBlockSizeMapSize_v];	// 청크큐를 새로 만들 때 넘겨준다.
 
 	friend class MemoryPoolManager;
 };
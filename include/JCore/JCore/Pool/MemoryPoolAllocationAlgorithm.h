@@ -13,8 +13,8 @@ NS_JC_BEGIN
 
 enum MemoryPoolAllocationAlgorithm
 {
-	eBinarySearch = 0x10,		// O(logn) / 2의 제곱 단위로만 할당가능
-	eFullIndexing = 0x20,		// O(1)    / 2의 제곱 단위로만 할당가능
+	eBinarySearch = 0x10,		// O(1) / 사이즈 클래스 단위로 할당 (예전 이름 유지, MemoryPoolDetail.h 참고)
+	eFullIndexing = 0x20,		// O(1) / 사이즈 클래스 단위로 할당
 	eMemoryPoolAllocationAlgorithmMax = eFullIndexing,
 	eMemoryPoolAllocationAlgorithmMask = 0xf0
 
@@ -2,47 +2,85 @@
  * 작성자: 윤정도
  * 생성일: 12/15/2022 2:50:25 PM
  * =====================
+ * 메모리풀 크기 단위(사이즈 클래스) 표
  *
+ * 예전에는 2의 거듭제곱 단위로만 블록을 나눠서 65바이트를 요청하면 128바이트를 줬다. (최대 49% 낭비)
+ * 지금은 jemalloc처럼 두배가 될 때마다 4개의 단위를 둔다.
+ *
+ *   8, 16, 24, 32, | 40, 48, 56, 64, | 80, 96, 112, 128, | 160, 192, 224, 256, | ... | 10M, 12M, 14M, 16M
+ *   (8바이트 간격)    (8바이트 간격)    (16바이트 간격)       (32바이트 간격)
+ *
+ * (2^k, 2^(k+1)] 구간을 2^(k-2) 간격으로 4등분하므로 33바이트 이상 요청의 낭비는 블록 크기의 20% 미만이다.
+ * 32바이트 이하는 청크에 다음 청크 주소를 적어야해서 8바이트 간격으로 둔다.
+ * 64바이트를 넘는 블록은 모두 16의 배수이고 16의 배수 크기 요청은 16의 배수 블록으로 가므로
+ * 16바이트 정렬이 필요한 타입(크기가 정렬의 배수)의 정렬이 유지된다.
+ *
+ * 크기 -> 인덱스 변환은 표를 찾지 않고 가장 높은 1 비트 위치(CountLeadingZero64)로 바로 계산한다. (분기 없음, O(1))
  */
 
 
 #pragma once
 
 #include <JCore/Type.h>
+#include <JCore/Bit.h>
 #include <JCore/Container/Arrays.h>
 
 
 NS_JC_BEGIN
 NS_DETAIL_BEGIN
 
-// 53바이트, 73바이트 뭐 이런식으로 정밀하게 할당해줄 수 없기때문에
-// 53바이트를 요청하면 64바이트를
-// 74바이트를 요청하면 128바이트를 할당해주는 식으로 처리
-// 이후 내가 언급하는 블록은 "한번에 1, 2, 4, 8, 16 ... 8'388'608, 16'777'216에 해당하는 단위로 할당가능한 메모리양의 단위"를 의미한다.
-inline constexpr int MemoryBlockSizeMap_v[] {
-	1 << 0,  1 << 1,  1 << 2,  1 << 3,  1 << 4,
-	1 << 5,  1 << 6,  1 << 7,  1 << 8,  1 << 9,
-	1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14,
-	1 << 15, 1 << 16, 1 << 17, 1 << 18, 1 << 19,
-	1 << 20, 1 << 21, 1 << 22, 1 << 23, 1 << 24
+inline constexpr int SizeClassGroupBits_v = 2;									// 두배마다 1 << 2 = 4개
+inline constexpr int SizeClassGroupCount_v = 1 << SizeClassGroupBits_v;
+inline constexpr int SizeClassFirstGroupShift_v = 5;							// 첫 4등분 구간은 (32, 64]
+inline constexpr int MemoryBlockSizeMapSize_v = 80;								// 8바이트 ~ 16MB
+inline constexpr int InvalidSlot_v = -1;
+
+struct MemoryBlockSizeTable
+{
+	int Sizes[MemoryBlockSizeMapSize_v];
 };
 
-inline char MemoryIndexSizeMap_v;
+// 인덱스를 4개씩 묶었을 때 첫 묶음은 8, 16, 24, 32이고
+// 그 다음 묶음부터는 (j + 5) << (묶음 번호 + 2) (j = 0 ~ 3) 이다.
+constexpr MemoryBlockSizeTable MakeMemoryBlockSizeTable() {
+	MemoryBlockSizeTable table{};
 
-inline constexpr int MemoryBlockSizeMapSize_v = sizeof(MemoryBlockSizeMap_v) / sizeof(int);
-inline constexpr int InvalidSlot_v = -1;
+	for (int i = 0; i < MemoryBlockSizeMapSize_v; ++i) {
+		const int iGroup = i >> SizeClassGroupBits_v;
+		const int iStep = i & (SizeClassGroupCount_v - 1);
+
+		table.Sizes[i] = iGroup == 0
+			? (iStep + 1) << 3
+			: (SizeClassGroupCount_v + iStep + 1) << (iGroup + SizeClassGroupBits_v);
+	}
+
+	return table;
+}
+
+inline constexpr MemoryBlockSizeTable MemoryBlockSizeTable_v = MakeMemoryBlockSizeTable();
+inline constexpr const int (&MemoryBlockSizeMap_v)[MemoryBlockSizeMapSize_v] = MemoryBlockSizeTable_v.Sizes;
+inline constexpr int MemoryBlockSizeMax_v = MemoryBlockSizeMap_v[MemoryBlockSizeMapSize_v - 1];
+
+static_assert(MemoryBlockSizeMax_v == 1 << 24, "마지막 블록은 16MB여야 합니다.");
 
 // 예를들어서
-// 64바이트 -> 6으로 변환
-//  6을    -> 64바이트로 변환 해주는 기능 수행
+// 65바이트 -> 8 (80바이트 블록)으로 변환
+//  8을    -> 80바이트로 변환 해주는 기능 수행
 struct AllocationLengthMapConverter {
-	template <Int32 Size, Int32 Index = 0>
+	// size - 1이 (2^k, 2^(k+1)] 구간의 몇번째 4등분에 드는지 계산한다.
+	//  k = 가장 높은 1 비트 위치 (32보다 작으면 5로 보고 8바이트 간격을 그대로 이어간다)
+	//  인덱스 = (k - 5) * 4 + ((size - 1) >> (k - 2))		// 두번째 항은 구간 안에서 4 ~ 7 (k = 5 미만이면 0 ~ 3)
+	// 0바이트는 1바이트로 취급한다.
+	static constexpr int CalculateIndex(Int32 size) {
+		const Int64U uiLast = Int64U(size + (size == 0)) - 1;
+		const int iShift = 63 - CountLeadingZero64(uiLast | (Int64U(1) << SizeClassFirstGroupShift_v));
+		return ((iShift - SizeClassFirstGroupShift_v) << SizeClassGroupBits_v) + int(uiLast >> (iShift - SizeClassGroupBits_v));
+	}
+
+	template <Int32 Size>
 	static constexpr int ToIndex() {
-		static_assert(Index >= 0 && Index < MemoryBlockSizeMapSize_v, "... cannot find valid index [AllocationLengthMapConverter]");
-		if constexpr (Size <= MemoryBlockSizeMap_v[Index])
-			return Index;
-		else
-			return ToIndex<Size, Index + 1>();
+		static_assert(Size >= 0 && Size <= MemoryBlockSizeMax_v, "... cannot find valid index [AllocationLengthMapConverter]");
+		return CalculateIndex(Size);
 	}
 
 
@@ -53,9 +91,8 @@ struct AllocationLengthMapConverter {
 	}
 
 	static int ToIndex(Int32 size) {
-		int iIndex = Arrays::LowerBound(Detail::MemoryBlockSizeMap_v, size);
-		DebugAssertMsg(iIndex >= 0 && iIndex < MemoryBlockSizeMapSize_v, "전달한 Size로 할당가능한 사이즈에 맞는 풀이 없어요");
-		return iIndex;
+		DebugAssertMsg(size >= 0 && size <= MemoryBlockSizeMax_v, "전달한 Size로 할당가능한 사이즈에 맞는 풀이 없어요 (%d바이트)", size);
+		return CalculateIndex(size);
 	}
 
 	static int ToSize(Int32 index) {
@@ -63,26 +100,16 @@ struct AllocationLengthMapConverter {
 		return Detail::MemoryBlockSizeMap_v[index];
 	}
 
-	// Set Bit 계산
+	// 블록 크기와 정확히 같은지
 	template <Int32 Size>
 	static constexpr bool ValidateSize() {
 		static_assert(Size > 0, "... Size must be greater than 0");
-		int size = Size;
-		int cnt = 0;
-		while (true) {
-			if ((size & 1) == 1) ++cnt;
-			size >>= 1;
-			if (size == 0) break;
-		}
-
-		if (cnt == 1) return true;
-		return false;
+		return Size <= MemoryBlockSizeMax_v && ToSize<CalculateIndex(Size)>() == Size;
 	}
 
-	// 런타임에는 성능이 중요하니 내장함수를 사용하자.
 	static bool ValidateSize(Int32 size) {
 		DebugAssertMsg(size > 0, "사이즈가 0보다는 무조건 커야돼요");
-		return __popcnt(size) == 1;
+		return size > 0 && size <= MemoryBlockSizeMax_v && MemoryBlockSizeMap_v[CalculateIndex(size)] == size;
 	}
 };
 
@@ -24,21 +24,29 @@ public:
 	Int64U GetTotalAllocated() { return m_uiInitAllocted + m_uiNewAlloctaed; }	// 메모리풀이 관리중인 메모리 크기
 	Int64U GetTotalUsed() { return m_uiTotalUsed; }
 	Int64U GetTotalReturned() { return m_uiTotalReturned; }
+	Int64U GetTotalRequested() { return m_uiTotalRequested; }
+	Int64U GetTotalWasted() { return m_uiTotalUsed - m_uiTotalRequested; }		// 요청 크기보다 큰 블록을 주느라 버려진 바이트 수 (누적)
+
+	// 내부 단편화 비율: 사용된 블록 바이트 중 요청하지 않은 바이트의 비율
+	double GetWasteRatio() { return m_uiTotalUsed == 0 ? 0.0 : double(GetTotalWasted()) / double(m_uiTotalUsed); }
 
 	int GetBlockTotalCounter(int blockIndex) { return m_pBlockTotalCounter[blockIndex]; }
 	int GetBlockUsedCounter(int blockIndex) { return m_pBlockUsedCounter[blockIndex]; }
 	int GetBlockNewAllocCounter(int blockIndex) { return m_pBlockNewAllocCounter[blockIndex]; }
 	int GetBlockUsingCounter(int blockIndex) { return m_pBlockUsingCounter[blockIndex]; }
+	Int64U GetBlockWasted(int blockIndex) { return m_pBlockWasted[blockIndex]; }
 protected:
 	void AddInitBlock(Int32 blockIndex, Int32 blockCount) {
 		m_uiInitAllocted += static_cast<Int64U>(Detail::AllocationLengthMapConverter::ToSize(blockIndex)) * blockCount;
 		m_pBlockTotalCounter[blockIndex] += blockCount;
 	}
 
-	void AddAllocated(Int32 blockIndex, bool createNew) {
+	void AddAllocated(Int32 blockIndex, bool createNew, Int32 requestSize) {
 		int iSize = Detail::AllocationLengthMapConverter::ToSize(blockIndex);
 
 		m_uiTotalUsed += iSize;
+		m_uiTotalRequested += requestSize;
+		m_pBlockWasted[blockIndex] += iSize - requestSize;
 
 		if (createNew) {
 			m_uiNewAlloctaed += iSize;
@@ -61,11 +69,13 @@ protected:
 		m_uiNewAlloctaed = 0;
 		m_uiTotalUsed = 0;
 		m_uiTotalReturned = 0;
+		m_uiTotalRequested = 0;
 
 		Arrays::Fill(m_pBlockTotalCounter, 0);
 		Arrays::Fill(m_pBlockUsedCounter, 0);
 		Arrays::Fill(m_pBlockNewAllocCounter, 0);
 		Arrays::Fill(m_pBlockUsingCounter, 0);
+		Arrays::Fill(m_pBlockWasted, Int64U(0));
 	}
 
 	// 현재 사용중인 블록이 있는지
@@ -75,11 +85,13 @@ protected:
 	Int64U m_uiNewAlloctaed{};		//	MemoryPool::Initialize()때 할당된 메모리외에! 추가로 새로 할당된 메모리양 (누적)
 	Int64U m_uiTotalUsed{};			//	메모리풀을 얼마나 사용했는지
 	Int64U m_uiTotalReturned{};		//  메모리풀로 얼마나 반환되었는지
+	Int64U m_uiTotalRequested{};	//	사용자가 실제로 요청한 메모리양 (m_uiTotalUsed와의 차이가 내부 단편화)
 
 	int m_pBlockTotalCounter[Detail::MemoryBlockSizeMapSize_v]{};			// 블록 종류별로 현재 몇개가 있는지 기록
 	int m_pBlockUsedCounter[Detail::MemoryBlockSizeMapSize_v]{};			// 블록 종류별로 몇번 사용되었는지
 	int m_pBlockNewAllocCounter[Detail::MemoryBlockSizeMapSize_v]{};		// 블록 종류별로 몇번 생성 할당되었는지 기록
 	int m_pBlockUsingCounter[Detail::MemoryBlockSizeMapSize_v]{};			// 블록 종류별로 사용중인 블록 수 기록
+	Int64U m_pBlockWasted[Detail::MemoryBlockSizeMapSize_v]{};				// 블록 종류별로 요청보다 크게 줘서 버려진 바이트 수 (누적)
 
 	friend class MemoryPoolAbstract;
 };
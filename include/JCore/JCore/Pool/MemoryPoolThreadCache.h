@@ -0,0 +1,260 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 메모리풀 쓰레드 캐시 (매거진)
+ * MemoryChunckQueue는 Push/Pop마다 머리 포인터에 CAS를 하므로 여러 쓰레드가 같은 풀을 쓰면 그 캐시라인을 서로 빼앗으며 느려진다.
+ * 쓰레드마다 블록 크기별로 작은 청크 스택(매거진)을 두고 대부분의 Push/Pop을 여기서 끝낸다.
+ *
+ *  - Pop: 매거진이 비었으면 공유 큐에서 용량의 절반을 한번에 가져온다.
+ *  - Push: 매거진이 꽉 찼으면 오래된 절반을 공유 큐로 한번에 돌려보내고 최근에 쓴 청크는 남긴다.
+ *  - 쓰레드 번호: 쓰레드마다 0 ~ MaxThreadCount - 1 번호를 하나씩 받아서 매거진 묶음을 찾는다.
+ *                 번호가 모자라면 그 쓰레드는 캐시 없이 공유 큐를 바로 쓴다.
+ *  - 쓰레드 종료: 살아있는 모든 쓰레드 캐시에서 그 번호의 매거진을 공유 큐로 비운 후 번호를 반납한다.
+ *                 끝난 쓰레드의 청크가 다음 쓰레드가 올 때까지 (최대 풀마다 크기별 MaxMagazineBytes) 묶여있지 않도록 한다.
+ *
+ * 한 매거진에 MaxMagazineBytes를 넘게 담지 않으므로 큰 블록은 캐시하지 않는다.
+ * Flush와 SetEnabled는 다른 쓰레드가 풀을 쓰지 않을 때만 호출해야 한다.
+ * 풀을 쓴 쓰레드가 끝나는 중에 (thread_local 소멸) 그 풀을 파괴해서도 안된다.
+ */
+
+#pragma once
+
+#include <JCore/Primitives/Atomic.h>
+#include <JCore/Sync/SpinLock.h>
+#include <JCore/Pool/MemoryChuckQueue.h>
+#include <JCore/Pool/MemoryPoolDetail.h>
+
+NS_JC_BEGIN
+
+class MemoryPoolThreadCache;
+
+NS_DETAIL_BEGIN
+
+inline constexpr int ThreadCacheMaxThreadCount_v = 64;
+inline Atomic<bool> ThreadCacheSlotInUse_v[ThreadCacheMaxThreadCount_v];
+
+struct ThreadCacheSlot
+{
+	ThreadCacheSlot() : Index(-1) {
+		for (int i = 0; i < ThreadCacheMaxThreadCount_v; ++i) {
+			if (ThreadCacheSlotInUse_v[i].TryCompareExchange(false, true)) {
+				Index = i;
+				break;
+			}
+		}
+	}
+
+	~ThreadCacheSlot();
+
+	int Index;		// 사용중인 번호 (-1: 번호가 모자라서 캐시를 쓰지 않음)
+};
+
+inline thread_local ThreadCacheSlot ThreadCacheSlot_v;
+
+// 쓰레드가 끝날 때 매거진을 비울 수 있도록 살아있는 쓰레드 캐시를 모두 연결해둔다.
+inline SpinLock ThreadCacheRegistryLock_v;
+inline MemoryPoolThreadCache* ThreadCacheRegistryHead_v = nullptr;
+
+NS_DETAIL_END
+
+class MemoryPoolThreadCache
+{
+public:
+	static constexpr int MaxThreadCount = Detail::ThreadCacheMaxThreadCount_v;
+	static constexpr int MaxMagazineCapacity = 64;			// 매거진 하나에 담는 최대 청크 수
+	static constexpr int MinMagazineCapacity = 4;			// 이보다 적게 담기는 큰 블록은 캐시하지 않는다.
+	static constexpr int MaxMagazineBytes = 64 * 1024;		// 매거진 하나에 담는 최대 바이트 수
+
+	MemoryPoolThreadCache() : m_bEnabled(false), m_pMagazineSets{}, m_pPrev(nullptr), m_pNext(nullptr) {
+		SpinLockGuard guard(Detail::ThreadCacheRegistryLock_v);
+		m_pNext = Detail::ThreadCacheRegistryHead_v;
+		if (m_pNext) m_pNext->m_pPrev = this;
+		Detail::ThreadCacheRegistryHead_v = this;
+	}
+
+	MemoryPoolThreadCache(const MemoryPoolThreadCache&) = delete;
+	~MemoryPoolThreadCache() {
+		{
+			// 끝나는 쓰레드가 이 캐시를 비우는 중이면 끝날 때까지 기다린다.
+			SpinLockGuard guard(Detail::ThreadCacheRegistryLock_v);
+			if (m_pPrev) m_pPrev->m_pNext = m_pNext;
+			else Detail::ThreadCacheRegistryHead_v = m_pNext;
+			if (m_pNext) m_pNext->m_pPrev = m_pPrev;
+		}
+
+		for (int i = 0; i < MaxThreadCount; ++i) {
+			JCORE_DELETE_SAFE(m_pMagazineSets[i]);
+		}
+	}
+
+	MemoryPoolThreadCache& operator=(const MemoryPoolThreadCache&) = delete;
+
+	// 끌 때는 모든 매거진을 비운다.
+	void SetEnabled(bool enabled) {
+		if (!enabled) Flush();
+		m_bEnabled = enabled;
+	}
+
+	bool IsEnabled() const { return m_bEnabled; }
+
+	// classIndex는 queue의 블록 크기 인덱스 (AllocationLengthMapConverter::ToIndex)
+	void* Pop(MemoryChunckQueue* queue, int classIndex, JCORE_OUT bool& newAlloc) {
+		Magazine* pMagazine = FindMagazine(queue, classIndex);
+
+		if (pMagazine == nullptr) {
+			return queue->Pop(newAlloc);
+		}
+
+		if (pMagazine->Count == 0) {
+			const int iRefillCount = pMagazine->Capacity / 2;
+			pMagazine->NewAllocCount = queue->PopBatch(pMagazine->Chunks, iRefillCount);
+			pMagazine->Count = iRefillCount;
+		}
+
+		newAlloc = pMagazine->NewAllocCount > 0;
+		if (newAlloc) --pMagazine->NewAllocCount;
+		return pMagazine->Chunks[--pMagazine->Count];
+	}
+
+	void Push(MemoryChunckQueue* queue, int classIndex, void* chunk) {
+		Magazine* pMagazine = FindMagazine(queue, classIndex);
+
+		if (pMagazine == nullptr) {
+			queue->Push(chunk);
+			return;
+		}
+
+		if (pMagazine->Count == pMagazine->Capacity) {
+			const int iFlushCount = pMagazine->Capacity / 2;
+			queue->PushBatch(pMagazine->Chunks, iFlushCount);
+			pMagazine->Count -= iFlushCount;
+			Memory::CopyUnsafe(pMagazine->Chunks, pMagazine->Chunks + iFlushCount, sizeof(void*) * pMagazine->Count);
+
+			if (pMagazine->NewAllocCount > pMagazine->Count) {
+				pMagazine->NewAllocCount = pMagazine->Count;
+			}
+		}
+
+		pMagazine->Chunks[pMagazine->Count++] = chunk;
+	}
+
+	// 모든 쓰레드의 매거진에 남은 청크를 공유 큐로 돌려보낸다.
+	// 풀이 공유 큐를 지우거나 새로 만들기 전에 호출해야 한다.
+	void Flush() {
+		for (int i = 0; i < MaxThreadCount; ++i) {
+			FlushSlot(i);
+		}
+	}
+
+	// 매거진에 담겨있는 청크 수 (다른 쓰레드가 쓰는 중이면 정확하지 않다)
+	int CachedCount() const {
+		int iCount = 0;
+		for (int i = 0; i < MaxThreadCount; ++i) {
+			const MagazineSet* pSet = m_pMagazineSets[i];
+			if (pSet == nullptr) continue;
+
+			for (int j = 0; j < Detail::MemoryBlockSizeMapSize_v; ++j) {
+				iCount += pSet->Magazines[j].Count;
+			}
+		}
+		return iCount;
+	}
+private:
+	struct Magazine
+	{
+		MemoryChunckQueue* Queue;	// 처음 쓸 때 정해진다.
+		int Capacity;				// 0이면 캐시하지 않는 크기
+		int Count;
+		int NewAllocCount;			// Chunks 중 공유 큐가 새로 할당해서 준 청크 수 (통계용)
+		void* Chunks[MaxMagazineCapacity];
+	};
+
+	// 쓰레드 하나가 쓰는 매거진 묶음. 다른 쓰레드의 묶음과 캐시라인을 나눠 쓰지 않도록 한다.
+	struct alignas(64) MagazineSet
+	{
+		Magazine Magazines[Detail::MemoryBlockSizeMapSize_v];
+	};
+
+	// slot 번호의 매거진만 비운다. 그 번호를 가진 쓰레드 또는 Flush에서만 호출한다.
+	void FlushSlot(int slot) {
+		MagazineSet* pSet = m_pMagazineSets[slot];
+		if (pSet == nullptr) return;
+
+		for (int j = 0; j < Detail::MemoryBlockSizeMapSize_v; ++j) {
+			Magazine& magazine = pSet->Magazines[j];
+			if (magazine.Count > 0) {
+				magazine.Queue->PushBatch(magazine.Chunks, magazine.Count);
+			}
+
+			// 풀이 큐를 새로 만들 수도 있으므로 다음에 쓸 때 다시 연결한다.
+			magazine.Queue = nullptr;
+			magazine.Count = 0;
+			magazine.NewAllocCount = 0;
+		}
+	}
+
+	Magazine* FindMagazine(MemoryChunckQueue* queue, int classIndex) {
+		if (!m_bEnabled) {
+			return nullptr;
+		}
+
+		const int iSlot = Detail::ThreadCacheSlot_v.Index;
+		if (iSlot < 0) {
+			return nullptr;
+		}
+
+		// 묶음은 그 번호를 가진 쓰레드만 만들고 쓰므로 락이 필요없다.
+		MagazineSet* pSet = m_pMagazineSets[iSlot];
+		if (pSet == nullptr) {
+			pSet = dbg_new MagazineSet{};
+			m_pMagazineSets[iSlot] = pSet;
+		}
+
+		Magazine& magazine = pSet->Magazines[classIndex];
+		if (magazine.Queue == nullptr) {
+			magazine.Queue = queue;
+			magazine.Capacity = CalculateCapacity(queue->ChunkSize());
+		}
+
+		return magazine.Capacity > 0 ? &magazine : nullptr;
+	}
+
+	static int CalculateCapacity(int chunkSize) {
+		const int iCapacity = MaxMagazineBytes / chunkSize;
+
+		if (iCapacity < MinMagazineCapacity) return 0;
+		if (iCapacity > MaxMagazineCapacity) return MaxMagazineCapacity;
+		return iCapacity;
+	}
+private:
+	bool m_bEnabled;
+	MagazineSet* m_pMagazineSets[MaxThreadCount];
+
+	// Detail::ThreadCacheRegistryHead_v 목록
+	MemoryPoolThreadCache* m_pPrev;
+	MemoryPoolThreadCache* m_pNext;
+
+	friend struct Detail::ThreadCacheSlot;
+};
+
+NS_DETAIL_BEGIN
+
+inline ThreadCacheSlot::~ThreadCacheSlot() {
+	if (Index < 0) {
+		return;
+	}
+
+	// 번호를 반납하기 전에 비워야 같은 번호를 받은 새 쓰레드와 매거진을 동시에 건드리지 않는다.
+	{
+		SpinLockGuard guard(ThreadCacheRegistryLock_v);
+		for (MemoryPoolThreadCache* pCache = ThreadCacheRegistryHead_v; pCache != nullptr; pCache = pCache->m_pNext) {
+			pCache->FlushSlot(Index);
+		}
+	}
+
+	ThreadCacheSlotInUse_v[Index].Store(false);
+}
+
+NS_DETAIL_END
+
+NS_JC_END
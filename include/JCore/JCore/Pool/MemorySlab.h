@@ -0,0 +1,138 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * 메모리풀 슬랩
+ * MemoryChunckQueue가 비었을 때 청크를 하나씩 할당하지 않고 큰 페이지(슬랩) 하나를 운영체제에서 받아서 여러 청크로 나눈다.
+ *  - 시스템 할당 횟수가 청크 수가 아닌 슬랩 수만큼으로 줄어든다.
+ *  - 같은 크기의 청크가 연속된 주소에 모여 있으므로 캐시/TLB 효율이 좋다.
+ *  - 청크가 전부 반환된 슬랩은 통째로 운영체제에 돌려줄 수 있다. (MemoryChunckQueue::ReleaseEmptySlabs)
+ *
+ * 슬랩 크기가 HugePageSize의 배수이면 2MB 큰 페이지를 먼저 시도한다.
+ *  - 윈도우: MEM_LARGE_PAGES (메모리 잠금 권한이 있어야 한다)
+ *  - 그 외: MAP_HUGETLB (예약된 큰 페이지가 있어야 한다), 실패하면 2MB 정렬 후 투명 큰 페이지(MADV_HUGEPAGE)를 요청한다.
+ * 미리 빌드된 JCore.lib에 없는 기능이라 헤더에 플랫폼별로 모두 구현한다.
+ */
+
+#pragma once
+
+#include <JCore/Core.h>
+#include <JCore/Exception.h>
+#include <JCore/Primitives/StringUtil.h>
+
+#if JCORE_PLATFORM_POSIX
+	#include <sys/mman.h>
+#endif
+
+NS_JC_BEGIN
+
+// 크기 단위(청크 크기)마다 슬랩을 얼마나 크게 할당할지
+// 첫 슬랩은 InitialSlabBytes이고 새로 할당할 때마다 GrowthFactor배씩 MaxSlabBytes까지 키운다.
+// 청크 하나가 MaxSlabBytes보다 크면 슬랩 하나에 청크 하나만 담는다.
+struct MemorySlabPolicy
+{
+	static constexpr int DefaultInitialSlabBytes = 64 * 1024;
+	static constexpr int DefaultMaxSlabBytes = 2 * 1024 * 1024;
+	static constexpr int DefaultGrowthFactor = 2;
+
+	int InitialSlabBytes = DefaultInitialSlabBytes;		// 0이면 슬랩을 쓰지 않고 청크를 하나씩 할당한다.
+	int MaxSlabBytes = DefaultMaxSlabBytes;
+	int GrowthFactor = DefaultGrowthFactor;
+
+	bool IsSlabDisabled() const { return InitialSlabBytes <= 0; }
+};
+
+NS_DETAIL_BEGIN
+
+// 슬랩의 맨 앞에 두는 머리. 청크는 그 뒤(SlabHeaderSize)부터 나눈다.
+struct MemorySlab
+{
+	MemorySlab* Next;
+	Size_t Bytes;			// 머리를 포함한 슬랩 전체 크기
+	int ChunkCount;
+	int FreeCount;			// ReleaseEmptySlabs 중에만 쓴다.
+	bool HugePage;
+};
+
+inline constexpr int SlabHeaderSize_v = 64;		// 첫 청크가 캐시라인에 맞춰지도록 머리를 64바이트로 잡는다.
+static_assert(sizeof(MemorySlab) <= SlabHeaderSize_v, "MemorySlab 머리가 너무 큽니다.");
+
+NS_DETAIL_END
+
+class MemoryPage final
+{
+public:
+	static constexpr Size_t PageSize = 4096;
+	static constexpr Size_t HugePageSize = 2 * 1024 * 1024;
+
+	static constexpr Size_t RoundUp(Size_t bytes, Size_t unit) {
+		return (bytes + unit - 1) / unit * unit;
+	}
+
+	// bytes는 PageSize의 배수여야 한다. 실패하면 RuntimeException을 던진다.
+	static void* Allocate(Size_t bytes, JCORE_OUT bool& hugePage) {
+		hugePage = false;
+
+	#if JCORE_PLATFORM_WINDOWS
+		const Size_t uiLargePageSize = GetLargePageMinimum();
+		if (uiLargePageSize > 0 && bytes % uiLargePageSize == 0) {
+			void* pHuge = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (pHuge != nullptr) {
+				hugePage = true;
+				return pHuge;
+			}
+		}
+
+		void* pMemory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (pMemory == nullptr) {
+			throw RuntimeException(StringUtil::Format("슬랩 페이지를 할당하지 못했습니다. (%llu바이트)", Int64U(bytes)));
+		}
+		return pMemory;
+	#else
+		if (bytes % HugePageSize != 0) {
+			return Map(bytes);
+		}
+
+	#ifdef MAP_HUGETLB
+		void* pHuge = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (pHuge != MAP_FAILED) {
+			hugePage = true;
+			return pHuge;
+		}
+	#endif
+
+		// 2MB 경계에 맞춰야 투명 큰 페이지로 바뀔 수 있으므로 넉넉히 받아서 앞뒤를 잘라낸다.
+		Byte* pReserved = static_cast<Byte*>(Map(bytes + HugePageSize));
+		Byte* pAligned = reinterpret_cast<Byte*>(RoundUp(Size_t(IntPtr(pReserved)), HugePageSize));
+		const Size_t uiHead = Size_t(pAligned - pReserved);
+		const Size_t uiTail = HugePageSize - uiHead;
+
+		if (uiHead > 0) munmap(pReserved, uiHead);
+		if (uiTail > 0) munmap(pAligned + bytes, uiTail);
+
+	#ifdef MADV_HUGEPAGE
+		madvise(pAligned, bytes, MADV_HUGEPAGE);
+	#endif
+		return pAligned;
+	#endif
+	}
+
+	static void Deallocate(void* memory, Size_t bytes) {
+	#if JCORE_PLATFORM_WINDOWS
+		VirtualFree(memory, 0, MEM_RELEASE);
+	#else
+		munmap(memory, bytes);
+	#endif
+	}
+private:
+#if JCORE_PLATFORM_POSIX
+	static void* Map(Size_t bytes) {
+		void* pMemory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (pMemory == MAP_FAILED) {
+			throw RuntimeException(StringUtil::Format("슬랩 페이지를 할당하지 못했습니다. (%llu바이트)", Int64U(bytes)));
+		}
+		return pMemory;
+	}
+#endif
+};
+
+NS_JC_END
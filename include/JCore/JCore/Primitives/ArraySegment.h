@@ -27,6 +27,9 @@ public:
 		DebugAssertMsg(idx >= 0 && idx < m_iLen, "세그먼트의 인덱스 범위가 이상합니다.");
 		return m_pRawArray[idx];
 	}
+
+	T* Source() const { return m_pRawArray; }
+	int Length() const { return m_iLen; }
 private:
 	T* m_pRawArray;
 	int m_iLen;
@@ -15,6 +15,8 @@
 #include <JCore/TypeTraits.h>
 #include <JCore/Wrapper/WinApi.h>
 
+#include <atomic>
+
 NS_JC_BEGIN
 
 template <typename T>
@@ -32,6 +34,10 @@ public:
     void Store(T operand) { Exchange(operand); }
     T Load() { return TInterlocked::Read(&m_Value); }
 
+    // Interlocked를 거치지 않는 읽기 (Load는 Add(0)이라 캐시라인을 쓰기 상태로 만든다)
+    // 여러 쓰레드가 같은 값을 계속 읽기만 하는 경우에 사용
+    T LoadAcquire() { return std::atomic_ref<T>(m_Value).load(std::memory_order_acquire); }
+
     T Add(T operand) { return TInterlocked::Add(&m_Value, operand); }
 
     bool TryCompareExchange(T expected, T desired) { return CompareExchange(expected, desired); }
@@ -113,6 +119,7 @@ public:
     void Store(U operand) { Exchange(operand); }
 
     T* Load() { return TInterlocked::Read(&m_Value); }
+    T* LoadAcquire() { return std::atomic_ref<T*>(m_Value).load(std::memory_order_acquire); }
     T* Add(int operand) {  return TInterlocked::Add(&m_Value, operand); }
 
     template <typename U, DefaultEnableIf_t<IsConvertible_v<U, T*>> = nullptr>
@@ -36,6 +36,7 @@ class VoidWatcher;
 struct VoidPointerCounter {
 	bool Alive = true;
 	int Counter = 1;
+	void(*Deleter)(void*) = nullptr;	// 오너가 해제될 때 포인터를 원래 타입으로 지운다. (void*로 지우면 소멸자가 호출되지 않는다)
 };
 
 /*=====================================================================================
@@ -79,8 +80,8 @@ protected:
 			return;
 		}
 
-		if (!m_bNoDelete) {
-			JCORE_DELETE_SAFE(m_pPointer);
+		if (!m_bNoDelete && m_pCounter->Deleter) {
+			m_pCounter->Deleter(m_pPointer);
 		}
 
 		m_pPointer = nullptr;
@@ -133,10 +134,18 @@ class VoidOwner : public VoidBase
 {
 	friend class VoidWatcher;
 public:
-	VoidOwner(void* ptr, bool nodelete = false) {
-		m_pPointer = ptr;
+	// 지울 때 필요한 타입을 받아둔다. void*는 지울 수 없으므로 nodelete로만 넘길 수 있다.
+	template <typename T>
+	VoidOwner(T* ptr, bool nodelete = false) {
+		m_pPointer = (void*)ptr;
 		m_pCounter = dbg_new VoidPointerCounter();
 		m_bNoDelete = nodelete;
+
+		if constexpr (IsVoidType_v<T>) {
+			DebugAssertMsg(nodelete, "void* 포인터는 지울 수 없습니다. 타입이 있는 포인터를 넘겨주세요.");
+		} else {
+			m_pCounter->Deleter = [](void* pointer) { delete static_cast<T*>(pointer); };
+		}
 	}
 
 	VoidOwner(const VoidOwner&) = delete;
@@ -224,7 +233,7 @@ public:
 
 struct JCORE_NOVTABLE PtrCounter
 {
-	virtual void DestroyObject() = 0;
+	virtual void DestroyObject() {}	// Owner(T*)처럼 오브젝트 없이 카운터만 쓰는 경우도 있으므로 순수 가상함수로 두지 않는다.
 
 	bool Alive = true;
 	int Counter = 1;
@@ -472,7 +481,7 @@ class Owner : public Base<T>
 	using TOwner		= Owner<T>;
 	using TWatcher		= Watcher<T>;
 
-	friend class TWatcher;
+	friend TWatcher;
 
 
 public:
@@ -523,9 +532,9 @@ public:
 	template <typename U>
 	void MoveToOwner(Owner<U>& owner) {
 		if constexpr (Detail::IsStaticCastable<T, U>()) {
-			this->OwnerMoveToOwner<U, TBase::Cast::StaticCastable>(owner);
+			this->template OwnerMoveToOwner<U, TBase::Cast::StaticCastable>(owner);
 		} else if constexpr (Detail::IsDynamicCastable<T, U>()) {
-			this->OwnerMoveToOwner<U, TBase::Cast::DynamicCastable>(owner);
+			this->template OwnerMoveToOwner<U, TBase::Cast::DynamicCastable>(owner);
 		} else {
 			DebugAssertMsg(false, "... cannot convert each other"); // static_assert(false, "cannot convert each other");
 		}
@@ -541,7 +550,7 @@ class Watcher : public Base<T>
 	using TOwner		= Owner<T>;
 	using TWatcher		= Watcher<T>;
 
-	friend class TOwner;
+	friend TOwner;
 public:
 	Watcher() {}
 	Watcher(std::nullptr_t) {}
@@ -599,9 +608,9 @@ public:
 	template <typename U>
 	void CopyToOwner(Owner<U>& owner) {
 		if constexpr (Detail::IsStaticCastable<T, U>()) {
-			this->WatcherCopyToOwner<U, TBase::Cast::StaticCastable>(owner);
+			this->template WatcherCopyToOwner<U, TBase::Cast::StaticCastable>(owner);
 		} else if constexpr (Detail::IsDynamicCastable<T, U>()) {
-			this->WatcherCopyToOwner<U, TBase::Cast::DynamicCastable>(owner);
+			this->template WatcherCopyToOwner<U, TBase::Cast::DynamicCastable>(owner);
 		} else {
 			DebugAssertMsg(false, "... cannot convert each other"); //static_assert(false, "cannot convert each other");
 		}
@@ -615,9 +624,9 @@ public:
 		}
 
 		if constexpr (Detail::IsStaticCastable<T, U>()) {
-			this->WatcherCopyToWatcher<U, TBase::Cast::StaticCastable>(watcher);
+			this->template WatcherCopyToWatcher<U, TBase::Cast::StaticCastable>(watcher);
 		} else if constexpr (Detail::IsDynamicCastable<T, U>()) {
-			this->WatcherCopyToWatcher<U, TBase::Cast::DynamicCastable>(watcher);
+			this->template WatcherCopyToWatcher<U, TBase::Cast::DynamicCastable>(watcher);
 		} else {
 			DebugAssertMsg(false, "... cannot convert each other");
 		}
@@ -631,9 +640,9 @@ public:
 		}
 
 		if constexpr (Detail::IsStaticCastable<T, U>()) {
-			this->WatcherMoveToWatcher<U, TBase::Cast::StaticCastable>(watcher);
+			this->template WatcherMoveToWatcher<U, TBase::Cast::StaticCastable>(watcher);
 		} else if constexpr (Detail::IsDynamicCastable<T, U>()) {
-			this->WatcherMoveToWatcher<U, TBase::Cast::DynamicCastable>(watcher);
+			this->template WatcherMoveToWatcher<U, TBase::Cast::DynamicCastable>(watcher);
 		} else {
 			DebugAssertMsg(false, "... cannot convert each other");
 		}
@@ -99,7 +99,7 @@ public:
 		char* pSrc = (char*)src;
 		char* pDst = (char*)dst;
 
-		while (*pDst != NULL && *pSrc != NULL) {
+		while (*pDst != '\0' && *pSrc != '\0') {
 			if (*pDst > *pSrc)
 				return -1;
 			else if (*pDst < *pSrc)
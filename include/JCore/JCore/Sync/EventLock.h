@@ -37,6 +37,6 @@ private:
 };
 
 using EventLockGuard = LockGuard<EventLock>;
-extern template         LockGuard<EventLock>;
+extern template class         LockGuard<EventLock>;
 
 NS_JC_END;
@@ -11,6 +11,10 @@
 #include <JCore/Primitives/Atomic.h>
 #include <JCore/Wrapper/WinApi.h>
 
+#if JCORE_PLATFORM_POSIX
+#include <pthread.h>
+#endif
+
 NS_JC_BEGIN
 
 class NormalLock final : public ILock
@@ -26,7 +30,11 @@ public:
 	bool TryLock() override;
 	bool IsLocked() override;
 private:
+#if JCORE_PLATFORM_WINDOWS
 	WinApi::CriticalSection m_CriticalSection;
+#else
+	pthread_mutex_t m_Mutex;
+#endif
 	Atomic<int> m_hOwnThread;
 };
 
@@ -37,6 +45,6 @@ private:
 // 학습 내용 : https://blog.naver.com/wjdeh313/222622599396
 
 using NormalLockGuard = LockGuard<NormalLock>;
-extern template         LockGuard<NormalLock>;
+extern template class         LockGuard<NormalLock>;
 
 NS_JC_END
@@ -39,8 +39,8 @@ private:
 using NormalWriteLockGuard = RwLockGuard<NormalRwLock, RwLockMode::Write>;
 using NormalReadLockGuard = RwLockGuard<NormalRwLock, RwLockMode::Read>;
 
-extern template NormalWriteLockGuard;
-extern template NormalReadLockGuard;
+extern template class RwLockGuard<NormalRwLock, RwLockMode::Write>;
+extern template class RwLockGuard<NormalRwLock, RwLockMode::Read>;
 
 NS_JC_END
 
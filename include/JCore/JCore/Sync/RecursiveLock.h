@@ -30,6 +30,6 @@ private:
 };
 
 using RecursiveLockGuard = LockGuard<RecursiveLock>;
-extern template            LockGuard<RecursiveLock>;
+extern template class            LockGuard<RecursiveLock>;
 
 NS_JC_END
@@ -37,6 +37,6 @@ private:
 };
 
 using SemaphoreGuard =  LockGuard<Semaphore>;
-extern template         LockGuard<Semaphore>;
+extern template class         LockGuard<Semaphore>;
 
 NS_JC_END
\ No newline at end of file
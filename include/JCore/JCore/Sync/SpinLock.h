@@ -29,6 +29,6 @@ private:
 };
 
 using SpinLockGuard = LockGuard<SpinLock>;
-extern template       LockGuard<SpinLock>;
+extern template class       LockGuard<SpinLock>;
 
 NS_JC_END
\ No newline at end of file
@@ -30,7 +30,7 @@ bool IsLocked() override { return false; }
 };
 
 using UnusedLockGuard = LockGuard<UnusedLock>;
-extern template         LockGuard<UnusedLock>;
+extern template class         LockGuard<UnusedLock>;
 
 NS_JC_END;
 
@@ -22,7 +22,7 @@ using LDouble	= long double;
 using Byte		= unsigned char;
 using WideChar	= wchar_t;
 
-#ifdef _WIN64
+#if defined(_WIN64) || defined(__LP64__)
 using IntPtr = Int64;
 using Size_t = unsigned long long;
 #else
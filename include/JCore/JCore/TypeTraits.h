@@ -174,7 +174,7 @@ NS_JC_BEGIN
     //      __End__> = 6
     template <typename FirstParameterPack, typename... RestParameterPacks>
     struct ParameterPackCountOf {
-        static constexpr int Count = FirstParameterPack::Count + ParameterPackCountOf<RestParameterPacks>::Count;
+        static constexpr int Count = FirstParameterPack::Count + ParameterPackCountOf<RestParameterPacks...>::Count;
     };
 
     template <>
@@ -30,7 +30,7 @@ struct WinApi {
     struct CriticalSectionDebug {
         Int16       Type;
         Int16       CreatorBackTraceIndex;
-        CriticalSection* CriticalSection;
+        struct CriticalSection* CriticalSection;
         ListEntry   ProcessLocksList;
         Int32UL     EntryCount;
         Int32UL     ContentionCount;
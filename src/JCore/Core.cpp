@@ -0,0 +1,54 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 JCore 초기화 및 공용 함수 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Env.h>
+#include <JCore/Time.h>
+
+#include <cstdarg>
+#include <cstdlib>
+#include <ctime>
+
+NS_JC_BEGIN
+
+Int64 AppTime_v;
+
+NS_DETAIL_BEGIN
+
+static Int64 MonotonicMicroSeconds() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<Int64>(ts.tv_sec) * TicksPerSecond_v + ts.tv_nsec / 1000;
+}
+
+void InitializeJCore() {
+	AppTime_v = MonotonicMicroSeconds();
+	Console::Init();
+}
+
+void __DebugAssertMsgImpl(const char* filePath, int lineNum, const char* functionName, const char* fmt, ...) {
+	char szBuffer[1024];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(szBuffer, sizeof(szBuffer), fmt, args);
+	va_end(args);
+
+	fprintf(stderr, "[Assert] %s:%d (%s)\n%s\n", filePath, lineNum, functionName, szBuffer);
+	fflush(stderr);
+	abort();
+}
+
+NS_DETAIL_END
+
+TimeSpan Env::AppTime() {
+	return { Detail::MonotonicMicroSeconds() - AppTime_v };
+}
+
+TimeSpan Env::SystemTime() {
+	return { Detail::MonotonicMicroSeconds() };
+}
+
+NS_JC_END
@@ -0,0 +1,137 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 파일 유틸리티 구현
+ * 경로는 UTF-8 그대로 사용하므로 코드 페이지 변환은 하지 않는다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/FileSystem/File.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Exception.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+NS_JC_BEGIN
+
+namespace Detail {
+	// fopen 실패시 RuntimeException을 던진다. (FileStream과 동일)
+	inline FILE* OpenFileOrThrow(const char* path, const char* mode) {
+		FILE* pFile = fopen(path, mode);
+
+		if (pFile == nullptr) {
+			throw RuntimeException(StringUtil::Format("%s 파일을 열지 못했습니다. (errno: %d)", path, errno));
+		}
+
+		return pFile;
+	}
+}
+
+bool File::Exist(const char* path) {
+	struct stat info;
+	return stat(path, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+bool File::Exist(const String& path) {
+	return Exist(path.Source());
+}
+
+long File::Size(const char* path) {
+	struct stat info;
+
+	if (stat(path, &info) != 0) {
+		return -1;
+	}
+
+	return long(info.st_size);
+}
+
+long File::Size(const String& path) {
+	return Size(path.Source());
+}
+
+bool File::Delete(const char* path) {
+	return remove(path) == 0;
+}
+
+bool File::Delete(const String& path) {
+	return Delete(path.Source());
+}
+
+// rename은 같은 파일 시스템 안에서 dstPath를 원자적으로 교체한다.
+bool File::Move(const char* srcPath, const char* dstPath) {
+	return rename(srcPath, dstPath) == 0;
+}
+
+bool File::Move(const String& srcPath, const String& dstPath) {
+	return Move(srcPath.Source(), dstPath.Source());
+}
+
+bool File::Copy(const char* srcPath, const char* dstPath) {
+	FILE* pSrc = fopen(srcPath, "rb");
+	if (pSrc == nullptr) {
+		return false;
+	}
+
+	FILE* pDst = fopen(dstPath, "wb");
+	if (pDst == nullptr) {
+		fclose(pSrc);
+		return false;
+	}
+
+	char szBuffer[8192];
+	bool bSuccess = true;
+	size_t uiRead;
+
+	while ((uiRead = fread(szBuffer, 1, sizeof(szBuffer), pSrc)) > 0) {
+		if (fwrite(szBuffer, 1, uiRead, pDst) != uiRead) {
+			bSuccess = false;
+			break;
+		}
+	}
+
+	fclose(pSrc);
+	return fclose(pDst) == 0 && bSuccess;
+}
+
+bool File::Copy(const String& srcPath, const String& dstPath) {
+	return Copy(srcPath.Source(), dstPath.Source());
+}
+
+void File::WriteAllText(const char* content, const int contentLength, const char* path) {
+	WriteAllBytes(reinterpret_cast<const Byte*>(content), contentLength, path);
+}
+
+void File::WriteAllText(const String& content, const char* path) {
+	WriteAllText(content.Source(), content.Length(), path);
+}
+
+void File::WriteAllBytes(const Byte* content, const int contentLength, const char* path) {
+	FILE* pFile = Detail::OpenFileOrThrow(path, "wb");
+	fwrite(content, 1, contentLength, pFile);
+	fclose(pFile);
+}
+
+String File::ReadAllText(const char* path) {
+	FILE* pFile = Detail::OpenFileOrThrow(path, "rb");
+	String content;
+	char szBuffer[8192];
+	size_t uiRead;
+
+	while ((uiRead = fread(szBuffer, 1, sizeof(szBuffer) - 1, pFile)) > 0) {
+		szBuffer[uiRead] = '\0';
+		content.Append(szBuffer);
+	}
+
+	fclose(pFile);
+	return content;
+}
+
+void File::FormatFileMode(char* modeBuffer, const int modeBufferCapacity, const char* dfaultMode, CodePage) {
+	snprintf(modeBuffer, modeBufferCapacity, "%s", dfaultMode);
+}
+
+NS_JC_END
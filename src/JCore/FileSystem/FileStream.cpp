@@ -0,0 +1,122 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 파일 스트림 구현
+ * 파일 디스크립터를 IoHandle에 그대로 담는다. (닫힌 상태는 -1)
+ */
+
+#include <JCore/Core.h>
+#include <JCore/FileSystem/FileStream.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Exception.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+NS_JC_BEGIN
+
+namespace Detail {
+	inline int ToFileDescriptor(IoHandle handle) { return int(IntPtr(handle)); }
+	inline IoHandle ToIoHandle(int fd) { return reinterpret_cast<IoHandle>(IntPtr(fd)); }
+
+	inline int ToOpenFlags(FileAccess access, FileMode mode) {
+		int iFlags = access == eRead ? O_RDONLY : access == eWrite ? O_WRONLY : O_RDWR;
+
+		switch (mode) {
+		case eCreate: iFlags |= O_CREAT | O_TRUNC; break;
+		case eAppend: iFlags |= O_CREAT; break;
+		case eOpen:   break;
+		}
+
+		return iFlags;
+	}
+}
+
+FileStream::FileStream(const String& path, FileAccess access, FileMode mode)
+	: Stream(access != eRead, access != eWrite, true)
+	, m_eAccess(access)
+	, m_eMode(mode)
+{
+	const int iFd = open(path.Source(), Detail::ToOpenFlags(access, mode) | O_CLOEXEC, 0644);
+
+	if (iFd == -1) {
+		throw RuntimeException(StringUtil::Format("%s 파일을 열지 못했습니다. (errno: %d)", path.Source(), errno));
+	}
+
+	m_hHandle = Detail::ToIoHandle(iFd);
+	m_iLength = int(lseek(iFd, 0, SEEK_END));
+	m_iOffset = mode == eAppend ? m_iLength : int(lseek(iFd, 0, SEEK_SET));
+}
+
+FileStream::~FileStream() {
+	FileStream::Close();
+}
+
+int FileStream::Read(JCORE_OUT Byte* bytes, int offset, int len) {
+	DebugAssertMsg(CanRead(), "해당 스트림에 Read 할 수 없습니다.");
+	const int iFd = Detail::ToFileDescriptor(m_hHandle);
+	int iTotalRead = 0;
+
+	// 시그널 등으로 요청보다 적게 읽힐 수 있으므로 파일 끝이 아니면 끝까지 읽는다.
+	while (iTotalRead < len) {
+		const ssize_t iRead = read(iFd, bytes + offset + iTotalRead, len - iTotalRead);
+
+		if (iRead < 0 && errno == EINTR) continue;
+		if (iRead <= 0) break;
+
+		iTotalRead += int(iRead);
+	}
+
+	m_iOffset += iTotalRead;
+	return iTotalRead;
+}
+
+void FileStream::Write(const Byte* bytes, int offset, int len) {
+	DebugAssertMsg(CanWrite(), "해당 스트림에 Write 할 수 없습니다.");
+	const int iFd = Detail::ToFileDescriptor(m_hHandle);
+	int iTotalWritten = 0;
+
+	while (iTotalWritten < len) {
+		const ssize_t iWritten = write(iFd, bytes + offset + iTotalWritten, len - iTotalWritten);
+
+		if (iWritten < 0 && errno == EINTR) continue;
+		if (iWritten < 0) {
+			throw RuntimeException(StringUtil::Format("파일 쓰기에 실패했습니다. (errno: %d)", errno));
+		}
+
+		iTotalWritten += int(iWritten);
+	}
+
+	SetOffset(m_iOffset + iTotalWritten);
+}
+
+void FileStream::Seek(int offset, Origin origin) {
+	const int iWhence = origin == eBegin ? SEEK_SET : origin == eCurrent ? SEEK_CUR : SEEK_END;
+	const off_t iOffset = lseek(Detail::ToFileDescriptor(m_hHandle), offset, iWhence);
+
+	if (iOffset < 0) {
+		throw RuntimeException(StringUtil::Format("파일 위치를 옮기지 못했습니다. (errno: %d)", errno));
+	}
+
+	SetOffset(int(iOffset));
+}
+
+bool FileStream::Flush() {
+	return fsync(Detail::ToFileDescriptor(m_hHandle)) == 0;
+}
+
+void FileStream::Close() {
+	if (IsClosed()) {
+		return;
+	}
+
+	close(Detail::ToFileDescriptor(m_hHandle));
+	m_hHandle = Detail::ToIoHandle(-1);
+}
+
+bool FileStream::IsClosed() {
+	return Detail::ToFileDescriptor(m_hHandle) == -1;
+}
+
+NS_JC_END
@@ -0,0 +1,47 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 메모리 복사/초기화 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Memory.h>
+
+#include <cstring>
+
+NS_JC_BEGIN
+
+void Memory::Copy(void* dst, const int dstCapacityByte, const void* src, const int srcCopyByte) {
+	if (dstCapacityByte < srcCopyByte) {
+		throw InvalidArgumentException("복사할 크기가 대상 버퍼의 크기보다 큽니다.");
+	}
+
+	memmove(dst, src, srcCopyByte);
+}
+
+void Memory::CopyUnsafe(void* dst, const void* src, const int srcCopyByte) {
+	memmove(dst, src, srcCopyByte);
+}
+
+void Memory::CopyReverse(void* dst, const int dstCapacityByte, const void* src, const int srcCopyByte) {
+	if (dstCapacityByte < srcCopyByte) {
+		throw InvalidArgumentException("복사할 크기가 대상 버퍼의 크기보다 큽니다.");
+	}
+
+	CopyUnsafeReverse(dst, src, srcCopyByte);
+}
+
+void Memory::CopyUnsafeReverse(void* dst, const void* src, const int srcCopyByte) {
+	Byte* pDst = static_cast<Byte*>(dst) + srcCopyByte;
+	const Byte* pSrc = static_cast<const Byte*>(src) + srcCopyByte;
+
+	for (int i = 0; i < srcCopyByte; ++i) {
+		*--pDst = *--pSrc;
+	}
+}
+
+void Memory::Set(void* src, const int srcCapacity, const Byte value) {
+	memset(src, value, srcCapacity);
+}
+
+NS_JC_END
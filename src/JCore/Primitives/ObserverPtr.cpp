@@ -0,0 +1,53 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 ObserverPtr 공용 정의
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Primitives/ObserverPtr.h>
+
+NS_JC_BEGIN
+
+void VoidBase::OwnerMoveToOwner(VoidOwner& owner) {
+	DeletePointer();
+
+	m_pPointer = owner.m_pPointer;
+	m_pCounter = owner.m_pCounter;
+	m_bNoDelete = owner.m_bNoDelete;
+
+	owner.m_pPointer = nullptr;
+	owner.m_pCounter = nullptr;
+}
+
+void VoidBase::WatcherCopyToOwner(const VoidOwner& owner) {
+	SubtractWatcherCount();
+
+	m_pPointer = owner.m_pPointer;
+	m_pCounter = owner.m_pCounter;
+
+	AddWatcherCount();
+}
+
+void VoidBase::WatcherCopyToWatcher(const VoidWatcher& watcher) {
+	if (this == &watcher) return;
+	SubtractWatcherCount();
+
+	m_pPointer = watcher.m_pPointer;
+	m_pCounter = watcher.m_pCounter;
+
+	AddWatcherCount();
+}
+
+void VoidBase::WatcherMoveToWatcher(VoidWatcher& watcher) {
+	if (this == &watcher) return;
+	SubtractWatcherCount();
+
+	m_pPointer = watcher.m_pPointer;
+	m_pCounter = watcher.m_pCounter;
+
+	watcher.m_pPointer = nullptr;
+	watcher.m_pCounter = nullptr;
+}
+
+NS_JC_END
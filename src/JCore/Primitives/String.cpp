@@ -0,0 +1,423 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 String 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Primitives/String.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Container/Vector.h>
+#include <JCore/Exception.h>
+
+#include <cstdarg>
+#include <cstring>
+#include <cctype>
+
+NS_JC_BEGIN
+
+String::String() {
+	Initialize();
+}
+
+String::String(const int capacity) {
+	Initialize(capacity);
+}
+
+String::String(const char* str, const int capacity) {
+	const int iLen = str ? StringUtil::Length(str) : 0;
+	Initialize(Math::Max(capacity, iLen + 1));
+	Append(str ? str : EmptyString);
+}
+
+String::String(const char* str) : String(str, DefaultBufferSize) {}
+
+String::String(char ch, int count) {
+	Initialize(Math::Max(DefaultBufferSize, count + 1));
+	memset(m_pBuffer, ch, count);
+	m_iLen = count;
+	m_pBuffer[m_iLen] = '\0';
+}
+
+String::String(const std::string& str) : String(str.c_str(), static_cast<int>(str.length()) + 1) {}
+
+String::String(const String& str) {
+	Initialize(str.m_iCapacity > 0 ? str.m_iCapacity : DefaultBufferSize);
+	if (str.m_pBuffer) {
+		memcpy(m_pBuffer, str.m_pBuffer, str.m_iLen + 1);
+		m_iLen = str.m_iLen;
+	}
+}
+
+String::String(String&& str) noexcept {
+	m_pBuffer = str.m_pBuffer;
+	m_iLen = str.m_iLen;
+	m_iCapacity = str.m_iCapacity;
+
+	str.m_pBuffer = nullptr;
+	str.m_iLen = 0;
+	str.m_iCapacity = 0;
+}
+
+String::~String() {
+	JCORE_DELETE_ARRAY_SAFE(m_pBuffer);
+	m_iLen = 0;
+	m_iCapacity = 0;
+}
+
+void String::Initialize(int capacity) {
+	if (capacity <= 0) capacity = DefaultBufferSize;
+
+	m_pBuffer = dbg_new char[capacity];
+	m_pBuffer[0] = '\0';
+	m_iLen = 0;
+	m_iCapacity = capacity;
+}
+
+void String::ExchangeSource(char* src, int len) {
+	JCORE_DELETE_ARRAY_SAFE(m_pBuffer);
+	m_pBuffer = src;
+	m_iLen = len;
+	m_iCapacity = len + 1;
+}
+
+void String::Append(const char ch) {
+	ThrowIfNotInitialized();
+	ResizeIfNeeded(m_iLen + 1);
+	m_pBuffer[m_iLen++] = ch;
+	m_pBuffer[m_iLen] = '\0';
+}
+
+void String::Append(const char* str) {
+	ThrowIfNotInitialized();
+	const int iLen = StringUtil::Length(str);
+	ResizeIfNeeded(m_iLen + iLen);
+	memcpy(m_pBuffer + m_iLen, str, iLen);
+	m_iLen += iLen;
+	m_pBuffer[m_iLen] = '\0';
+}
+
+void String::Append(const std::string& str) {
+	Append(str.c_str());
+}
+
+void String::Append(const String& str) {
+	if (str.m_pBuffer == nullptr) return;
+	ThrowIfNotInitialized();
+	const int iLen = str.m_iLen;
+	ResizeIfNeeded(m_iLen + iLen);
+	memmove(m_pBuffer + m_iLen, str.m_pBuffer, iLen);
+	m_iLen += iLen;
+	m_pBuffer[m_iLen] = '\0';
+}
+
+void String::Append(String&& str) {
+	Append(static_cast<const String&>(str));
+}
+
+void String::Insert(const int idx, const char* str) {
+	ThrowIfNotInitialized();
+	if (idx < 0 || idx > m_iLen) {
+		throw OutOfRangeException("올바르지 않은 인덱스입니다.");
+	}
+
+	const int iLen = StringUtil::Length(str);
+	ResizeIfNeeded(m_iLen + iLen);
+	memmove(m_pBuffer + idx + iLen, m_pBuffer + idx, m_iLen - idx + 1);
+	memcpy(m_pBuffer + idx, str, iLen);
+	m_iLen += iLen;
+}
+
+void String::Insert(const int idx, const String& str) {
+	Insert(idx, str.Source());
+}
+
+void String::Resize(const int capacity) {
+	if (capacity <= m_iLen) {
+		throw InvalidArgumentException("문자열 길이보다 작은 크기로 변경할 수 없습니다.");
+	}
+
+	char* pNewBuffer = dbg_new char[capacity];
+	if (m_pBuffer) {
+		memcpy(pNewBuffer, m_pBuffer, m_iLen + 1);
+	} else {
+		pNewBuffer[0] = '\0';
+	}
+
+	JCORE_DELETE_ARRAY_SAFE(m_pBuffer);
+	m_pBuffer = pNewBuffer;
+	m_iCapacity = capacity;
+}
+
+void String::ResizeIfNeeded(int len) {
+	if (len < m_iCapacity) {
+		return;
+	}
+
+	int iNewCapacity = Math::Max(m_iCapacity, 1) * ExpandingFactor;
+	while (iNewCapacity <= len) {
+		iNewCapacity *= ExpandingFactor;
+	}
+	Resize(iNewCapacity);
+}
+
+int String::Compare(const String& str) const {
+	return Compare(str.Source(), str.Length());
+}
+
+int String::Compare(const char* str, const int strLen) const {
+	const char* pSelf = m_pBuffer ? m_pBuffer : EmptyString;
+	const int iOtherLen = strLen < 0 ? StringUtil::Length(str) : strLen;
+	const int iCommon = Math::Min(m_iLen, iOtherLen);
+	const int iResult = memcmp(pSelf, str, iCommon);
+
+	if (iResult != 0) return iResult < 0 ? -1 : 1;
+	if (m_iLen == iOtherLen) return 0;
+	return m_iLen < iOtherLen ? -1 : 1;
+}
+
+Vector<int, DefaultAllocator> String::FindAll(int startIdx, int endIdx, const char* str) const {
+	Vector<int, DefaultAllocator> vResult;
+	const int iLen = StringUtil::Length(str);
+	if (iLen == 0) return vResult;
+
+	int iOffset = startIdx;
+	while (true) {
+		const int iFound = Find(iOffset, endIdx, str);
+		if (iFound == -1) break;
+		vResult.PushBack(iFound);
+		iOffset = iFound + iLen;
+	}
+
+	return vResult;
+}
+
+Vector<int, DefaultAllocator> String::FindAll(const char* str) const { return FindAll(0, m_iLen - 1, str); }
+Vector<int, DefaultAllocator> String::FindAll(const String& str) const { return FindAll(0, m_iLen - 1, str.Source()); }
+
+int String::Find(int startIdx, int endIdx, const char* str) const {
+	return StringUtil::Find(m_pBuffer, m_iLen, startIdx, endIdx, str);
+}
+
+int String::Find(int startIdx, const char* str) const { return Find(startIdx, m_iLen - 1, str); }
+int String::Find(int startIdx, const String& str) const { return Find(startIdx, m_iLen - 1, str.Source()); }
+int String::Find(const char* str) const { return Find(0, m_iLen - 1, str); }
+int String::Find(const String& str) const { return Find(0, m_iLen - 1, str.Source()); }
+
+int String::FindReverse(int startIdx, int endIdx, const char* str) const {
+	const int iLen = StringUtil::Length(str);
+	if (iLen == 0 || m_iLen == 0) return -1;
+	if (startIdx < 0) startIdx = 0;
+	if (endIdx >= m_iLen) endIdx = m_iLen - 1;
+
+	for (int i = endIdx - iLen + 1; i >= startIdx; --i) {
+		if (memcmp(m_pBuffer + i, str, iLen) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int String::FindReverse(const String& str) const { return FindReverse(0, m_iLen - 1, str.Source()); }
+int String::FindReverse(const char* str) const { return FindReverse(0, m_iLen - 1, str); }
+
+void String::Clear() {
+	if (m_pBuffer == nullptr) return;
+	m_iLen = 0;
+	m_pBuffer[0] = '\0';
+}
+
+void String::Clear(int offset, int len) {
+	if (offset < 0 || offset + len > m_iLen) {
+		throw OutOfRangeException("올바르지 않은 범위입니다.");
+	}
+
+	memmove(m_pBuffer + offset, m_pBuffer + offset + len, m_iLen - offset - len + 1);
+	m_iLen -= len;
+}
+
+int String::Count(const char* str) const { return FindAll(str).Size(); }
+int String::Count(const String& val) const { return FindAll(val).Size(); }
+int String::Count(const int startIdx, const int endIdx, const char* str) const { return FindAll(startIdx, endIdx, str).Size(); }
+int String::Count(const int startIdx, const int endIdx, const String& val) const { return FindAll(startIdx, endIdx, val.Source()).Size(); }
+
+int String::Replace(const char* from, const String& to) { return Replace(0, from, to); }
+int String::Replace(const String& from, const String& to) { return Replace(0, from.Source(), to); }
+
+int String::Replace(int offset, int len, const String& to) {
+	Clear(offset, len);
+	Insert(offset, to);
+
+	const int iNext = offset + to.Length();
+	return iNext >= m_iLen ? -1 : iNext;
+}
+
+int String::Replace(int offset, const char* from, const String& to) {
+	const int iFound = Find(offset, from);
+	if (iFound == -1) return -1;
+	return Replace(iFound, StringUtil::Length(from), to);
+}
+
+int String::Replace(int offset, const String& from, const String& to) {
+	return Replace(offset, from.Source(), to);
+}
+
+void String::ReplaceAll(const char* from, const char* to) {
+	const String szTo = to;
+	int iOffset = 0;
+	while (iOffset != -1 && iOffset < m_iLen) {
+		iOffset = Replace(iOffset, from, szTo);
+	}
+}
+
+bool String::Contain(const char* str) const { return Find(str) != -1; }
+bool String::Contain(const String& str) const { return Find(str) != -1; }
+
+void String::Format(const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	*this = StringUtil::Format(format, args);
+	va_end(args);
+}
+
+void String::SetAt(const int idx, const char ch) {
+	ThrowIfInvalidIndex(idx);
+	m_pBuffer[idx] = ch;
+}
+
+char String::GetAt(const int idx) const {
+	ThrowIfInvalidIndex(idx);
+	return m_pBuffer[idx];
+}
+
+String String::GetRange(const int startIdx, const int endIdx) const {
+	ThrowIfInvalidRangeIndex(startIdx, endIdx);
+	return StringUtil::GetRange(m_pBuffer, m_iLen, startIdx, endIdx);
+}
+
+Tuple<char*, int, int> String::GetRangeUnsafe(const int startIdx, const int endIdx) const {
+	return StringUtil::GetRangeUnsafe(m_pBuffer, m_iLen, startIdx, endIdx);
+}
+
+Vector<String, DefaultAllocator> String::Split(const char* delimiter, const bool includeEmpty) const {
+	Vector<String, DefaultAllocator> vTokens;
+	const int iDelimiterLen = StringUtil::Length(delimiter);
+	int iOffset = 0;
+
+	while (iOffset <= m_iLen) {
+		int iFound = iDelimiterLen > 0 ? Find(iOffset, delimiter) : -1;
+		if (iFound == -1) iFound = m_iLen;
+
+		const int iTokenLen = iFound - iOffset;
+		if (iTokenLen > 0) {
+			vTokens.PushBack(String(m_pBuffer + iOffset, iTokenLen + 1).GetRange(0, iTokenLen - 1));
+		} else if (includeEmpty) {
+			vTokens.PushBack(String());
+		}
+
+		iOffset = iFound + Math::Max(iDelimiterLen, 1);
+	}
+
+	return vTokens;
+}
+
+String String::ToLowerCase() const {
+	String szResult = *this;
+	for (int i = 0; i < szResult.m_iLen; ++i)
+		szResult.m_pBuffer[i] = static_cast<char>(tolower(szResult.m_pBuffer[i]));
+	return szResult;
+}
+
+String String::ToUpperCase() const {
+	String szResult = *this;
+	for (int i = 0; i < szResult.m_iLen; ++i)
+		szResult.m_pBuffer[i] = static_cast<char>(toupper(szResult.m_pBuffer[i]));
+	return szResult;
+}
+
+std::string String::ToStd() {
+	return std::string(m_pBuffer ? m_pBuffer : EmptyString, m_iLen);
+}
+
+char& String::operator[](const int idx) const {
+	ThrowIfInvalidIndex(idx);
+	return m_pBuffer[idx];
+}
+
+String String::operator+(const String& other) const { String szTemp = *this; szTemp.Append(other); return szTemp; }
+String String::operator+(const char ch) const { String szTemp = *this; szTemp.Append(ch); return szTemp; }
+String String::operator+(const char* str) const { String szTemp = *this; szTemp.Append(str); return szTemp; }
+
+String& String::operator+=(const String& other) { Append(other); return *this; }
+String& String::operator+=(const char ch) { Append(ch); return *this; }
+String& String::operator+=(const char* str) { Append(str); return *this; }
+
+String& String::operator=(const String& other) {
+	if (this == &other) return *this;
+	if (m_pBuffer == nullptr) Initialize(Math::Max(other.m_iLen + 1, DefaultBufferSize));
+
+	Clear();
+	Append(other);
+	return *this;
+}
+
+String& String::operator=(String&& other) noexcept {
+	if (this == &other) return *this;
+	JCORE_DELETE_ARRAY_SAFE(m_pBuffer);
+
+	m_pBuffer = other.m_pBuffer;
+	m_iLen = other.m_iLen;
+	m_iCapacity = other.m_iCapacity;
+
+	other.m_pBuffer = nullptr;
+	other.m_iLen = 0;
+	other.m_iCapacity = 0;
+	return *this;
+}
+
+String& String::operator=(const char* other) {
+	if (m_pBuffer == nullptr) Initialize();
+
+	Clear();
+	Append(other);
+	return *this;
+}
+
+bool String::operator==(const String& other) const { return Compare(other) == 0; }
+bool String::operator==(const char* other) const { return Compare(other) == 0; }
+bool String::operator!=(const String& other) const { return Compare(other) != 0; }
+bool String::operator!=(const char* other) const { return Compare(other) != 0; }
+bool String::operator<(const String& other) const { return Compare(other) < 0; }
+bool String::operator<(const char* other) const { return Compare(other) < 0; }
+bool String::operator>(const String& other) const { return Compare(other) > 0; }
+bool String::operator>(const char* other) const { return Compare(other) > 0; }
+bool String::operator<=(const String& other) const { return Compare(other) <= 0; }
+bool String::operator<=(const char* other) const { return Compare(other) <= 0; }
+bool String::operator>=(const String& other) const { return Compare(other) >= 0; }
+bool String::operator>=(const char* other) const { return Compare(other) >= 0; }
+
+std::ostream& operator<<(std::ostream& os, const String& src) {
+	os << (src.m_pBuffer ? src.m_pBuffer : String::EmptyString);
+	return os;
+}
+
+void String::ThrowIfInvalidRangeIndex(const int startIdx, const int endIdx) const {
+	if (!IsValidIndexRange(startIdx, endIdx)) {
+		throw OutOfRangeException("올바르지 않은 범위입니다.");
+	}
+}
+
+void String::ThrowIfNotInitialized() const {
+	if (m_pBuffer == nullptr) {
+		throw NullPointerException("문자열이 초기화되지 않았습니다.");
+	}
+}
+
+void String::ThrowIfInvalidIndex(const int idx) const {
+	if (idx < 0 || idx >= m_iLen) {
+		throw OutOfRangeException("올바르지 않은 인덱스입니다.");
+	}
+}
+
+NS_JC_END
@@ -0,0 +1,211 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 StringUtil 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Primitives/StringUtil.h>
+#include <JCore/Primitives/String.h>
+#include <JCore/Container/Vector.h>
+#include <JCore/Exception.h>
+
+#include <cstdarg>
+#include <cstring>
+
+NS_JC_BEGIN
+
+Vector<String, DefaultAllocator> StringUtil::Split(String& src, const char* delimiter) {
+	return src.Split(delimiter);
+}
+
+String StringUtil::Format(const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	String szResult = Format(format, args);
+	va_end(args);
+	return szResult;
+}
+
+String StringUtil::Format(const char* format, va_list args) {
+	va_list argsCopy;
+	va_copy(argsCopy, args);
+	const int iLen = vsnprintf(nullptr, 0, format, argsCopy);
+	va_end(argsCopy);
+
+	if (iLen < 0) {
+		throw RuntimeException("문자열 포맷팅에 실패했습니다.");
+	}
+
+	String szResult(iLen + 1);
+	vsnprintf(szResult.Source(), iLen + 1, format, args);
+	szResult.SetLength(iLen);
+	return szResult;
+}
+
+void StringUtil::FormatBuffer(char* buff, const int buffCapacity, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	FormatBuffer(buff, buffCapacity, format, args);
+	va_end(args);
+}
+
+void StringUtil::FormatBuffer(char* buff, const int buffCapacity, const char* format, va_list va) {
+	vsnprintf(buff, buffCapacity, format, va);
+}
+
+template <typename TInteger>
+TInteger StringUtil::ToNumber(const char* str, bool ignoreLeadingZero) {
+	if (ignoreLeadingZero) {
+		str = SkipLeadingChar(str, '0');
+	}
+
+	bool bNegative = false;
+	if (*str == '-') {
+		bNegative = true;
+		++str;
+	}
+
+	TInteger iResult = 0;
+	for (; *str >= '0' && *str <= '9'; ++str) {
+		iResult = iResult * 10 + static_cast<TInteger>(*str - '0');
+	}
+
+	return bNegative ? static_cast<TInteger>(-iResult) : iResult;
+}
+
+const char* StringUtil::SkipLeadingChar(const char* str, char skipChar) {
+	// 숫자 "0" 처럼 전부 skipChar인 경우 마지막 한 글자는 남겨둔다.
+	while (*str == skipChar && *(str + 1) != '\0') {
+		++str;
+	}
+	return str;
+}
+
+template <typename TInteger>
+String StringUtil::ToString(TInteger integer) {
+	String szResult;
+	szResult.Append(integer);
+	return szResult;
+}
+
+int StringUtil::Length(const char* str) {
+	return str ? static_cast<int>(strlen(str)) : 0;
+}
+
+int StringUtil::Copy(char* buffer, const int bufferSize, const char* copy) {
+	const int iLen = Length(copy);
+	if (iLen + 1 > bufferSize) {
+		throw InvalidArgumentException("버퍼 크기가 부족합니다.");
+	}
+
+	memcpy(buffer, copy, iLen + 1);
+	return iLen;
+}
+
+int StringUtil::CopyUnsafe(char* buffer, const char* copy) {
+	const int iLen = Length(copy);
+	memcpy(buffer, copy, iLen + 1);
+	return iLen;
+}
+
+bool StringUtil::IsEqual(const char* src, const int srcLen, const char* dst, const int dstLen) {
+	return srcLen == dstLen && memcmp(src, dst, srcLen) == 0;
+}
+
+void StringUtil::Swap(String& src, String& dst) {
+	String szTemp = Move(src);
+	src = Move(dst);
+	dst = Move(szTemp);
+}
+
+int StringUtil::Find(const char* source, int sourceLen, int startIdx, int endIdx, const char* str) {
+	const int iLen = Length(str);
+	if (source == nullptr || iLen == 0) return -1;
+	if (startIdx < 0) startIdx = 0;
+	if (endIdx >= sourceLen) endIdx = sourceLen - 1;
+
+	for (int i = startIdx; i + iLen - 1 <= endIdx; ++i) {
+		if (memcmp(source + i, str, iLen) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int StringUtil::Find(const char* source, int sourceLen, int startIdx, const char* str) {
+	return Find(source, sourceLen, startIdx, sourceLen - 1, str);
+}
+
+int StringUtil::FindChar(const char* source, char ch) {
+	const char* pFound = strchr(source, ch);
+	return pFound ? static_cast<int>(pFound - source) : -1;
+}
+
+int StringUtil::FindCharUncontained(const char* source, char ch) {
+	for (int i = 0; source[i] != '\0'; ++i) {
+		if (source[i] != ch) return i;
+	}
+	return -1;
+}
+
+String StringUtil::GetRange(const char* source, int sourceLen, int startIdx, int endIdx) {
+	const int iLen = endIdx - startIdx + 1;
+	String szResult(iLen + 1);
+	memcpy(szResult.Source(), source + startIdx, iLen);
+	szResult.Source()[iLen] = '\0';
+	szResult.SetLength(iLen);
+	return szResult;
+}
+
+Tuple<char*, int, int> StringUtil::GetRangeUnsafe(const char* source, int sourceLen, int startIdx, int endIdx) {
+	const int iLen = endIdx - startIdx + 1;
+	char* pBuffer = dbg_new char[iLen + 1];
+	memcpy(pBuffer, source + startIdx, iLen);
+	pBuffer[iLen] = '\0';
+	return { pBuffer, iLen, iLen + 1 };
+}
+
+void StringUtil::ConcatInnerBack(char* buf, int buflen, int bufCapacity, const char* concatStr, int concatStrLen) {
+	if (buflen + concatStrLen + 1 > bufCapacity) {
+		throw InvalidArgumentException("버퍼 크기가 부족합니다.");
+	}
+
+	memcpy(buf + buflen, concatStr, concatStrLen);
+	buf[buflen + concatStrLen] = '\0';
+}
+
+void StringUtil::ConcatInnerBack(char* buf, int bufCapacity, const char* concatStr) {
+	ConcatInnerBack(buf, Length(buf), bufCapacity, concatStr, Length(concatStr));
+}
+
+void StringUtil::ConcatInnerFront(char* buf, int buflen, int bufCapacity, const char* concatStr, int concatStrLen) {
+	if (buflen + concatStrLen + 1 > bufCapacity) {
+		throw InvalidArgumentException("버퍼 크기가 부족합니다.");
+	}
+
+	memmove(buf + concatStrLen, buf, buflen + 1);
+	memcpy(buf, concatStr, concatStrLen);
+}
+
+void StringUtil::ConcatInnerFront(char* buf, int bufCapacity, const char* concatStr) {
+	ConcatInnerFront(buf, Length(buf), bufCapacity, concatStr, Length(concatStr));
+}
+
+#define JCORE_STRING_UTIL_INSTANTIATE(type)									\
+	template type StringUtil::ToNumber<type>(const char*, bool);			\
+	template String StringUtil::ToString<type>(type)
+
+JCORE_STRING_UTIL_INSTANTIATE(Int8);
+JCORE_STRING_UTIL_INSTANTIATE(Int8U);
+JCORE_STRING_UTIL_INSTANTIATE(Int16);
+JCORE_STRING_UTIL_INSTANTIATE(Int16U);
+JCORE_STRING_UTIL_INSTANTIATE(Int32);
+JCORE_STRING_UTIL_INSTANTIATE(Int32U);
+JCORE_STRING_UTIL_INSTANTIATE(Int32L);
+JCORE_STRING_UTIL_INSTANTIATE(Int32UL);
+JCORE_STRING_UTIL_INSTANTIATE(Int64);
+JCORE_STRING_UTIL_INSTANTIATE(Int64U);
+
+NS_JC_END
@@ -0,0 +1,47 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 난수 생성기 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Random.h>
+
+NS_JC_BEGIN
+
+Random::Random() {
+	EngineInitialize();
+}
+
+void Random::EngineInitialize() {
+	if (ms_bInitialized) {
+		return;
+	}
+
+	ms_DefaultRandomEngine.seed(ms_RandomDevice());
+	ms_bInitialized = true;
+}
+
+int Random::GenerateInt(int inclusiveBegin, int exclusiveEnd) {
+	EngineInitialize();
+
+	if (inclusiveBegin >= exclusiveEnd) {
+		throw InvalidArgumentException("begin >= end 되면 안댐");
+	}
+
+	std::uniform_int_distribution<int> dist(inclusiveBegin, exclusiveEnd - 1);
+	return dist(ms_DefaultRandomEngine);
+}
+
+double Random::GenerateDouble(double inclusiveBegin, double inclusiveEnd) {
+	EngineInitialize();
+
+	if (inclusiveBegin > inclusiveEnd) {
+		throw InvalidArgumentException("begin > end 되면 안댐");
+	}
+
+	std::uniform_real_distribution<double> dist(inclusiveBegin, inclusiveEnd);
+	return dist(ms_DefaultRandomEngine);
+}
+
+NS_JC_END
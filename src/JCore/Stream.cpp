@@ -0,0 +1,50 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 스트림 공통 읽기/쓰기 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Stream.h>
+#include <JCore/Primitives/String.h>
+#include <JCore/Exception.h>
+
+NS_JC_BEGIN
+
+namespace Detail {
+	template <typename T>
+	T ReadPrimitive(Stream& stream) {
+		T data{};
+		if (stream.Read(reinterpret_cast<Byte*>(&data), 0, sizeof(T)) != sizeof(T)) {
+			throw RuntimeException("스트림에서 읽을 데이터가 부족합니다.");
+		}
+		return data;
+	}
+}
+
+// 널문자까지 읽는다.
+String Stream::ReadString() {
+	String str;
+	char ch;
+
+	while (Read(reinterpret_cast<Byte*>(&ch), 0, 1) == 1 && ch != '\0') {
+		str.Append(ch);
+	}
+
+	return str;
+}
+
+Int8 Stream::ReadInt8() { return Detail::ReadPrimitive<Int8>(*this); }
+Byte Stream::ReadByte() { return Detail::ReadPrimitive<Byte>(*this); }
+Int16 Stream::ReadInt16() { return Detail::ReadPrimitive<Int16>(*this); }
+Int16U Stream::ReadInt16U() { return Detail::ReadPrimitive<Int16U>(*this); }
+Int32 Stream::ReadInt32() { return Detail::ReadPrimitive<Int32>(*this); }
+Int32U Stream::ReadInt32U() { return Detail::ReadPrimitive<Int32U>(*this); }
+Int64 Stream::ReadInt64() { return Detail::ReadPrimitive<Int64>(*this); }
+Int64U Stream::ReadInt64U() { return Detail::ReadPrimitive<Int64U>(*this); }
+
+void Stream::WriteString(const String& str, bool withNull) {
+	Write(reinterpret_cast<const Byte*>(str.Source()), 0, withNull ? str.LengthWithNull() : str.Length());
+}
+
+NS_JC_END
@@ -0,0 +1,51 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 NormalLock 구현
+ * CriticalSection과 동작을 맞추기 위해 재귀 잠금이 가능한 뮤텍스를 사용한다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/NormalLock.h>
+#include <JCore/Threading/Thread.h>
+
+NS_JC_BEGIN
+
+NormalLock::NormalLock() : m_hOwnThread(0) {
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&m_Mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+NormalLock::~NormalLock() {
+	pthread_mutex_destroy(&m_Mutex);
+}
+
+void NormalLock::Lock() {
+	pthread_mutex_lock(&m_Mutex);
+	m_hOwnThread.Store(static_cast<int>(Thread::GetThreadId()));
+}
+
+void NormalLock::Unlock() {
+	m_hOwnThread.Store(0);
+	pthread_mutex_unlock(&m_Mutex);
+}
+
+bool NormalLock::TryLock() {
+	if (pthread_mutex_trylock(&m_Mutex) != 0) {
+		return false;
+	}
+
+	m_hOwnThread.Store(static_cast<int>(Thread::GetThreadId()));
+	return true;
+}
+
+bool NormalLock::IsLocked() {
+	return m_hOwnThread.Load() != 0;
+}
+
+template class LockGuard<NormalLock>;
+
+NS_JC_END
@@ -0,0 +1,82 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 NormalRwLock 구현 (std::mutex + std::condition_variable)
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/NormalRwLock.h>
+
+NS_JC_BEGIN
+
+NormalRwLock::NormalRwLock()
+	: m_iReadCount(0)
+	, m_bWriteFlag(false)
+{}
+
+void NormalRwLock::WriteLock() {
+	std::unique_lock lock(m_Mtx);
+	m_Condvar.wait(lock, [this] { return !m_bWriteFlag && m_iReadCount == 0; });
+	m_bWriteFlag = true;
+}
+
+bool NormalRwLock::TryWriteLock() {
+	std::unique_lock lock(m_Mtx);
+	if (m_bWriteFlag || m_iReadCount > 0) {
+		return false;
+	}
+
+	m_bWriteFlag = true;
+	return true;
+}
+
+void NormalRwLock::WriteUnlock() {
+	{
+		std::unique_lock lock(m_Mtx);
+		m_bWriteFlag = false;
+	}
+	m_Condvar.notify_all();
+}
+
+bool NormalRwLock::IsWriteLocked() {
+	std::unique_lock lock(m_Mtx);
+	return m_bWriteFlag;
+}
+
+void NormalRwLock::ReadLock() {
+	std::unique_lock lock(m_Mtx);
+	m_Condvar.wait(lock, [this] { return !m_bWriteFlag; });
+	++m_iReadCount;
+}
+
+bool NormalRwLock::TryReadLock() {
+	std::unique_lock lock(m_Mtx);
+	if (m_bWriteFlag) {
+		return false;
+	}
+
+	++m_iReadCount;
+	return true;
+}
+
+void NormalRwLock::ReadUnlock() {
+	bool bNotify;
+	{
+		std::unique_lock lock(m_Mtx);
+		bNotify = --m_iReadCount == 0;
+	}
+
+	if (bNotify) {
+		m_Condvar.notify_all();
+	}
+}
+
+bool NormalRwLock::IsReadLocked() {
+	std::unique_lock lock(m_Mtx);
+	return m_iReadCount > 0;
+}
+
+template class RwLockGuard<NormalRwLock, RwLockMode::Write>;
+template class RwLockGuard<NormalRwLock, RwLockMode::Read>;
+
+NS_JC_END
@@ -0,0 +1,63 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 RecursiveLock 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/RecursiveLock.h>
+#include <JCore/Threading/Thread.h>
+
+NS_JC_BEGIN
+
+RecursiveLock::RecursiveLock()
+	: m_uiLockedThreadId(0)
+	, m_iRecursion(0)
+{}
+
+void RecursiveLock::Lock() {
+	const Int32U uiThreadId = Thread::GetThreadId();
+
+	if (m_iRecursion > 0 && m_uiLockedThreadId == uiThreadId) {
+		++m_iRecursion;
+		return;
+	}
+
+	m_Lock.Lock();
+	m_uiLockedThreadId = uiThreadId;
+	m_iRecursion = 1;
+}
+
+bool RecursiveLock::TryLock() {
+	const Int32U uiThreadId = Thread::GetThreadId();
+
+	if (m_iRecursion > 0 && m_uiLockedThreadId == uiThreadId) {
+		++m_iRecursion;
+		return true;
+	}
+
+	if (!m_Lock.TryLock()) {
+		return false;
+	}
+
+	m_uiLockedThreadId = uiThreadId;
+	m_iRecursion = 1;
+	return true;
+}
+
+void RecursiveLock::Unlock() {
+	if (--m_iRecursion > 0) {
+		return;
+	}
+
+	m_uiLockedThreadId = 0;
+	m_Lock.Unlock();
+}
+
+bool RecursiveLock::IsLocked() {
+	return m_iRecursion > 0;
+}
+
+template class LockGuard<RecursiveLock>;
+
+NS_JC_END
@@ -0,0 +1,59 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 Semaphore 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/Semaphore.h>
+
+NS_JC_BEGIN
+
+Semaphore::Semaphore() : Semaphore(1, 1) {}
+
+Semaphore::Semaphore(int maxCount, int initialUsableCount)
+	: m_iMaxCount(maxCount)
+	, m_iUsableCount(initialUsableCount)
+{}
+
+void Semaphore::Lock() {
+	std::unique_lock lock(m_Mtx);
+	m_Condvar.wait(lock, [this] { return m_iUsableCount > 0; });
+	--m_iUsableCount;
+}
+
+void Semaphore::Unlock() {
+	Release(1);
+}
+
+bool Semaphore::TryLock() {
+	std::unique_lock lock(m_Mtx);
+	if (m_iUsableCount <= 0) {
+		return false;
+	}
+
+	--m_iUsableCount;
+	return true;
+}
+
+bool Semaphore::IsLocked() {
+	std::unique_lock lock(m_Mtx);
+	return m_iUsableCount <= 0;
+}
+
+int Semaphore::UsableCount() {
+	std::unique_lock lock(m_Mtx);
+	return m_iUsableCount;
+}
+
+void Semaphore::Release(int count) {
+	{
+		std::unique_lock lock(m_Mtx);
+		m_iUsableCount = Math::Min(m_iUsableCount + count, m_iMaxCount);
+	}
+	m_Condvar.notify_all();
+}
+
+template class LockGuard<Semaphore>;
+
+NS_JC_END
@@ -0,0 +1,44 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 SpinLock 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/SpinLock.h>
+
+NS_JC_BEGIN
+
+SpinLock::SpinLock() : m_bLocked(false) {}
+SpinLock::~SpinLock() = default;
+
+void SpinLock::Lock() {
+	for (;;) {
+		bool bExpected = false;
+		if (m_bLocked.CompareExchange(bExpected, true)) {
+			return;
+		}
+
+		// 잠금이 풀릴때까지는 읽기만 하면서 대기해서 캐시라인 핑퐁을 줄인다.
+		while (m_bLocked.Load()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void SpinLock::Unlock() {
+	m_bLocked.Store(false);
+}
+
+bool SpinLock::TryLock() {
+	bool bExpected = false;
+	return m_bLocked.CompareExchange(bExpected, true);
+}
+
+bool SpinLock::IsLocked() {
+	return m_bLocked.Load();
+}
+
+template class LockGuard<SpinLock>;
+
+NS_JC_END
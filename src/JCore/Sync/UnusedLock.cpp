@@ -0,0 +1,14 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 UnusedLock 구현
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Sync/UnusedLock.h>
+
+NS_JC_BEGIN
+
+template class LockGuard<UnusedLock>;
+
+NS_JC_END
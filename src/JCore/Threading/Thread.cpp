@@ -0,0 +1,174 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 Thread 구현 (pthread)
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Threading/Thread.h>
+
+#include <ctime>
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+
+NS_JC_BEGIN
+
+Int32U Thread::ms_uiMainThreadId = WinApi::GetCurrentThreadId();
+thread_local Int32U Thread::tls_uiThreadId;
+
+static pthread_t ToPosixHandle(WinHandle handle) { return reinterpret_cast<pthread_t>(handle); }
+static WinHandle FromPosixHandle(pthread_t handle) { return reinterpret_cast<WinHandle>(handle); }
+
+Thread::Thread(TRunnable&& fn, void* param, const char* name, bool autoJoin)
+	: Thread(name, autoJoin)
+{
+	Start(Move(fn), param);
+}
+
+Thread::Thread(Thread&& other) noexcept
+	: m_hHandle(other.m_hHandle)
+	, m_Name(Move(other.m_Name))
+	, m_uiThreadId(other.m_uiThreadId)
+	, m_eState(other.m_eState.Load())
+	, m_RunningSignal(1, 0)
+	, m_bAutoJoin(other.m_bAutoJoin)
+{
+	other.m_hHandle = nullptr;
+	other.m_uiThreadId = 0;
+	other.m_eState = eUninitialized;
+}
+
+Thread::~Thread() noexcept {
+	if (m_bAutoJoin && Joinable()) {
+		Join();
+	}
+}
+
+Thread& Thread::operator=(Thread&& other) noexcept {
+	if (m_eState != eUninitialized) {
+		return *this;
+	}
+
+	m_hHandle = other.m_hHandle;
+	m_Name = Move(other.m_Name);
+	m_uiThreadId = other.m_uiThreadId;
+	m_eState = other.m_eState.Load();
+	m_bAutoJoin = other.m_bAutoJoin;
+
+	other.m_hHandle = nullptr;
+	other.m_uiThreadId = 0;
+	other.m_eState = eUninitialized;
+	return *this;
+}
+
+int Thread::Start(TRunnable&& fn, void* param) {
+	if (m_eState != eUninitialized && m_eState != eJoined) {
+		return 0;
+	}
+
+	m_eState = eRunningWait;
+
+	ThreadParam* pParam = dbg_new ThreadParam{ Move(fn), this, param };
+
+	pthread_t hThread;
+	const auto fnEntry = [](void* threadParam) -> void* {
+		ThreadRoutine(threadParam);
+		return nullptr;
+	};
+
+	if (pthread_create(&hThread, nullptr, fnEntry, pParam) != 0) {
+		delete pParam;
+		m_eState = eUninitialized;
+		return 0;
+	}
+
+	m_hHandle = FromPosixHandle(hThread);
+	m_RunningSignal.Acquire();		// 쓰레드 아이디가 기록될때까지 대기
+	return static_cast<int>(m_uiThreadId);
+}
+
+Thread::JoinResult Thread::Join(int timeoutMiliSeconds) {
+	if (m_eState == eJoined) return eAlreadyJoined;
+	if (!Joinable()) return eNotJoinable;
+
+	m_eState = eJoinWait;
+
+	int iResult;
+	if (timeoutMiliSeconds == static_cast<int>(JCORE_INFINITE)) {
+		iResult = pthread_join(ToPosixHandle(m_hHandle), nullptr);
+	} else {
+		timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += timeoutMiliSeconds / 1000;
+		ts.tv_nsec += static_cast<long>(timeoutMiliSeconds % 1000) * 1000000;
+		if (ts.tv_nsec >= 1000000000) {
+			ts.tv_sec += 1;
+			ts.tv_nsec -= 1000000000;
+		}
+		iResult = pthread_timedjoin_np(ToPosixHandle(m_hHandle), nullptr, &ts);
+	}
+
+	if (iResult == ETIMEDOUT) {
+		m_eState = eRunning;
+		return eTimeout;
+	}
+
+	if (iResult != 0) {
+		return eError;
+	}
+
+	m_hHandle = nullptr;
+	m_eState = eJoined;
+	return eSuccess;
+}
+
+bool Thread::Joinable() {
+	return m_hHandle != nullptr && (m_eState == eRunning || m_eState == eJoinWait || m_eState == eAborted);
+}
+
+void Thread::Abort() {
+	if (m_hHandle == nullptr) return;
+	pthread_cancel(ToPosixHandle(m_hHandle));
+	m_eState = eAborted;
+}
+
+bool Thread::SetPriority(int priority) {
+	return WinApi::SetThreadPriority(m_hHandle, priority);
+}
+
+int Thread::GetPriority() {
+	return WinApi::GetThreadPriority(m_hHandle);
+}
+
+Int32U Thread::GetId() {
+	return m_uiThreadId;
+}
+
+Int32U Thread::GetThreadId() {
+	if (tls_uiThreadId == 0) {
+		tls_uiThreadId = WinApi::GetCurrentThreadId();
+	}
+
+	return tls_uiThreadId;
+}
+
+void Thread::Sleep(Int32U ms) {
+	timespec ts{ static_cast<time_t>(ms / 1000), static_cast<long>(ms % 1000) * 1000000 };
+	nanosleep(&ts, nullptr);
+}
+
+Int32U JCORE_STDCALL Thread::ThreadRoutine(void* param) {
+	ThreadParam* pParam = static_cast<ThreadParam*>(param);
+	Thread* pThread = pParam->Self;
+
+	pThread->m_uiThreadId = GetThreadId();
+	pThread->m_eState = eRunning;
+	pThread->m_RunningSignal.Release();
+
+	pParam->ThreadFunc(pParam->Param);
+	delete pParam;
+	return 0;
+}
+
+NS_JC_END
@@ -0,0 +1,68 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 스탑워치 구현
+ * 틱 단위는 TimeSpan과 동일하게 마이크로초이다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Time.h>
+
+#include <time.h>
+
+NS_JC_BEGIN
+
+namespace Detail {
+	inline Int64U MonotonicMicroSeconds() {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return Int64U(ts.tv_sec) * 1'000'000 + Int64U(ts.tv_nsec) / 1'000;
+	}
+
+	inline Int64U MonotonicNanoSeconds() {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return Int64U(ts.tv_sec) * 1'000'000'000 + Int64U(ts.tv_nsec);
+	}
+}
+
+Int64U StopWatch<StopWatchMode::System>::Start() {
+	StartTick = int(Detail::MonotonicMicroSeconds() / 1'000);
+	return StartTick;
+}
+
+TimeSpan StopWatch<StopWatchMode::System>::StopReset() {
+	const int iNow = int(Detail::MonotonicMicroSeconds() / 1'000);
+	const TimeSpan elapsed(Int64(iNow - StartTick) * 1'000);
+	StartTick = iNow;
+	return elapsed;
+}
+
+TimeSpan StopWatch<StopWatchMode::System>::StopContinue() {
+	const int iNow = int(Detail::MonotonicMicroSeconds() / 1'000);
+	return TimeSpan(Int64(iNow - StartTick) * 1'000);
+}
+
+// 카운터는 나노초, 반환은 마이크로초
+StopWatch<StopWatchMode::HighResolution>::StopWatch()
+	: Precision(1'000)
+	, Frequency(1'000'000'000) {
+}
+
+Int64U StopWatch<StopWatchMode::HighResolution>::Start() {
+	StartCounter = Detail::MonotonicNanoSeconds();
+	return StartCounter;
+}
+
+TimeSpan StopWatch<StopWatchMode::HighResolution>::StopReset() {
+	const Int64U uiNow = Detail::MonotonicNanoSeconds();
+	const TimeSpan elapsed(Int64(uiNow - StartCounter) / Int64(Precision));
+	StartCounter = uiNow;
+	return elapsed;
+}
+
+TimeSpan StopWatch<StopWatchMode::HighResolution>::StopContinue() {
+	return TimeSpan(Int64(Detail::MonotonicNanoSeconds() - StartCounter) / Int64(Precision));
+}
+
+NS_JC_END
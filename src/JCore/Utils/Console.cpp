@@ -0,0 +1,104 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 Console 구현
+ * 윈도우 콘솔 API 대신 VT 이스케이프 시퀀스로 색상/커서를 제어한다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Utils/Console.h>
+
+#include <iostream>
+#include <unistd.h>
+
+NS_JC_BEGIN
+
+const char* Console::VTForeColor[ConsoleColor::Max] = {
+	CSI_GRAPHIC_RENDITION(30), CSI_GRAPHIC_RENDITION(34), CSI_GRAPHIC_RENDITION(32), CSI_GRAPHIC_RENDITION(36),
+	CSI_GRAPHIC_RENDITION(31), CSI_GRAPHIC_RENDITION(35), CSI_GRAPHIC_RENDITION(33), CSI_GRAPHIC_RENDITION(37),
+	CSI_GRAPHIC_RENDITION(90), CSI_GRAPHIC_RENDITION(94), CSI_GRAPHIC_RENDITION(92), CSI_GRAPHIC_RENDITION(96),
+	CSI_GRAPHIC_RENDITION(91), CSI_GRAPHIC_RENDITION(95), CSI_GRAPHIC_RENDITION(93), CSI_GRAPHIC_RENDITION(97)
+};
+
+const char* Console::VTBackColor[ConsoleColor::Max] = {
+	CSI_GRAPHIC_RENDITION(40), CSI_GRAPHIC_RENDITION(44), CSI_GRAPHIC_RENDITION(42), CSI_GRAPHIC_RENDITION(46),
+	CSI_GRAPHIC_RENDITION(41), CSI_GRAPHIC_RENDITION(45), CSI_GRAPHIC_RENDITION(43), CSI_GRAPHIC_RENDITION(47),
+	CSI_GRAPHIC_RENDITION(100), CSI_GRAPHIC_RENDITION(104), CSI_GRAPHIC_RENDITION(102), CSI_GRAPHIC_RENDITION(106),
+	CSI_GRAPHIC_RENDITION(101), CSI_GRAPHIC_RENDITION(105), CSI_GRAPHIC_RENDITION(103), CSI_GRAPHIC_RENDITION(107)
+};
+
+const char* Console::VTForeToken[ConsoleColor::Max] = {
+	VT_FORE_COLOR_BLACK, VT_FORE_COLOR_BLUE, VT_FORE_COLOR_GREEN, VT_FORE_COLOR_CYAN,
+	VT_FORE_COLOR_RED, VT_FORE_COLOR_MAGNETA, VT_FORE_COLOR_YELLOW, VT_FORE_COLOR_LIGHT_GRAY,
+	VT_FORE_COLOR_GRAY, VT_FORE_COLOR_LIGHT_BLUE, VT_FORE_COLOR_LIGHT_GREEN, VT_FORE_COLOR_LIGHT_CYAN,
+	VT_FORE_COLOR_LIGHT_RED, VT_FORE_COLOR_LIGHT_MAGNETA, VT_FORE_COLOR_LIGHT_YELLOW, VT_FORE_COLOR_WHITE
+};
+
+const char* Console::VTBackToken[ConsoleColor::Max] = {
+	VT_BACK_COLOR_BLACK, VT_BACK_COLOR_BLUE, VT_BACK_COLOR_GREEN, VT_BACK_COLOR_CYAN,
+	VT_BACK_COLOR_RED, VT_BACK_COLOR_MAGNETA, VT_BACK_COLOR_YELLOW, VT_BACK_COLOR_LIGHT_GRAY,
+	VT_BACK_COLOR_GRAY, VT_BACK_COLOR_LIGHT_BLUE, VT_BACK_COLOR_LIGHT_GREEN, VT_BACK_COLOR_LIGHT_CYAN,
+	VT_BACK_COLOR_LIGHT_RED, VT_BACK_COLOR_LIGHT_MAGNETA, VT_BACK_COLOR_LIGHT_YELLOW, VT_BACK_COLOR_WHITE
+};
+
+bool Console::Init() {
+	ms_hStdout = WinApi::GetStdoutHandle();
+	return true;
+}
+
+bool Console::SetSize(int width, int height) {
+	// 터미널 에뮬레이터의 창 크기는 프로그램에서 바꾸지 않는다.
+	return false;
+}
+
+void Console::SetColor(ConsoleColor color) {
+	TLockGuard guard(ms_ConsoleLock);
+	ms_iDefaultColor = color;
+
+	// 출력이 터미널이 아닐때(파이프, 파일)는 색상 시퀀스를 섞지 않는다.
+	if (isatty(fileno(stdout))) {
+		fputs(VTForeColor[color], stdout);
+	}
+}
+
+void Console::GetColor(ConsoleColor color) {
+	SetColor(color);
+}
+
+ConsoleColor Console::GetColor() {
+	return ms_iDefaultColor;
+}
+
+String Console::ReadLine() {
+	std::string szLine;
+	std::getline(std::cin, szLine);
+	return szLine;
+}
+
+void Console::Clear() {
+	printf(CSI "2J" CSI "H");
+}
+
+void Console::SetCursorPosition(int x, int y) {
+	ms_iCursorPosX = x;
+	ms_iCursorPosY = y;
+	WinApi::SetConsoleCursorPosition(ms_hStdout, x, y);
+}
+
+Tuple<int, int> Console::GetCursorPosition() {
+	return { ms_iCursorPosX, ms_iCursorPosY };
+}
+
+bool Console::SetOutputCodePage(int codePage) {
+	return WinApi::SetConsoleOutputCodePage(codePage);
+}
+
+bool Console::SetEnableVTMode(bool enabled) {
+	return true;
+}
+
+int Console::GetOutputCodePage() {
+	return WinApi::GetConsoleOutputCodePage();
+}
+
+NS_JC_END
@@ -0,0 +1,124 @@
+﻿/*
+ * 작성자: 윤정도
+ * =====================
+ * POSIX 빌드용 WinApi/Interlocked 대체 구현
+ * 콘솔/이벤트 관련 함수는 대응되는 기능이 없으므로 실패를 반환하고
+ * Interlocked는 GCC/Clang의 __atomic 빌트인으로 구현한다.
+ */
+
+#include <JCore/Core.h>
+#include <JCore/Wrapper/WinApi.h>
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+NS_JC_BEGIN
+
+WinHandle WinApi::InvalidHandleValue = reinterpret_cast<WinHandle>(-1);
+
+bool WinApi::SetConsoleCursorPosition(WinHandle, int x, int y) {
+	printf("\x1b[%d;%dH", y + 1, x + 1);
+	return true;
+}
+
+bool WinApi::GetConsoleCursorPosition(WinHandle, int& x, int& y) {
+	x = 0;
+	y = 0;
+	return false;
+}
+
+bool WinApi::SetConsoleTextAttribute(WinHandle, Int16) { return false; }
+bool WinApi::SetConsoleOutputCodePage(Int32) { return true; }
+Int WinApi::GetConsoleOutputCodePage() { return 65001; }		// 리눅스 터미널은 UTF-8로 간주
+WinHandle WinApi::GetStdoutHandle() { return stdout; }
+WinHandle WinApi::CreateEventA(bool, bool, const char*) { return nullptr; }
+Int32U WinApi::WaitForMultipleObjectsEx(Int32U, WinHandle*, bool, Int32U, bool) { return JCORE_INFINITE; }
+Int32U WinApi::GetLastError() { return static_cast<Int32U>(errno); }
+bool WinApi::SetEvent(WinHandle) { return false; }
+bool WinApi::ResetEvent(WinHandle) { return false; }
+bool WinApi::CloseHandle(WinHandle) { return false; }
+int WinApi::GetThreadPriority(WinHandle) { return 0; }
+bool WinApi::SetThreadPriority(WinHandle, Int) { return false; }
+Int32U WinApi::GetCurrentThreadId() { return static_cast<Int32U>(syscall(SYS_gettid)); }
+
+Int32U WinApi::GetModuleFilePath(WinModule, char* filenameBuffer, int filenameBufferCapacity) {
+	const ssize_t iLen = readlink("/proc/self/exe", filenameBuffer, filenameBufferCapacity - 1);
+	if (iLen < 0) return 0;
+	filenameBuffer[iLen] = '\0';
+	return static_cast<Int32U>(iLen);
+}
+
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Add(TOperand* destination, TOperand value) {
+	return __atomic_add_fetch(destination, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::CompareExchange(TOperand* destination, TOperand expected, TOperand desired) {
+	__atomic_compare_exchange_n(destination, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return expected;	// 실패시 expected에 현재 값이 기록되므로 항상 초기값이 반환된다.
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Exchange(TOperand* destination, TOperand value) {
+	return __atomic_exchange_n(destination, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::ExchangeAdd(TOperand* destination, TOperand value) {
+	return __atomic_fetch_add(destination, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Increment(TOperand* destination) {
+	return __atomic_add_fetch(destination, 1, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Decrement(TOperand* destination) {
+	return __atomic_sub_fetch(destination, 1, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::And(TOperand* destination, TOperand value) {
+	return __atomic_fetch_and(destination, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Or(TOperand* destination, TOperand value) {
+	return __atomic_fetch_or(destination, value, __ATOMIC_SEQ_CST);
+}
+
+template <typename TOperand>
+TOperand Interlocked<TOperand>::Xor(TOperand* destination, TOperand value) {
+	return __atomic_fetch_xor(destination, value, __ATOMIC_SEQ_CST);
+}
+
+bool Interlocked<bool>::CompareExchange(bool* destination, bool expected, bool desired) {
+	__atomic_compare_exchange_n(destination, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return expected;
+}
+
+bool Interlocked<bool>::Exchange(bool* destination, bool value) {
+	return __atomic_exchange_n(destination, value, __ATOMIC_SEQ_CST);
+}
+
+bool Interlocked<bool>::Read(bool* destination) {
+	return __atomic_load_n(destination, __ATOMIC_SEQ_CST);
+}
+
+template struct Interlocked<Int8>;
+template struct Interlocked<Int8U>;
+template struct Interlocked<Int16>;
+template struct Interlocked<Int16U>;
+template struct Interlocked<WideChar>;
+template struct Interlocked<Int32>;
+template struct Interlocked<Int32U>;
+template struct Interlocked<Int32L>;
+template struct Interlocked<Int32UL>;
+template struct Interlocked<Int64>;
+template struct Interlocked<Int64U>;
+
+NS_JC_END